@@ -18,12 +18,45 @@
  * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include <Arduino.h>
+#include "hardware/clocks.h"
 
 #include "./src/ArduProfApp.h"
 #include "./src/AppContext.h"
 #include "./src/thread/QueueMain.h"
+#include "./src/util/BinLog.h"
+#include "./src/util/Metrics.h"
+#include "./src/audio/audio_const.h"
+#include "./src/peripheral/ClockScaler.h"
 
 ///////////////////////////////////////////////////////////////////////////////
+// clk_sys an integer multiple of the audio PIO clock (jitter-free BCLK/PDM clock), before any UART/SPI set up
+static bool initClocks(void)
+{
+#ifdef CLOCK_PLAN_ENABLE
+    return ClockScaler::getInstance()->begin(AUDIO_CAPTURE_RATE * AUDIO_PIO_CYCLES_PER_SAMPLE);
+#else
+    return false;
+#endif
+}
+
+static void logClocks(bool planned)
+{
+#ifdef CLOCK_PLAN_ENABLE
+    if (planned)
+    {
+        auto &plan = ClockScaler::getInstance()->plan();
+        LOG_TRACE("clock plan: VCO=", plan.vco_hz, ", postdiv=", plan.postdiv1, "/", plan.postdiv2,
+                  ", high=", plan.sys_hz[clockplan::ProfileHigh], " (PIO ", plan.pio[clockplan::ProfileHigh].div, "+", plan.pio[clockplan::ProfileHigh].frac, "/256)",
+                  ", low=", plan.sys_hz[clockplan::ProfileLow], " (PIO ", plan.pio[clockplan::ProfileLow].div, "+", plan.pio[clockplan::ProfileLow].frac, "/256)");
+    }
+    else
+    {
+        LOG_TRACE("no clock plan for ", AUDIO_CAPTURE_RATE * AUDIO_PIO_CYCLES_PER_SAMPLE, " Hz, clk_sys unchanged");
+    }
+#endif
+    Metrics::getInstance()->setClock(clock_get_hz(clk_sys), false);
+}
+
 static void initGlobalVar(void)
 {
 }
@@ -36,6 +69,11 @@ static void startTasks(void)
         static_cast<QueueMain *>(ctx->queueMain)->start(ctx);
     }
 
+    if (ctx->threadLog)
+    {
+        ctx->threadLog->start(ctx);
+    }
+
     if (ctx->threadApp)
     {
         ctx->threadApp->start(ctx);
@@ -68,12 +106,14 @@ static void initDebugPort(void)
     if (Serial)
     {
         LOG_ATTACH_SERIAL(Serial);
+        BinLog::getInstance()->attach(&Serial); // binary log frames, decode by tools/binlog_decode.py
         LOG_TRACE("set debug port to USB/CDC");
     }
     else
     {
         Serial1.begin(115200);
         LOG_ATTACH_SERIAL(Serial1);
+        BinLog::getInstance()->attach(&Serial1);
         LOG_TRACE("set debug port to UART0");
     }
 }
@@ -81,7 +121,9 @@ static void initDebugPort(void)
 ///////////////////////////////////////////////////////////////////////////////
 void setup()
 {
+    bool planned = initClocks();
     initDebugPort();
+    logClocks(planned);
 
     initGlobalVar();
     startTasks();
@@ -24,6 +24,7 @@
 #include "./thread/ThreadApp.h"
 #include "./thread/ThreadNet.h"
 #include "./thread/ThreadAudio.h"
+#include "./thread/ThreadLog.h"
 #include "./thread/QueueMain.h"
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -41,6 +42,7 @@ AppContext *getAppContext(void)
             .threadApp = ThreadApp::getInstance(),
             .threadAudio = ThreadAudio::getInstance(),
             .threadNet = ThreadNet::getInstance(),
+            .threadLog = ThreadLog::getInstance(),
         };
         _instance = &appContext;
     }
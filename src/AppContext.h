@@ -45,6 +45,7 @@ typedef struct _AppContext
     ardumbedos::ThreadBase *threadApp;
     ardumbedos::ThreadBase *threadAudio;
     ardumbedos::ThreadBase *threadNet;
+    ardumbedos::ThreadBase *threadLog;
 } AppContext;
 
 #endif
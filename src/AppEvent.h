@@ -52,10 +52,14 @@ typedef enum _AppTriggerSource : int16_t
     AppEthUp,
     AppEthDn,
 
-    AppInference, // ThreadApp->ThreadNet: uParam=<InferenceState>
-                  // ThreadAudio->ThreadApp: lParam=<prediction_result> (0.0-1.0; the content on uint32_t is a float data)
+    AppInference, // ThreadApp->ThreadNet: uParam=<InferenceState>, lParam=<detection time>
+                  // ThreadAudio->ThreadApp: uParam=<prediction_result> (0.0-1.0 as 0-65535, unit_to_uint16()), lParam=<detection time>
+                  // detection time: end of the analysed audio on the sample clock, low 32 bits of microseconds (time_us_32())
 
     AppCallmebotState, // uParam=<Callmebot::MessageState>
+
+    AppAudioTap,  // ThreadAudio->ThreadNet: packets are pending in AudioTap
+    AppClipReady, // ThreadAudio->ThreadNet: ClipRecorder holds a clip to be uploaded
 } AppTriggerSource;
 
 typedef enum _InferenceState : int16_t
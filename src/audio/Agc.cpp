@@ -0,0 +1,149 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "./Agc.h"
+
+///////////////////////////////////////////////////////////////////////////////
+static uint32_t isqrt(uint32_t value)
+{
+    uint32_t root = 0;
+    uint32_t bit = 1u << 30;
+    while (bit > value)
+    {
+        bit >>= 2;
+    }
+    while (bit)
+    {
+        if (value >= root + bit)
+        {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+Agc::Agc() : _gain(AGC_GAIN_INIT),
+             _envelope(AGC_TARGET_PEAK),
+             _peak(0),
+             _rms(0)
+{
+}
+
+uint32_t Agc::convert(const int32_t *src, int16_t *dst, size_t count, size_t stride, int32_t gain)
+{
+    // split gain into shift and 9-bit mantissa: y = ((x >> shift) * mult) >> 8, mult in [256, 512),
+    // so the shift keeps every bit that reaches int16 and the product fits in int32
+    int32_t shift = 16;
+    int32_t mult = gain;
+    while (mult >= 2 * AGC_GAIN_UNITY)
+    {
+        mult >>= 1;
+        shift--;
+    }
+    while (mult < AGC_GAIN_UNITY)
+    {
+        mult <<= 1;
+        shift++;
+    }
+
+    uint32_t clipped = 0;
+    while (count--)
+    {
+        int32_t y = ((*src >> shift) * mult) >> 8;
+        int32_t hi = (y - 32768) >> 31; // 0 if y > 32767
+        int32_t lo = (y + 32768) >> 31; // -1 if y < -32768
+        y = (y & hi) | (0x7FFF & ~hi);
+        y = (y & ~lo) | (-0x8000 & lo);
+        clipped += (~hi | lo) & 1;
+
+        *dst++ = (int16_t)y;
+        src += stride;
+    }
+    return clipped;
+}
+
+uint32_t Agc::convert(const int16_t *src, int16_t *dst, size_t count, int32_t gain)
+{
+    // gain <= AGC_GAIN_MAX: the product fits in int32
+    uint32_t clipped = 0;
+    while (count--)
+    {
+        int32_t y = (*src++ * gain) >> 8;
+        int32_t hi = (y - 32768) >> 31; // 0 if y > 32767
+        int32_t lo = (y + 32768) >> 31; // -1 if y < -32768
+        y = (y & hi) | (0x7FFF & ~hi);
+        y = (y & ~lo) | (-0x8000 & lo);
+        clipped += (~hi | lo) & 1;
+
+        *dst++ = (int16_t)y;
+    }
+    return clipped;
+}
+
+void Agc::update(const int16_t *block, size_t count, uint32_t clipped)
+{
+    // block statistics
+    uint32_t peak = 0;
+    uint32_t energy = 0; // sum of y^2 / 512, cannot overflow for count <= 1024
+    for (size_t i = 0; i < count; i++)
+    {
+        int32_t y = block[i];
+        uint32_t mag = (y ^ (y >> 31)) - (y >> 31);
+        peak = (mag > peak) ? mag : peak;
+        energy += ((uint32_t)(y * y)) >> 9;
+    }
+    _peak = peak;
+    _rms = isqrt((energy / count) << 9);
+
+    // peak envelope with attack/release
+    if (peak > _envelope)
+    {
+        _envelope += (peak - _envelope) >> AGC_ATTACK_SHIFT;
+    }
+    else
+    {
+        _envelope -= (_envelope - peak) >> AGC_RELEASE_SHIFT;
+    }
+
+#ifdef AGC_ENABLE
+    int32_t gain = _gain.load(std::memory_order_relaxed);
+    int32_t step = 0;
+    if (clipped || (_envelope > AGC_HIGH_PEAK))
+    {
+        step = -(gain >> AGC_GAIN_DOWN_SHIFT);
+        _envelope -= _envelope >> AGC_GAIN_DOWN_SHIFT; // follow the new gain
+    }
+    else if ((_envelope < AGC_LOW_PEAK) && (_envelope > AGC_NOISE_FLOOR))
+    {
+        step = gain >> AGC_GAIN_UP_SHIFT;
+        _envelope += _envelope >> AGC_GAIN_UP_SHIFT;
+    }
+
+    gain += step;
+    gain = (gain < AGC_GAIN_MIN) ? AGC_GAIN_MIN : ((gain > AGC_GAIN_MAX) ? AGC_GAIN_MAX : gain);
+    _gain.store(gain, std::memory_order_relaxed);
+#endif
+}
@@ -0,0 +1,80 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+#define AGC_ENABLE // comment out to use a fixed AGC_GAIN_INIT
+
+// gain in Q8: 256 = x1 (MSB 16 bits of the 32-bit I2S word)
+#define AGC_GAIN_UNITY 256
+#define AGC_GAIN_INIT (16 * AGC_GAIN_UNITY) // same as former MIC_GAIN_X16
+#define AGC_GAIN_MIN (AGC_GAIN_UNITY / 4)
+#define AGC_GAIN_MAX (32 * AGC_GAIN_UNITY)
+
+#define AGC_TARGET_PEAK 8192 // -12 dBFS, leaves headroom for transients
+#define AGC_HIGH_PEAK (AGC_TARGET_PEAK * 3 / 2)
+#define AGC_LOW_PEAK (AGC_TARGET_PEAK * 2 / 3)
+
+// time constants in blocks (one DMA block = AUDIO_CAPTURE_FRAME_LEN samples = 32 ms)
+#define AGC_ATTACK_SHIFT 1     // peak envelope rise: ~64 ms
+#define AGC_RELEASE_SHIFT 5    // peak envelope decay: ~1 s
+#define AGC_GAIN_DOWN_SHIFT 3  // gain -12.5% per block above AGC_HIGH_PEAK
+#define AGC_GAIN_UP_SHIFT 6    // gain +1.6% per block below AGC_LOW_PEAK, ~4 dB/s
+#define AGC_NOISE_FLOOR 64     // do not raise gain on blocks quieter than this (silence)
+
+static_assert(AGC_GAIN_MAX <= (32 * AGC_GAIN_UNITY), "AGC_GAIN_MAX overflows the conversion kernel"); // (x >> 11) * 511
+static_assert(AGC_GAIN_MIN > 0, "AGC_GAIN_MIN must be positive");
+
+// Integer-only automatic gain control.
+// ThreadAudio::dma_i2s_in_handler applies gain() in convert(), ThreadAudio calls update() once per block.
+class Agc
+{
+public:
+    Agc();
+
+    // 32-bit I2S words (24-bit MSB aligned) -> int16 with saturation, no branch per sample.
+    // stride is number of words between samples of the same channel. Returns number of clipped samples.
+    static uint32_t convert(const int32_t *src, int16_t *dst, size_t count, size_t stride, int32_t gain);
+    // packed int16 samples (16 MSBs, I2S_PACKED_16) -> int16 with saturation
+    static uint32_t convert(const int16_t *src, int16_t *dst, size_t count, int32_t gain);
+
+    void update(const int16_t *block, size_t count, uint32_t clipped);
+
+    inline int32_t gain(void) const
+    {
+        return _gain.load(std::memory_order_relaxed);
+    }
+    inline uint32_t peak(void) const
+    {
+        return _peak;
+    }
+    inline uint32_t rms(void) const
+    {
+        return _rms;
+    }
+
+private:
+    std::atomic<int32_t> _gain; // written by ThreadAudio, read by DMA ISR
+    uint32_t _envelope;         // peak envelope of output
+    uint32_t _peak;             // last block peak
+    uint32_t _rms;              // last block RMS
+};
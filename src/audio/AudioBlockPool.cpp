@@ -0,0 +1,60 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "./AudioBlockPool.h"
+#include "../AppDef.h"
+
+///////////////////////////////////////////////////////////////////////////////
+ML_DATA AudioBlock AudioBlockPool::_blocks[AUDIO_POOL_BLOCKS];
+
+AudioBlockPool::AudioBlockPool() : _head(0),
+                                   _tail(0),
+                                   _sequence(0)
+{
+}
+
+AudioBlock *AudioBlockPool::produce(void)
+{
+    uint32_t head = _head.load(std::memory_order_relaxed);
+    if (head - _tail.load(std::memory_order_acquire) >= AUDIO_POOL_BLOCKS)
+    {
+        return nullptr;
+    }
+    return &_blocks[head & (AUDIO_POOL_BLOCKS - 1)];
+}
+
+void AudioBlockPool::commit(void)
+{
+    _head.store(_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+AudioBlock *AudioBlockPool::consume(void)
+{
+    uint32_t tail = _tail.load(std::memory_order_relaxed);
+    if (_head.load(std::memory_order_acquire) == tail)
+    {
+        return nullptr;
+    }
+    return &_blocks[tail & (AUDIO_POOL_BLOCKS - 1)];
+}
+
+void AudioBlockPool::release(void)
+{
+    _tail.store(_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
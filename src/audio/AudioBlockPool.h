@@ -0,0 +1,81 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+#include "./audio_const.h"
+#include "./i2s.h"
+
+#define AUDIO_POOL_BLOCKS 4 // power of 2; blocks the DMA handler may fill ahead of ThreadAudio
+
+static_assert((AUDIO_POOL_BLOCKS & (AUDIO_POOL_BLOCKS - 1)) == 0, "AUDIO_POOL_BLOCKS must be a power of 2");
+
+// one DMA block converted to int16, channel-planar
+typedef struct AudioBlock
+{
+    uint32_t sequence;  // DMA block number since capture start, gaps are blocks dropped by the handler
+    uint32_t timestamp; // time_us_32() at DMA completion
+    uint32_t clipped;   // samples saturated by the conversion
+    int16_t samples[NUM_CHANNELS][AUDIO_CAPTURE_FRAME_LEN];
+} AudioBlock;
+
+// Single-producer (DMA handler) single-consumer (ThreadAudio) pool of owned audio blocks.
+// A block is either owned by the handler (being filled) or by the thread (ready or being processed),
+// so samples are never overwritten while read. When the thread falls behind, the handler drops the
+// new block instead and the gap shows in the sequence numbers.
+class AudioBlockPool
+{
+public:
+    AudioBlockPool();
+
+    // DMA handler: returns the block to fill, or nullptr when every block is still held by the thread
+    AudioBlock *produce(void);
+    // DMA handler: hands the block filled after produce() to the thread
+    void commit(void);
+    // DMA handler: called once per DMA block whether it was committed or dropped
+    inline uint32_t next_sequence(void)
+    {
+        uint32_t sequence = _sequence.load(std::memory_order_relaxed);
+        _sequence.store(sequence + 1, std::memory_order_relaxed);
+        return sequence;
+    }
+    // DMA handler: blocks lost without a handler call of their own (coalesced interrupts) number on
+    inline void skip_sequence(uint32_t count)
+    {
+        _sequence.store(_sequence.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+    }
+
+    // ThreadAudio: oldest ready block or nullptr, must be released after use
+    AudioBlock *consume(void);
+    void release(void);
+    inline uint32_t pending(void) const
+    {
+        return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_relaxed);
+    }
+
+private:
+    static AudioBlock _blocks[AUDIO_POOL_BLOCKS];
+
+    std::atomic<uint32_t> _head; // written by the DMA handler only
+    std::atomic<uint32_t> _tail; // written by ThreadAudio only
+    std::atomic<uint32_t> _sequence;
+};
@@ -0,0 +1,111 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include <string.h>
+#include "./Beamformer.h"
+#include "./accel.h"
+
+#define SPEED_OF_SOUND (BEAM_SPEED_OF_SOUND_MM_S / 1000.0f) // m/s
+
+///////////////////////////////////////////////////////////////////////////////
+// 3rd order Lagrange interpolator in Q14 evaluated between taps 1 and 2: x(n - 1 - frac) from x(n) .. x(n - 3)
+const int16_t Beamformer::_taps[1 << BEAM_FRAC_BITS][BEAM_TAPS] = {
+    {0, 16384, 0, 0},           // 0/8
+    {-560, 15120, 2160, -336},  // 1/8
+    {-896, 13440, 4480, -640},  // 2/8
+    {-1040, 11440, 6864, -880}, // 3/8
+    {-1024, 9216, 9216, -1024}, // 4/8
+    {-880, 6864, 11440, -1040}, // 5/8
+    {-640, 4480, 13440, -896},  // 6/8
+    {-336, 2160, 15120, -560},  // 7/8
+};
+
+///////////////////////////////////////////////////////////////////////////////
+Beamformer::Beamformer() : _buffer(),
+                           _channelDelay(),
+                           _delay(0),
+                           _mode(ModeDelaySum)
+{
+    setDelay(delay_for_angle(BEAM_STEER_DEGREE));
+}
+
+void Beamformer::setMode(Mode mode)
+{
+    _mode = mode;
+}
+
+void Beamformer::setDelay(int32_t delay)
+{
+    const int32_t limit = BEAM_MAX_DELAY << BEAM_FRAC_BITS;
+    delay = (delay < -limit) ? -limit : ((delay > limit) ? limit : delay);
+    _delay = delay;
+
+    // delay the leading microphone; both channels get one extra sample so the interpolator never looks ahead
+    const int32_t one = 1 << BEAM_FRAC_BITS;
+    _channelDelay[0] = one + ((delay > 0) ? delay : 0);
+    _channelDelay[1] = one + ((delay < 0) ? -delay : 0);
+}
+
+int32_t Beamformer::delay_for_angle(float degree)
+{
+    float seconds = (BEAM_MIC_SPACING_MM / 1000.0f) * sinf(degree * (float)M_PI / 180.0f) / SPEED_OF_SOUND;
+    return (int32_t)lroundf(seconds * AUDIO_CAPTURE_RATE * (1 << BEAM_FRAC_BITS));
+}
+
+void Beamformer::process(const int16_t *left, const int16_t *right, int16_t *dst)
+{
+    memcpy(&_buffer[0][BEAM_HISTORY], left, AUDIO_CAPTURE_FRAME_LEN * sizeof(int16_t));
+    memcpy(&_buffer[1][BEAM_HISTORY], right, AUDIO_CAPTURE_FRAME_LEN * sizeof(int16_t));
+
+    switch (_mode)
+    {
+    case ModeLeft:
+        memcpy(dst, left, AUDIO_CAPTURE_FRAME_LEN * sizeof(int16_t));
+        break;
+    case ModeRight:
+        memcpy(dst, right, AUDIO_CAPTURE_FRAME_LEN * sizeof(int16_t));
+        break;
+    default:
+    {
+        const int32_t mask = (1 << BEAM_FRAC_BITS) - 1;
+        const int16_t *l = &_buffer[0][BEAM_HISTORY] - (_channelDelay[0] >> BEAM_FRAC_BITS) + 1;
+        const int16_t *r = &_buffer[1][BEAM_HISTORY] - (_channelDelay[1] >> BEAM_FRAC_BITS) + 1;
+        const int16_t *hl = _taps[_channelDelay[0] & mask];
+        const int16_t *hr = _taps[_channelDelay[1] & mask];
+
+        for (size_t n = 0; n < AUDIO_CAPTURE_FRAME_LEN; n++)
+        {
+            // Q14 taps: each channel sum stays below 2^30, the sum of both is the average in Q15
+            int32_t acc = hl[0] * l[0] + hl[1] * l[-1] + hl[2] * l[-2] + hl[3] * l[-3];
+            acc += hr[0] * r[0] + hr[1] * r[-1] + hr[2] * r[-2] + hr[3] * r[-3];
+            *dst++ = accel::sat_q15(acc);
+            l++;
+            r++;
+        }
+        break;
+    }
+    }
+
+    // keep the tail of this block for the next one
+    for (int ch = 0; ch < 2; ch++)
+    {
+        memcpy(_buffer[ch], &_buffer[ch][AUDIO_CAPTURE_FRAME_LEN], BEAM_HISTORY * sizeof(int16_t));
+    }
+}
@@ -0,0 +1,82 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+#include "./audio_const.h"
+
+// microphone pair: left INMP441 (L/R=GND) and right INMP441 (L/R=VDD) on the same DIN, WS and BCLK
+#define BEAM_MIC_SPACING_MM 50 // distance between the two microphone ports
+#define BEAM_STEER_DEGREE 0    // look direction: 0 = broadside, +90 = towards the left microphone, -90 = towards the right one
+
+#define BEAM_SPEED_OF_SOUND_MM_S 343000 // at 20 degC
+
+#define BEAM_FRAC_BITS 3 // delay resolution: 1/8 sample
+#define BEAM_TAPS 4      // 3rd order Lagrange fractional delay filter
+// samples, end-fire arrival delay rounded up: 3 for 50 mm at 16 kHz, 7 at 48 kHz
+#define BEAM_MAX_DELAY ((BEAM_MIC_SPACING_MM * AUDIO_CAPTURE_RATE + BEAM_SPEED_OF_SOUND_MM_S - 1) / BEAM_SPEED_OF_SOUND_MM_S)
+// samples kept from the previous block for each channel, even so that the block copies stay word aligned
+#define BEAM_HISTORY ((BEAM_MAX_DELAY + BEAM_TAPS) & ~1)
+
+static_assert(BEAM_MAX_DELAY * BEAM_SPEED_OF_SOUND_MM_S >= BEAM_MIC_SPACING_MM * AUDIO_CAPTURE_RATE,
+              "BEAM_MAX_DELAY does not cover the arrival delay between the microphones");
+static_assert(BEAM_HISTORY >= BEAM_MAX_DELAY + BEAM_TAPS - 1, "BEAM_HISTORY too short for BEAM_MAX_DELAY");
+
+// Fixed-point delay-and-sum beamformer / channel selector for two microphones, run by ThreadAudio ahead of PreProcessor.
+// process() takes the two channels of an AudioBlock and produces the mono block.
+class Beamformer
+{
+public:
+    enum Mode : uint8_t
+    {
+        ModeLeft,     // left microphone only
+        ModeRight,    // right microphone only
+        ModeDelaySum, // (left + right) / 2 after aligning the look direction
+    };
+
+    Beamformer();
+
+    void setMode(Mode mode);
+    inline Mode mode(void) const
+    {
+        return _mode;
+    }
+
+    // arrival delay of the right microphone relative to the left one in 1/(2^BEAM_FRAC_BITS) sample,
+    // positive when the source is on the left side. Clamped to +/- BEAM_MAX_DELAY samples.
+    void setDelay(int32_t delay);
+    inline int32_t delay(void) const
+    {
+        return _delay;
+    }
+    static int32_t delay_for_angle(float degree);
+
+    // AUDIO_CAPTURE_FRAME_LEN samples of each channel to dst, output lags the input by one sample in ModeDelaySum
+    void process(const int16_t *left, const int16_t *right, int16_t *dst);
+
+private:
+    static const int16_t _taps[1 << BEAM_FRAC_BITS][BEAM_TAPS];
+
+    int16_t _buffer[2][BEAM_HISTORY + AUDIO_CAPTURE_FRAME_LEN]; // history followed by the current block
+    int32_t _channelDelay[2]; // delay applied to each channel, 1/(2^BEAM_FRAC_BITS) sample, >= 1 sample
+    int32_t _delay;
+    Mode _mode;
+};
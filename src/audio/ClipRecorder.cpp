@@ -0,0 +1,129 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "./ClipRecorder.h"
+#include "./codec.h"
+#include "../AppDef.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////
+ClipRecorder *ClipRecorder::_instance = nullptr;
+ML_DATA uint8_t ClipRecorder::_ring[CLIP_RING_SIZE];
+
+ClipRecorder *ClipRecorder::getInstance(void)
+{
+    if (!_instance)
+    {
+        static ClipRecorder instance;
+        _instance = &instance;
+    }
+    return _instance;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+ClipRecorder::ClipRecorder() : _state(Recording),
+                               _triggerRequest(false),
+                               _releaseRequest(false),
+                               _writePos(0),
+                               _written(0),
+                               _clipEnd(0)
+{
+}
+
+bool ClipRecorder::write(const int16_t *src, size_t count)
+{
+    auto state = _state.load(std::memory_order_relaxed);
+    if (state == Ready)
+    {
+        if (!_releaseRequest.load(std::memory_order_acquire))
+        {
+            return false; // clip is being uploaded, keep it intact
+        }
+        _releaseRequest.store(false, std::memory_order_relaxed);
+        _triggerRequest.store(false, std::memory_order_relaxed); // drop alarms raised during upload
+        _written = 0;
+        state = Recording;
+    }
+
+    if ((state == Recording) && _triggerRequest.load(std::memory_order_acquire))
+    {
+        _triggerRequest.store(false, std::memory_order_relaxed);
+        _clipEnd = _written + CLIP_POST_ROLL_SAMPLES;
+        state = PostRoll;
+    }
+
+    // encode straight into the ring, split at the wrap point
+    size_t first = CLIP_RING_SIZE - _writePos;
+    if (first > count)
+    {
+        first = count;
+    }
+    audiocodec::mulaw_encode_block(src, &_ring[_writePos], first);
+    audiocodec::mulaw_encode_block(src + first, &_ring[0], count - first);
+    _writePos += count;
+    if (_writePos >= CLIP_RING_SIZE)
+    {
+        _writePos -= CLIP_RING_SIZE;
+    }
+    _written += count;
+
+    bool ready = (state == PostRoll) && ((int32_t)(_written - _clipEnd) >= 0);
+    _state.store(ready ? Ready : state, std::memory_order_release);
+    return ready;
+}
+
+void ClipRecorder::trigger(void)
+{
+    _triggerRequest.store(true, std::memory_order_release);
+}
+
+size_t ClipRecorder::clip_bytes(void) const
+{
+    // post-roll ends on a frame boundary, so the clip may exceed CLIP_SAMPLES by less than a frame.
+    // pre-roll is shorter if the alarm fired soon after boot or after the last upload
+    size_t size = CLIP_SAMPLES + (_written - _clipEnd);
+    return (_written < size) ? _written : size;
+}
+
+int ClipRecorder::clip_segments(const uint8_t *ptr[2], size_t len[2]) const
+{
+    if (state() != Ready)
+    {
+        return 0;
+    }
+
+    size_t size = clip_bytes();
+    size_t start = (_writePos >= size) ? (_writePos - size) : (_writePos + CLIP_RING_SIZE - size);
+    if (start + size <= CLIP_RING_SIZE)
+    {
+        ptr[0] = &_ring[start];
+        len[0] = size;
+        return 1;
+    }
+
+    ptr[0] = &_ring[start];
+    len[0] = CLIP_RING_SIZE - start;
+    ptr[1] = &_ring[0];
+    len[1] = size - len[0];
+    return 2;
+}
+
+void ClipRecorder::release(void)
+{
+    _releaseRequest.store(true, std::memory_order_release);
+}
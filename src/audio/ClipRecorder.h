@@ -0,0 +1,82 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+#include "./audio_const.h"
+
+#define CLIP_RECORDER_ENABLE // comment out to disable pre-trigger clip recording
+
+#define CLIP_PRE_ROLL_MS 3000  // audio kept before the alarm
+#define CLIP_POST_ROLL_MS 1000 // audio recorded after the alarm
+
+#define CLIP_PRE_ROLL_SAMPLES (AUDIO_SAMPLING_RATE / 1000 * CLIP_PRE_ROLL_MS)
+#define CLIP_POST_ROLL_SAMPLES (AUDIO_SAMPLING_RATE / 1000 * CLIP_POST_ROLL_MS)
+#define CLIP_SAMPLES (CLIP_PRE_ROLL_SAMPLES + CLIP_POST_ROLL_SAMPLES)
+
+// mu-law, one byte per sample. One spare frame because post-roll ends on a frame boundary.
+#define CLIP_RING_SIZE (CLIP_SAMPLES + AUDIO_FRAME_LEN)
+
+// Circular history of compressed audio fed by ThreadAudio.
+// Only the audio thread changes the state; ThreadApp and ThreadNet post requests via flags,
+// so no lock is needed between the threads.
+class ClipRecorder
+{
+public:
+    enum State : uint8_t
+    {
+        Recording, // continuously overwriting the history
+        PostRoll,  // alarm triggered, recording post-roll
+        Ready,     // clip frozen, waiting for ThreadNet to upload and release it
+    };
+
+    ClipRecorder();
+
+    static ClipRecorder *getInstance(void);
+
+    // called by ThreadAudio, returns true once when a clip becomes ready
+    bool write(const int16_t *src, size_t count);
+
+    // called by ThreadApp
+    void trigger(void);
+
+    // called by ThreadNet while the clip is ready
+    inline State state(void) const
+    {
+        return _state.load(std::memory_order_acquire);
+    }
+    size_t clip_bytes(void) const;
+    int clip_segments(const uint8_t *ptr[2], size_t len[2]) const;
+    void release(void);
+
+private:
+    static ClipRecorder *_instance;
+    static uint8_t _ring[CLIP_RING_SIZE];
+
+    std::atomic<State> _state;
+    std::atomic<bool> _triggerRequest;
+    std::atomic<bool> _releaseRequest;
+
+    size_t _writePos;   // next byte to be written in _ring
+    uint32_t _written;  // total samples written since boot (or since last release)
+    uint32_t _clipEnd;  // value of _written at which post-roll completes
+};
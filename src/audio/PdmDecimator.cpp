@@ -0,0 +1,154 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <string.h>
+#include "./PdmDecimator.h"
+#include "./pdm_filters.h"
+#include "./accel.h"
+
+#if defined ARDUINO_ARCH_MBED_RP2040
+#include "pico/platform.h"
+#define PDM_FUNC(name) __not_in_flash_func(name) // called from the DMA handler, run from SRAM
+#else
+#define PDM_FUNC(name) name
+#endif
+
+#define CIC_ORDER 4
+#define HISTORY (PDM_MAX_TAPS - 1)
+
+static_assert(CIC_ORDER * (PDM_CIC_DECIMATION - 1) + 1 <= 8 * PDM_CIC_BYTES, "CIC impulse response exceeds the byte tables");
+static_assert((PDM_HALFBAND_TAPS <= PDM_MAX_TAPS) && (PDM_COMP_TAPS <= PDM_MAX_TAPS), "PDM_MAX_TAPS too small for pdm_filters.h");
+static_assert((PDM_HALFBAND_TAPS & 1) && (PDM_COMP_TAPS & 1), "symmetric odd-length FIRs expected");
+
+///////////////////////////////////////////////////////////////////////////////
+int16_t PdmDecimator::_cic[PDM_CIC_BYTES][256];
+
+PdmDecimator::PdmDecimator() : _window{0, 0, 0}
+{
+}
+
+void PdmDecimator::init(void)
+{
+    // impulse response of CIC_ORDER cascaded moving sums of PDM_CIC_DECIMATION (sum 16^4 = 65536), padded
+    // at the start so the newest bit of the window has the last tap
+    int32_t h[8 * PDM_CIC_BYTES] = {0};
+    h[8 * PDM_CIC_BYTES - CIC_ORDER * (PDM_CIC_DECIMATION - 1) - 1] = 1;
+    for (int stage = 0; stage < CIC_ORDER; stage++)
+    {
+        for (int n = 8 * PDM_CIC_BYTES - 1; n >= 0; n--)
+        {
+            int32_t sum = 0;
+            for (int k = 0; (k < PDM_CIC_DECIMATION) && (k <= n); k++)
+            {
+                sum += h[n - k];
+            }
+            h[n] = sum;
+        }
+    }
+
+    // table g maps byte g of the window (bits 8g .. 8g + 7, earliest in the MSB) to sum(h * (2 * bit - 1))
+    for (int g = 0; g < PDM_CIC_BYTES; g++)
+    {
+        for (int v = 0; v < 256; v++)
+        {
+            int32_t sum = 0;
+            for (int i = 0; i < 8; i++)
+            {
+                sum += ((v >> (7 - i)) & 1) ? h[8 * g + i] : -h[8 * g + i];
+            }
+            _cic[g][v] = (int16_t)sum;
+        }
+    }
+
+    _window[0] = _window[1] = _window[2] = 0x5555; // idle PDM: density 1/2
+    memset(_stage1, 0, sizeof(_stage1));
+    memset(_stage2, 0, sizeof(_stage2));
+}
+
+// CIC output for the 64-bit window h0..h3 (16 bits each, oldest first), scaled to int16
+static inline int16_t cic(const int16_t (*t)[256], uint32_t h0, uint32_t h1, uint32_t h2, uint32_t h3)
+{
+    int32_t s = t[0][h0 >> 8] + t[1][h0 & 0xFF] + t[2][h1 >> 8] + t[3][h1 & 0xFF] +
+                t[4][h2 >> 8] + t[5][h2 & 0xFF] + t[6][h3 >> 8] + t[7][h3 & 0xFF];
+    // s is even in [-65536, 65536]: s / 2, with all ones (65536) mapped to 32767
+    return (int16_t)((s - (s >> 16)) >> 1);
+}
+
+// Decimate by 2 with symmetric odd-length FIRs. x points to the oldest sample of the first window,
+// the windows of consecutive outputs start two samples apart.
+static void PDM_FUNC(halfband)(const int16_t *x, int16_t *dst, size_t count)
+{
+    const int mid = PDM_HALFBAND_TAPS / 2;
+    for (size_t m = 0; m < count; m++, x += 2)
+    {
+        int32_t acc = pdm_halfband[mid] * x[mid];
+        for (int j = (mid + 1) & 1; j < mid; j += 2) // every other tap is zero
+        {
+            acc += pdm_halfband[j] * (x[j] + x[PDM_HALFBAND_TAPS - 1 - j]);
+        }
+        *dst++ = accel::sat_q15_soft(acc);
+    }
+}
+
+static void PDM_FUNC(compensation)(const int16_t *x, int16_t *dst, size_t count)
+{
+    const int mid = PDM_COMP_TAPS / 2;
+    for (size_t m = 0; m < count; m++, x += 2)
+    {
+        int32_t acc = pdm_compensation[mid] * x[mid];
+        for (int j = 0; j < mid; j++)
+        {
+            acc += pdm_compensation[j] * (x[j] + x[PDM_COMP_TAPS - 1 - j]);
+        }
+        *dst++ = accel::sat_q15_soft(acc);
+    }
+}
+
+size_t PDM_FUNC(PdmDecimator::process)(const uint32_t *src, size_t words, int16_t *dst)
+{
+    // CIC: two outputs per 32-bit word, the window advances by 16 bits
+    const int16_t(*t)[256] = _cic;
+    uint32_t h0 = _window[0], h1 = _window[1], h2 = _window[2];
+    int16_t *y = &_stage1[HISTORY];
+    for (size_t i = 0; i < words; i++)
+    {
+        uint32_t w = src[i];
+        uint32_t h3 = w >> 16;
+        *y++ = cic(t, h0, h1, h2, h3);
+        h0 = h1;
+        h1 = h2;
+        h2 = h3;
+        h3 = w & 0xFFFF;
+        *y++ = cic(t, h0, h1, h2, h3);
+        h0 = h1;
+        h1 = h2;
+        h2 = h3;
+    }
+    _window[0] = h0;
+    _window[1] = h1;
+    _window[2] = h2;
+
+    // each output window ends on the second sample of a pair
+    halfband(&_stage1[HISTORY + 2 - PDM_HALFBAND_TAPS], &_stage2[HISTORY], words);
+    compensation(&_stage2[HISTORY + 2 - PDM_COMP_TAPS], dst, words / 2);
+
+    memmove(_stage1, &_stage1[2 * words], HISTORY * sizeof(_stage1[0]));
+    memmove(_stage2, &_stage2[words], HISTORY * sizeof(_stage2[0]));
+    return words / 2;
+}
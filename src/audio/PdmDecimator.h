@@ -0,0 +1,53 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+#include "./audio_const.h"
+
+#define PDM_DECIMATION 64    // PDM clock = AUDIO_CAPTURE_RATE * 64 (1.024 MHz for 16 kHz)
+#define PDM_CIC_DECIMATION 16 // CIC order 4, then two FIR stages decimating by 2
+#define PDM_CIC_BYTES 8      // CIC impulse response (4 * 15 + 1 taps) padded to 64 bits
+#define PDM_MAX_WORDS 128    // 32-bit PDM words per process() call
+#define PDM_MAX_TAPS 63      // longest FIR in pdm_filters.h (tools/pdm_design.py)
+
+// PDM bitstream to int16 PCM at PDM clock / 64, fixed point:
+//   CIC order 4, / 16: one table lookup per byte of the bitstream (same output as integrator and comb stages)
+//   half-band FIR / 2 (pdm_halfband)
+//   FIR / 2 with CIC droop compensation (pdm_compensation)
+// Input words hold 32 PDM bits, earliest in the MSB (PIO shifting left). A density of all ones is 32767.
+class PdmDecimator
+{
+public:
+    PdmDecimator();
+
+    void init(void); // builds the CIC tables and clears the filter history
+
+    // consumes words (even, <= PDM_MAX_WORDS) PDM words, returns number of samples written to dst (words / 2)
+    size_t process(const uint32_t *src, size_t words, int16_t *dst);
+
+private:
+    static int16_t _cic[PDM_CIC_BYTES][256]; // bipolar CIC taps of each byte of the 64-bit window
+
+    uint32_t _window[3];                                   // last three 16-bit groups of bits, oldest first
+    int16_t _stage1[PDM_MAX_TAPS - 1 + 2 * PDM_MAX_WORDS]; // CIC output (history followed by the current call)
+    int16_t _stage2[PDM_MAX_TAPS - 1 + PDM_MAX_WORDS];     // half-band output
+};
@@ -0,0 +1,95 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <string.h>
+#include "./Resampler.h"
+#include "./accel.h"
+
+///////////////////////////////////////////////////////////////////////////////
+Resampler::Resampler() : _bank(nullptr),
+                         _buffer(),
+                         _phase(0),
+                         _index(0),
+                         _stepInt(0),
+                         _stepFrac(0)
+{
+}
+
+const resampler_bank_t *Resampler::find(uint32_t in_rate, uint32_t out_rate)
+{
+    for (size_t i = 0; i < resampler_bank_count; i++)
+    {
+        if ((resampler_banks[i].in_rate == in_rate) && (resampler_banks[i].out_rate == out_rate))
+        {
+            return &resampler_banks[i];
+        }
+    }
+    return nullptr;
+}
+
+bool Resampler::init(const resampler_bank_t *bank)
+{
+    if (!bank || (bank->taps > RESAMPLER_MAX_TAPS))
+    {
+        return false;
+    }
+    _bank = bank;
+    memset(_buffer, 0, sizeof(_buffer));
+    _phase = 0;
+    _index = 0;
+    _stepInt = bank->down / bank->up;
+    _stepFrac = bank->down % bank->up;
+    return true;
+}
+
+size_t Resampler::process(const int16_t *src, size_t count, int16_t *dst)
+{
+    const size_t taps = _bank->taps;
+    const size_t history = taps - 1;
+    const uint32_t up = _bank->up;
+
+    memcpy(&_buffer[history], src, count * sizeof(int16_t));
+    const int16_t *x = &_buffer[history]; // x[-history] .. x[-1] are the end of the previous block
+
+    size_t written = 0;
+    while (_index < count)
+    {
+        const int16_t *h = &_bank->coeffs[_phase * taps];
+        const int16_t *xp = &x[_index];
+        int32_t acc = 0;
+        for (size_t j = 0; j < taps; j++)
+        {
+            acc += h[j] * xp[-(int32_t)j];
+        }
+        dst[written++] = accel::sat_q15(acc);
+
+        // next output is down / up input samples later
+        _index += _stepInt;
+        _phase += _stepFrac;
+        if (_phase >= up)
+        {
+            _phase -= up;
+            _index++;
+        }
+    }
+    _index -= count;
+
+    memmove(_buffer, &_buffer[count], history * sizeof(int16_t));
+    return written;
+}
@@ -0,0 +1,70 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+#include "./audio_const.h"
+
+#define RESAMPLER_MAX_TAPS 96 // taps per phase of the largest bank in resampler_banks.cpp
+
+// Polyphase coefficient bank converting in_rate to out_rate = in_rate * up / down.
+// coeffs[p * taps + j] (Q15) multiplies input x[n - j] for phase p. Generated by tools/resampler_design.py.
+typedef struct resampler_bank_t
+{
+    uint32_t in_rate;
+    uint32_t out_rate;
+    uint16_t up;
+    uint16_t down;
+    uint16_t taps;
+    const int16_t *coeffs;
+} resampler_bank_t;
+
+extern const resampler_bank_t resampler_banks[];
+extern const size_t resampler_bank_count;
+
+// Streaming rational resampler between capture and PreProcessor.
+// Every output sample costs exactly bank->taps multiply-accumulates, and one call produces
+// at most max_output(count) samples, so the cost per block is bounded.
+class Resampler
+{
+public:
+    Resampler();
+
+    static const resampler_bank_t *find(uint32_t in_rate, uint32_t out_rate);
+
+    bool init(const resampler_bank_t *bank);
+
+    // consumes count (<= AUDIO_CAPTURE_FRAME_LEN) input samples, returns number of samples written to dst
+    size_t process(const int16_t *src, size_t count, int16_t *dst);
+
+    inline size_t max_output(size_t count) const
+    {
+        return (count * _bank->up + _bank->down - 1) / _bank->down;
+    }
+
+private:
+    const resampler_bank_t *_bank;
+    int16_t _buffer[RESAMPLER_MAX_TAPS - 1 + AUDIO_CAPTURE_FRAME_LEN]; // history followed by the current block
+    uint32_t _phase;    // phase of the next output, 0 .. up - 1
+    uint32_t _index;    // newest input sample of the next output, relative to the current block
+    uint32_t _stepInt;  // down / up
+    uint32_t _stepFrac; // down % up
+};
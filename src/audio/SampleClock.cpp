@@ -0,0 +1,95 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "./SampleClock.h"
+
+#define NOMINAL_PERIOD ((1000000ull << SAMPLE_CLOCK_Q) / AUDIO_CAPTURE_RATE)
+
+///////////////////////////////////////////////////////////////////////////////
+SampleClock::SampleClock() : _started(false),
+                             _anchored(false),
+                             _anchorSample(0),
+                             _anchorUs(0),
+                             _bestSample(0),
+                             _bestUs(0),
+                             _bestResidual(INT64_MAX),
+                             _windowEnd(0),
+                             _lastUs(0),
+                             _period(NOMINAL_PERIOD)
+{
+}
+
+bool SampleClock::update(uint32_t sequence, uint32_t timestamp)
+{
+    uint64_t count = samples(sequence);
+    if (!_started)
+    {
+        _started = true;
+        _lastUs = timestamp;
+        _anchorSample = count;
+        _anchorUs = _lastUs;
+        _windowEnd = count + SAMPLE_CLOCK_WINDOW;
+        return false;
+    }
+
+    // time_us_32() wraps every 71 minutes, blocks arrive every few ms
+    _lastUs += (uint32_t)(timestamp - (uint32_t)_lastUs);
+
+    // the interrupt is never early: the smallest residual is the block closest to its true completion
+    int64_t residual = (int64_t)(_lastUs - micros(count));
+    if (residual < _bestResidual)
+    {
+        _bestResidual = residual;
+        _bestSample = count;
+        _bestUs = _lastUs;
+    }
+    if (count < _windowEnd)
+    {
+        return false;
+    }
+
+    // the first anchor is a block of unknown latency, and a best block early in the window leaves a short
+    // baseline: keep the period, move the anchor only
+    bool measured = false;
+    uint64_t span = _bestSample - _anchorSample;
+    if (_anchored && (span >= SAMPLE_CLOCK_WINDOW / 4))
+    {
+        _period = ((_bestUs - _anchorUs) << SAMPLE_CLOCK_Q) / span;
+        measured = true;
+    }
+    _anchored = true;
+    _anchorSample = _bestSample;
+    _anchorUs = _bestUs;
+    _bestResidual = INT64_MAX;
+    _windowEnd = count + SAMPLE_CLOCK_WINDOW;
+    return measured;
+}
+
+uint64_t SampleClock::micros(uint64_t count) const
+{
+    // signed: a frame may end before the anchor block (resampler leftover)
+    int64_t delta = (int64_t)(count - _anchorSample);
+    return _anchorUs + delta * (int64_t)_period / (1 << SAMPLE_CLOCK_Q);
+}
+
+int32_t SampleClock::errorPpm(void) const
+{
+    // a longer period is a slower clock
+    return (int32_t)(((int64_t)NOMINAL_PERIOD - (int64_t)_period) * 1000000 / (int64_t)NOMINAL_PERIOD);
+}
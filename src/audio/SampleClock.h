@@ -0,0 +1,85 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+#include "./audio_const.h"
+
+#define SAMPLE_CLOCK_WINDOW (1u << 22) // samples per rate measurement, 262 s at 16 kHz
+#define SAMPLE_CLOCK_Q 24              // fraction bits of the sample period
+
+// Monotonic capture clock: the number of samples captured since capture start, counted from the DMA
+// block sequence (AUDIO_CAPTURE_FRAME_LEN samples per block, blocks dropped by the handler included),
+// and its mapping to local time in microseconds, whose low 32 bits are time_us_32().
+// The completion time of a single block jitters with the DMA interrupt latency (up to a block while a flash
+// erase holds interrupts off), so the mapping does not use it directly: every SAMPLE_CLOCK_WINDOW samples the
+// block completing earliest against the current fit becomes the new anchor, and the sample period is
+// measured between two anchors. This places a sample within a few microseconds and tracks the PIO clock
+// divider error (BL_PIO_DIV) and clock profile switches.
+// Written and read by ThreadAudio only.
+class SampleClock
+{
+public:
+    SampleClock();
+
+    // every block taken from the pool, in sequence order: AudioBlock::sequence and AudioBlock::timestamp
+    // returns true when the sample period was measured again
+    bool update(uint32_t sequence, uint32_t timestamp);
+
+    // DMA blocks completed besides the one being served, elapsed microseconds after the previous DMA interrupt.
+    // Interrupts held off for longer than a block (a flash sector erase takes about 45 ms) coalesce, and the
+    // DMA ring overwrites the blocks completed meanwhile: the handler numbers them so the sequence keeps
+    // counting samples. The block served completed less than a period before the interrupt (a later one
+    // would be served instead), so elapsed is off by less than a block either way; the two DMA buffers
+    // alternate, and sameBuffer (served from the buffer of the previous interrupt) settles the parity.
+    static inline uint32_t missedBlocks(uint32_t elapsed, uint32_t period, bool sameBuffer)
+    {
+        uint32_t blocks = sameBuffer ? 2 : 1;
+        for (; elapsed >= (blocks + 1) * period; blocks += 2)
+        {
+        }
+        return blocks - 1;
+    }
+
+    // samples captured when the block completed
+    static inline uint64_t samples(uint32_t sequence)
+    {
+        return ((uint64_t)sequence + 1) * AUDIO_CAPTURE_FRAME_LEN;
+    }
+
+    // local time in microseconds at which count samples had been captured
+    uint64_t micros(uint64_t count) const;
+
+    // measured sample rate against AUDIO_CAPTURE_RATE
+    int32_t errorPpm(void) const;
+
+private:
+    bool _started;
+    bool _anchored; // the anchor is the best block of a window
+    uint64_t _anchorSample;
+    uint64_t _anchorUs;
+    uint64_t _bestSample; // earliest block of the current window
+    uint64_t _bestUs;
+    int64_t _bestResidual;
+    uint64_t _windowEnd;
+    uint64_t _lastUs; // timestamp of the last block extended to 64 bits
+    uint64_t _period; // microseconds per sample, Q(SAMPLE_CLOCK_Q)
+};
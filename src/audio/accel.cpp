@@ -0,0 +1,58 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "./accel.h"
+
+namespace accel
+{
+    void begin(void)
+    {
+#ifdef ACCEL_RP2040
+        // lane 0: accum >> 15 sign-extended from bit 16 (= accum bit 31), clamped to [BASE0, BASE1]
+        interp_config cfg = interp_default_config();
+        interp_config_set_shift(&cfg, 15);
+        interp_config_set_mask(&cfg, 0, 16);
+        interp_config_set_signed(&cfg, true);
+        interp_config_set_clamp(&cfg, true);
+        interp_set_config(interp1, 0, &cfg);
+        interp1->base[0] = (uint32_t)-32768;
+        interp1->base[1] = 32767;
+#endif
+    }
+
+    void window_q15(const int16_t *window, const int16_t *src, int16_t *dst, size_t count)
+    {
+        // two samples per iteration; M0+ has a single-cycle 32x32 multiplier
+        for (; count >= 2; count -= 2)
+        {
+            int32_t y0 = (window[0] * src[0]) >> 15;
+            int32_t y1 = (window[1] * src[1]) >> 15;
+            dst[0] = (int16_t)y0;
+            dst[1] = (int16_t)y1;
+            window += 2;
+            src += 2;
+            dst += 2;
+        }
+        if (count)
+        {
+            *dst = (int16_t)((*window * *src) >> 15);
+        }
+    }
+
+} // namespace accel
@@ -0,0 +1,61 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+#if defined ARDUINO_ARCH_MBED_RP2040
+#include "hardware/interp.h"
+#define ACCEL_RP2040 // SIO interpolator kernels, portable C otherwise (host tools)
+#endif
+
+// RP2040 accelerator kernels for the DSP path, with a portable implementation behind the same API.
+// The SIO interpolators are per core and not saved on context switch or interrupt entry, so interp1 belongs to
+// ThreadAudio: no other thread uses it, and DMA handlers use the *_soft kernels. Call begin() once from that thread.
+// There is no divider kernel: ThreadAudio preempts the other threads, and the SDK division routines only save the
+// SIO divider state in the code doing the interrupting, so a raw divider access here would corrupt a division
+// in progress in ThreadNet or ThreadApp. Plain "/" goes through those routines and is safe.
+namespace accel
+{
+    void begin(void);
+
+    // sat_q15 without the interpolator, for code running in DMA handlers
+    static inline int16_t sat_q15_soft(int32_t acc)
+    {
+        int32_t y = (acc + (1 << 14)) >> 15;
+        return (int16_t)((y > 32767) ? 32767 : ((y < -32768) ? -32768 : y));
+    }
+
+    // (acc + 2^14) >> 15 saturated to int16: output stage of the Q15 filters (interp1 clamp mode)
+    static inline int16_t sat_q15(int32_t acc)
+    {
+#ifdef ACCEL_RP2040
+        interp1->accum[0] = (uint32_t)(acc + (1 << 14));
+        return (int16_t)interp1->peek[0];
+#else
+        return sat_q15_soft(acc);
+#endif
+    }
+
+    // dst = (window * src) >> 15 for a non-negative Q15 window, same result as arm_mult_q15()
+    // (the product cannot saturate), without its per-sample software saturation on Cortex-M0+
+    void window_q15(const int16_t *window, const int16_t *src, int16_t *dst, size_t count);
+
+} // namespace accel
@@ -21,6 +21,10 @@
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 #define AUDIO_SAMPLING_RATE 16000 // sampling frequency = 16kHz
+#define AUDIO_CAPTURE_RATE AUDIO_SAMPLING_RATE // I2S rate, converted to AUDIO_SAMPLING_RATE by Resampler when different
+// #define AUDIO_CAPTURE_RATE 48000 // needs a bank in src/audio/resampler_banks.cpp (tools/resampler_design.py)
+// #define AUDIO_INPUT_PDM // PDM microphone (src/audio/pdm.h) at AUDIO_CAPTURE_RATE * 64 instead of I2S, mono only
+#define AUDIO_PIO_CYCLES_PER_SAMPLE 256 // I2S: 64 BCLK x 4 PIO cycles, PDM: 64 clocks x 4 PIO cycles (ClockScaler plan)
 #define AUDIO_CHANNEL_MONO 1
 #define AUDIO_CHANNEL_STEREO 2
 
@@ -29,6 +33,11 @@
 #define AUDIO_FRAME_STEP 128 // stride
 #define AUDIO_INPUT_SHIFT 0  // number of bits shift on audio_buffer for arm_shift_q15
 
+// samples per DMA block at a capture rate, rounded up to even so that mono blocks fill whole 32-bit DMA words
+// (I2S_PACKED_16): 706 at 22.05 kHz, 1412 at 44.1 kHz
+#define AUDIO_CAPTURE_FRAME_LEN_AT(rate) ((AUDIO_FRAME_LEN * (rate) / AUDIO_SAMPLING_RATE + 1) & ~1)
+#define AUDIO_CAPTURE_FRAME_LEN AUDIO_CAPTURE_FRAME_LEN_AT(AUDIO_CAPTURE_RATE)
+
 ////////////////////////////////////////////////////////////////////////////////////////////
 #define AUDIO_FFT_LEN 256
 
@@ -0,0 +1,258 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "codec.h"
+
+#define MULAW_BIAS 0x84  // 132, added so that the segment boundaries are powers of 2
+#define MULAW_CLIP 32635 // (32767 - MULAW_BIAS)
+
+#define ADPCM_INDEX_MAX 88
+
+namespace audiocodec
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // G.711 mu-law
+    ///////////////////////////////////////////////////////////////////////////////
+
+    // segment (exponent) of biased magnitude, indexed by bits [14:7].
+    // Cortex-M0+ has no CLZ instruction, so a 256-byte table replaces the search loop.
+    static const uint8_t mulaw_exp_lut[256] = {
+        0, 0, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+        5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+        6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+        6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+        6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+        6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+        7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+        7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+        7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+        7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+        7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+        7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+        7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+        7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+    };
+
+    static const int16_t mulaw_decode_lut[256] = {
+        -32124, -31100, -30076, -29052, -28028, -27004, -25980, -24956,
+        -23932, -22908, -21884, -20860, -19836, -18812, -17788, -16764,
+        -15996, -15484, -14972, -14460, -13948, -13436, -12924, -12412,
+        -11900, -11388, -10876, -10364, -9852, -9340, -8828, -8316,
+        -7932, -7676, -7420, -7164, -6908, -6652, -6396, -6140,
+        -5884, -5628, -5372, -5116, -4860, -4604, -4348, -4092,
+        -3900, -3772, -3644, -3516, -3388, -3260, -3132, -3004,
+        -2876, -2748, -2620, -2492, -2364, -2236, -2108, -1980,
+        -1884, -1820, -1756, -1692, -1628, -1564, -1500, -1436,
+        -1372, -1308, -1244, -1180, -1116, -1052, -988, -924,
+        -876, -844, -812, -780, -748, -716, -684, -652,
+        -620, -588, -556, -524, -492, -460, -428, -396,
+        -372, -356, -340, -324, -308, -292, -276, -260,
+        -244, -228, -212, -196, -180, -164, -148, -132,
+        -120, -112, -104, -96, -88, -80, -72, -64,
+        -56, -48, -40, -32, -24, -16, -8, 0,
+        32124, 31100, 30076, 29052, 28028, 27004, 25980, 24956,
+        23932, 22908, 21884, 20860, 19836, 18812, 17788, 16764,
+        15996, 15484, 14972, 14460, 13948, 13436, 12924, 12412,
+        11900, 11388, 10876, 10364, 9852, 9340, 8828, 8316,
+        7932, 7676, 7420, 7164, 6908, 6652, 6396, 6140,
+        5884, 5628, 5372, 5116, 4860, 4604, 4348, 4092,
+        3900, 3772, 3644, 3516, 3388, 3260, 3132, 3004,
+        2876, 2748, 2620, 2492, 2364, 2236, 2108, 1980,
+        1884, 1820, 1756, 1692, 1628, 1564, 1500, 1436,
+        1372, 1308, 1244, 1180, 1116, 1052, 988, 924,
+        876, 844, 812, 780, 748, 716, 684, 652,
+        620, 588, 556, 524, 492, 460, 428, 396,
+        372, 356, 340, 324, 308, 292, 276, 260,
+        244, 228, 212, 196, 180, 164, 148, 132,
+        120, 112, 104, 96, 88, 80, 72, 64,
+        56, 48, 40, 32, 24, 16, 8, 0,
+    };
+
+    uint8_t mulaw_encode(int16_t sample)
+    {
+        int32_t s = sample;
+        int32_t smask = s >> 31; // -1 if negative
+        uint8_t sign = smask & 0x80;
+        s = (s ^ smask) - smask; // |s|
+        if (s > MULAW_CLIP)
+        {
+            s = MULAW_CLIP;
+        }
+        s += MULAW_BIAS;
+
+        uint8_t exponent = mulaw_exp_lut[(s >> 7) & 0xFF];
+        uint8_t mantissa = (s >> (exponent + 3)) & 0x0F;
+        return ~(sign | (exponent << 4) | mantissa);
+    }
+
+    int16_t mulaw_decode(uint8_t code)
+    {
+        return mulaw_decode_lut[code];
+    }
+
+    void mulaw_encode_block(const int16_t *src, uint8_t *dst, size_t count)
+    {
+        while (count--)
+        {
+            *dst++ = mulaw_encode(*src++);
+        }
+    }
+
+    void mulaw_decode_block(const uint8_t *src, int16_t *dst, size_t count)
+    {
+        while (count--)
+        {
+            *dst++ = mulaw_decode_lut[*src++];
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // IMA-ADPCM
+    ///////////////////////////////////////////////////////////////////////////////
+    static const int16_t adpcm_step_table[ADPCM_INDEX_MAX + 1] = {
+        7, 8, 9, 10, 11, 12, 13, 14, 16, 17,
+        19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+        50, 55, 60, 66, 73, 80, 88, 97, 107, 118,
+        130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+        337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+        876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+        2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358,
+        5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+        15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+    };
+
+    static const int8_t adpcm_index_table[16] = {
+        -1, -1, -1, -1, 2, 4, 6, 8,
+        -1, -1, -1, -1, 2, 4, 6, 8,
+    };
+
+    static inline int32_t clamp_predictor(int32_t predictor)
+    {
+        if ((uint32_t)(predictor + 32768) > 0xFFFF)
+        {
+            predictor = 0x7FFF ^ (predictor >> 31); // 32767 or -32768
+        }
+        return predictor;
+    }
+
+    static inline int32_t clamp_index(int32_t index)
+    {
+        if ((uint32_t)index > ADPCM_INDEX_MAX)
+        {
+            index = (index < 0) ? 0 : ADPCM_INDEX_MAX;
+        }
+        return index;
+    }
+
+    // Successive approximation of |diff| by step, step/2, step/4.
+    // Each bit uses a sign mask instead of a branch; vpdiff is the value the decoder will reconstruct.
+    static inline uint8_t adpcm_encode_sample(int32_t sample, int32_t *predictor, int32_t *index)
+    {
+        int32_t step = adpcm_step_table[*index];
+        int32_t diff = sample - *predictor;
+        int32_t smask = diff >> 31; // -1 if negative
+        diff = (diff ^ smask) - smask;
+
+        int32_t vpdiff = step >> 3;
+        int32_t m = ~((diff - step) >> 31); // -1 if diff >= step
+        uint8_t code = 4 & m;
+        diff -= step & m;
+        vpdiff += step & m;
+
+        step >>= 1;
+        m = ~((diff - step) >> 31);
+        code |= 2 & m;
+        diff -= step & m;
+        vpdiff += step & m;
+
+        step >>= 1;
+        m = ~((diff - step) >> 31);
+        code |= 1 & m;
+        vpdiff += step & m;
+
+        code |= smask & 8;
+        *predictor = clamp_predictor(*predictor + ((vpdiff ^ smask) - smask));
+        *index = clamp_index(*index + adpcm_index_table[code]);
+        return code;
+    }
+
+    static inline int32_t adpcm_decode_sample(uint8_t code, int32_t *predictor, int32_t *index)
+    {
+        int32_t step = adpcm_step_table[*index];
+        int32_t vpdiff = step >> 3;
+        vpdiff += step & -(int32_t)((code >> 2) & 1);
+        vpdiff += (step >> 1) & -(int32_t)((code >> 1) & 1);
+        vpdiff += (step >> 2) & -(int32_t)(code & 1);
+
+        int32_t smask = -(int32_t)((code >> 3) & 1);
+        *predictor = clamp_predictor(*predictor + ((vpdiff ^ smask) - smask));
+        *index = clamp_index(*index + adpcm_index_table[code]);
+        return *predictor;
+    }
+
+    void adpcm_init(adpcm_state_t *state)
+    {
+        state->predictor = 0;
+        state->index = 0;
+    }
+
+    void adpcm_encode_block(adpcm_state_t *state, const int16_t *src, uint8_t *dst, size_t count)
+    {
+        // keep state in registers for the whole block
+        int32_t predictor = state->predictor;
+        int32_t index = state->index;
+
+        for (; count >= 2; count -= 2)
+        {
+            uint8_t lo = adpcm_encode_sample(*src++, &predictor, &index);
+            uint8_t hi = adpcm_encode_sample(*src++, &predictor, &index);
+            *dst++ = lo | (hi << 4);
+        }
+        if (count)
+        {
+            *dst = adpcm_encode_sample(*src, &predictor, &index);
+        }
+
+        state->predictor = predictor;
+        state->index = index;
+    }
+
+    void adpcm_decode_block(adpcm_state_t *state, const uint8_t *src, int16_t *dst, size_t count)
+    {
+        int32_t predictor = state->predictor;
+        int32_t index = state->index;
+
+        for (; count >= 2; count -= 2)
+        {
+            uint8_t code = *src++;
+            *dst++ = adpcm_decode_sample(code & 0x0F, &predictor, &index);
+            *dst++ = adpcm_decode_sample(code >> 4, &predictor, &index);
+        }
+        if (count)
+        {
+            *dst = adpcm_decode_sample(*src & 0x0F, &predictor, &index);
+        }
+
+        state->predictor = predictor;
+        state->index = index;
+    }
+
+} // namespace audiocodec
@@ -0,0 +1,51 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+// Fixed-point audio codecs for Cortex-M0+: table-driven, no multiply or divide in the sample loop.
+namespace audiocodec
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // G.711 mu-law: 16-bit linear PCM <-> 8-bit companded sample (2:1)
+    ///////////////////////////////////////////////////////////////////////////////
+    uint8_t mulaw_encode(int16_t sample);
+    int16_t mulaw_decode(uint8_t code);
+    void mulaw_encode_block(const int16_t *src, uint8_t *dst, size_t count);
+    void mulaw_decode_block(const uint8_t *src, int16_t *dst, size_t count);
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // IMA-ADPCM: 16-bit linear PCM <-> 4-bit code (4:1)
+    // Two samples per byte, first sample in the low nibble (same as WAV IMA-ADPCM data).
+    ///////////////////////////////////////////////////////////////////////////////
+    typedef struct adpcm_state_t
+    {
+        int16_t predictor;
+        uint8_t index; // index into step table, 0-88
+    } adpcm_state_t;
+
+    void adpcm_init(adpcm_state_t *state);
+
+    // count is number of samples; dst/src hold (count + 1) / 2 bytes
+    void adpcm_encode_block(adpcm_state_t *state, const int16_t *src, uint8_t *dst, size_t count);
+    void adpcm_decode_block(adpcm_state_t *state, const uint8_t *src, int16_t *dst, size_t count);
+
+} // namespace audiocodec
@@ -80,3 +80,155 @@ static inline void i2s_master_in_mono_left_program_init(PIO pio, uint8_t sm, uin
 
 #endif
 
+
+// -------------------- //
+// i2s_master_in_stereo //
+// -------------------- //
+
+#define i2s_master_in_stereo_wrap_target 4
+#define i2s_master_in_stereo_wrap 19
+
+#define i2s_master_in_stereo_offset_entry_point 0u
+
+static const uint16_t i2s_master_in_stereo_program_instructions[] = {
+    0xa842, //  0: nop                    side 1     
+    0xe83e, //  1: set    x, 30           side 1     
+    0xa042, //  2: nop                    side 0     
+    0xa042, //  3: nop                    side 0     
+            //     .wrap_target
+    0xa842, //  4: nop                    side 1     
+    0x4801, //  5: in     pins, 1         side 1     
+    0xa042, //  6: nop                    side 0     
+    0x0044, //  7: jmp    x--, 4          side 0     
+    0xb842, //  8: nop                    side 3     
+    0x5801, //  9: in     pins, 1         side 3     
+    0xf03e, // 10: set    x, 30           side 2     
+    0xb042, // 11: nop                    side 2     
+    0xb842, // 12: nop                    side 3     
+    0x5801, // 13: in     pins, 1         side 3     
+    0xb042, // 14: nop                    side 2     
+    0x104c, // 15: jmp    x--, 12         side 2     
+    0xa842, // 16: nop                    side 1     
+    0x4801, // 17: in     pins, 1         side 1     
+    0xe03e, // 18: set    x, 30           side 0     
+    0xa042, // 19: nop                    side 0     
+            //     .wrap
+};
+
+#if !PICO_NO_HARDWARE
+static const struct pio_program i2s_master_in_stereo_program = {
+    .instructions = i2s_master_in_stereo_program_instructions,
+    .length = 20,
+    .origin = -1,
+};
+
+static inline pio_sm_config i2s_master_in_stereo_program_get_default_config(uint offset) {
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_wrap(&c, offset + i2s_master_in_stereo_wrap_target, offset + i2s_master_in_stereo_wrap);
+    sm_config_set_sideset(&c, 2, false, false);
+    return c;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// left (L/R=GND) and right (L/R=VDD) microphones share DIN, WS and BCLK; words are pushed as L, R, L, R, ...
+static inline void i2s_master_in_stereo_program_init(PIO pio, uint8_t sm, uint8_t offset, uint8_t bit_depth, uint8_t din_pin, uint8_t clock_pin_base) 
+{
+    pio_gpio_init(pio, din_pin);
+    pio_gpio_init(pio, clock_pin_base);
+    pio_gpio_init(pio, clock_pin_base + 1);
+    gpio_pull_down(din_pin);
+    pio_sm_config sm_config = i2s_master_in_stereo_program_get_default_config(offset);
+    sm_config_set_in_pins(&sm_config, din_pin);
+    sm_config_set_sideset_pins(&sm_config, clock_pin_base);
+    sm_config_set_in_shift(&sm_config, false, true, bit_depth);
+    sm_config_set_fifo_join(&sm_config, PIO_FIFO_JOIN_RX);
+    pio_sm_init(pio, sm, offset, &sm_config);
+    // DIN as input
+    // LRCLK and BCLK as output 
+    uint32_t pin_dirs = (3u << clock_pin_base);  
+    uint32_t pin_mask = (1u << din_pin) | (3u << clock_pin_base);  
+    pio_sm_set_pins_with_mask(pio, sm, 0, pin_mask);  
+    pio_sm_set_pindirs_with_mask(pio, sm, pin_dirs, pin_mask);
+}
+
+#endif
+
+
+// -------------------------- //
+// i2s_master_in_mono_left_16 //
+// -------------------------- //
+
+#define i2s_master_in_mono_left_16_wrap_target 4
+#define i2s_master_in_mono_left_16_wrap 21
+
+#define i2s_master_in_mono_left_16_offset_entry_point 0u
+
+static const uint16_t i2s_master_in_mono_left_16_program_instructions[] = {
+    0xa842, //  0: nop                    side 1     
+    0xe82f, //  1: set    x, 15           side 1     
+    0x6060, //  2: out    null, 32        side 0     
+    0xa042, //  3: nop                    side 0     
+            //     .wrap_target
+    0xa842, //  4: nop                    side 1     
+    0x4801, //  5: in     pins, 1         side 1     
+    0xa042, //  6: nop                    side 0     
+    0x0044, //  7: jmp    x--, 4          side 0     
+    0x08f6, //  8: jmp    !osre, 22       side 1     
+    0xa846, //  9: mov    y, isr          side 1     
+    0xa0c3, // 10: mov    isr, null       side 0     
+    0xa0e3, // 11: mov    osr, null       side 0     
+    0xe92c, // 12: set    x, 12           side 1 [1]
+    0xa142, // 13: nop                    side 0 [1]
+    0xa942, // 14: nop                    side 1 [1]
+    0x014e, // 15: jmp    x--, 14         side 0 [1]
+    0xb942, // 16: nop                    side 3 [1]
+    0xf13e, // 17: set    x, 30           side 2 [1]
+    0xb942, // 18: nop                    side 3 [1]
+    0x1152, // 19: jmp    x--, 18         side 2 [1]
+    0xa942, // 20: nop                    side 1 [1]
+    0xe12f, // 21: set    x, 15           side 0 [1]
+            //     .wrap
+    0x4850, // 22: in     y, 16           side 1     
+    0x6060, // 23: out    null, 32        side 0     
+    0x000c, // 24: jmp    12              side 0     
+};
+
+#if !PICO_NO_HARDWARE
+static const struct pio_program i2s_master_in_mono_left_16_program = {
+    .instructions = i2s_master_in_mono_left_16_program_instructions,
+    .length = 25,
+    .origin = -1,
+};
+
+static inline pio_sm_config i2s_master_in_mono_left_16_program_get_default_config(uint offset) {
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_wrap(&c, offset + i2s_master_in_mono_left_16_wrap_target, offset + i2s_master_in_mono_left_16_wrap);
+    sm_config_set_sideset(&c, 2, false, false);
+    return c;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// left slot only, 16 MSBs of each sample: the first sample of a pair is kept in Y (OSR shift count
+// as odd/even flag) and shifted in below the second, so each autopushed word holds two samples in
+// memory order (little-endian int16[2]). bit_depth sets BCLK only, the push threshold is 32.
+static inline void i2s_master_in_mono_left_16_program_init(PIO pio, uint8_t sm, uint8_t offset, uint8_t bit_depth, uint8_t din_pin, uint8_t clock_pin_base) 
+{
+    pio_gpio_init(pio, din_pin);
+    pio_gpio_init(pio, clock_pin_base);
+    pio_gpio_init(pio, clock_pin_base + 1);
+    gpio_pull_down(din_pin);
+    pio_sm_config sm_config = i2s_master_in_mono_left_16_program_get_default_config(offset);
+    sm_config_set_in_pins(&sm_config, din_pin);
+    sm_config_set_sideset_pins(&sm_config, clock_pin_base);
+    sm_config_set_in_shift(&sm_config, false, true, 32);
+    sm_config_set_fifo_join(&sm_config, PIO_FIFO_JOIN_RX);
+    pio_sm_init(pio, sm, offset, &sm_config);
+    // DIN as input
+    // LRCLK and BCLK as output 
+    uint32_t pin_dirs = (3u << clock_pin_base);  
+    uint32_t pin_mask = (1u << din_pin) | (3u << clock_pin_base);  
+    pio_sm_set_pins_with_mask(pio, sm, 0, pin_mask);  
+    pio_sm_set_pindirs_with_mask(pio, sm, pin_dirs, pin_mask);
+}
+
+#endif
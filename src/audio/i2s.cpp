@@ -31,48 +31,48 @@
 #include "audio_const.h"
 #include "../pins.h"
 #include "../ArduProfApp.h"
+#include "../util/BinLog.h"
+#include "../peripheral/ClockPlanner.h"
 
 #define PICO_I2S_PIO 0 // select PIO instance for I2S, either 0 or 1
 #define i2s_pio __CONCAT(pio, PICO_I2S_PIO)
 
+static_assert(2 * 32 * pio_i2s_master_in_program_mult == AUDIO_PIO_CYCLES_PER_SAMPLE, "AUDIO_PIO_CYCLES_PER_SAMPLE does not match the I2S program");
+
 namespace pioi2s
 {
     const config_t i2s_config_default = {
-        AUDIO_SAMPLING_RATE,
+        AUDIO_CAPTURE_RATE,
         32, // 32-bit per channel
         PIN_I2S_DI,
         PIN_I2S_BCLK,
     };
 
-    static float pio_div(float freq, uint16_t *div, uint8_t *frac)
+    // nearest divider in 1/256 steps; with CLOCK_PLAN_ENABLE clk_sys is a multiple of freq and frac is 0 (no jitter)
+    static uint32_t pio_div(uint32_t freq, uint16_t *div, uint8_t *frac)
     {
-        float clk = (float)clock_get_hz(clk_sys);
-        float ratio = clk / freq;
-        float d;
-        float f = modff(ratio, &d);
-        *div = (uint16_t)d;
-        *frac = (uint8_t)(f * 256.0f);
-
-        // Use post-converted values to get actual freq after any rounding
-        float result = clk / ((float)*div + ((float)*frac / 256.0f));
+        uint32_t clk = clock_get_hz(clk_sys);
+        auto clock = clockplan::pio_divider(clk, freq);
+        *div = clock.div;
+        *frac = clock.frac;
 
-        String sClk = String(clk, 2);
-        String sResult = String(result, 2);
-        LOG_TRACE("clk=", sClk.c_str(), ", freq=", freq, ", div=", *div, ", frac=", (uint32_t)(*frac), ", result=", sResult.c_str());
+        BINLOG(BL_PIO_DIV, clk, freq, *div, *frac, (uint32_t)clock.ppb);
 
-        return result;
+        return clock.hz;
     }
 
     static inline void calc_clocks_master(const config_t *config, clocks_t *clocks)
     {
-        float bck_hz = config->fs * (float)config->bit_depth * 2.0f;
-        clocks->bck_pio_hz = pio_div(bck_hz * (float)pio_i2s_master_in_program_mult, &clocks->bck_d, &clocks->bck_f);
+        uint32_t bck_hz = config->fs * config->bit_depth * 2;
+        clocks->bck_pio_hz = pio_div(bck_hz * pio_i2s_master_in_program_mult, &clocks->bck_d, &clocks->bck_f);
     }
 
     ///////////////////////////////////////////////////////////////////////////////
     // PIO initialization
     ///////////////////////////////////////////////////////////////////////////////
-    static bool i2s_master_in_mono_left_init_pio(const config_t *config, pio_i2s_t *i2s)
+    typedef void (*program_init_t)(PIO pio, uint8_t sm, uint8_t offset, uint8_t bit_depth, uint8_t din_pin, uint8_t clock_pin_base);
+
+    static bool i2s_master_in_init_pio(const config_t *config, pio_i2s_t *i2s, const pio_program_t *program, program_init_t program_init)
     {
         i2s->sm_mask = 0;
 
@@ -85,7 +85,7 @@ namespace pioi2s
         // build environment, so perform the steps explicitly using `pio0`.
         PIO pio = i2s_pio;
         uint sm = pio_claim_unused_sm(pio, true);
-        uint offset = pio_add_program(pio, &i2s_master_in_mono_left_program);
+        uint offset = pio_add_program(pio, program);
         bool success = true;
         if (success)
         {
@@ -93,7 +93,7 @@ namespace pioi2s
             i2s->sm_din = sm;
             i2s->offset_din = offset;
             i2s->sm_mask |= (1u << i2s->sm_din);
-            i2s_master_in_mono_left_program_init(pio, sm, offset, config->bit_depth, config->din_pin, config->clock_pin_base);
+            program_init(pio, sm, offset, config->bit_depth, config->din_pin, config->clock_pin_base);
             pio_sm_set_clkdiv_int_frac(pio, sm, clocks_master.bck_d, clocks_master.bck_f);
         }
         return success;
@@ -134,7 +134,7 @@ namespace pioi2s
                               &c,
                               NULL,                        // Will be set by ctrl channel
                               &i2s->pio->rxf[i2s->sm_din], // Source pointer
-                              DMA_BUFFER_SIZE,             // Number of transfers
+                              DMA_TRANSFER_COUNT,          // Number of transfers
                               false                        // don't start
         );
 
@@ -154,24 +154,37 @@ namespace pioi2s
         dma_start_channel_mask(ch_mask);
     }
 
-    ///////////////////////////////////////////////////////////////////////////////
-    bool master_in_mono_left_start(const config_t *config, void (*dma_handler)(void), pio_i2s_t *i2s)
+    static bool i2s_master_in_start(const config_t *config, void (*dma_handler)(void), pio_i2s_t *i2s, const pio_program_t *program, program_init_t program_init)
     {
         assert(!((uint32_t)(i2s->dma_in_ctrl_blocks) % 8) && !((uint32_t)(i2s->dma_in_buffer) % 8));
 
         // memset(i2s, 0, sizeof(*i2s));
-        if (i2s_master_in_mono_left_init_pio(config, i2s))
+        if (i2s_master_in_init_pio(config, i2s, program, program_init))
         {
             i2s_master_in_init_dma(i2s, dma_handler);
-            pio_enable_sm_mask_in_sync(i2s->pio, i2s->sm_mask);
-            rtos::ThisThread::sleep_for(std::chrono::milliseconds(263)); // skip 2^18 clock cycles for INMP441 to be normal operation mode
+            pio_enable_sm_mask_in_sync(i2s->pio, i2s->sm_mask); // data valid after I2S_MIC_SETTLE_MS
             return true;
         }
         else
         {
-            LOG_TRACE("i2s_master_in_mono_left_init_pio() failed");
+            LOG_TRACE("i2s_master_in_init_pio() failed");
             return false;
         }
     }
 
+    ///////////////////////////////////////////////////////////////////////////////
+    bool master_in_mono_left_start(const config_t *config, void (*dma_handler)(void), pio_i2s_t *i2s)
+    {
+#ifdef I2S_PACKED_16
+        return i2s_master_in_start(config, dma_handler, i2s, &i2s_master_in_mono_left_16_program, i2s_master_in_mono_left_16_program_init);
+#else
+        return i2s_master_in_start(config, dma_handler, i2s, &i2s_master_in_mono_left_program, i2s_master_in_mono_left_program_init);
+#endif
+    }
+
+    bool master_in_stereo_start(const config_t *config, void (*dma_handler)(void), pio_i2s_t *i2s)
+    {
+        return i2s_master_in_start(config, dma_handler, i2s, &i2s_master_in_stereo_program, i2s_master_in_stereo_program_init);
+    }
+
 } // namespace pioi2s
@@ -26,7 +26,25 @@
 #define NUM_CHANNELS 1 // total number of channels: 1=mono; 2=stereo
 // #define NUM_CHANNELS 2 // total number of channels: 1=mono; 2=stereo
 
-#define DMA_BUFFER_SIZE (AUDIO_FRAME_LEN * NUM_CHANNELS)
+#if NUM_CHANNELS == 1
+#define I2S_PACKED_16 // PIO keeps the 16 MSBs of each sample and packs two per word: int16 DMA buffers, no 32-bit words
+#endif
+
+#define DMA_BUFFER_SIZE (AUDIO_CAPTURE_FRAME_LEN * NUM_CHANNELS) // samples per DMA block
+#define I2S_MIC_SETTLE_MS 263 // INMP441 output is valid 2^18 SCK cycles after the clock starts, ThreadAudio drops earlier blocks
+
+#ifdef I2S_PACKED_16
+typedef int16_t dma_sample_t;
+#else
+typedef int32_t dma_sample_t; // 24-bit MSB aligned I2S words
+#endif
+#define DMA_TRANSFER_COUNT (DMA_BUFFER_SIZE * sizeof(dma_sample_t) / sizeof(uint32_t)) // 32-bit reads from the RX FIFO
+// DMA blocks are whole 32-bit words at every capture rate of the README (Capture rate, Clock planner)
+#define I2S_WHOLE_WORDS(rate) ((AUDIO_CAPTURE_FRAME_LEN_AT(rate) * NUM_CHANNELS * sizeof(dma_sample_t)) % sizeof(uint32_t) == 0)
+static_assert(I2S_WHOLE_WORDS(AUDIO_CAPTURE_RATE), "I2S_PACKED_16 needs an even AUDIO_CAPTURE_FRAME_LEN");
+static_assert(I2S_WHOLE_WORDS(16000) && I2S_WHOLE_WORDS(22050) && I2S_WHOLE_WORDS(32000) &&
+                  I2S_WHOLE_WORDS(44100) && I2S_WHOLE_WORDS(48000),
+              "a documented capture rate does not fill whole DMA words");
 
 namespace pioi2s
 {
@@ -41,7 +59,7 @@ namespace pioi2s
     typedef struct clocks_t
     {
         // Clock computation results
-        float bck_pio_hz;
+        uint32_t bck_pio_hz;
 
         // PIO divider ratios to obtain the computed clocks above
         uint16_t bck_d;
@@ -51,10 +69,10 @@ namespace pioi2s
     // NOTE: Use __attribute__ ((aligned(8))) on this struct or the DMA wrap won't work!
     typedef struct pio_i2s_t
     {
-        int32_t *dma_in_ctrl_blocks[2]; // Control blocks MUST have 8-byte alignment.
+        dma_sample_t *dma_in_ctrl_blocks[2]; // Control blocks MUST have 8-byte alignment.
         uint dma_ch_in_ctrl;
         uint dma_ch_in_data;
-        int32_t dma_in_buffer[2][DMA_BUFFER_SIZE];
+        dma_sample_t dma_in_buffer[2][DMA_BUFFER_SIZE];
 
         PIO pio;
         uint8_t sm_mask;
@@ -66,6 +84,7 @@ namespace pioi2s
 
     extern const config_t i2s_config_default;
 
-    bool master_in_mono_left_start(const config_t *config, void (*dma_handler)(void), pio_i2s_t *i2s);
+    bool master_in_mono_left_start(const config_t *config, void (*dma_handler)(void), pio_i2s_t *i2s); // packed int16 with I2S_PACKED_16
+    bool master_in_stereo_start(const config_t *config, void (*dma_handler)(void), pio_i2s_t *i2s); // NUM_CHANNELS 2: interleaved L, R words
 
 } // namespace pioi2s
@@ -0,0 +1,139 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <mbed.h>
+#include <rtos.h>
+#include <math.h>
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/pio.h"
+
+#include "pdm.h"
+#include "pdm.pio.h"
+
+#include "audio_const.h"
+#include "../pins.h"
+#include "../ArduProfApp.h"
+#include "../util/BinLog.h"
+#include "../peripheral/ClockPlanner.h"
+
+#define PICO_PDM_PIO 0 // select PIO instance for PDM, either 0 or 1
+#define pdm_pio __CONCAT(pio, PICO_PDM_PIO)
+
+static_assert(PDM_DECIMATION * pio_pdm_in_program_mult == AUDIO_PIO_CYCLES_PER_SAMPLE, "AUDIO_PIO_CYCLES_PER_SAMPLE does not match the PDM program");
+
+namespace pdm
+{
+    const config_t pdm_config_default = {
+        AUDIO_CAPTURE_RATE,
+        PIN_PDM_DATA,
+        PIN_PDM_CLK,
+    };
+
+    // nearest divider in 1/256 steps; with CLOCK_PLAN_ENABLE clk_sys is a multiple of freq and frac is 0 (no jitter)
+    static uint32_t pio_div(uint32_t freq, uint16_t *div, uint8_t *frac)
+    {
+        uint32_t clk = clock_get_hz(clk_sys);
+        auto clock = clockplan::pio_divider(clk, freq);
+        *div = clock.div;
+        *frac = clock.frac;
+
+        BINLOG(BL_PIO_DIV, clk, freq, *div, *frac, (uint32_t)clock.ppb);
+
+        return clock.hz;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // PIO initialization
+    ///////////////////////////////////////////////////////////////////////////////
+    static void pdm_init_pio(const config_t *config, pio_pdm_t *pdm)
+    {
+        uint16_t div;
+        uint8_t frac;
+        pio_div(config->fs * PDM_DECIMATION * pio_pdm_in_program_mult, &div, &frac);
+        LOG_TRACE("pdm div=", div, ", frac=", frac);
+
+        PIO pio = pdm_pio;
+        pdm->pio = pio;
+        pdm->sm = pio_claim_unused_sm(pio, true);
+        pdm->offset = pio_add_program(pio, &pdm_mono_in_program);
+        pdm_mono_in_program_init(pio, pdm->sm, pdm->offset, config->data_pin, config->clock_pin);
+        pio_sm_set_clkdiv_int_frac(pio, pdm->sm, div, frac);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // DMA initialization: the ctrl channel reloads the data channel with the two buffers in turn
+    ///////////////////////////////////////////////////////////////////////////////
+    static void pdm_init_dma(pio_pdm_t *pdm, void (*dma_handler)(void))
+    {
+        pdm->dma_ch_in_ctrl = dma_claim_unused_channel(true);
+        pdm->dma_ch_in_data = dma_claim_unused_channel(true);
+
+        pdm->dma_in_ctrl_blocks[0] = pdm->dma_in_buffer[0];
+        pdm->dma_in_ctrl_blocks[1] = pdm->dma_in_buffer[1];
+
+        dma_channel_config c = dma_channel_get_default_config(pdm->dma_ch_in_ctrl);
+        channel_config_set_read_increment(&c, true);
+        channel_config_set_write_increment(&c, false);
+        channel_config_set_ring(&c, false, 3);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+        dma_channel_configure(pdm->dma_ch_in_ctrl,
+                              &c,
+                              &dma_hw->ch[pdm->dma_ch_in_data].al2_write_addr_trig, // Destination pointer
+                              pdm->dma_in_ctrl_blocks,                              // Source pointer
+                              1,                                                    // Number of transfers
+                              false                                                 // don't start
+        );
+
+        c = dma_channel_get_default_config(pdm->dma_ch_in_data);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+        channel_config_set_read_increment(&c, false);
+        channel_config_set_write_increment(&c, true);
+        channel_config_set_chain_to(&c, pdm->dma_ch_in_ctrl);
+        channel_config_set_dreq(&c, pio_get_dreq(pdm->pio, pdm->sm, false));
+
+        dma_channel_configure(pdm->dma_ch_in_data,
+                              &c,
+                              NULL,                    // Will be set by ctrl channel
+                              &pdm->pio->rxf[pdm->sm], // Source pointer
+                              PDM_DMA_WORDS,           // Number of transfers
+                              false                    // don't start
+        );
+
+        dma_channel_set_irq0_enabled(pdm->dma_ch_in_data, true);
+        irq_set_exclusive_handler(DMA_IRQ_0, dma_handler);
+        irq_set_enabled(DMA_IRQ_0, true);
+
+        dma_start_channel_mask(1u << pdm->dma_ch_in_ctrl);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    bool mono_in_start(const config_t *config, void (*dma_handler)(void), pio_pdm_t *pdm)
+    {
+        assert(!((uint32_t)(pdm->dma_in_ctrl_blocks) % 8) && !((uint32_t)(pdm->dma_in_buffer) % 8));
+
+        pdm->config = *config;
+        pdm_init_pio(config, pdm);
+        pdm_init_dma(pdm, dma_handler);
+        pio_sm_set_enabled(pdm->pio, pdm->sm, true); // data valid after PDM_MIC_SETTLE_MS
+        return true;
+    }
+
+} // namespace pdm
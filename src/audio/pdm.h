@@ -0,0 +1,67 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <stdio.h>
+#include "hardware/pio.h"
+
+#include "./audio_const.h"
+#include "./i2s.h"
+#include "./PdmDecimator.h"
+
+#if defined AUDIO_INPUT_PDM && NUM_CHANNELS != 1
+#error "AUDIO_INPUT_PDM supports a single microphone, set NUM_CHANNELS 1"
+#endif
+
+#define PDM_DMA_WORDS 128 // 32-bit PDM words per DMA block: 4096 bits, 64 samples, 4 ms at 16 kHz
+#define PDM_MIC_SETTLE_MS 50 // PDM microphones wake up within 50 ms of the first clock, ThreadAudio drops earlier blocks
+
+static_assert(PDM_DMA_WORDS <= PDM_MAX_WORDS, "PDM_DMA_WORDS exceeds PdmDecimator::process()");
+static_assert(AUDIO_CAPTURE_FRAME_LEN % (PDM_DMA_WORDS / 2) == 0, "AUDIO_CAPTURE_FRAME_LEN must be a multiple of the samples per PDM DMA block");
+
+namespace pdm
+{
+    typedef struct config_t
+    {
+        uint32_t fs; // output sampling frequency, PDM clock = fs * PDM_DECIMATION
+        uint8_t data_pin;
+        uint8_t clock_pin;
+    } config_t;
+
+    // NOTE: Use __attribute__ ((aligned(8))) on this struct or the DMA wrap won't work!
+    typedef struct pio_pdm_t
+    {
+        uint32_t *dma_in_ctrl_blocks[2]; // Control blocks MUST have 8-byte alignment.
+        uint dma_ch_in_ctrl;
+        uint dma_ch_in_data;
+        uint32_t dma_in_buffer[2][PDM_DMA_WORDS];
+
+        PIO pio;
+        uint8_t sm;
+        uint offset;
+
+        config_t config;
+    } pio_pdm_t;
+
+    extern const config_t pdm_config_default;
+
+    // dma_handler is called on DMA_IRQ_0 for every PDM_DMA_WORDS block
+    bool mono_in_start(const config_t *config, void (*dma_handler)(void), pio_pdm_t *pdm);
+
+} // namespace pdm
@@ -0,0 +1,61 @@
+// -------------------------------------------------- //
+// This file is autogenerated by pioasm; do not edit! //
+// -------------------------------------------------- //
+
+#pragma once
+
+#if !PICO_NO_HARDWARE
+#include "hardware/pio.h"
+#endif
+
+// ----------- //
+// pdm_mono_in //
+// ----------- //
+
+#define pdm_mono_in_wrap_target 0
+#define pdm_mono_in_wrap 2
+
+static const uint16_t pdm_mono_in_program_instructions[] = {
+            //     .wrap_target
+    0xa042, //  0: nop                    side 0     
+    0x4001, //  1: in     pins, 1         side 0     
+    0xb142, //  2: nop                    side 1 [1] 
+            //     .wrap
+};
+
+#if !PICO_NO_HARDWARE
+static const struct pio_program pdm_mono_in_program = {
+    .instructions = pdm_mono_in_program_instructions,
+    .length = 3,
+    .origin = -1,
+};
+
+static inline pio_sm_config pdm_mono_in_program_get_default_config(uint offset) {
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_wrap(&c, offset + pdm_mono_in_wrap_target, offset + pdm_mono_in_wrap);
+    sm_config_set_sideset(&c, 1, false, false);
+    return c;
+}
+
+const int pio_pdm_in_program_mult = 4; // PIO cycles per PDM clock
+///////////////////////////////////////////////////////////////////////////////
+// CLK low for 2 cycles, DATA sampled at the end of the low phase (mic with SEL tied low drives
+// DATA after the rising edge), then CLK high for 2 cycles. 32 bits per autopush, earliest bit in the MSB.
+static inline void pdm_mono_in_program_init(PIO pio, uint8_t sm, uint8_t offset, uint8_t data_pin, uint8_t clock_pin) 
+{
+    pio_gpio_init(pio, data_pin);
+    pio_gpio_init(pio, clock_pin);
+    gpio_pull_down(data_pin);
+    pio_sm_config sm_config = pdm_mono_in_program_get_default_config(offset);
+    sm_config_set_in_pins(&sm_config, data_pin);
+    sm_config_set_sideset_pins(&sm_config, clock_pin);
+    sm_config_set_in_shift(&sm_config, false, true, 32);
+    sm_config_set_fifo_join(&sm_config, PIO_FIFO_JOIN_RX);
+    pio_sm_init(pio, sm, offset, &sm_config);
+    // DATA as input, CLK as output
+    uint32_t pin_mask = (1u << data_pin) | (1u << clock_pin);
+    pio_sm_set_pins_with_mask(pio, sm, 0, pin_mask);
+    pio_sm_set_pindirs_with_mask(pio, sm, 1u << clock_pin, pin_mask);
+}
+
+#endif
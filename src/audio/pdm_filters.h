@@ -0,0 +1,36 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+// generated by tools/pdm_design.py, do not edit
+// pass band 50 - 7000 Hz: -0.03 .. +0.01 dB, worst alias -62.2 dB
+#pragma once
+#include <stdint.h>
+
+#define PDM_HALFBAND_TAPS 19
+#define PDM_COMP_TAPS 63
+
+// 64000 -> 32000 Hz, Q15
+static const int16_t pdm_halfband[19] = {
+    3, 0, -97, 0, 596, 0, -2269, 0, 9958, 16384, 9958, 0, -2269, 0, 596, 0, -97, 0, 3
+};
+
+// 32000 -> 16000 Hz with CIC droop compensation, Q15
+static const int16_t pdm_compensation[63] = {
+    -5, 0, 14, 0, -29, 0, 51, 1, -84, -1, 129, 1, -190, 0, 273, 0, -382, 1, 528, -1, -726, -1, 1004, 6, -1421, -21, 2136, 69, -3710, -330, 10606, 16941, 10606, -330, -3710, 69, 2136, -21, -1421, 6, 1004, -1, -726, -1, 528, 1, -382, 0, 273, 0, -190, 1, 129, -1, -84, 1, 51, 0, -29, 0, 14, 0, -5
+};
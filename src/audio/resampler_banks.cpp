@@ -0,0 +1,360 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+// generated by tools/resampler_design.py, do not edit
+#include "./Resampler.h"
+
+static const int16_t _coeffs_48000_16000[1 * 96] = {
+    1, 0, -3, -4, -1, 6, 10, 6, -7, -20, -17, 5, 31, 37, 8, -40, -65, -35, 40, 100, 82, -21, -133, -151, -30, 152, 238, 123, -137, -334, -268, 66, 421, 471, 93, -470, -739, -384, 437, 1092, 907, -236, -1618, -2006, -458, 2924, 6846, 9467, 9467, 6846, 2924, -458, -2006, -1618, -236, 907, 1092, 437, -384, -739, -470, 93, 471, 421, 66, -268, -334, -137, 123, 238, 152, -30, -151, -133, -21, 82, 100, 40, -35, -65, -40, 8, 37, 31, 5, -17, -20, -7, 6, 10, 6, -1, -4, -3, 0, 1, // phase 0
+};
+
+static const int16_t _coeffs_16000_8000[1 * 64] = {
+    1, -3, -5, 5, 14, -5, -30, -3, 52, 26, -74, -71, 88, 141, -77, -237, 23, 348, 97, -454, -303, 522, 618, -504, -1067, 326, 1712, 170, -2784, -1564, 5885, 13537, 13537, 5885, -1564, -2784, 170, 1712, 326, -1067, -504, 618, 522, -303, -454, 97, 348, 23, -237, -77, 141, 88, -71, -74, 26, 52, -3, -30, -5, 14, 5, -5, -3, 1, // phase 0
+};
+
+static const int16_t _coeffs_22050_16000[320 * 32] = {
+    4, -8, -13, 58, -50, -90, 255, -144, -356, 759, -279, -1114, 1996, -406, -4060, 9161, 21399, 9101, -4071, -386, 1989, -1120, -272, 757, -358, -142, 254, -90, -49, 58, -13, -8, // phase 0
+    4, -8, -13, 58, -51, -89, 255, -147, -353, 761, -286, -1109, 2003, -427, -4048, 9221, 21399, 9041, -4082, -366, 1982, -1125, -265, 755, -360, -139, 254, -91, -49, 57, -13, -8, // phase 1
+    4, -8, -13, 58, -51, -88, 256, -149, -351, 763, -293, -1104, 2010, -447, -4037, 9281, 21399, 8982, -4093, -346, 1975, -1130, -258, 753, -362, -137, 253, -92, -48, 57, -13, -7, // phase 2
+    4, -8, -12, 58, -52, -87, 256, -151, -349, 765, -300, -1098, 2016, -467, -4025, 9340, 21398, 8922, -4103, -326, 1968, -1135, -251, 751, -365, -134, 253, -93, -47, 57, -13, -7, // phase 3
+    4, -8, -12, 58, -52, -87, 257, -154, -346, 767, -307, -1092, 2023, -488, -4013, 9400, 21396, 8862, -4114, -306, 1961, -1141, -244, 749, -367, -132, 252, -93, -47, 57, -14, -7, // phase 4
+    4, -8, -12, 58, -53, -86, 257, -156, -344, 768, -314, -1087, 2030, -508, -4001, 9460, 21395, 8802, -4124, -286, 1954, -1146, -237, 747, -369, -130, 252, -94, -46, 57, -14, -7, // phase 5
+    4, -8, -12, 58, -54, -85, 257, -159, -341, 770, -321, -1081, 2036, -528, -3988, 9520, 21393, 8743, -4134, -266, 1946, -1151, -230, 745, -371, -127, 251, -95, -45, 57, -14, -7, // phase 6
+    4, -8, -12, 58, -54, -84, 258, -161, -339, 772, -328, -1075, 2042, -549, -3976, 9580, 21391, 8683, -4143, -246, 1939, -1156, -223, 743, -373, -125, 251, -96, -45, 57, -14, -7, // phase 7
+    4, -8, -12, 58, -55, -83, 258, -164, -336, 774, -335, -1070, 2049, -569, -3963, 9639, 21389, 8623, -4153, -226, 1931, -1160, -216, 741, -375, -122, 250, -96, -44, 57, -14, -7, // phase 8
+    4, -9, -11, 58, -56, -83, 259, -166, -334, 775, -342, -1064, 2055, -590, -3950, 9699, 21386, 8563, -4162, -206, 1924, -1165, -209, 739, -377, -120, 249, -97, -43, 57, -14, -7, // phase 9
+    4, -9, -11, 59, -56, -82, 259, -168, -332, 777, -349, -1058, 2061, -610, -3936, 9759, 21383, 8504, -4171, -186, 1916, -1170, -202, 737, -380, -117, 249, -98, -43, 56, -14, -7, // phase 10
+    4, -9, -11, 59, -57, -81, 259, -171, -329, 778, -356, -1052, 2067, -631, -3923, 9819, 21380, 8444, -4180, -166, 1909, -1175, -195, 735, -382, -115, 248, -98, -42, 56, -14, -7, // phase 11
+    4, -9, -11, 59, -58, -80, 260, -173, -326, 780, -363, -1046, 2073, -652, -3909, 9878, 21376, 8384, -4189, -147, 1901, -1179, -188, 732, -384, -112, 248, -99, -42, 56, -15, -7, // phase 12
+    4, -9, -11, 59, -58, -79, 260, -176, -324, 781, -370, -1040, 2079, -672, -3895, 9938, 21372, 8325, -4198, -127, 1893, -1184, -181, 730, -386, -110, 247, -100, -41, 56, -15, -7, // phase 13
+    4, -9, -11, 59, -59, -78, 261, -178, -321, 783, -377, -1034, 2085, -693, -3881, 9998, 21368, 8265, -4206, -107, 1885, -1188, -174, 728, -388, -108, 246, -100, -40, 56, -15, -6, // phase 14
+    4, -9, -11, 59, -60, -78, 261, -181, -319, 784, -384, -1027, 2091, -714, -3867, 10057, 21364, 8205, -4214, -88, 1878, -1193, -167, 725, -390, -105, 246, -101, -40, 56, -15, -6, // phase 15
+    4, -9, -10, 59, -60, -77, 261, -183, -316, 786, -391, -1021, 2097, -734, -3852, 10117, 21359, 8146, -4222, -68, 1870, -1197, -160, 723, -392, -103, 245, -102, -39, 56, -15, -6, // phase 16
+    4, -9, -10, 59, -61, -76, 262, -185, -314, 787, -398, -1015, 2103, -755, -3838, 10177, 21354, 8086, -4229, -49, 1862, -1202, -153, 721, -394, -100, 245, -102, -38, 56, -15, -6, // phase 17
+    4, -9, -10, 59, -61, -75, 262, -188, -311, 789, -405, -1008, 2108, -776, -3823, 10236, 21348, 8026, -4237, -29, 1854, -1206, -146, 718, -396, -98, 244, -103, -38, 55, -15, -6, // phase 18
+    4, -9, -10, 59, -62, -74, 262, -190, -308, 790, -412, -1002, 2114, -796, -3807, 10296, 21343, 7967, -4244, -10, 1845, -1210, -139, 716, -397, -96, 243, -104, -37, 55, -15, -6, // phase 19
+    4, -10, -10, 59, -63, -73, 262, -193, -306, 791, -419, -996, 2119, -817, -3792, 10355, 21337, 7907, -4251, 10, 1837, -1214, -132, 713, -399, -93, 243, -104, -36, 55, -16, -6, // phase 20
+    4, -10, -10, 59, -63, -72, 263, -195, -303, 793, -426, -989, 2125, -838, -3776, 10415, 21331, 7848, -4258, 29, 1829, -1218, -126, 711, -401, -91, 242, -105, -36, 55, -16, -6, // phase 21
+    4, -10, -9, 59, -64, -71, 263, -197, -300, 794, -433, -982, 2130, -859, -3761, 10474, 21324, 7788, -4265, 48, 1821, -1222, -119, 708, -403, -88, 241, -105, -35, 55, -16, -6, // phase 22
+    4, -10, -9, 59, -65, -71, 263, -200, -297, 795, -440, -976, 2135, -880, -3744, 10534, 21317, 7729, -4271, 67, 1812, -1226, -112, 706, -405, -86, 240, -106, -34, 55, -16, -6, // phase 23
+    4, -10, -9, 59, -65, -70, 263, -202, -295, 796, -447, -969, 2140, -900, -3728, 10593, 21310, 7670, -4278, 87, 1804, -1230, -105, 703, -407, -83, 240, -107, -34, 55, -16, -6, // phase 24
+    4, -10, -9, 59, -66, -69, 264, -205, -292, 798, -454, -962, 2145, -921, -3712, 10653, 21303, 7610, -4284, 106, 1795, -1234, -98, 701, -408, -81, 239, -107, -33, 54, -16, -5, // phase 25
+    4, -10, -9, 59, -67, -68, 264, -207, -289, 799, -461, -955, 2150, -942, -3695, 10712, 21295, 7551, -4290, 125, 1787, -1238, -91, 698, -410, -79, 238, -108, -33, 54, -16, -5, // phase 26
+    4, -10, -9, 59, -67, -67, 264, -209, -286, 800, -468, -949, 2155, -963, -3678, 10771, 21287, 7492, -4295, 144, 1778, -1242, -84, 696, -412, -76, 238, -108, -32, 54, -16, -5, // phase 27
+    4, -10, -8, 59, -68, -66, 264, -212, -283, 801, -475, -942, 2160, -984, -3661, 10831, 21278, 7432, -4301, 163, 1770, -1245, -78, 693, -414, -74, 237, -109, -31, 54, -16, -5, // phase 28
+    4, -10, -8, 59, -68, -65, 265, -214, -281, 802, -482, -935, 2165, -1005, -3644, 10890, 21270, 7373, -4306, 182, 1761, -1249, -71, 690, -415, -71, 236, -110, -31, 54, -17, -5, // phase 29
+    4, -10, -8, 59, -69, -64, 265, -216, -278, 803, -489, -928, 2169, -1026, -3626, 10949, 21261, 7314, -4311, 201, 1752, -1253, -64, 688, -417, -69, 235, -110, -30, 54, -17, -5, // phase 30
+    4, -11, -8, 59, -70, -63, 265, -219, -275, 804, -496, -921, 2174, -1047, -3608, 11008, 21252, 7255, -4316, 219, 1743, -1256, -57, 685, -418, -67, 235, -111, -29, 53, -17, -5, // phase 31
+    4, -11, -8, 59, -70, -62, 265, -221, -272, 805, -503, -913, 2179, -1068, -3590, 11067, 21242, 7196, -4321, 238, 1735, -1260, -50, 682, -420, -64, 234, -111, -29, 53, -17, -5, // phase 32
+    4, -11, -7, 60, -71, -61, 265, -224, -269, 806, -510, -906, 2183, -1089, -3572, 11126, 21232, 7137, -4325, 257, 1726, -1263, -44, 679, -422, -62, 233, -112, -28, 53, -17, -5, // phase 33
+    4, -11, -7, 60, -72, -60, 265, -226, -266, 807, -517, -899, 2187, -1110, -3554, 11186, 21222, 7078, -4329, 275, 1717, -1266, -37, 677, -423, -59, 232, -112, -27, 53, -17, -5, // phase 34
+    4, -11, -7, 60, -72, -59, 265, -228, -263, 807, -524, -892, 2192, -1131, -3535, 11245, 21212, 7019, -4333, 294, 1708, -1270, -30, 674, -425, -57, 231, -113, -27, 53, -17, -5, // phase 35
+    4, -11, -7, 60, -73, -58, 266, -231, -260, 808, -531, -884, 2196, -1152, -3516, 11303, 21201, 6960, -4337, 312, 1699, -1273, -23, 671, -426, -55, 231, -113, -26, 53, -17, -5, // phase 36
+    4, -11, -7, 60, -73, -58, 266, -233, -257, 809, -538, -877, 2200, -1173, -3497, 11362, 21190, 6901, -4341, 331, 1689, -1276, -17, 668, -428, -52, 230, -114, -26, 52, -17, -4, // phase 37
+    4, -11, -6, 60, -74, -57, 266, -235, -254, 810, -544, -870, 2204, -1194, -3478, 11421, 21179, 6842, -4345, 349, 1680, -1279, -10, 665, -429, -50, 229, -114, -25, 52, -17, -4, // phase 38
+    4, -11, -6, 60, -75, -56, 266, -238, -251, 811, -551, -862, 2208, -1215, -3458, 11480, 21167, 6784, -4348, 368, 1671, -1282, -3, 662, -431, -48, 228, -115, -24, 52, -17, -4, // phase 39
+    4, -11, -6, 60, -75, -55, 266, -240, -248, 811, -558, -854, 2212, -1236, -3439, 11539, 21156, 6725, -4351, 386, 1662, -1285, 3, 660, -432, -45, 227, -115, -24, 52, -18, -4, // phase 40
+    4, -11, -6, 60, -76, -54, 266, -242, -245, 812, -565, -847, 2215, -1257, -3419, 11597, 21143, 6666, -4354, 404, 1652, -1288, 10, 657, -434, -43, 226, -116, -23, 52, -18, -4, // phase 41
+    4, -12, -6, 60, -77, -53, 266, -245, -242, 813, -572, -839, 2219, -1278, -3399, 11656, 21131, 6608, -4357, 422, 1643, -1291, 17, 654, -435, -41, 226, -116, -22, 52, -18, -4, // phase 42
+    4, -12, -6, 60, -77, -52, 266, -247, -239, 813, -579, -831, 2223, -1299, -3378, 11715, 21118, 6549, -4359, 440, 1634, -1294, 23, 651, -436, -38, 225, -117, -22, 51, -18, -4, // phase 43
+    4, -12, -5, 60, -78, -51, 266, -249, -236, 814, -586, -824, 2226, -1320, -3358, 11773, 21105, 6491, -4362, 458, 1624, -1296, 30, 648, -438, -36, 224, -117, -21, 51, -18, -4, // phase 44
+    4, -12, -5, 59, -78, -50, 266, -252, -233, 814, -593, -816, 2230, -1341, -3337, 11832, 21092, 6432, -4364, 476, 1615, -1299, 37, 645, -439, -33, 223, -118, -21, 51, -18, -4, // phase 45
+    4, -12, -5, 59, -79, -49, 266, -254, -229, 815, -599, -808, 2233, -1362, -3316, 11890, 21078, 6374, -4366, 494, 1605, -1302, 43, 642, -441, -31, 222, -118, -20, 51, -18, -4, // phase 46
+    4, -12, -5, 59, -80, -48, 266, -256, -226, 815, -606, -800, 2236, -1383, -3295, 11948, 21064, 6316, -4368, 512, 1595, -1304, 50, 639, -442, -29, 221, -119, -19, 51, -18, -4, // phase 47
+    4, -12, -5, 59, -80, -47, 266, -258, -223, 816, -613, -792, 2239, -1404, -3273, 12007, 21050, 6257, -4369, 530, 1586, -1307, 56, 635, -443, -26, 220, -119, -19, 50, -18, -4, // phase 48
+    4, -12, -4, 59, -81, -45, 266, -261, -220, 816, -620, -784, 2242, -1425, -3252, 12065, 21036, 6199, -4371, 547, 1576, -1309, 63, 632, -444, -24, 219, -120, -18, 50, -18, -4, // phase 49
+    4, -12, -4, 59, -81, -44, 266, -263, -217, 816, -627, -776, 2245, -1446, -3230, 12123, 21021, 6141, -4372, 565, 1566, -1311, 69, 629, -446, -22, 219, -120, -17, 50, -18, -3, // phase 50
+    4, -12, -4, 59, -82, -43, 266, -265, -213, 817, -633, -768, 2248, -1467, -3208, 12181, 21006, 6083, -4373, 583, 1557, -1314, 76, 626, -447, -19, 218, -121, -17, 50, -18, -3, // phase 51
+    4, -12, -4, 59, -83, -42, 266, -268, -210, 817, -640, -760, 2251, -1488, -3185, 12239, 20991, 6025, -4374, 600, 1547, -1316, 82, 623, -448, -17, 217, -121, -16, 50, -19, -3, // phase 52
+    4, -13, -4, 59, -83, -41, 266, -270, -207, 817, -647, -752, 2254, -1509, -3163, 12297, 20975, 5967, -4374, 618, 1537, -1318, 89, 620, -449, -15, 216, -121, -16, 50, -19, -3, // phase 53
+    4, -13, -3, 59, -84, -40, 266, -272, -204, 817, -654, -743, 2256, -1530, -3140, 12355, 20959, 5910, -4375, 635, 1527, -1320, 95, 617, -450, -13, 215, -122, -15, 49, -19, -3, // phase 54
+    4, -13, -3, 59, -84, -39, 265, -274, -200, 818, -660, -735, 2259, -1551, -3117, 12413, 20943, 5852, -4375, 652, 1517, -1322, 102, 613, -451, -10, 214, -122, -14, 49, -19, -3, // phase 55
+    4, -13, -3, 59, -85, -38, 265, -277, -197, 818, -667, -727, 2261, -1572, -3094, 12470, 20926, 5794, -4375, 669, 1507, -1324, 108, 610, -452, -8, 213, -123, -14, 49, -19, -3, // phase 56
+    4, -13, -3, 59, -86, -37, 265, -279, -194, 818, -674, -718, 2264, -1593, -3071, 12528, 20910, 5737, -4375, 686, 1497, -1326, 114, 607, -454, -6, 212, -123, -13, 49, -19, -3, // phase 57
+    4, -13, -2, 59, -86, -36, 265, -281, -190, 818, -680, -710, 2266, -1614, -3047, 12586, 20892, 5679, -4375, 704, 1487, -1328, 121, 604, -455, -3, 211, -123, -13, 49, -19, -3, // phase 58
+    4, -13, -2, 59, -87, -35, 265, -283, -187, 818, -687, -701, 2268, -1635, -3023, 12643, 20875, 5622, -4375, 721, 1477, -1330, 127, 600, -456, -1, 210, -124, -12, 48, -19, -3, // phase 59
+    4, -13, -2, 59, -87, -34, 265, -286, -184, 818, -694, -693, 2270, -1656, -2999, 12700, 20857, 5564, -4374, 737, 1467, -1332, 134, 597, -457, 1, 209, -124, -11, 48, -19, -3, // phase 60
+    4, -13, -2, 59, -88, -33, 265, -288, -180, 818, -700, -684, 2272, -1677, -2975, 12758, 20840, 5507, -4373, 754, 1456, -1333, 140, 594, -458, 3, 208, -125, -11, 48, -19, -3, // phase 61
+    4, -13, -2, 59, -88, -32, 264, -290, -177, 818, -707, -676, 2274, -1698, -2950, 12815, 20821, 5450, -4372, 771, 1446, -1335, 146, 590, -459, 6, 207, -125, -10, 48, -19, -3, // phase 62
+    4, -13, -1, 59, -89, -31, 264, -292, -173, 818, -713, -667, 2276, -1718, -2926, 12872, 20803, 5393, -4371, 788, 1436, -1337, 153, 587, -460, 8, 206, -125, -10, 47, -19, -2, // phase 63
+    4, -14, -1, 59, -90, -29, 264, -294, -170, 818, -720, -658, 2278, -1739, -2901, 12929, 20784, 5336, -4370, 804, 1425, -1338, 159, 584, -460, 10, 205, -126, -9, 47, -19, -2, // phase 64
+    4, -14, -1, 59, -90, -28, 264, -297, -166, 817, -727, -649, 2280, -1760, -2876, 12986, 20765, 5279, -4368, 821, 1415, -1340, 165, 580, -461, 12, 204, -126, -8, 47, -19, -2, // phase 65
+    4, -14, -1, 58, -91, -27, 264, -299, -163, 817, -733, -640, 2281, -1781, -2850, 13043, 20746, 5222, -4367, 837, 1405, -1341, 171, 577, -462, 15, 203, -126, -8, 47, -19, -2, // phase 66
+    4, -14, -1, 58, -91, -26, 263, -301, -160, 817, -740, -632, 2283, -1802, -2825, 13100, 20726, 5165, -4365, 854, 1394, -1342, 178, 573, -463, 17, 202, -127, -7, 47, -20, -2, // phase 67
+    4, -14, 0, 58, -92, -25, 263, -303, -156, 817, -746, -623, 2284, -1823, -2799, 13156, 20706, 5108, -4363, 870, 1384, -1344, 184, 570, -464, 19, 201, -127, -7, 46, -20, -2, // phase 68
+    4, -14, 0, 58, -92, -24, 263, -305, -153, 816, -753, -614, 2285, -1843, -2773, 13213, 20686, 5052, -4360, 886, 1373, -1345, 190, 566, -465, 21, 200, -127, -6, 46, -20, -2, // phase 69
+    4, -14, 0, 58, -93, -23, 262, -307, -149, 816, -759, -605, 2286, -1864, -2747, 13270, 20666, 4995, -4358, 903, 1363, -1346, 196, 563, -466, 24, 199, -128, -5, 46, -20, -2, // phase 70
+    4, -14, 0, 58, -94, -22, 262, -309, -145, 816, -766, -596, 2287, -1885, -2721, 13326, 20645, 4939, -4355, 919, 1352, -1347, 202, 559, -466, 26, 198, -128, -5, 46, -20, -2, // phase 71
+    4, -14, 1, 58, -94, -20, 262, -312, -142, 815, -772, -587, 2288, -1906, -2694, 13382, 20624, 4882, -4353, 935, 1342, -1348, 208, 556, -467, 28, 197, -128, -4, 45, -20, -2, // phase 72
+    4, -14, 1, 58, -95, -19, 262, -314, -138, 815, -778, -577, 2289, -1926, -2667, 13438, 20602, 4826, -4350, 951, 1331, -1349, 214, 552, -468, 30, 196, -128, -4, 45, -20, -2, // phase 73
+    4, -14, 1, 58, -95, -18, 261, -316, -135, 814, -785, -568, 2290, -1947, -2640, 13495, 20581, 4770, -4347, 967, 1320, -1350, 220, 549, -469, 32, 195, -129, -3, 45, -20, -2, // phase 74
+    4, -14, 1, 58, -96, -17, 261, -318, -131, 814, -791, -559, 2291, -1968, -2613, 13551, 20559, 4714, -4343, 982, 1310, -1351, 226, 545, -469, 34, 194, -129, -3, 45, -20, -2, // phase 75
+    4, -15, 1, 58, -96, -16, 260, -320, -128, 813, -798, -550, 2291, -1988, -2585, 13607, 20537, 4658, -4340, 998, 1299, -1352, 233, 542, -470, 37, 193, -129, -2, 45, -20, -2, // phase 76
+    4, -15, 2, 57, -97, -15, 260, -322, -124, 813, -804, -540, 2292, -2009, -2558, 13662, 20515, 4602, -4336, 1014, 1288, -1353, 239, 538, -471, 39, 191, -129, -1, 44, -20, -1, // phase 77
+    4, -15, 2, 57, -97, -14, 260, -324, -120, 812, -810, -531, 2292, -2029, -2530, 13718, 20492, 4546, -4333, 1029, 1277, -1353, 245, 534, -471, 41, 190, -130, -1, 44, -20, -1, // phase 78
+    4, -15, 2, 57, -98, -12, 259, -326, -117, 811, -816, -522, 2293, -2050, -2502, 13774, 20469, 4491, -4329, 1045, 1266, -1354, 250, 531, -472, 43, 189, -130, 0, 44, -20, -1, // phase 79
+    4, -15, 2, 57, -98, -11, 259, -328, -113, 811, -823, -512, 2293, -2070, -2473, 13829, 20446, 4435, -4325, 1060, 1256, -1354, 256, 527, -472, 45, 188, -130, 0, 44, -20, -1, // phase 80
+    4, -15, 3, 57, -99, -10, 259, -330, -109, 810, -829, -503, 2293, -2091, -2445, 13884, 20422, 4380, -4320, 1075, 1245, -1355, 262, 523, -473, 47, 187, -130, 1, 43, -20, -1, // phase 81
+    4, -15, 3, 57, -100, -9, 258, -332, -106, 809, -835, -493, 2293, -2111, -2416, 13940, 20398, 4324, -4316, 1090, 1234, -1355, 268, 520, -473, 50, 186, -131, 1, 43, -20, -1, // phase 82
+    4, -15, 3, 57, -100, -8, 258, -334, -102, 808, -841, -484, 2293, -2132, -2387, 13995, 20374, 4269, -4311, 1106, 1223, -1356, 274, 516, -474, 52, 185, -131, 2, 43, -20, -1, // phase 83
+    4, -15, 3, 57, -101, -7, 257, -336, -98, 808, -848, -474, 2293, -2152, -2358, 14050, 20350, 4214, -4306, 1121, 1212, -1356, 280, 512, -474, 54, 184, -131, 3, 43, -20, -1, // phase 84
+    4, -15, 4, 56, -101, -5, 257, -338, -95, 807, -854, -464, 2293, -2172, -2328, 14105, 20325, 4159, -4302, 1136, 1201, -1357, 286, 509, -475, 56, 183, -131, 3, 42, -20, -1, // phase 85
+    4, -15, 4, 56, -102, -4, 256, -340, -91, 806, -860, -455, 2292, -2193, -2299, 14160, 20301, 4104, -4296, 1151, 1190, -1357, 292, 505, -475, 58, 182, -132, 4, 42, -20, -1, // phase 86
+    4, -15, 4, 56, -102, -3, 256, -342, -87, 805, -866, -445, 2292, -2213, -2269, 14214, 20275, 4049, -4291, 1165, 1179, -1357, 297, 501, -476, 60, 180, -132, 4, 42, -20, -1, // phase 87
+    4, -16, 4, 56, -103, -2, 255, -344, -83, 804, -872, -435, 2291, -2233, -2239, 14269, 20250, 3994, -4286, 1180, 1168, -1357, 303, 497, -476, 62, 179, -132, 5, 42, -20, -1, // phase 88
+    4, -16, 5, 56, -103, -1, 255, -346, -80, 803, -878, -425, 2291, -2253, -2209, 14323, 20224, 3940, -4280, 1195, 1157, -1357, 309, 494, -477, 64, 178, -132, 5, 42, -21, -1, // phase 89
+    4, -16, 5, 56, -104, 1, 254, -348, -76, 802, -884, -416, 2290, -2273, -2178, 14378, 20198, 3885, -4274, 1209, 1145, -1357, 314, 490, -477, 66, 177, -132, 6, 41, -21, -1, // phase 90
+    4, -16, 5, 56, -104, 2, 254, -350, -72, 801, -890, -406, 2289, -2294, -2148, 14432, 20172, 3831, -4268, 1224, 1134, -1357, 320, 486, -477, 68, 176, -132, 6, 41, -21, -1, // phase 91
+    4, -16, 5, 55, -105, 3, 253, -352, -68, 800, -896, -396, 2288, -2314, -2117, 14486, 20146, 3777, -4262, 1238, 1123, -1357, 326, 482, -478, 70, 175, -133, 7, 41, -21, 0, // phase 92
+    4, -16, 5, 55, -105, 4, 253, -354, -64, 798, -902, -386, 2287, -2334, -2086, 14540, 20119, 3723, -4256, 1252, 1112, -1357, 331, 478, -478, 72, 173, -133, 7, 41, -21, 0, // phase 93
+    4, -16, 6, 55, -106, 5, 252, -356, -61, 797, -908, -376, 2286, -2354, -2054, 14594, 20092, 3669, -4250, 1266, 1101, -1357, 337, 475, -478, 75, 172, -133, 8, 40, -21, 0, // phase 94
+    4, -16, 6, 55, -106, 7, 251, -358, -57, 796, -914, -366, 2285, -2374, -2023, 14648, 20065, 3615, -4243, 1281, 1089, -1356, 343, 471, -479, 77, 171, -133, 9, 40, -21, 0, // phase 95
+    4, -16, 6, 55, -107, 8, 251, -360, -53, 795, -920, -356, 2283, -2393, -1991, 14701, 20037, 3561, -4236, 1295, 1078, -1356, 348, 467, -479, 79, 170, -133, 9, 40, -21, 0, // phase 96
+    4, -16, 6, 55, -107, 9, 250, -362, -49, 793, -926, -346, 2282, -2413, -1959, 14755, 20009, 3507, -4230, 1309, 1067, -1356, 354, 463, -479, 81, 169, -133, 10, 40, -21, 0, // phase 97
+    4, -16, 7, 54, -108, 10, 250, -364, -45, 792, -932, -336, 2281, -2433, -1927, 14808, 19981, 3454, -4223, 1322, 1056, -1355, 359, 459, -479, 83, 168, -133, 10, 39, -21, 0, // phase 98
+    4, -16, 7, 54, -108, 12, 249, -365, -41, 791, -937, -325, 2279, -2453, -1895, 14861, 19953, 3400, -4215, 1336, 1044, -1355, 365, 455, -479, 85, 166, -134, 11, 39, -21, 0, // phase 99
+    4, -16, 7, 54, -109, 13, 248, -367, -37, 789, -943, -315, 2277, -2472, -1862, 14914, 19924, 3347, -4208, 1350, 1033, -1354, 370, 451, -480, 87, 165, -134, 11, 39, -21, 0, // phase 100
+    4, -17, 7, 54, -109, 14, 248, -369, -34, 788, -949, -305, 2275, -2492, -1830, 14967, 19895, 3294, -4201, 1363, 1021, -1353, 375, 447, -480, 89, 164, -134, 12, 39, -21, 0, // phase 101
+    4, -17, 8, 54, -110, 15, 247, -371, -30, 786, -955, -295, 2273, -2512, -1797, 15020, 19866, 3241, -4193, 1377, 1010, -1353, 381, 444, -480, 91, 163, -134, 12, 38, -21, 0, // phase 102
+    4, -17, 8, 54, -110, 17, 246, -373, -26, 785, -960, -284, 2271, -2531, -1763, 15072, 19837, 3188, -4185, 1390, 999, -1352, 386, 440, -480, 93, 162, -134, 13, 38, -21, 0, // phase 103
+    4, -17, 8, 53, -111, 18, 246, -375, -22, 783, -966, -274, 2269, -2551, -1730, 15125, 19807, 3135, -4177, 1404, 987, -1351, 391, 436, -480, 94, 160, -134, 13, 38, -21, 0, // phase 104
+    4, -17, 8, 53, -111, 19, 245, -376, -18, 782, -972, -264, 2267, -2570, -1696, 15177, 19777, 3082, -4169, 1417, 976, -1350, 397, 432, -480, 96, 159, -134, 14, 38, -21, 0, // phase 105
+    4, -17, 9, 53, -111, 20, 244, -378, -14, 780, -977, -253, 2265, -2590, -1663, 15230, 19747, 3030, -4161, 1430, 964, -1350, 402, 428, -480, 98, 158, -134, 14, 37, -21, 0, // phase 106
+    4, -17, 9, 53, -112, 22, 243, -380, -10, 778, -983, -243, 2262, -2609, -1629, 15282, 19717, 2977, -4152, 1443, 953, -1349, 407, 424, -480, 100, 157, -134, 15, 37, -21, 0, // phase 107
+    4, -17, 9, 53, -112, 23, 243, -382, -6, 777, -988, -232, 2260, -2628, -1594, 15334, 19686, 2925, -4144, 1456, 941, -1348, 412, 420, -480, 102, 156, -134, 15, 37, -21, 0, // phase 108
+    4, -17, 9, 52, -113, 24, 242, -383, -2, 775, -994, -222, 2257, -2647, -1560, 15385, 19655, 2873, -4135, 1469, 930, -1347, 418, 416, -480, 104, 154, -134, 16, 36, -21, 1, // phase 109
+    4, -17, 10, 52, -113, 25, 241, -385, 2, 773, -999, -211, 2254, -2667, -1525, 15437, 19624, 2821, -4126, 1481, 918, -1345, 423, 412, -480, 106, 153, -135, 16, 36, -21, 1, // phase 110
+    4, -17, 10, 52, -114, 27, 240, -387, 6, 771, -1005, -201, 2252, -2686, -1491, 15488, 19593, 2769, -4117, 1494, 907, -1344, 428, 408, -480, 108, 152, -135, 17, 36, -21, 1, // phase 111
+    4, -17, 10, 52, -114, 28, 239, -389, 10, 769, -1010, -190, 2249, -2705, -1456, 15540, 19561, 2717, -4108, 1507, 895, -1343, 433, 404, -480, 110, 151, -135, 17, 36, -21, 1, // phase 112
+    4, -17, 10, 51, -115, 29, 239, -390, 14, 768, -1015, -179, 2246, -2724, -1420, 15591, 19529, 2666, -4099, 1519, 884, -1342, 438, 400, -480, 112, 149, -135, 18, 35, -21, 1, // phase 113
+    4, -18, 11, 51, -115, 30, 238, -392, 18, 766, -1021, -169, 2243, -2743, -1385, 15642, 19497, 2614, -4090, 1531, 872, -1340, 443, 396, -480, 113, 148, -135, 18, 35, -21, 1, // phase 114
+    4, -18, 11, 51, -115, 32, 237, -394, 22, 764, -1026, -158, 2239, -2762, -1349, 15693, 19465, 2563, -4080, 1544, 861, -1339, 448, 392, -479, 115, 147, -135, 19, 35, -21, 1, // phase 115
+    4, -18, 11, 51, -116, 33, 236, -395, 26, 762, -1031, -147, 2236, -2780, -1314, 15744, 19432, 2512, -4070, 1556, 849, -1338, 453, 388, -479, 117, 146, -135, 19, 35, -21, 1, // phase 116
+    4, -18, 12, 51, -116, 34, 235, -397, 30, 760, -1037, -137, 2233, -2799, -1278, 15794, 19399, 2461, -4060, 1568, 837, -1336, 458, 384, -479, 119, 145, -135, 20, 34, -21, 1, // phase 117
+    4, -18, 12, 50, -117, 35, 234, -399, 34, 758, -1042, -126, 2229, -2818, -1241, 15845, 19366, 2410, -4050, 1580, 826, -1335, 463, 380, -479, 121, 143, -135, 20, 34, -21, 1, // phase 118
+    4, -18, 12, 50, -117, 37, 234, -400, 38, 755, -1047, -115, 2225, -2836, -1205, 15895, 19332, 2359, -4040, 1592, 814, -1333, 468, 375, -479, 123, 142, -135, 21, 34, -21, 1, // phase 119
+    4, -18, 12, 50, -117, 38, 233, -402, 42, 753, -1052, -104, 2222, -2855, -1168, 15945, 19299, 2308, -4030, 1604, 803, -1331, 473, 371, -478, 124, 141, -135, 21, 34, -21, 1, // phase 120
+    4, -18, 13, 50, -118, 39, 232, -403, 46, 751, -1057, -93, 2218, -2873, -1131, 15995, 19265, 2258, -4020, 1616, 791, -1330, 478, 367, -478, 126, 139, -135, 22, 33, -21, 1, // phase 121
+    4, -18, 13, 49, -118, 41, 231, -405, 50, 749, -1063, -82, 2214, -2892, -1094, 16045, 19231, 2208, -4009, 1627, 779, -1328, 482, 363, -478, 128, 138, -135, 22, 33, -21, 1, // phase 122
+    4, -18, 13, 49, -119, 42, 230, -406, 54, 747, -1068, -72, 2210, -2910, -1057, 16094, 19196, 2157, -3999, 1639, 768, -1326, 487, 359, -478, 130, 137, -135, 23, 33, -21, 1, // phase 123
+    4, -18, 13, 49, -119, 43, 229, -408, 59, 744, -1073, -61, 2206, -2928, -1020, 16144, 19162, 2107, -3988, 1650, 756, -1324, 492, 355, -477, 132, 136, -135, 23, 33, -21, 1, // phase 124
+    4, -18, 14, 49, -119, 44, 228, -410, 63, 742, -1078, -50, 2201, -2946, -982, 16193, 19127, 2057, -3977, 1661, 744, -1322, 497, 351, -477, 133, 134, -135, 24, 32, -21, 1, // phase 125
+    4, -18, 14, 48, -120, 46, 227, -411, 67, 740, -1083, -39, 2197, -2965, -944, 16242, 19092, 2008, -3966, 1673, 733, -1320, 501, 347, -476, 135, 133, -135, 24, 32, -21, 1, // phase 126
+    4, -18, 14, 48, -120, 47, 226, -413, 71, 737, -1087, -28, 2193, -2983, -906, 16291, 19056, 1958, -3954, 1684, 721, -1318, 506, 343, -476, 137, 132, -135, 24, 32, -21, 1, // phase 127
+    4, -18, 14, 48, -121, 48, 225, -414, 75, 735, -1092, -17, 2188, -3001, -868, 16340, 19021, 1909, -3943, 1695, 709, -1316, 511, 339, -476, 139, 131, -134, 25, 31, -21, 2, // phase 128
+    4, -18, 15, 48, -121, 50, 224, -416, 79, 732, -1097, -6, 2183, -3019, -830, 16388, 18985, 1859, -3932, 1706, 698, -1314, 515, 334, -475, 140, 129, -134, 25, 31, -21, 2, // phase 129
+    4, -19, 15, 47, -121, 51, 223, -417, 83, 730, -1102, 6, 2179, -3036, -791, 16437, 18949, 1810, -3920, 1717, 686, -1312, 520, 330, -475, 142, 128, -134, 26, 31, -21, 2, // phase 130
+    4, -19, 15, 47, -122, 52, 222, -418, 87, 727, -1107, 17, 2174, -3054, -752, 16485, 18912, 1761, -3908, 1727, 674, -1310, 524, 326, -474, 144, 127, -134, 26, 31, -21, 2, // phase 131
+    4, -19, 15, 47, -122, 54, 221, -420, 91, 725, -1111, 28, 2169, -3072, -713, 16533, 18876, 1712, -3897, 1738, 662, -1308, 529, 322, -474, 145, 125, -134, 27, 30, -21, 2, // phase 132
+    4, -19, 16, 46, -122, 55, 220, -421, 96, 722, -1116, 39, 2164, -3089, -674, 16581, 18839, 1664, -3885, 1749, 651, -1305, 533, 318, -473, 147, 124, -134, 27, 30, -21, 2, // phase 133
+    4, -19, 16, 46, -123, 56, 219, -423, 100, 719, -1121, 50, 2159, -3107, -635, 16629, 18802, 1615, -3872, 1759, 639, -1303, 538, 314, -473, 149, 123, -134, 28, 30, -21, 2, // phase 134
+    4, -19, 16, 46, -123, 57, 218, -424, 104, 717, -1125, 61, 2153, -3124, -595, 16676, 18765, 1567, -3860, 1769, 627, -1300, 542, 309, -472, 150, 122, -134, 28, 30, -21, 2, // phase 135
+    4, -19, 17, 46, -123, 59, 217, -426, 108, 714, -1130, 73, 2148, -3142, -555, 16724, 18727, 1519, -3848, 1780, 616, -1298, 547, 305, -472, 152, 120, -134, 28, 29, -21, 2, // phase 136
+    4, -19, 17, 45, -124, 60, 215, -427, 112, 711, -1135, 84, 2142, -3159, -515, 16771, 18690, 1471, -3835, 1790, 604, -1295, 551, 301, -471, 154, 119, -134, 29, 29, -21, 2, // phase 137
+    4, -19, 17, 45, -124, 61, 214, -428, 116, 708, -1139, 95, 2137, -3176, -475, 16818, 18652, 1423, -3823, 1800, 592, -1293, 555, 297, -471, 155, 118, -134, 29, 29, -21, 2, // phase 138
+    3, -19, 17, 45, -124, 63, 213, -430, 121, 706, -1144, 106, 2131, -3193, -435, 16865, 18614, 1375, -3810, 1810, 581, -1290, 559, 293, -470, 157, 116, -134, 30, 29, -21, 2, // phase 139
+    3, -19, 18, 44, -125, 64, 212, -431, 125, 703, -1148, 118, 2125, -3210, -394, 16911, 18575, 1327, -3797, 1820, 569, -1288, 564, 289, -469, 158, 115, -133, 30, 28, -21, 2, // phase 140
+    3, -19, 18, 44, -125, 65, 211, -432, 129, 700, -1152, 129, 2119, -3227, -354, 16958, 18537, 1280, -3784, 1829, 557, -1285, 568, 284, -469, 160, 114, -133, 31, 28, -21, 2, // phase 141
+    3, -19, 18, 44, -125, 67, 210, -433, 133, 697, -1157, 140, 2113, -3244, -313, 17004, 18498, 1233, -3771, 1839, 545, -1282, 572, 280, -468, 162, 113, -133, 31, 28, -21, 2, // phase 142
+    3, -19, 18, 43, -126, 68, 209, -435, 137, 694, -1161, 152, 2107, -3261, -272, 17050, 18459, 1186, -3758, 1849, 534, -1279, 576, 276, -467, 163, 111, -133, 31, 27, -21, 2, // phase 143
+    3, -19, 19, 43, -126, 69, 207, -436, 141, 691, -1165, 163, 2101, -3277, -230, 17096, 18419, 1139, -3745, 1858, 522, -1276, 580, 272, -467, 165, 110, -133, 32, 27, -21, 2, // phase 144
+    3, -19, 19, 43, -126, 71, 206, -437, 146, 688, -1170, 174, 2095, -3294, -189, 17142, 18380, 1092, -3731, 1867, 510, -1274, 584, 268, -466, 166, 109, -133, 32, 27, -21, 2, // phase 145
+    3, -19, 19, 42, -127, 72, 205, -438, 150, 685, -1174, 186, 2088, -3310, -147, 17187, 18340, 1045, -3717, 1877, 499, -1271, 588, 263, -465, 168, 107, -133, 33, 27, -20, 2, // phase 146
+    3, -19, 20, 42, -127, 73, 204, -440, 154, 682, -1178, 197, 2082, -3327, -105, 17233, 18300, 999, -3704, 1886, 487, -1268, 592, 259, -464, 169, 106, -132, 33, 26, -20, 2, // phase 147
+    3, -20, 20, 42, -127, 74, 203, -441, 158, 679, -1182, 209, 2075, -3343, -63, 17278, 18260, 953, -3690, 1895, 475, -1265, 596, 255, -464, 171, 105, -132, 33, 26, -20, 2, // phase 148
+    3, -20, 20, 41, -127, 76, 201, -442, 162, 675, -1186, 220, 2069, -3359, -21, 17323, 18220, 907, -3676, 1904, 464, -1261, 600, 251, -463, 172, 103, -132, 34, 26, -20, 2, // phase 149
+    3, -20, 20, 41, -128, 77, 200, -443, 167, 672, -1190, 232, 2062, -3375, 21, 17367, 18179, 861, -3662, 1913, 452, -1258, 604, 247, -462, 174, 102, -132, 34, 26, -20, 3, // phase 150
+    3, -20, 21, 41, -128, 78, 199, -444, 171, 669, -1194, 243, 2055, -3391, 64, 17412, 18138, 815, -3648, 1922, 440, -1255, 608, 242, -461, 175, 101, -132, 35, 25, -20, 3, // phase 151
+    3, -20, 21, 40, -128, 80, 197, -445, 175, 666, -1198, 255, 2048, -3407, 107, 17456, 18097, 769, -3634, 1930, 428, -1252, 612, 238, -460, 177, 99, -132, 35, 25, -20, 3, // phase 152
+    3, -20, 21, 40, -128, 81, 196, -447, 179, 662, -1202, 266, 2041, -3423, 149, 17500, 18056, 724, -3619, 1939, 417, -1249, 616, 234, -459, 178, 98, -131, 35, 25, -20, 3, // phase 153
+    3, -20, 21, 40, -129, 82, 195, -448, 183, 659, -1206, 278, 2033, -3439, 193, 17544, 18014, 679, -3605, 1947, 405, -1245, 620, 230, -459, 180, 97, -131, 36, 24, -20, 3, // phase 154
+    3, -20, 22, 39, -129, 84, 194, -449, 188, 656, -1210, 289, 2026, -3454, 236, 17588, 17973, 634, -3590, 1956, 394, -1242, 623, 226, -458, 181, 96, -131, 36, 24, -20, 3, // phase 155
+    3, -20, 22, 39, -129, 85, 192, -450, 192, 652, -1213, 301, 2019, -3470, 279, 17632, 17931, 589, -3576, 1964, 382, -1239, 627, 221, -457, 183, 94, -131, 37, 24, -20, 3, // phase 156
+    3, -20, 22, 39, -129, 86, 191, -451, 196, 649, -1217, 312, 2011, -3485, 323, 17675, 17889, 544, -3561, 1972, 370, -1235, 631, 217, -456, 184, 93, -131, 37, 24, -20, 3, // phase 157
+    3, -20, 23, 38, -130, 88, 189, -452, 200, 645, -1221, 324, 2004, -3501, 367, 17718, 17846, 499, -3546, 1980, 359, -1232, 634, 213, -455, 185, 92, -130, 37, 23, -20, 3, // phase 158
+    3, -20, 23, 38, -130, 89, 188, -453, 204, 642, -1224, 335, 1996, -3516, 411, 17761, 17804, 455, -3531, 1988, 347, -1228, 638, 209, -454, 187, 90, -130, 38, 23, -20, 3, // phase 159
+    3, -20, 23, 38, -130, 90, 187, -454, 209, 638, -1228, 347, 1988, -3531, 455, 17804, 17761, 411, -3516, 1996, 335, -1224, 642, 204, -453, 188, 89, -130, 38, 23, -20, 3, // phase 160
+    3, -20, 23, 37, -130, 92, 185, -455, 213, 634, -1232, 359, 1980, -3546, 499, 17846, 17718, 367, -3501, 2004, 324, -1221, 645, 200, -452, 189, 88, -130, 38, 23, -20, 3, // phase 161
+    3, -20, 24, 37, -131, 93, 184, -456, 217, 631, -1235, 370, 1972, -3561, 544, 17889, 17675, 323, -3485, 2011, 312, -1217, 649, 196, -451, 191, 86, -129, 39, 22, -20, 3, // phase 162
+    3, -20, 24, 37, -131, 94, 183, -457, 221, 627, -1239, 382, 1964, -3576, 589, 17931, 17632, 279, -3470, 2019, 301, -1213, 652, 192, -450, 192, 85, -129, 39, 22, -20, 3, // phase 163
+    3, -20, 24, 36, -131, 96, 181, -458, 226, 623, -1242, 394, 1956, -3590, 634, 17973, 17588, 236, -3454, 2026, 289, -1210, 656, 188, -449, 194, 84, -129, 39, 22, -20, 3, // phase 164
+    3, -20, 24, 36, -131, 97, 180, -459, 230, 620, -1245, 405, 1947, -3605, 679, 18014, 17544, 193, -3439, 2033, 278, -1206, 659, 183, -448, 195, 82, -129, 40, 21, -20, 3, // phase 165
+    3, -20, 25, 35, -131, 98, 178, -459, 234, 616, -1249, 417, 1939, -3619, 724, 18056, 17500, 149, -3423, 2041, 266, -1202, 662, 179, -447, 196, 81, -128, 40, 21, -20, 3, // phase 166
+    3, -20, 25, 35, -132, 99, 177, -460, 238, 612, -1252, 428, 1930, -3634, 769, 18097, 17456, 107, -3407, 2048, 255, -1198, 666, 175, -445, 197, 80, -128, 40, 21, -20, 3, // phase 167
+    3, -20, 25, 35, -132, 101, 175, -461, 242, 608, -1255, 440, 1922, -3648, 815, 18138, 17412, 64, -3391, 2055, 243, -1194, 669, 171, -444, 199, 78, -128, 41, 21, -20, 3, // phase 168
+    3, -20, 26, 34, -132, 102, 174, -462, 247, 604, -1258, 452, 1913, -3662, 861, 18179, 17367, 21, -3375, 2062, 232, -1190, 672, 167, -443, 200, 77, -128, 41, 20, -20, 3, // phase 169
+    2, -20, 26, 34, -132, 103, 172, -463, 251, 600, -1261, 464, 1904, -3676, 907, 18220, 17323, -21, -3359, 2069, 220, -1186, 675, 162, -442, 201, 76, -127, 41, 20, -20, 3, // phase 170
+    2, -20, 26, 33, -132, 105, 171, -464, 255, 596, -1265, 475, 1895, -3690, 953, 18260, 17278, -63, -3343, 2075, 209, -1182, 679, 158, -441, 203, 74, -127, 42, 20, -20, 3, // phase 171
+    2, -20, 26, 33, -132, 106, 169, -464, 259, 592, -1268, 487, 1886, -3704, 999, 18300, 17233, -105, -3327, 2082, 197, -1178, 682, 154, -440, 204, 73, -127, 42, 20, -19, 3, // phase 172
+    2, -20, 27, 33, -133, 107, 168, -465, 263, 588, -1271, 499, 1877, -3717, 1045, 18340, 17187, -147, -3310, 2088, 186, -1174, 685, 150, -438, 205, 72, -127, 42, 19, -19, 3, // phase 173
+    2, -21, 27, 32, -133, 109, 166, -466, 268, 584, -1274, 510, 1867, -3731, 1092, 18380, 17142, -189, -3294, 2095, 174, -1170, 688, 146, -437, 206, 71, -126, 43, 19, -19, 3, // phase 174
+    2, -21, 27, 32, -133, 110, 165, -467, 272, 580, -1276, 522, 1858, -3745, 1139, 18419, 17096, -230, -3277, 2101, 163, -1165, 691, 141, -436, 207, 69, -126, 43, 19, -19, 3, // phase 175
+    2, -21, 27, 31, -133, 111, 163, -467, 276, 576, -1279, 534, 1849, -3758, 1186, 18459, 17050, -272, -3261, 2107, 152, -1161, 694, 137, -435, 209, 68, -126, 43, 18, -19, 3, // phase 176
+    2, -21, 28, 31, -133, 113, 162, -468, 280, 572, -1282, 545, 1839, -3771, 1233, 18498, 17004, -313, -3244, 2113, 140, -1157, 697, 133, -433, 210, 67, -125, 44, 18, -19, 3, // phase 177
+    2, -21, 28, 31, -133, 114, 160, -469, 284, 568, -1285, 557, 1829, -3784, 1280, 18537, 16958, -354, -3227, 2119, 129, -1152, 700, 129, -432, 211, 65, -125, 44, 18, -19, 3, // phase 178
+    2, -21, 28, 30, -133, 115, 158, -469, 289, 564, -1288, 569, 1820, -3797, 1327, 18575, 16911, -394, -3210, 2125, 118, -1148, 703, 125, -431, 212, 64, -125, 44, 18, -19, 3, // phase 179
+    2, -21, 29, 30, -134, 116, 157, -470, 293, 559, -1290, 581, 1810, -3810, 1375, 18614, 16865, -435, -3193, 2131, 106, -1144, 706, 121, -430, 213, 63, -124, 45, 17, -19, 3, // phase 180
+    2, -21, 29, 29, -134, 118, 155, -471, 297, 555, -1293, 592, 1800, -3823, 1423, 18652, 16818, -475, -3176, 2137, 95, -1139, 708, 116, -428, 214, 61, -124, 45, 17, -19, 4, // phase 181
+    2, -21, 29, 29, -134, 119, 154, -471, 301, 551, -1295, 604, 1790, -3835, 1471, 18690, 16771, -515, -3159, 2142, 84, -1135, 711, 112, -427, 215, 60, -124, 45, 17, -19, 4, // phase 182
+    2, -21, 29, 28, -134, 120, 152, -472, 305, 547, -1298, 616, 1780, -3848, 1519, 18727, 16724, -555, -3142, 2148, 73, -1130, 714, 108, -426, 217, 59, -123, 46, 17, -19, 4, // phase 183
+    2, -21, 30, 28, -134, 122, 150, -472, 309, 542, -1300, 627, 1769, -3860, 1567, 18765, 16676, -595, -3124, 2153, 61, -1125, 717, 104, -424, 218, 57, -123, 46, 16, -19, 4, // phase 184
+    2, -21, 30, 28, -134, 123, 149, -473, 314, 538, -1303, 639, 1759, -3872, 1615, 18802, 16629, -635, -3107, 2159, 50, -1121, 719, 100, -423, 219, 56, -123, 46, 16, -19, 4, // phase 185
+    2, -21, 30, 27, -134, 124, 147, -473, 318, 533, -1305, 651, 1749, -3885, 1664, 18839, 16581, -674, -3089, 2164, 39, -1116, 722, 96, -421, 220, 55, -122, 46, 16, -19, 4, // phase 186
+    2, -21, 30, 27, -134, 125, 145, -474, 322, 529, -1308, 662, 1738, -3897, 1712, 18876, 16533, -713, -3072, 2169, 28, -1111, 725, 91, -420, 221, 54, -122, 47, 15, -19, 4, // phase 187
+    2, -21, 31, 26, -134, 127, 144, -474, 326, 524, -1310, 674, 1727, -3908, 1761, 18912, 16485, -752, -3054, 2174, 17, -1107, 727, 87, -418, 222, 52, -122, 47, 15, -19, 4, // phase 188
+    2, -21, 31, 26, -134, 128, 142, -475, 330, 520, -1312, 686, 1717, -3920, 1810, 18949, 16437, -791, -3036, 2179, 6, -1102, 730, 83, -417, 223, 51, -121, 47, 15, -19, 4, // phase 189
+    2, -21, 31, 25, -134, 129, 140, -475, 334, 515, -1314, 698, 1706, -3932, 1859, 18985, 16388, -830, -3019, 2183, -6, -1097, 732, 79, -416, 224, 50, -121, 48, 15, -18, 4, // phase 190
+    2, -21, 31, 25, -134, 131, 139, -476, 339, 511, -1316, 709, 1695, -3943, 1909, 19021, 16340, -868, -3001, 2188, -17, -1092, 735, 75, -414, 225, 48, -121, 48, 14, -18, 4, // phase 191
+    1, -21, 32, 24, -135, 132, 137, -476, 343, 506, -1318, 721, 1684, -3954, 1958, 19056, 16291, -906, -2983, 2193, -28, -1087, 737, 71, -413, 226, 47, -120, 48, 14, -18, 4, // phase 192
+    1, -21, 32, 24, -135, 133, 135, -476, 347, 501, -1320, 733, 1673, -3966, 2008, 19092, 16242, -944, -2965, 2197, -39, -1083, 740, 67, -411, 227, 46, -120, 48, 14, -18, 4, // phase 193
+    1, -21, 32, 24, -135, 134, 133, -477, 351, 497, -1322, 744, 1661, -3977, 2057, 19127, 16193, -982, -2946, 2201, -50, -1078, 742, 63, -410, 228, 44, -119, 49, 14, -18, 4, // phase 194
+    1, -21, 33, 23, -135, 136, 132, -477, 355, 492, -1324, 756, 1650, -3988, 2107, 19162, 16144, -1020, -2928, 2206, -61, -1073, 744, 59, -408, 229, 43, -119, 49, 13, -18, 4, // phase 195
+    1, -21, 33, 23, -135, 137, 130, -478, 359, 487, -1326, 768, 1639, -3999, 2157, 19196, 16094, -1057, -2910, 2210, -72, -1068, 747, 54, -406, 230, 42, -119, 49, 13, -18, 4, // phase 196
+    1, -21, 33, 22, -135, 138, 128, -478, 363, 482, -1328, 779, 1627, -4009, 2208, 19231, 16045, -1094, -2892, 2214, -82, -1063, 749, 50, -405, 231, 41, -118, 49, 13, -18, 4, // phase 197
+    1, -21, 33, 22, -135, 139, 126, -478, 367, 478, -1330, 791, 1616, -4020, 2258, 19265, 15995, -1131, -2873, 2218, -93, -1057, 751, 46, -403, 232, 39, -118, 50, 13, -18, 4, // phase 198
+    1, -21, 34, 21, -135, 141, 124, -478, 371, 473, -1331, 803, 1604, -4030, 2308, 19299, 15945, -1168, -2855, 2222, -104, -1052, 753, 42, -402, 233, 38, -117, 50, 12, -18, 4, // phase 199
+    1, -21, 34, 21, -135, 142, 123, -479, 375, 468, -1333, 814, 1592, -4040, 2359, 19332, 15895, -1205, -2836, 2225, -115, -1047, 755, 38, -400, 234, 37, -117, 50, 12, -18, 4, // phase 200
+    1, -21, 34, 20, -135, 143, 121, -479, 380, 463, -1335, 826, 1580, -4050, 2410, 19366, 15845, -1241, -2818, 2229, -126, -1042, 758, 34, -399, 234, 35, -117, 50, 12, -18, 4, // phase 201
+    1, -21, 34, 20, -135, 145, 119, -479, 384, 458, -1336, 837, 1568, -4060, 2461, 19399, 15794, -1278, -2799, 2233, -137, -1037, 760, 30, -397, 235, 34, -116, 51, 12, -18, 4, // phase 202
+    1, -21, 35, 19, -135, 146, 117, -479, 388, 453, -1338, 849, 1556, -4070, 2512, 19432, 15744, -1314, -2780, 2236, -147, -1031, 762, 26, -395, 236, 33, -116, 51, 11, -18, 4, // phase 203
+    1, -21, 35, 19, -135, 147, 115, -479, 392, 448, -1339, 861, 1544, -4080, 2563, 19465, 15693, -1349, -2762, 2239, -158, -1026, 764, 22, -394, 237, 32, -115, 51, 11, -18, 4, // phase 204
+    1, -21, 35, 18, -135, 148, 113, -480, 396, 443, -1340, 872, 1531, -4090, 2614, 19497, 15642, -1385, -2743, 2243, -169, -1021, 766, 18, -392, 238, 30, -115, 51, 11, -18, 4, // phase 205
+    1, -21, 35, 18, -135, 149, 112, -480, 400, 438, -1342, 884, 1519, -4099, 2666, 19529, 15591, -1420, -2724, 2246, -179, -1015, 768, 14, -390, 239, 29, -115, 51, 10, -17, 4, // phase 206
+    1, -21, 36, 17, -135, 151, 110, -480, 404, 433, -1343, 895, 1507, -4108, 2717, 19561, 15540, -1456, -2705, 2249, -190, -1010, 769, 10, -389, 239, 28, -114, 52, 10, -17, 4, // phase 207
+    1, -21, 36, 17, -135, 152, 108, -480, 408, 428, -1344, 907, 1494, -4117, 2769, 19593, 15488, -1491, -2686, 2252, -201, -1005, 771, 6, -387, 240, 27, -114, 52, 10, -17, 4, // phase 208
+    1, -21, 36, 16, -135, 153, 106, -480, 412, 423, -1345, 918, 1481, -4126, 2821, 19624, 15437, -1525, -2667, 2254, -211, -999, 773, 2, -385, 241, 25, -113, 52, 10, -17, 4, // phase 209
+    1, -21, 36, 16, -134, 154, 104, -480, 416, 418, -1347, 930, 1469, -4135, 2873, 19655, 15385, -1560, -2647, 2257, -222, -994, 775, -2, -383, 242, 24, -113, 52, 9, -17, 4, // phase 210
+    0, -21, 37, 15, -134, 156, 102, -480, 420, 412, -1348, 941, 1456, -4144, 2925, 19686, 15334, -1594, -2628, 2260, -232, -988, 777, -6, -382, 243, 23, -112, 53, 9, -17, 4, // phase 211
+    0, -21, 37, 15, -134, 157, 100, -480, 424, 407, -1349, 953, 1443, -4152, 2977, 19717, 15282, -1629, -2609, 2262, -243, -983, 778, -10, -380, 243, 22, -112, 53, 9, -17, 4, // phase 212
+    0, -21, 37, 14, -134, 158, 98, -480, 428, 402, -1350, 964, 1430, -4161, 3030, 19747, 15230, -1663, -2590, 2265, -253, -977, 780, -14, -378, 244, 20, -111, 53, 9, -17, 4, // phase 213
+    0, -21, 38, 14, -134, 159, 96, -480, 432, 397, -1350, 976, 1417, -4169, 3082, 19777, 15177, -1696, -2570, 2267, -264, -972, 782, -18, -376, 245, 19, -111, 53, 8, -17, 4, // phase 214
+    0, -21, 38, 13, -134, 160, 94, -480, 436, 391, -1351, 987, 1404, -4177, 3135, 19807, 15125, -1730, -2551, 2269, -274, -966, 783, -22, -375, 246, 18, -111, 53, 8, -17, 4, // phase 215
+    0, -21, 38, 13, -134, 162, 93, -480, 440, 386, -1352, 999, 1390, -4185, 3188, 19837, 15072, -1763, -2531, 2271, -284, -960, 785, -26, -373, 246, 17, -110, 54, 8, -17, 4, // phase 216
+    0, -21, 38, 12, -134, 163, 91, -480, 444, 381, -1353, 1010, 1377, -4193, 3241, 19866, 15020, -1797, -2512, 2273, -295, -955, 786, -30, -371, 247, 15, -110, 54, 8, -17, 4, // phase 217
+    0, -21, 39, 12, -134, 164, 89, -480, 447, 375, -1353, 1021, 1363, -4201, 3294, 19895, 14967, -1830, -2492, 2275, -305, -949, 788, -34, -369, 248, 14, -109, 54, 7, -17, 4, // phase 218
+    0, -21, 39, 11, -134, 165, 87, -480, 451, 370, -1354, 1033, 1350, -4208, 3347, 19924, 14914, -1862, -2472, 2277, -315, -943, 789, -37, -367, 248, 13, -109, 54, 7, -16, 4, // phase 219
+    0, -21, 39, 11, -134, 166, 85, -479, 455, 365, -1355, 1044, 1336, -4215, 3400, 19953, 14861, -1895, -2453, 2279, -325, -937, 791, -41, -365, 249, 12, -108, 54, 7, -16, 4, // phase 220
+    0, -21, 39, 10, -133, 168, 83, -479, 459, 359, -1355, 1056, 1322, -4223, 3454, 19981, 14808, -1927, -2433, 2281, -336, -932, 792, -45, -364, 250, 10, -108, 54, 7, -16, 4, // phase 221
+    0, -21, 40, 10, -133, 169, 81, -479, 463, 354, -1356, 1067, 1309, -4230, 3507, 20009, 14755, -1959, -2413, 2282, -346, -926, 793, -49, -362, 250, 9, -107, 55, 6, -16, 4, // phase 222
+    0, -21, 40, 9, -133, 170, 79, -479, 467, 348, -1356, 1078, 1295, -4236, 3561, 20037, 14701, -1991, -2393, 2283, -356, -920, 795, -53, -360, 251, 8, -107, 55, 6, -16, 4, // phase 223
+    0, -21, 40, 9, -133, 171, 77, -479, 471, 343, -1356, 1089, 1281, -4243, 3615, 20065, 14648, -2023, -2374, 2285, -366, -914, 796, -57, -358, 251, 7, -106, 55, 6, -16, 4, // phase 224
+    0, -21, 40, 8, -133, 172, 75, -478, 475, 337, -1357, 1101, 1266, -4250, 3669, 20092, 14594, -2054, -2354, 2286, -376, -908, 797, -61, -356, 252, 5, -106, 55, 6, -16, 4, // phase 225
+    0, -21, 41, 7, -133, 173, 72, -478, 478, 331, -1357, 1112, 1252, -4256, 3723, 20119, 14540, -2086, -2334, 2287, -386, -902, 798, -64, -354, 253, 4, -105, 55, 5, -16, 4, // phase 226
+    0, -21, 41, 7, -133, 175, 70, -478, 482, 326, -1357, 1123, 1238, -4262, 3777, 20146, 14486, -2117, -2314, 2288, -396, -896, 800, -68, -352, 253, 3, -105, 55, 5, -16, 4, // phase 227
+    -1, -21, 41, 6, -132, 176, 68, -477, 486, 320, -1357, 1134, 1224, -4268, 3831, 20172, 14432, -2148, -2294, 2289, -406, -890, 801, -72, -350, 254, 2, -104, 56, 5, -16, 4, // phase 228
+    -1, -21, 41, 6, -132, 177, 66, -477, 490, 314, -1357, 1145, 1209, -4274, 3885, 20198, 14378, -2178, -2273, 2290, -416, -884, 802, -76, -348, 254, 1, -104, 56, 5, -16, 4, // phase 229
+    -1, -21, 42, 5, -132, 178, 64, -477, 494, 309, -1357, 1157, 1195, -4280, 3940, 20224, 14323, -2209, -2253, 2291, -425, -878, 803, -80, -346, 255, -1, -103, 56, 5, -16, 4, // phase 230
+    -1, -20, 42, 5, -132, 179, 62, -476, 497, 303, -1357, 1168, 1180, -4286, 3994, 20250, 14269, -2239, -2233, 2291, -435, -872, 804, -83, -344, 255, -2, -103, 56, 4, -16, 4, // phase 231
+    -1, -20, 42, 4, -132, 180, 60, -476, 501, 297, -1357, 1179, 1165, -4291, 4049, 20275, 14214, -2269, -2213, 2292, -445, -866, 805, -87, -342, 256, -3, -102, 56, 4, -15, 4, // phase 232
+    -1, -20, 42, 4, -132, 182, 58, -475, 505, 292, -1357, 1190, 1151, -4296, 4104, 20301, 14160, -2299, -2193, 2292, -455, -860, 806, -91, -340, 256, -4, -102, 56, 4, -15, 4, // phase 233
+    -1, -20, 42, 3, -131, 183, 56, -475, 509, 286, -1357, 1201, 1136, -4302, 4159, 20325, 14105, -2328, -2172, 2293, -464, -854, 807, -95, -338, 257, -5, -101, 56, 4, -15, 4, // phase 234
+    -1, -20, 43, 3, -131, 184, 54, -474, 512, 280, -1356, 1212, 1121, -4306, 4214, 20350, 14050, -2358, -2152, 2293, -474, -848, 808, -98, -336, 257, -7, -101, 57, 3, -15, 4, // phase 235
+    -1, -20, 43, 2, -131, 185, 52, -474, 516, 274, -1356, 1223, 1106, -4311, 4269, 20374, 13995, -2387, -2132, 2293, -484, -841, 808, -102, -334, 258, -8, -100, 57, 3, -15, 4, // phase 236
+    -1, -20, 43, 1, -131, 186, 50, -473, 520, 268, -1355, 1234, 1090, -4316, 4324, 20398, 13940, -2416, -2111, 2293, -493, -835, 809, -106, -332, 258, -9, -100, 57, 3, -15, 4, // phase 237
+    -1, -20, 43, 1, -130, 187, 47, -473, 523, 262, -1355, 1245, 1075, -4320, 4380, 20422, 13884, -2445, -2091, 2293, -503, -829, 810, -109, -330, 259, -10, -99, 57, 3, -15, 4, // phase 238
+    -1, -20, 44, 0, -130, 188, 45, -472, 527, 256, -1354, 1256, 1060, -4325, 4435, 20446, 13829, -2473, -2070, 2293, -512, -823, 811, -113, -328, 259, -11, -98, 57, 2, -15, 4, // phase 239
+    -1, -20, 44, 0, -130, 189, 43, -472, 531, 250, -1354, 1266, 1045, -4329, 4491, 20469, 13774, -2502, -2050, 2293, -522, -816, 811, -117, -326, 259, -12, -98, 57, 2, -15, 4, // phase 240
+    -1, -20, 44, -1, -130, 190, 41, -471, 534, 245, -1353, 1277, 1029, -4333, 4546, 20492, 13718, -2530, -2029, 2292, -531, -810, 812, -120, -324, 260, -14, -97, 57, 2, -15, 4, // phase 241
+    -1, -20, 44, -1, -129, 191, 39, -471, 538, 239, -1353, 1288, 1014, -4336, 4602, 20515, 13662, -2558, -2009, 2292, -540, -804, 813, -124, -322, 260, -15, -97, 57, 2, -15, 4, // phase 242
+    -2, -20, 45, -2, -129, 193, 37, -470, 542, 233, -1352, 1299, 998, -4340, 4658, 20537, 13607, -2585, -1988, 2291, -550, -798, 813, -128, -320, 260, -16, -96, 58, 1, -15, 4, // phase 243
+    -2, -20, 45, -3, -129, 194, 34, -469, 545, 226, -1351, 1310, 982, -4343, 4714, 20559, 13551, -2613, -1968, 2291, -559, -791, 814, -131, -318, 261, -17, -96, 58, 1, -14, 4, // phase 244
+    -2, -20, 45, -3, -129, 195, 32, -469, 549, 220, -1350, 1320, 967, -4347, 4770, 20581, 13495, -2640, -1947, 2290, -568, -785, 814, -135, -316, 261, -18, -95, 58, 1, -14, 4, // phase 245
+    -2, -20, 45, -4, -128, 196, 30, -468, 552, 214, -1349, 1331, 951, -4350, 4826, 20602, 13438, -2667, -1926, 2289, -577, -778, 815, -138, -314, 262, -19, -95, 58, 1, -14, 4, // phase 246
+    -2, -20, 45, -4, -128, 197, 28, -467, 556, 208, -1348, 1342, 935, -4353, 4882, 20624, 13382, -2694, -1906, 2288, -587, -772, 815, -142, -312, 262, -20, -94, 58, 1, -14, 4, // phase 247
+    -2, -20, 46, -5, -128, 198, 26, -466, 559, 202, -1347, 1352, 919, -4355, 4939, 20645, 13326, -2721, -1885, 2287, -596, -766, 816, -145, -309, 262, -22, -94, 58, 0, -14, 4, // phase 248
+    -2, -20, 46, -5, -128, 199, 24, -466, 563, 196, -1346, 1363, 903, -4358, 4995, 20666, 13270, -2747, -1864, 2286, -605, -759, 816, -149, -307, 262, -23, -93, 58, 0, -14, 4, // phase 249
+    -2, -20, 46, -6, -127, 200, 21, -465, 566, 190, -1345, 1373, 886, -4360, 5052, 20686, 13213, -2773, -1843, 2285, -614, -753, 816, -153, -305, 263, -24, -92, 58, 0, -14, 4, // phase 250
+    -2, -20, 46, -7, -127, 201, 19, -464, 570, 184, -1344, 1384, 870, -4363, 5108, 20706, 13156, -2799, -1823, 2284, -623, -746, 817, -156, -303, 263, -25, -92, 58, 0, -14, 4, // phase 251
+    -2, -20, 47, -7, -127, 202, 17, -463, 573, 178, -1342, 1394, 854, -4365, 5165, 20726, 13100, -2825, -1802, 2283, -632, -740, 817, -160, -301, 263, -26, -91, 58, -1, -14, 4, // phase 252
+    -2, -19, 47, -8, -126, 203, 15, -462, 577, 171, -1341, 1405, 837, -4367, 5222, 20746, 13043, -2850, -1781, 2281, -640, -733, 817, -163, -299, 264, -27, -91, 58, -1, -14, 4, // phase 253
+    -2, -19, 47, -8, -126, 204, 12, -461, 580, 165, -1340, 1415, 821, -4368, 5279, 20765, 12986, -2876, -1760, 2280, -649, -727, 817, -166, -297, 264, -28, -90, 59, -1, -14, 4, // phase 254
+    -2, -19, 47, -9, -126, 205, 10, -460, 584, 159, -1338, 1425, 804, -4370, 5336, 20784, 12929, -2901, -1739, 2278, -658, -720, 818, -170, -294, 264, -29, -90, 59, -1, -14, 4, // phase 255
+    -2, -19, 47, -10, -125, 206, 8, -460, 587, 153, -1337, 1436, 788, -4371, 5393, 20803, 12872, -2926, -1718, 2276, -667, -713, 818, -173, -292, 264, -31, -89, 59, -1, -13, 4, // phase 256
+    -3, -19, 48, -10, -125, 207, 6, -459, 590, 146, -1335, 1446, 771, -4372, 5450, 20821, 12815, -2950, -1698, 2274, -676, -707, 818, -177, -290, 264, -32, -88, 59, -2, -13, 4, // phase 257
+    -3, -19, 48, -11, -125, 208, 3, -458, 594, 140, -1333, 1456, 754, -4373, 5507, 20840, 12758, -2975, -1677, 2272, -684, -700, 818, -180, -288, 265, -33, -88, 59, -2, -13, 4, // phase 258
+    -3, -19, 48, -11, -124, 209, 1, -457, 597, 134, -1332, 1467, 737, -4374, 5564, 20857, 12700, -2999, -1656, 2270, -693, -694, 818, -184, -286, 265, -34, -87, 59, -2, -13, 4, // phase 259
+    -3, -19, 48, -12, -124, 210, -1, -456, 600, 127, -1330, 1477, 721, -4375, 5622, 20875, 12643, -3023, -1635, 2268, -701, -687, 818, -187, -283, 265, -35, -87, 59, -2, -13, 4, // phase 260
+    -3, -19, 49, -13, -123, 211, -3, -455, 604, 121, -1328, 1487, 704, -4375, 5679, 20892, 12586, -3047, -1614, 2266, -710, -680, 818, -190, -281, 265, -36, -86, 59, -2, -13, 4, // phase 261
+    -3, -19, 49, -13, -123, 212, -6, -454, 607, 114, -1326, 1497, 686, -4375, 5737, 20910, 12528, -3071, -1593, 2264, -718, -674, 818, -194, -279, 265, -37, -86, 59, -3, -13, 4, // phase 262
+    -3, -19, 49, -14, -123, 213, -8, -452, 610, 108, -1324, 1507, 669, -4375, 5794, 20926, 12470, -3094, -1572, 2261, -727, -667, 818, -197, -277, 265, -38, -85, 59, -3, -13, 4, // phase 263
+    -3, -19, 49, -14, -122, 214, -10, -451, 613, 102, -1322, 1517, 652, -4375, 5852, 20943, 12413, -3117, -1551, 2259, -735, -660, 818, -200, -274, 265, -39, -84, 59, -3, -13, 4, // phase 264
+    -3, -19, 49, -15, -122, 215, -13, -450, 617, 95, -1320, 1527, 635, -4375, 5910, 20959, 12355, -3140, -1530, 2256, -743, -654, 817, -204, -272, 266, -40, -84, 59, -3, -13, 4, // phase 265
+    -3, -19, 50, -16, -121, 216, -15, -449, 620, 89, -1318, 1537, 618, -4374, 5967, 20975, 12297, -3163, -1509, 2254, -752, -647, 817, -207, -270, 266, -41, -83, 59, -4, -13, 4, // phase 266
+    -3, -19, 50, -16, -121, 217, -17, -448, 623, 82, -1316, 1547, 600, -4374, 6025, 20991, 12239, -3185, -1488, 2251, -760, -640, 817, -210, -268, 266, -42, -83, 59, -4, -12, 4, // phase 267
+    -3, -18, 50, -17, -121, 218, -19, -447, 626, 76, -1314, 1557, 583, -4373, 6083, 21006, 12181, -3208, -1467, 2248, -768, -633, 817, -213, -265, 266, -43, -82, 59, -4, -12, 4, // phase 268
+    -3, -18, 50, -17, -120, 219, -22, -446, 629, 69, -1311, 1566, 565, -4372, 6141, 21021, 12123, -3230, -1446, 2245, -776, -627, 816, -217, -263, 266, -44, -81, 59, -4, -12, 4, // phase 269
+    -4, -18, 50, -18, -120, 219, -24, -444, 632, 63, -1309, 1576, 547, -4371, 6199, 21036, 12065, -3252, -1425, 2242, -784, -620, 816, -220, -261, 266, -45, -81, 59, -4, -12, 4, // phase 270
+    -4, -18, 50, -19, -119, 220, -26, -443, 635, 56, -1307, 1586, 530, -4369, 6257, 21050, 12007, -3273, -1404, 2239, -792, -613, 816, -223, -258, 266, -47, -80, 59, -5, -12, 4, // phase 271
+    -4, -18, 51, -19, -119, 221, -29, -442, 639, 50, -1304, 1595, 512, -4368, 6316, 21064, 11948, -3295, -1383, 2236, -800, -606, 815, -226, -256, 266, -48, -80, 59, -5, -12, 4, // phase 272
+    -4, -18, 51, -20, -118, 222, -31, -441, 642, 43, -1302, 1605, 494, -4366, 6374, 21078, 11890, -3316, -1362, 2233, -808, -599, 815, -229, -254, 266, -49, -79, 59, -5, -12, 4, // phase 273
+    -4, -18, 51, -21, -118, 223, -33, -439, 645, 37, -1299, 1615, 476, -4364, 6432, 21092, 11832, -3337, -1341, 2230, -816, -593, 814, -233, -252, 266, -50, -78, 59, -5, -12, 4, // phase 274
+    -4, -18, 51, -21, -117, 224, -36, -438, 648, 30, -1296, 1624, 458, -4362, 6491, 21105, 11773, -3358, -1320, 2226, -824, -586, 814, -236, -249, 266, -51, -78, 60, -5, -12, 4, // phase 275
+    -4, -18, 51, -22, -117, 225, -38, -436, 651, 23, -1294, 1634, 440, -4359, 6549, 21118, 11715, -3378, -1299, 2223, -831, -579, 813, -239, -247, 266, -52, -77, 60, -6, -12, 4, // phase 276
+    -4, -18, 52, -22, -116, 226, -41, -435, 654, 17, -1291, 1643, 422, -4357, 6608, 21131, 11656, -3399, -1278, 2219, -839, -572, 813, -242, -245, 266, -53, -77, 60, -6, -12, 4, // phase 277
+    -4, -18, 52, -23, -116, 226, -43, -434, 657, 10, -1288, 1652, 404, -4354, 6666, 21143, 11597, -3419, -1257, 2215, -847, -565, 812, -245, -242, 266, -54, -76, 60, -6, -11, 4, // phase 278
+    -4, -18, 52, -24, -115, 227, -45, -432, 660, 3, -1285, 1662, 386, -4351, 6725, 21156, 11539, -3439, -1236, 2212, -854, -558, 811, -248, -240, 266, -55, -75, 60, -6, -11, 4, // phase 279
+    -4, -17, 52, -24, -115, 228, -48, -431, 662, -3, -1282, 1671, 368, -4348, 6784, 21167, 11480, -3458, -1215, 2208, -862, -551, 811, -251, -238, 266, -56, -75, 60, -6, -11, 4, // phase 280
+    -4, -17, 52, -25, -114, 229, -50, -429, 665, -10, -1279, 1680, 349, -4345, 6842, 21179, 11421, -3478, -1194, 2204, -870, -544, 810, -254, -235, 266, -57, -74, 60, -6, -11, 4, // phase 281
+    -4, -17, 52, -26, -114, 230, -52, -428, 668, -17, -1276, 1689, 331, -4341, 6901, 21190, 11362, -3497, -1173, 2200, -877, -538, 809, -257, -233, 266, -58, -73, 60, -7, -11, 4, // phase 282
+    -5, -17, 53, -26, -113, 231, -55, -426, 671, -23, -1273, 1699, 312, -4337, 6960, 21201, 11303, -3516, -1152, 2196, -884, -531, 808, -260, -231, 266, -58, -73, 60, -7, -11, 4, // phase 283
+    -5, -17, 53, -27, -113, 231, -57, -425, 674, -30, -1270, 1708, 294, -4333, 7019, 21212, 11245, -3535, -1131, 2192, -892, -524, 807, -263, -228, 265, -59, -72, 60, -7, -11, 4, // phase 284
+    -5, -17, 53, -27, -112, 232, -59, -423, 677, -37, -1266, 1717, 275, -4329, 7078, 21222, 11186, -3554, -1110, 2187, -899, -517, 807, -266, -226, 265, -60, -72, 60, -7, -11, 4, // phase 285
+    -5, -17, 53, -28, -112, 233, -62, -422, 679, -44, -1263, 1726, 257, -4325, 7137, 21232, 11126, -3572, -1089, 2183, -906, -510, 806, -269, -224, 265, -61, -71, 60, -7, -11, 4, // phase 286
+    -5, -17, 53, -29, -111, 234, -64, -420, 682, -50, -1260, 1735, 238, -4321, 7196, 21242, 11067, -3590, -1068, 2179, -913, -503, 805, -272, -221, 265, -62, -70, 59, -8, -11, 4, // phase 287
+    -5, -17, 53, -29, -111, 235, -67, -418, 685, -57, -1256, 1743, 219, -4316, 7255, 21252, 11008, -3608, -1047, 2174, -921, -496, 804, -275, -219, 265, -63, -70, 59, -8, -11, 4, // phase 288
+    -5, -17, 54, -30, -110, 235, -69, -417, 688, -64, -1253, 1752, 201, -4311, 7314, 21261, 10949, -3626, -1026, 2169, -928, -489, 803, -278, -216, 265, -64, -69, 59, -8, -10, 4, // phase 289
+    -5, -17, 54, -31, -110, 236, -71, -415, 690, -71, -1249, 1761, 182, -4306, 7373, 21270, 10890, -3644, -1005, 2165, -935, -482, 802, -281, -214, 265, -65, -68, 59, -8, -10, 4, // phase 290
+    -5, -16, 54, -31, -109, 237, -74, -414, 693, -78, -1245, 1770, 163, -4301, 7432, 21278, 10831, -3661, -984, 2160, -942, -475, 801, -283, -212, 264, -66, -68, 59, -8, -10, 4, // phase 291
+    -5, -16, 54, -32, -108, 238, -76, -412, 696, -84, -1242, 1778, 144, -4295, 7492, 21287, 10771, -3678, -963, 2155, -949, -468, 800, -286, -209, 264, -67, -67, 59, -9, -10, 4, // phase 292
+    -5, -16, 54, -33, -108, 238, -79, -410, 698, -91, -1238, 1787, 125, -4290, 7551, 21295, 10712, -3695, -942, 2150, -955, -461, 799, -289, -207, 264, -68, -67, 59, -9, -10, 4, // phase 293
+    -5, -16, 54, -33, -107, 239, -81, -408, 701, -98, -1234, 1795, 106, -4284, 7610, 21303, 10653, -3712, -921, 2145, -962, -454, 798, -292, -205, 264, -69, -66, 59, -9, -10, 4, // phase 294
+    -6, -16, 55, -34, -107, 240, -83, -407, 703, -105, -1230, 1804, 87, -4278, 7670, 21310, 10593, -3728, -900, 2140, -969, -447, 796, -295, -202, 263, -70, -65, 59, -9, -10, 4, // phase 295
+    -6, -16, 55, -34, -106, 240, -86, -405, 706, -112, -1226, 1812, 67, -4271, 7729, 21317, 10534, -3744, -880, 2135, -976, -440, 795, -297, -200, 263, -71, -65, 59, -9, -10, 4, // phase 296
+    -6, -16, 55, -35, -105, 241, -88, -403, 708, -119, -1222, 1821, 48, -4265, 7788, 21324, 10474, -3761, -859, 2130, -982, -433, 794, -300, -197, 263, -71, -64, 59, -9, -10, 4, // phase 297
+    -6, -16, 55, -36, -105, 242, -91, -401, 711, -126, -1218, 1829, 29, -4258, 7848, 21331, 10415, -3776, -838, 2125, -989, -426, 793, -303, -195, 263, -72, -63, 59, -10, -10, 4, // phase 298
+    -6, -16, 55, -36, -104, 243, -93, -399, 713, -132, -1214, 1837, 10, -4251, 7907, 21337, 10355, -3792, -817, 2119, -996, -419, 791, -306, -193, 262, -73, -63, 59, -10, -10, 4, // phase 299
+    -6, -15, 55, -37, -104, 243, -96, -397, 716, -139, -1210, 1845, -10, -4244, 7967, 21343, 10296, -3807, -796, 2114, -1002, -412, 790, -308, -190, 262, -74, -62, 59, -10, -9, 4, // phase 300
+    -6, -15, 55, -38, -103, 244, -98, -396, 718, -146, -1206, 1854, -29, -4237, 8026, 21348, 10236, -3823, -776, 2108, -1008, -405, 789, -311, -188, 262, -75, -61, 59, -10, -9, 4, // phase 301
+    -6, -15, 56, -38, -102, 245, -100, -394, 721, -153, -1202, 1862, -49, -4229, 8086, 21354, 10177, -3838, -755, 2103, -1015, -398, 787, -314, -185, 262, -76, -61, 59, -10, -9, 4, // phase 302
+    -6, -15, 56, -39, -102, 245, -103, -392, 723, -160, -1197, 1870, -68, -4222, 8146, 21359, 10117, -3852, -734, 2097, -1021, -391, 786, -316, -183, 261, -77, -60, 59, -10, -9, 4, // phase 303
+    -6, -15, 56, -40, -101, 246, -105, -390, 725, -167, -1193, 1878, -88, -4214, 8205, 21364, 10057, -3867, -714, 2091, -1027, -384, 784, -319, -181, 261, -78, -60, 59, -11, -9, 4, // phase 304
+    -6, -15, 56, -40, -100, 246, -108, -388, 728, -174, -1188, 1885, -107, -4206, 8265, 21368, 9998, -3881, -693, 2085, -1034, -377, 783, -321, -178, 261, -78, -59, 59, -11, -9, 4, // phase 305
+    -7, -15, 56, -41, -100, 247, -110, -386, 730, -181, -1184, 1893, -127, -4198, 8325, 21372, 9938, -3895, -672, 2079, -1040, -370, 781, -324, -176, 260, -79, -58, 59, -11, -9, 4, // phase 306
+    -7, -15, 56, -42, -99, 248, -112, -384, 732, -188, -1179, 1901, -147, -4189, 8384, 21376, 9878, -3909, -652, 2073, -1046, -363, 780, -326, -173, 260, -80, -58, 59, -11, -9, 4, // phase 307
+    -7, -14, 56, -42, -98, 248, -115, -382, 735, -195, -1175, 1909, -166, -4180, 8444, 21380, 9819, -3923, -631, 2067, -1052, -356, 778, -329, -171, 259, -81, -57, 59, -11, -9, 4, // phase 308
+    -7, -14, 56, -43, -98, 249, -117, -380, 737, -202, -1170, 1916, -186, -4171, 8504, 21383, 9759, -3936, -610, 2061, -1058, -349, 777, -332, -168, 259, -82, -56, 59, -11, -9, 4, // phase 309
+    -7, -14, 57, -43, -97, 249, -120, -377, 739, -209, -1165, 1924, -206, -4162, 8563, 21386, 9699, -3950, -590, 2055, -1064, -342, 775, -334, -166, 259, -83, -56, 58, -11, -9, 4, // phase 310
+    -7, -14, 57, -44, -96, 250, -122, -375, 741, -216, -1160, 1931, -226, -4153, 8623, 21389, 9639, -3963, -569, 2049, -1070, -335, 774, -336, -164, 258, -83, -55, 58, -12, -8, 4, // phase 311
+    -7, -14, 57, -45, -96, 251, -125, -373, 743, -223, -1156, 1939, -246, -4143, 8683, 21391, 9580, -3976, -549, 2042, -1075, -328, 772, -339, -161, 258, -84, -54, 58, -12, -8, 4, // phase 312
+    -7, -14, 57, -45, -95, 251, -127, -371, 745, -230, -1151, 1946, -266, -4134, 8743, 21393, 9520, -3988, -528, 2036, -1081, -321, 770, -341, -159, 257, -85, -54, 58, -12, -8, 4, // phase 313
+    -7, -14, 57, -46, -94, 252, -130, -369, 747, -237, -1146, 1954, -286, -4124, 8802, 21395, 9460, -4001, -508, 2030, -1087, -314, 768, -344, -156, 257, -86, -53, 58, -12, -8, 4, // phase 314
+    -7, -14, 57, -47, -93, 252, -132, -367, 749, -244, -1141, 1961, -306, -4114, 8862, 21396, 9400, -4013, -488, 2023, -1092, -307, 767, -346, -154, 257, -87, -52, 58, -12, -8, 4, // phase 315
+    -7, -13, 57, -47, -93, 253, -134, -365, 751, -251, -1135, 1968, -326, -4103, 8922, 21398, 9340, -4025, -467, 2016, -1098, -300, 765, -349, -151, 256, -87, -52, 58, -12, -8, 4, // phase 316
+    -7, -13, 57, -48, -92, 253, -137, -362, 753, -258, -1130, 1975, -346, -4093, 8982, 21399, 9281, -4037, -447, 2010, -1104, -293, 763, -351, -149, 256, -88, -51, 58, -13, -8, 4, // phase 317
+    -8, -13, 57, -49, -91, 254, -139, -360, 755, -265, -1125, 1982, -366, -4082, 9041, 21399, 9221, -4048, -427, 2003, -1109, -286, 761, -353, -147, 255, -89, -51, 58, -13, -8, 4, // phase 318
+    -8, -13, 58, -49, -90, 254, -142, -358, 757, -272, -1120, 1989, -386, -4071, 9101, 21399, 9161, -4060, -406, 1996, -1114, -279, 759, -356, -144, 255, -90, -50, 58, -13, -8, 4, // phase 319
+};
+
+const resampler_bank_t resampler_banks[] = {
+    {48000, 16000, 1, 3, 96, _coeffs_48000_16000},
+    {16000, 8000, 1, 2, 64, _coeffs_16000_8000},
+    {22050, 16000, 320, 441, 32, _coeffs_22050_16000},
+};
+
+const size_t resampler_bank_count = sizeof(resampler_banks) / sizeof(resampler_banks[0]);
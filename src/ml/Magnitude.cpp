@@ -0,0 +1,113 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include "./Magnitude.h"
+
+#if defined ARDUINO_ARCH_MBED_RP2040
+#include "arm_math.h"
+#endif
+
+// alpha-max-plus-beta-min constants minimizing the peak error (3.96%), Q15
+#define AMPB_ALPHA 31472 // 0.96043387
+#define AMPB_BETA 13036  // 0.39782473
+
+namespace magnitude
+{
+    static uint16_t _sqrt_lut[256]; // sqrt(i) in Q11
+
+    void begin(void)
+    {
+        for (int i = 0; i < 256; i++)
+        {
+            // entries from 64 up are also reached by shifted (truncated) power values in [i, i + 1):
+            // store the square root of the interval centre to halve the worst-case error
+            float x = (i < 64) ? (float)i : (float)i + 0.5f;
+            _sqrt_lut[i] = (uint16_t)lroundf(sqrtf(x) * 2048.0f);
+        }
+    }
+
+    void exact(const int16_t *src, int16_t *dst, size_t bins)
+    {
+#if defined ARDUINO_ARCH_MBED_RP2040
+        arm_cmplx_mag_q15(src, dst, bins);
+#else
+        // reference for host tools
+        for (size_t i = 0; i < bins; i++)
+        {
+            float re = src[2 * i], im = src[2 * i + 1];
+            dst[i] = (int16_t)(sqrtf(re * re + im * im) / 2);
+        }
+#endif
+    }
+
+    void ampb(const int16_t *src, int16_t *dst, size_t bins)
+    {
+        while (bins--)
+        {
+            int32_t re = *src++;
+            int32_t im = *src++;
+            uint32_t a = (re ^ (re >> 31)) - (re >> 31);
+            uint32_t b = (im ^ (im >> 31)) - (im >> 31);
+            uint32_t hi = (a > b) ? a : b;
+            uint32_t lo = (a > b) ? b : a;
+            *dst++ = (int16_t)((AMPB_ALPHA * hi + AMPB_BETA * lo) >> 16); // Q15 and / 2
+        }
+    }
+
+    void power_lut(const int16_t *src, int16_t *dst, size_t bins)
+    {
+        while (bins--)
+        {
+            int32_t re = *src++;
+            int32_t im = *src++;
+            uint32_t p = (uint32_t)(re * re) + (uint32_t)(im * im); // <= 2^31
+
+            // even shift bringing p into [64, 256): sqrt(p) = sqrt(p >> 2k) << k
+            uint32_t k = 0;
+            if (p >= (256u << 16))
+            {
+                p >>= 16;
+                k += 8;
+            }
+            if (p >= (256u << 8))
+            {
+                p >>= 8;
+                k += 4;
+            }
+            if (p >= (256u << 4))
+            {
+                p >>= 4;
+                k += 2;
+            }
+            if (p >= (256u << 2))
+            {
+                p >>= 2;
+                k += 1;
+            }
+            if (p >= 256u)
+            {
+                p >>= 2;
+                k += 1;
+            }
+            *dst++ = (int16_t)((((uint32_t)_sqrt_lut[p] << k) + (1u << 11)) >> 12); // Q11 and / 2, rounded
+        }
+    }
+
+} // namespace magnitude
@@ -0,0 +1,51 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+// FFT magnitude estimator used by PreProcessor::calculate_spectrum
+#define MAG_EXACT 0     // arm_cmplx_mag_q15(): square root per bin
+#define MAG_AMPB 1      // alpha * max(|re|, |im|) + beta * min(|re|, |im|), two multiplies per bin, <= 4% error
+#define MAG_POWER_LUT 2 // re^2 + im^2, square root from a 256-entry table of the normalized power, <= 0.6% error
+
+#define MAG_MODE MAG_POWER_LUT
+
+// All modes write sqrt(re^2 + im^2) / 2 (2.14 format, as arm_cmplx_mag_q15) for interleaved re, im input.
+namespace magnitude
+{
+    void begin(void);
+
+    void exact(const int16_t *src, int16_t *dst, size_t bins);
+    void ampb(const int16_t *src, int16_t *dst, size_t bins);
+    void power_lut(const int16_t *src, int16_t *dst, size_t bins);
+
+    inline void compute(const int16_t *src, int16_t *dst, size_t bins)
+    {
+#if MAG_MODE == MAG_EXACT
+        exact(src, dst, bins);
+#elif MAG_MODE == MAG_AMPB
+        ampb(src, dst, bins);
+#else
+        power_lut(src, dst, bins);
+#endif
+    }
+
+} // namespace magnitude
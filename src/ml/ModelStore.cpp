@@ -0,0 +1,324 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <string.h>
+#include "./ModelStore.h"
+
+#define MODEL_MAGIC 0x314C444D // "MDL1"
+
+// first bytes of the header page, the rest of the page stays erased
+typedef struct ModelHeader
+{
+    uint32_t magic;
+    uint32_t generation; // incremented by every commit, the highest valid one is active
+    uint32_t size;       // bytes of the .tflite file following the header page
+    uint32_t crc;        // CRC-32 of the file
+    uint32_t headerCrc;  // CRC-32 of the fields above
+} ModelHeader;
+
+static_assert(sizeof(ModelHeader) <= MODEL_HEADER_SIZE, "ModelHeader exceeds the header page");
+
+#if defined ARDUINO_ARCH_MBED_RP2040
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+#include "hardware/regs/addressmap.h"
+
+// The flash is unreadable while erasing or programming: interrupts stay off meanwhile (single core), so no
+// code runs from XIP. A sector erase takes about 45 ms, longer than an audio DMA block: the DMA ring keeps
+// running and overwrites the blocks completed meanwhile, one coalesced interrupt is served afterwards and
+// ThreadAudio counts the lost blocks as DMA overruns.
+class Rp2040Flash : public ModelFlash
+{
+public:
+    bool erase(uint32_t offset, size_t size) override
+    {
+        uint32_t ints = save_and_disable_interrupts();
+        flash_range_erase(offset, size);
+        restore_interrupts(ints);
+        return true;
+    }
+    bool program(uint32_t offset, const uint8_t *data, size_t size) override
+    {
+        uint32_t ints = save_and_disable_interrupts();
+        flash_range_program(offset, data, size);
+        restore_interrupts(ints);
+        return true;
+    }
+    const uint8_t *map(uint32_t offset) override
+    {
+        return (const uint8_t *)(XIP_BASE + offset);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////
+ModelStore *ModelStore::_instance = nullptr;
+
+ModelStore *ModelStore::getInstance(void)
+{
+    if (!_instance)
+    {
+        static Rp2040Flash flash;
+        static ModelStore instance(&flash, MODEL_STORE_OFFSET);
+        _instance = &instance;
+        instance.init();
+    }
+    return _instance;
+}
+#endif // ARDUINO_ARCH_MBED_RP2040
+
+////////////////////////////////////////////////////////////////////////////////////////////
+ModelStore::ModelStore(ModelFlash *flash, uint32_t offset) : _flash(flash),
+                                                              _offset(offset),
+                                                              _active(-1),
+                                                              _generation{0},
+                                                              _size{0},
+                                                              _upload(-1),
+                                                              _expectSize(0),
+                                                              _expectCrc(0),
+                                                              _received(0),
+                                                              _erased(0),
+                                                              _verified(false)
+{
+}
+
+// CRC-32 (IEEE 802.3, as zlib.crc32), 4 bits per step with a 16-entry table
+uint32_t ModelStore::crc32(uint32_t crc, const uint8_t *data, size_t size)
+{
+    static const uint32_t table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C};
+
+    crc = ~crc;
+    while (size--)
+    {
+        crc ^= *data++;
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+void ModelStore::init(void)
+{
+    abort();
+    _active = -1;
+    for (int slot = 0; slot < MODEL_SLOT_COUNT; slot++)
+    {
+        if (validate(slot) && ((_active < 0) || ((int32_t)(_generation[slot] - _generation[_active]) > 0)))
+        {
+            _active = slot;
+        }
+    }
+}
+
+bool ModelStore::validate(int slot)
+{
+    _generation[slot] = 0;
+    _size[slot] = 0;
+
+    const ModelHeader *h = (const ModelHeader *)_flash->map(slot_offset(slot));
+    if ((h->magic != MODEL_MAGIC) ||
+        (h->headerCrc != crc32(0, (const uint8_t *)h, offsetof(ModelHeader, headerCrc))) ||
+        (h->size == 0) || (h->size > MODEL_MAX_SIZE) ||
+        (h->crc != crc32(0, _flash->map(slot_offset(slot) + MODEL_HEADER_SIZE), h->size)))
+    {
+        return false;
+    }
+    _generation[slot] = h->generation;
+    _size[slot] = h->size;
+    return true;
+}
+
+const uint8_t *ModelStore::model(int slot, size_t *size)
+{
+    if ((slot < 0) || (slot >= MODEL_SLOT_COUNT) || (_size[slot] == 0))
+    {
+        return nullptr;
+    }
+    if (size)
+    {
+        *size = _size[slot];
+    }
+    return _flash->map(slot_offset(slot) + MODEL_HEADER_SIZE);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+ModelStore::Status ModelStore::begin(uint32_t size, uint32_t crc)
+{
+    if (_upload >= 0)
+    {
+        return ErrorState;
+    }
+    if ((size == 0) || (size > MODEL_MAX_SIZE))
+    {
+        return ErrorSize;
+    }
+
+    _upload = (_active == 0) ? 1 : 0;
+    _expectSize = size;
+    _expectCrc = crc;
+    _received = 0;
+    _verified = false;
+
+    // erasing the first sector invalidates the header: the slot stays invalid until commit()
+    _size[_upload] = 0;
+    _erased = 0;
+    if (!_flash->erase(slot_offset(_upload), MODEL_FLASH_SECTOR))
+    {
+        abort();
+        return ErrorFlash;
+    }
+    _erased = MODEL_FLASH_SECTOR;
+    return Ok;
+}
+
+bool ModelStore::program_page(uint32_t position)
+{
+    // erase the following sectors only when reached, one sector erase per interrupt-free window
+    while (_erased < position + MODEL_FLASH_PAGE)
+    {
+        if (!_flash->erase(slot_offset(_upload) + _erased, MODEL_FLASH_SECTOR))
+        {
+            return false;
+        }
+        _erased += MODEL_FLASH_SECTOR;
+    }
+    return _flash->program(slot_offset(_upload) + position, _page, MODEL_FLASH_PAGE);
+}
+
+ModelStore::Status ModelStore::write(uint32_t offset, const uint8_t *data, size_t size)
+{
+    if ((_upload < 0) || _verified)
+    {
+        return ErrorState;
+    }
+    if (offset > _received)
+    {
+        return ErrorOffset;
+    }
+
+    // skip what a retransmitted chunk repeats
+    uint32_t skip = _received - offset;
+    if (skip >= size)
+    {
+        return Ok;
+    }
+    data += skip;
+    size -= skip;
+    if (size > _expectSize - _received)
+    {
+        return ErrorSize;
+    }
+
+    while (size)
+    {
+        uint32_t fill = _received % MODEL_FLASH_PAGE;
+        uint32_t n = MODEL_FLASH_PAGE - fill;
+        n = (n < size) ? n : size;
+        memcpy(&_page[fill], data, n);
+        data += n;
+        size -= n;
+        _received += n;
+
+        if ((fill + n) == MODEL_FLASH_PAGE)
+        {
+            if (!program_page(MODEL_HEADER_SIZE + _received - MODEL_FLASH_PAGE))
+            {
+                abort();
+                return ErrorFlash;
+            }
+        }
+    }
+    return Ok;
+}
+
+ModelStore::Status ModelStore::verify(const uint8_t **model)
+{
+    if (_upload < 0)
+    {
+        return ErrorState;
+    }
+    if (_received != _expectSize)
+    {
+        return ErrorSize;
+    }
+
+    if (!_verified)
+    {
+        uint32_t fill = _received % MODEL_FLASH_PAGE;
+        if (fill)
+        {
+            memset(&_page[fill], 0xFF, MODEL_FLASH_PAGE - fill);
+            if (!program_page(MODEL_HEADER_SIZE + _received - fill))
+            {
+                abort();
+                return ErrorFlash;
+            }
+        }
+
+        // read back: catches flash failures as well as transfer errors
+        if (crc32(0, _flash->map(slot_offset(_upload) + MODEL_HEADER_SIZE), _expectSize) != _expectCrc)
+        {
+            abort();
+            return ErrorCrc;
+        }
+        _verified = true;
+    }
+
+    if (model)
+    {
+        *model = _flash->map(slot_offset(_upload) + MODEL_HEADER_SIZE);
+    }
+    return Ok;
+}
+
+ModelStore::Status ModelStore::commit(void)
+{
+    if ((_upload < 0) || !_verified)
+    {
+        return ErrorState;
+    }
+
+    ModelHeader h;
+    h.magic = MODEL_MAGIC;
+    h.generation = generation() + 1;
+    h.size = _expectSize;
+    h.crc = _expectCrc;
+    h.headerCrc = crc32(0, (const uint8_t *)&h, offsetof(ModelHeader, headerCrc));
+
+    memset(_page, 0xFF, sizeof(_page));
+    memcpy(_page, &h, sizeof(h));
+    int slot = _upload;
+    if (!_flash->program(slot_offset(slot), _page, MODEL_FLASH_PAGE) || !validate(slot))
+    {
+        abort();
+        return ErrorFlash;
+    }
+
+    _active = slot;
+    _upload = -1;
+    _verified = false;
+    return Ok;
+}
+
+void ModelStore::abort(void)
+{
+    _upload = -1;
+    _verified = false;
+}
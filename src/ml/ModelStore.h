@@ -0,0 +1,125 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+#define MODEL_FLASH_SIZE (2 * 1024 * 1024) // W5100S-EVB-Pico / Pico: 2 MB QSPI flash
+#define MODEL_FLASH_SECTOR 4096            // erase unit
+#define MODEL_FLASH_PAGE 256               // program unit
+
+#define MODEL_SLOT_COUNT 2
+#define MODEL_SLOT_SIZE (64 * 1024)                                             // header page followed by the .tflite file
+#define MODEL_STORE_OFFSET (MODEL_FLASH_SIZE - MODEL_SLOT_COUNT * MODEL_SLOT_SIZE) // last 128 KB: must stay clear of the sketch
+#define MODEL_HEADER_SIZE MODEL_FLASH_PAGE
+#define MODEL_MAX_SIZE (MODEL_SLOT_SIZE - MODEL_HEADER_SIZE)
+
+static_assert(MODEL_SLOT_SIZE % MODEL_FLASH_SECTOR == 0, "MODEL_SLOT_SIZE must be a multiple of MODEL_FLASH_SECTOR");
+
+// Flash access used by ModelStore: the RP2040 XIP flash on the device, an emulator on host (tools/model_store_test.cpp)
+class ModelFlash
+{
+public:
+    virtual ~ModelFlash() {}
+    virtual bool erase(uint32_t offset, size_t size) = 0;                        // whole sectors, bytes become 0xFF
+    virtual bool program(uint32_t offset, const uint8_t *data, size_t size) = 0; // whole pages of erased flash
+    virtual const uint8_t *map(uint32_t offset) = 0;                             // memory-mapped read
+};
+
+// Two flash slots (A/B) holding .tflite models. A slot is valid when its header and CRC-32 check out,
+// the valid slot with the highest generation is active. An upload always goes to the other slot and its
+// header is programmed last, so a torn upload or power loss leaves the active model untouched.
+// Used by ThreadNet (upload) and AudioModel::init() (boot); not thread-safe.
+class ModelStore
+{
+public:
+    enum Status
+    {
+        Ok,
+        ErrorState,  // no upload in progress, or one already is
+        ErrorSize,   // model larger than MODEL_MAX_SIZE, or more data than announced
+        ErrorOffset, // chunk beyond the data received so far
+        ErrorFlash,  // erase or program failed
+        ErrorCrc,    // data read back from flash does not match the announced CRC-32
+    };
+
+    ModelStore(ModelFlash *flash, uint32_t offset);
+
+    static ModelStore *getInstance(void); // RP2040 flash at MODEL_STORE_OFFSET
+
+    void init(void); // validates both slots
+
+    inline int active_slot(void) const // -1 when no slot holds a valid model
+    {
+        return _active;
+    }
+    inline uint32_t generation(void) const // of the active slot, 0 without one
+    {
+        return (_active < 0) ? 0 : _generation[_active];
+    }
+    inline uint32_t generation(int slot) const
+    {
+        return _generation[slot];
+    }
+    const uint8_t *model(int slot, size_t *size); // nullptr unless the slot is valid
+
+    // upload into the slot that is not active: begin(), write() chunks in order, verify(), then commit()
+    Status begin(uint32_t size, uint32_t crc);
+    Status write(uint32_t offset, const uint8_t *data, size_t size); // a chunk already written is accepted again
+    Status verify(const uint8_t **model);                             // after the last chunk: data as mapped in flash
+    Status commit(void);                                              // header programmed: the slot is active
+    void abort(void);
+
+    inline bool busy(void) const
+    {
+        return _upload >= 0;
+    }
+    inline uint32_t received(void) const // bytes of the upload in progress
+    {
+        return (_upload < 0) ? 0 : _received;
+    }
+
+    static uint32_t crc32(uint32_t crc, const uint8_t *data, size_t size);
+
+private:
+    static ModelStore *_instance;
+
+    ModelFlash *_flash;
+    uint32_t _offset;
+
+    int _active;
+    uint32_t _generation[MODEL_SLOT_COUNT];
+    uint32_t _size[MODEL_SLOT_COUNT];
+
+    int _upload;         // slot being written, -1 when idle
+    uint32_t _expectSize;
+    uint32_t _expectCrc;
+    uint32_t _received;  // bytes accepted
+    uint32_t _erased;    // bytes of the slot erased so far
+    bool _verified;
+    uint8_t _page[MODEL_FLASH_PAGE];
+
+    inline uint32_t slot_offset(int slot) const
+    {
+        return _offset + slot * MODEL_SLOT_SIZE;
+    }
+    bool validate(int slot);
+    bool program_page(uint32_t position); // _page at position from the slot start
+};
@@ -21,6 +21,12 @@
 #include "audio_model.h"
 #include "../audio/audio_const.h"
 #include "../AppDef.h"
+#include "../audio/accel.h"
+#include "./Magnitude.h"
+#include "./Rfft256.h"
+#if REQUANT_MODE == REQUANT_CALIBRATED
+#include "./requant_table.h"
+#endif
 
 #define SCALE_FACTOR 64
 
@@ -36,7 +42,8 @@ PreProcessor::PreProcessor(int fft_size) : _fft_size(fft_size),
                                            _spectrogram_width(0),
                                            _spectrogram_height(0),
                                            _spectrogram_divider(0),
-                                           _spectrogram_zero_point(0.0)
+                                           _spectrogram_zero_point(0.0),
+                                           _requantizer()
 {
 }
 
@@ -89,10 +96,23 @@ arm_status PreProcessor::init(AudioModel *model)
                 (uint32_t)_spectrogram, _spectrogram_width, _spectrogram_height);
     MicroPrintf("_spectrogram_divider=%d, _spectrogram_zero_point=%d",
                 _spectrogram_divider, _spectrogram_zero_point);
+#if REQUANT_MODE == REQUANT_CALIBRATED
+    _requantizer.init_table(requant_table);
+#else
+    _requantizer.init_linear(_spectrogram_divider, (int32_t)_spectrogram_zero_point);
+#endif
+    magnitude::begin();
+    rfft256::begin();
 
     return arm_rfft_init_q15(&_S_q15, _fft_size, 0, 1);
 }
 
+void PreProcessor::attach(AudioModel *model)
+{
+    // AudioModel::prepare() only accepts models with the same input shape and quantization
+    _spectrogram = (int8_t *)model->input_data();
+}
+
 void PreProcessor::shift_spectrogram(int shift_amount)
 {
     int8_t *spectrogram = _spectrogram;
@@ -128,13 +148,16 @@ void PreProcessor::calculate_spectrum(const q15_t *input, int8_t *output)
     q15_t fft_mag_q15[_fft_size / 2 + 1];
 
     // apply the DSP pipeline: Hanning Window + FFT
-    arm_mult_q15(_hanning_window, input, windowed_input, _fft_size);
-    arm_rfft_q15(&_S_q15, windowed_input, fft_q15);
-    arm_cmplx_mag_q15(fft_q15, fft_mag_q15, (_fft_size / 2) + 1);
-
-    int8_t *dst = output;
-    for (int j = 0; j < ((_fft_size / 2) + 1); j++)
+    accel::window_q15(_hanning_window, input, windowed_input, _fft_size);
+    if (_fft_size == RFFT256_LEN)
+    {
+        rfft256::transform(windowed_input, fft_q15);
+    }
+    else
     {
-        *dst++ = __SSAT((fft_mag_q15[j] / _spectrogram_divider) + _spectrogram_zero_point, 8);
+        arm_rfft_q15(&_S_q15, windowed_input, fft_q15);
     }
+    magnitude::compute(fft_q15, fft_mag_q15, (_fft_size / 2) + 1);
+
+    _requantizer.quantize(fft_mag_q15, output, (_fft_size / 2) + 1);
 }
@@ -19,6 +19,8 @@
  */
 #pragma once
 #include "arm_math.h"
+#include "../audio/audio_const.h"
+#include "./Requantizer.h"
 
 class AudioModel;
 
@@ -31,8 +33,19 @@ public:
     static PreProcessor *getInstance(void);
 
     arm_status init(AudioModel *);
+    void attach(AudioModel *); // after AudioModel::swap(): the spectrogram lives in the new input tensor
     void update_spectrum(const int16_t *raw_input);
 
+    // most recent SPECTROGRAM_SHIFT columns written by update_spectrum()
+    inline const int8_t *latest_columns(void) const
+    {
+        return _spectrogram + (_spectrogram_height * (_spectrogram_width - SPECTROGRAM_SHIFT));
+    }
+    inline int32_t spectrogram_height(void) const
+    {
+        return _spectrogram_height;
+    }
+
 private:
     static PreProcessor *_instance;
     static q15_t _audio_buf[];
@@ -46,6 +59,7 @@ private:
     int32_t _spectrogram_height;
     int32_t _spectrogram_divider;
     float _spectrogram_zero_point;
+    Requantizer _requantizer;
 
     void shift_spectrogram(int shift_amount);
     void calculate_spectrum(const q15_t *input, int8_t *output);
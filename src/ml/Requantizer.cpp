@@ -0,0 +1,69 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <string.h>
+#include "./Requantizer.h"
+
+///////////////////////////////////////////////////////////////////////////////
+Requantizer::Requantizer() : _lut()
+{
+}
+
+void Requantizer::bucket(uint32_t i, uint32_t *low, uint32_t *width)
+{
+    if (i < (2u << REQUANT_MANTISSA_BITS))
+    {
+        *low = i;
+        *width = 1;
+    }
+    else
+    {
+        uint32_t shift = (i >> REQUANT_MANTISSA_BITS) - 1;
+        *low = (i - (shift << REQUANT_MANTISSA_BITS)) << shift;
+        *width = 1u << shift;
+    }
+}
+
+void Requantizer::init_linear(int32_t divider, int32_t zero_point)
+{
+    if (divider < 1)
+    {
+        divider = 1;
+    }
+    for (uint32_t i = 0; i < REQUANT_LUT_SIZE; i++)
+    {
+        uint32_t low, width;
+        bucket(i, &low, &width);
+        int32_t q = (int32_t)((low + width / 2) / divider) + zero_point; // bucket centre, divided once here
+        _lut[i] = (int8_t)((q > 127) ? 127 : ((q < -128) ? -128 : q));
+    }
+}
+
+void Requantizer::init_table(const int8_t *table)
+{
+    memcpy(_lut, table, sizeof(_lut));
+}
+
+void Requantizer::quantize(const int16_t *mag, int8_t *dst, size_t count) const
+{
+    while (count--)
+    {
+        *dst++ = _lut[index((uint16_t)*mag++)];
+    }
+}
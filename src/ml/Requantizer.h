@@ -0,0 +1,79 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+// spectrogram requantization: q15 FFT magnitude -> int8 model input
+#define REQUANT_LINEAR 0     // mag / (SCALE_FACTOR * input_scale) + zero_point, as the shipped model was trained
+#define REQUANT_CALIBRATED 1 // table from tools/requant_calibrate.py (src/ml/requant_table.h), model must be trained with it
+
+#define REQUANT_MODE REQUANT_LINEAR
+
+// Table index = magnitude as a small float: magnitudes below 2^(REQUANT_MANTISSA_BITS + 1) map 1:1,
+// every octave above is split into 2^REQUANT_MANTISSA_BITS steps (0.8% resolution).
+#define REQUANT_MANTISSA_BITS 7
+#define REQUANT_LUT_SIZE ((16 - REQUANT_MANTISSA_BITS) << REQUANT_MANTISSA_BITS) // covers magnitudes 0 .. 32767
+
+// One table lookup per bin instead of an integer division (no hardware divider on Cortex-M0+).
+class Requantizer
+{
+public:
+    Requantizer();
+
+    // mag / divider + zero_point, saturated; within one LSB of the division (exact when divider is a power of 2)
+    void init_linear(int32_t divider, int32_t zero_point);
+    // REQUANT_LUT_SIZE entries indexed by index()
+    void init_table(const int8_t *table);
+
+    static inline uint32_t index(uint32_t mag)
+    {
+        // shift = max(0, msb(mag) - REQUANT_MANTISSA_BITS), found by binary search as Cortex-M0+ has no CLZ
+        uint32_t m = mag >> (REQUANT_MANTISSA_BITS + 1);
+        uint32_t shift = 0;
+        if (m)
+        {
+            shift = 1;
+            if (m >= 16)
+            {
+                m >>= 4;
+                shift += 4;
+            }
+            if (m >= 4)
+            {
+                m >>= 2;
+                shift += 2;
+            }
+            if (m >= 2)
+            {
+                shift += 1;
+            }
+        }
+        return (shift << REQUANT_MANTISSA_BITS) + (mag >> shift);
+    }
+
+    // lowest magnitude and number of magnitudes mapped to table entry i
+    static void bucket(uint32_t i, uint32_t *low, uint32_t *width);
+
+    void quantize(const int16_t *mag, int8_t *dst, size_t count) const;
+
+private:
+    int8_t _lut[REQUANT_LUT_SIZE];
+};
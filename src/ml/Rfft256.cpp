@@ -0,0 +1,173 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <math.h>
+#include "./Rfft256.h"
+
+#if defined ARDUINO_ARCH_MBED_RP2040
+#include "pico/platform.h"
+#define RFFT256_FUNC(name) __not_in_flash_func(name) // run from SRAM, no XIP cache misses
+#else
+#define RFFT256_FUNC(name) name
+#endif
+
+#define CFFT_LEN (RFFT256_LEN / 2)
+#define TWIDDLE_LEN 192 // highest index used: 3 * 31 * 2 (first radix-4 stage)
+
+namespace rfft256
+{
+    // W256^k = cos(pi k / 128) - j sin(pi k / 128), Q15 interleaved; the radix-4 stages use W256^(stride * n).
+    // Kept in SRAM (not const) so the inner loops never wait on flash.
+    static int16_t _twiddle[2 * TWIDDLE_LEN];
+    // position of bin k in the complex FFT output (radix-4 digits reversed)
+    static uint8_t _position[CFFT_LEN];
+    static int16_t _work[2 * CFFT_LEN];
+
+    static int16_t q15(double x)
+    {
+        long y = lround(x * 32768.0);
+        return (int16_t)((y > 32767) ? 32767 : y);
+    }
+
+    void begin(void)
+    {
+        for (int k = 0; k < TWIDDLE_LEN; k++)
+        {
+            _twiddle[2 * k] = q15(cos(M_PI * k / CFFT_LEN));
+            _twiddle[2 * k + 1] = q15(-sin(M_PI * k / CFFT_LEN));
+        }
+        for (int k = 0; k < CFFT_LEN; k++)
+        {
+            _position[k] = (uint8_t)((k & 3) * 32 + ((k >> 2) & 3) * 8 + ((k >> 4) & 3) * 2 + (k >> 6));
+        }
+    }
+
+    // Radix-4 decimation-in-frequency stage over groups of 4 * span complex points.
+    // The loads, sums and stores of each butterfly are kept in that order so the compiler can
+    // schedule them with the eight Thumb-1 low registers; n == 0 (unity twiddles) is peeled off.
+    static void RFFT256_FUNC(radix4)(const int16_t *src, int16_t *dst, int span, int stride, int shift)
+    {
+        const int quarter = 2 * span;
+        const int group = 4 * quarter;
+        for (int n = 0; n < span; n++)
+        {
+            const int16_t *w = &_twiddle[2 * stride * n];
+            int32_t w1r = w[0], w1i = w[1];
+            int32_t w2r = w[2 * stride * n], w2i = w[2 * stride * n + 1];
+            int32_t w3r = w[4 * stride * n], w3i = w[4 * stride * n + 1];
+
+            for (int g = 2 * n; g < 2 * CFFT_LEN; g += group)
+            {
+                const int16_t *a = src + g;
+                int32_t ar = a[0], ai = a[1];
+                int32_t cr = a[2 * quarter], ci = a[2 * quarter + 1];
+                int32_t t0r = ar + cr, t0i = ai + ci;
+                int32_t t1r = ar - cr, t1i = ai - ci;
+                int32_t br = a[quarter], bi = a[quarter + 1];
+                int32_t dr = a[3 * quarter], di = a[3 * quarter + 1];
+                int32_t t2r = br + dr, t2i = bi + di;
+                int32_t t3r = br - dr, t3i = bi - di;
+
+                int16_t *y = dst + g;
+                y[0] = (int16_t)((t0r + t2r) >> shift);
+                y[1] = (int16_t)((t0i + t2i) >> shift);
+
+                int32_t y1r = (t1r + t3i) >> shift, y1i = (t1i - t3r) >> shift;
+                int32_t y2r = (t0r - t2r) >> shift, y2i = (t0i - t2i) >> shift;
+                int32_t y3r = (t1r - t3i) >> shift, y3i = (t1i + t3r) >> shift;
+                if (n == 0)
+                {
+                    y[quarter] = (int16_t)y1r;
+                    y[quarter + 1] = (int16_t)y1i;
+                    y[2 * quarter] = (int16_t)y2r;
+                    y[2 * quarter + 1] = (int16_t)y2i;
+                    y[3 * quarter] = (int16_t)y3r;
+                    y[3 * quarter + 1] = (int16_t)y3i;
+                }
+                else
+                {
+                    y[quarter] = (int16_t)((y1r * w1r - y1i * w1i) >> 15);
+                    y[quarter + 1] = (int16_t)((y1r * w1i + y1i * w1r) >> 15);
+                    y[2 * quarter] = (int16_t)((y2r * w2r - y2i * w2i) >> 15);
+                    y[2 * quarter + 1] = (int16_t)((y2r * w2i + y2i * w2r) >> 15);
+                    y[3 * quarter] = (int16_t)((y3r * w3r - y3i * w3i) >> 15);
+                    y[3 * quarter + 1] = (int16_t)((y3r * w3i + y3i * w3r) >> 15);
+                }
+            }
+        }
+    }
+
+    static void RFFT256_FUNC(radix2)(int16_t *z)
+    {
+        for (int i = 0; i < 2 * CFFT_LEN; i += 4)
+        {
+            int32_t ar = z[i], ai = z[i + 1];
+            int32_t br = z[i + 2], bi = z[i + 3];
+            z[i] = (int16_t)((ar + br) >> 1);
+            z[i + 1] = (int16_t)((ai + bi) >> 1);
+            z[i + 2] = (int16_t)((ar - br) >> 1);
+            z[i + 3] = (int16_t)((ai - bi) >> 1);
+        }
+    }
+
+    // X[k] = (Z[k] + Z*[128 - k]) / 2 + W256^k (Z[k] - Z*[128 - k]) / 2j, two bins per iteration
+    static void RFFT256_FUNC(split)(const int16_t *z, int16_t *dst)
+    {
+        int32_t zr = z[0], zi = z[1];
+        dst[0] = (int16_t)(zr + zi);
+        dst[1] = 0;
+        dst[2 * CFFT_LEN] = (int16_t)(zr - zi);
+        dst[2 * CFFT_LEN + 1] = 0;
+
+        for (int k = 1; k < CFFT_LEN / 2; k++)
+        {
+            const int16_t *zk = &z[2 * _position[k]];
+            const int16_t *zm = &z[2 * _position[CFFT_LEN - k]];
+            int32_t sr = zk[0] + zm[0], si = zk[1] - zm[1];
+            int32_t dr = zk[0] - zm[0], di = zk[1] + zm[1];
+            int32_t wr = _twiddle[2 * k], wi = _twiddle[2 * k + 1];
+            int32_t hr = (wr * di + wi * dr) >> 15;
+            int32_t hi = (wi * di - wr * dr) >> 15;
+
+            int16_t *xk = &dst[2 * k];
+            int16_t *xm = &dst[2 * (CFFT_LEN - k)];
+            xk[0] = (int16_t)((sr + hr) >> 1);
+            xk[1] = (int16_t)((si + hi) >> 1);
+            xm[0] = (int16_t)((sr - hr) >> 1);
+            xm[1] = (int16_t)((hi - si) >> 1);
+        }
+
+        // W256^64 = -j
+        const int16_t *zq = &z[2 * _position[CFFT_LEN / 2]];
+        dst[CFFT_LEN] = zq[0];
+        dst[CFFT_LEN + 1] = (int16_t)-zq[1];
+    }
+
+    void RFFT256_FUNC(transform)(const int16_t *src, int16_t *dst)
+    {
+        // src viewed as 128 complex points x[2n] + j x[2n + 1]; the first stage scales by 1/8
+        // instead of 1/4 so a rotated full-scale point cannot overflow the int16 work buffer
+        radix4(src, _work, 32, 2, 3);
+        radix4(_work, _work, 8, 8, 2);
+        radix4(_work, _work, 2, 32, 2);
+        radix2(_work);
+        split(_work, dst);
+    }
+
+} // namespace rfft256
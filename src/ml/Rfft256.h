@@ -0,0 +1,39 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+#define RFFT256_LEN 256
+#define RFFT256_BINS (RFFT256_LEN / 2 + 1)
+
+// 256-point real FFT specialized for Cortex-M0+, in place of arm_rfft_q15() in PreProcessor.
+// The 256 real samples are transformed as 128 complex points (radix-4 x 3 + radix-2 stages,
+// scaled by 1/2 per radix-2 step) and split into the real spectrum in one post-processing pass
+// that also undoes the digit-reversed output order, so there is no bit-reversal pass.
+//
+// dst receives RFFT256_BINS interleaved re, im values scaled as arm_rfft_q15() (DFT / 256).
+// Uses a static work buffer: call from one thread only (ThreadAudio). Call begin() once before transform().
+namespace rfft256
+{
+    void begin(void);
+    void transform(const int16_t *src, int16_t *dst);
+
+} // namespace rfft256
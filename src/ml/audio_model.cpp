@@ -18,12 +18,18 @@
  * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include <math.h>
+#include <string.h>
 
 #include "audio_model.h"
 #include "tflite_model.h"
+#include "ModelStore.h"
 #include "../AppDef.h"
 
-static ML_DATA __ALIGNED(8) uint8_t tensor_arena[64 * 1024];
+#ifdef MODEL_HOT_SWAP
+static ML_DATA __ALIGNED(8) uint8_t tensor_arena[2][MODEL_ARENA_SIZE]; // serving and standby, roles swap with the model
+#else
+static ML_DATA __ALIGNED(8) uint8_t tensor_arena[1][MODEL_ARENA_SIZE];
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 AudioModel *AudioModel::_instance = nullptr;
@@ -31,12 +37,21 @@ AudioModel *AudioModel::_instance = nullptr;
 ////////////////////////////////////////////////////////////////////////////////////////////
 
 AudioModel::AudioModel(uint8_t *tensor_arena,
+                       uint8_t *standby_arena,
                        int tensor_arena_size) : _tensor_arena(tensor_arena),
+                                                _standby_arena(standby_arena),
                                                 _tensor_arena_size(tensor_arena_size),
+                                                _tflite_model(NULL),
+                                                _generation(0),
                                                 _model(NULL),
                                                 _interpreter(NULL),
                                                 _input_tensor(NULL),
-                                                _output_tensor(NULL)
+                                                _output_tensor(NULL),
+                                                _standby(NULL),
+                                                _standbyModel(NULL),
+                                                _standbyGeneration(0),
+                                                _standbyReady(false),
+                                                _retired(NULL)
 {
     static tflite::MicroErrorReporter micro_error_reporter;
     _error_reporter = &micro_error_reporter;
@@ -49,13 +64,19 @@ AudioModel::~AudioModel()
         delete _interpreter;
         _interpreter = NULL;
     }
+    delete _standby;
+    delete _retired;
 }
 
 AudioModel *AudioModel::getInstance(void)
 {
     if (!_instance)
     {
-        static ML_DATA AudioModel _model(tensor_arena, sizeof(tensor_arena));
+#ifdef MODEL_HOT_SWAP
+        static ML_DATA AudioModel _model(tensor_arena[0], tensor_arena[1], MODEL_ARENA_SIZE);
+#else
+        static ML_DATA AudioModel _model(tensor_arena[0], NULL, MODEL_ARENA_SIZE);
+#endif
         _instance = &_model;
     }
     return _instance;
@@ -73,31 +94,24 @@ TfLiteStatus AudioModel::initOpsResolver(void)
     return kTfLiteOk;
 }
 
-TfLiteStatus AudioModel::init(void)
+TfLiteStatus AudioModel::create(const unsigned char *model, uint8_t *arena, tflite::MicroInterpreter **interpreter)
 {
-    _model = tflite::GetModel(tflite_model);
-    if (_model->version() != TFLITE_SCHEMA_VERSION)
+    *interpreter = NULL;
+    auto m = tflite::GetModel(model);
+    if (m->version() != TFLITE_SCHEMA_VERSION)
     {
         TF_LITE_REPORT_ERROR(_error_reporter,
                              "Model provided is schema version %d not equal "
                              "to supported version %d.",
-                             _model->version(), TFLITE_SCHEMA_VERSION);
+                             m->version(), TFLITE_SCHEMA_VERSION);
 
         return kTfLiteError;
     }
 
-    if (initOpsResolver() != kTfLiteOk)
-    {
-        TF_LITE_REPORT_ERROR(_error_reporter,
-                             "Failed to initOpsResolver");
-        return kTfLiteUnresolvedOps;
-    }
-    MicroPrintf("initOpsResolver() success");
-
-    _interpreter = new tflite::MicroInterpreter(
-        _model, _opsResolver,
-        _tensor_arena, _tensor_arena_size);
-    if (_interpreter == NULL)
+    auto p = new tflite::MicroInterpreter(
+        m, _opsResolver,
+        arena, _tensor_arena_size);
+    if (p == NULL)
     {
         TF_LITE_REPORT_ERROR(_error_reporter,
                              "Failed to allocate interpreter");
@@ -105,20 +119,148 @@ TfLiteStatus AudioModel::init(void)
     }
     MicroPrintf("new tflite::MicroInterpreter() success");
 
-    TfLiteStatus allocate_status = _interpreter->AllocateTensors();
+    TfLiteStatus allocate_status = p->AllocateTensors();
     if (allocate_status != kTfLiteOk)
     {
         TF_LITE_REPORT_ERROR(_error_reporter, "AllocateTensors() failed");
+        delete p;
         return kTfLiteError;
     }
     MicroPrintf("_interpreter->AllocateTensors() success");
 
+    *interpreter = p;
+    return kTfLiteOk;
+}
+
+TfLiteStatus AudioModel::init(void)
+{
+    if (initOpsResolver() != kTfLiteOk)
+    {
+        TF_LITE_REPORT_ERROR(_error_reporter,
+                             "Failed to initOpsResolver");
+        return kTfLiteUnresolvedOps;
+    }
+    MicroPrintf("initOpsResolver() success");
+
+    // active flash slot first, then the other slot, then the model compiled into the firmware
+    auto store = ModelStore::getInstance();
+    int active = store->active_slot();
+    for (int i = 0; (i < MODEL_SLOT_COUNT) && (active >= 0) && !_interpreter; i++)
+    {
+        int slot = (active + i) % MODEL_SLOT_COUNT;
+        const unsigned char *model = store->model(slot, NULL);
+        if (model && (create(model, _tensor_arena, &_interpreter) == kTfLiteOk))
+        {
+            _tflite_model = model;
+            _generation = store->generation(slot);
+        }
+    }
+    if (!_interpreter)
+    {
+        TF_LITE_ENSURE_STATUS(create(tflite_model, _tensor_arena, &_interpreter));
+        _tflite_model = tflite_model;
+        _generation = 0;
+    }
+    MicroPrintf("model generation %u", _generation);
+
+    _model = tflite::GetModel(_tflite_model);
     _input_tensor = _interpreter->input(0);
     _output_tensor = _interpreter->output(0);
 
     return kTfLiteOk;
 }
 
+void AudioModel::reclaim(void)
+{
+    // after swap() has completed, the interpreter it replaced used what is now the standby arena
+    if (!_standbyReady.load(std::memory_order_acquire))
+    {
+        delete _retired;
+        _retired = NULL;
+    }
+}
+
+TfLiteStatus AudioModel::prepare(const unsigned char *model)
+{
+#ifdef MODEL_HOT_SWAP
+    if (_standbyReady.load(std::memory_order_acquire) || _standby)
+    {
+        return kTfLiteError; // the previous model has not been swapped in yet
+    }
+
+    reclaim();
+
+    tflite::MicroInterpreter *interpreter;
+    TF_LITE_ENSURE_STATUS(create(model, _standby_arena, &interpreter));
+
+    // PreProcessor keeps writing the same spectrogram: same shape, type and quantization
+    auto in = interpreter->input(0);
+    auto out = interpreter->output(0);
+    if ((in->type != _input_tensor->type) || (in->bytes != _input_tensor->bytes) ||
+        !TfLiteIntArrayEqual(in->dims, _input_tensor->dims) ||
+        (in->params.scale != _input_tensor->params.scale) ||
+        (in->params.zero_point != _input_tensor->params.zero_point) ||
+        (out->type != kTfLiteInt8))
+    {
+        TF_LITE_REPORT_ERROR(_error_reporter, "model input does not match the running model");
+        delete interpreter;
+        return kTfLiteError;
+    }
+
+    _standby = interpreter;
+    _standbyModel = model;
+    return kTfLiteOk;
+#else
+    return kTfLiteError;
+#endif
+}
+
+void AudioModel::publish(uint32_t generation)
+{
+    if (_standby)
+    {
+        _standbyGeneration = generation;
+        _standbyReady.store(true, std::memory_order_release);
+    }
+}
+
+void AudioModel::discard(void)
+{
+    if (_standby && !_standbyReady.load(std::memory_order_acquire))
+    {
+        delete _standby;
+        _standby = NULL;
+    }
+}
+
+bool AudioModel::swap(void)
+{
+    if (!_standbyReady.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    // the spectrogram history carries over, the next hop continues it in the new input tensor
+    auto in = _standby->input(0);
+    memcpy(in->data.data, _input_tensor->data.data, in->bytes);
+
+    _retired = _interpreter;
+    _interpreter = _standby;
+    _input_tensor = in;
+    _output_tensor = _interpreter->output(0);
+    _tflite_model = _standbyModel;
+    _model = tflite::GetModel(_tflite_model);
+    _generation = _standbyGeneration;
+
+    uint8_t *arena = _tensor_arena;
+    _tensor_arena = _standby_arena;
+    _standby_arena = arena;
+
+    _standby = NULL;
+    _standbyReady.store(false, std::memory_order_release);
+    return true;
+}
+
 void *AudioModel::input_data()
 {
     return (_input_tensor == NULL) ? NULL : _input_tensor->data.data;
@@ -162,3 +304,8 @@ int32_t AudioModel::input_height(void) const
 {
     return (_input_tensor->dims->size > 2) ? _input_tensor->dims->data[2] : -1;
 }
+
+size_t AudioModel::arena_used_bytes(void) const
+{
+    return (_interpreter == NULL) ? 0 : _interpreter->arena_used_bytes();
+}
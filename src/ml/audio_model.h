@@ -27,6 +27,10 @@
 #include <tensorflow/lite/micro/micro_interpreter.h>
 #include <tensorflow/lite/schema/schema_generated.h>
 #include <tensorflow/lite/micro/tflite_bridge/micro_error_reporter.h>
+#include <atomic>
+
+#define MODEL_ARENA_SIZE (64 * 1024)
+#define MODEL_HOT_SWAP // comment out to drop the standby arena (MODEL_ARENA_SIZE, +64 KB RAM): uploaded models then load at the next boot
 
 const int kSpectrogramWidth = 124;
 const int kSpectrogramHeight = 129;
@@ -36,26 +40,54 @@ using AudioOpResolver = tflite::MicroMutableOpResolver<7>;
 class AudioModel
 {
 public:
-    AudioModel(uint8_t *tensor_arena, int tensor_arena_size);
+    AudioModel(uint8_t *tensor_arena, uint8_t *standby_arena, int tensor_arena_size);
     virtual ~AudioModel();
 
     static AudioModel *getInstance(void);
-    TfLiteStatus init(void);
+    TfLiteStatus init(void); // model of the active flash slot (ModelStore), the compiled-in one as fallback
 
     float inference(void);
 
+    // Hot swap: ThreadNet builds a second interpreter in the standby arena while this one keeps serving,
+    // ThreadAudio switches between two hops.
+    void reclaim(void);                               // ThreadNet: deletes the interpreter replaced by the last swap()
+    TfLiteStatus prepare(const unsigned char *model); // ThreadNet: the input must match the current one
+    void publish(uint32_t generation);                // ThreadNet: the prepared interpreter is taken by the next swap()
+    void discard(void);                               // ThreadNet: drops a prepared, unpublished interpreter
+    inline bool swap_pending(void) const
+    {
+        return _standbyReady.load(std::memory_order_acquire);
+    }
+    bool swap(void); // ThreadAudio, between hops: true when the published interpreter took over
+    inline uint32_t generation(void) const // ModelStore generation of the running model, 0 for the compiled-in one
+    {
+        return _generation;
+    }
+    inline const unsigned char *model_data(void) const // flatbuffer of the running model (flash)
+    {
+        return _tflite_model;
+    }
+
     void *input_data();
     float input_scale() const;
     int32_t input_zero_point() const;
     int32_t input_width(void) const;
     int32_t input_height(void) const;
 
+    size_t arena_used_bytes(void) const;
+    inline size_t arena_size(void) const
+    {
+        return _tensor_arena_size;
+    }
+
 private:
     static AudioModel *_instance;
     uint8_t *_tensor_arena;
+    uint8_t *_standby_arena;
     int _tensor_arena_size;
 
     const unsigned char *_tflite_model;
+    uint32_t _generation;
 
     tflite::ErrorReporter *_error_reporter;
     const tflite::Model *_model;
@@ -63,5 +95,13 @@ private:
     TfLiteTensor *_input_tensor;
     TfLiteTensor *_output_tensor;
     AudioOpResolver _opsResolver;
+
+    tflite::MicroInterpreter *_standby; // prepared in _standby_arena
+    const unsigned char *_standbyModel;
+    uint32_t _standbyGeneration;
+    std::atomic<bool> _standbyReady;     // published by ThreadNet, cleared by ThreadAudio after the swap
+    tflite::MicroInterpreter *_retired;  // replaced by swap(), deleted by ThreadNet in reclaim()
+
     TfLiteStatus initOpsResolver(void);
+    TfLiteStatus create(const unsigned char *model, uint8_t *arena, tflite::MicroInterpreter **interpreter);
 };
\ No newline at end of file
@@ -0,0 +1,191 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "./ClockPlanner.h"
+
+namespace clockplan
+{
+    pio_clock_t pio_divider(uint32_t sys_hz, uint32_t pio_hz)
+    {
+        pio_clock_t clock = {};
+        if (!pio_hz || (sys_hz < pio_hz))
+        {
+            return clock;
+        }
+
+        uint64_t div256 = ((uint64_t)sys_hz * 256 + pio_hz / 2) / pio_hz;
+        if (div256 > 0xFFFFFFull)
+        {
+            div256 = 0xFFFFFFull; // 65535 + 255/256
+        }
+        clock.div = (uint16_t)(div256 >> 8);
+        clock.frac = (uint8_t)(div256 & 0xFF);
+        clock.hz = (uint32_t)(((uint64_t)sys_hz * 256 + div256 / 2) / div256);
+
+        double average = (double)sys_hz * 256.0 / (double)div256;
+        clock.ppb = (int32_t)((average - (double)pio_hz) * 1e9 / (double)pio_hz);
+        clock.jitter_ps = clock.frac ? (uint32_t)(1000000000000ull / sys_hz) : 0;
+        return clock;
+    }
+
+    static inline uint32_t abs_ppb(const pio_clock_t &clock)
+    {
+        return (clock.ppb < 0) ? (uint32_t)(-(int64_t)clock.ppb) : (uint32_t)clock.ppb;
+    }
+
+    // 2: integer divider, 1: fractional within CLOCK_PIO_TOLERANCE_PPB, 0: off rate
+    static inline int quality(const pio_clock_t &clock)
+    {
+        if ((clock.frac == 0) && (clock.ppb == 0))
+        {
+            return 2;
+        }
+        return (abs_ppb(clock) <= CLOCK_PIO_TOLERANCE_PPB) ? 1 : 0;
+    }
+
+    static bool better(const plan_t &a, const plan_t &b, uint32_t high_min_hz)
+    {
+        bool fa = (a.sys_hz[ProfileHigh] >= high_min_hz);
+        bool fb = (b.sys_hz[ProfileHigh] >= high_min_hz);
+        if (fa != fb)
+        {
+            return fa; // fast enough for inference
+        }
+        int qa = 3 * quality(a.pio[ProfileHigh]) + quality(a.pio[ProfileLow]); // ProfileHigh weighs more
+        int qb = 3 * quality(b.pio[ProfileHigh]) + quality(b.pio[ProfileLow]);
+        if (qa != qb)
+        {
+            return qa > qb;
+        }
+        if (a.sys_hz[ProfileHigh] != b.sys_hz[ProfileHigh])
+        {
+            return a.sys_hz[ProfileHigh] > b.sys_hz[ProfileHigh]; // more headroom, less jitter if fractional
+        }
+        if (a.sys_hz[ProfileLow] != b.sys_hz[ProfileLow])
+        {
+            return a.sys_hz[ProfileLow] > b.sys_hz[ProfileLow];
+        }
+        uint64_t pa = (uint64_t)abs_ppb(a.pio[ProfileHigh]) + abs_ppb(a.pio[ProfileLow]);
+        uint64_t pb = (uint64_t)abs_ppb(b.pio[ProfileHigh]) + abs_ppb(b.pio[ProfileLow]);
+        if (pa != pb)
+        {
+            return pa < pb;
+        }
+        return a.vco_hz < b.vco_hz; // same clocks: the slower VCO draws less
+    }
+
+    bool plan(uint32_t pio_hz, uint32_t high_min_hz, uint32_t high_max_hz, uint32_t low_max_hz, plan_t *plan)
+    {
+        if (high_max_hz > CLOCK_SYS_MAX_HZ)
+        {
+            high_max_hz = CLOCK_SYS_MAX_HZ;
+        }
+        if (low_max_hz > high_max_hz)
+        {
+            low_max_hz = high_max_hz;
+        }
+
+        bool found = false;
+        plan_t best = {};
+        for (uint32_t fbdiv = CLOCK_FBDIV_MIN; fbdiv <= CLOCK_FBDIV_MAX; fbdiv++)
+        {
+            uint32_t vco = CLOCK_XOSC_HZ * fbdiv;
+            if ((vco < CLOCK_VCO_MIN_HZ) || (vco > CLOCK_VCO_MAX_HZ))
+            {
+                continue;
+            }
+            for (uint32_t pd1 = 1; pd1 <= CLOCK_POSTDIV_MAX; pd1++)
+            {
+                for (uint32_t pd2 = 1; pd2 <= pd1; pd2++)
+                {
+                    if (vco % (pd1 * pd2))
+                    {
+                        continue;
+                    }
+                    uint32_t pll = vco / (pd1 * pd2);
+                    if (pll > CLOCK_SYS_MAX_HZ)
+                    {
+                        continue; // the PLL output also feeds the clock muxes, keep it in the clk_sys range
+                    }
+
+                    // ProfileHigh: fastest integer clk_sys divider within the limit
+                    uint32_t high = (pll + high_max_hz - 1) / high_max_hz;
+                    for (; high * pio_hz <= pll; high++)
+                    {
+                        if (pll % high == 0)
+                        {
+                            break;
+                        }
+                    }
+                    if ((high * pio_hz > pll) || (pll / high > high_max_hz))
+                    {
+                        continue;
+                    }
+
+                    plan_t candidate = {};
+                    candidate.pio_hz = pio_hz;
+                    candidate.fbdiv = (uint16_t)fbdiv;
+                    candidate.postdiv1 = (uint8_t)pd1;
+                    candidate.postdiv2 = (uint8_t)pd2;
+                    candidate.vco_hz = vco;
+                    candidate.sys_div[ProfileHigh] = high;
+                    candidate.sys_hz[ProfileHigh] = pll / high;
+                    candidate.pio[ProfileHigh] = pio_divider(pll / high, pio_hz);
+
+                    // ProfileLow: the best divider of the same PLL output within low_max_hz
+                    bool low_found = false;
+                    for (uint32_t low = (high > (pll + low_max_hz - 1) / low_max_hz) ? high : (pll + low_max_hz - 1) / low_max_hz;
+                         low * pio_hz <= pll; low++)
+                    {
+                        if (pll % low)
+                        {
+                            continue;
+                        }
+                        plan_t option = candidate;
+                        option.sys_div[ProfileLow] = low;
+                        option.sys_hz[ProfileLow] = pll / low;
+                        option.pio[ProfileLow] = pio_divider(pll / low, pio_hz);
+                        if (!low_found || better(option, candidate, high_min_hz))
+                        {
+                            candidate = option;
+                            low_found = true;
+                        }
+                    }
+                    if (!low_found)
+                    {
+                        continue;
+                    }
+
+                    if (!found || better(candidate, best, high_min_hz))
+                    {
+                        best = candidate;
+                        found = true;
+                    }
+                }
+            }
+        }
+
+        if (found)
+        {
+            *plan = best;
+        }
+        return found;
+    }
+
+} // namespace clockplan
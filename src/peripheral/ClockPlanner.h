@@ -0,0 +1,76 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <stdint.h>
+
+#define CLOCK_XOSC_HZ 12000000u     // crystal, PLL reference (REFDIV 1)
+#define CLOCK_VCO_MIN_HZ 750000000u // RP2040 PLL VCO range
+#define CLOCK_VCO_MAX_HZ 1600000000u
+#define CLOCK_FBDIV_MIN 16
+#define CLOCK_FBDIV_MAX 320
+#define CLOCK_POSTDIV_MAX 7
+#define CLOCK_SYS_MAX_HZ 133000000u // RP2040 rated clk_sys
+#define CLOCK_PIO_TOLERANCE_PPB 100000 // fractional dividers: prefer plans within 100 ppm of the sample rate
+
+// Host-testable clock planning for jitter-free PIO audio clocks (tools/clock_planner_test.cpp).
+// The PIO fractional divider spreads its error by stretching some PIO cycles by one clk_sys cycle:
+// the average rate is close, but every BCLK/PDM edge moves by up to a clk_sys period. A clk_sys that is
+// an integer multiple of the PIO clock gives an integer divider and no jitter.
+namespace clockplan
+{
+    enum Profile
+    {
+        ProfileHigh, // inference
+        ProfileLow,  // quiet periods
+        ProfileCount,
+    };
+
+    typedef struct pio_clock_t
+    {
+        uint16_t div;       // PIO SM clock divider, integer part
+        uint8_t frac;       // fractional part in 1/256
+        uint32_t hz;        // average PIO clock after rounding
+        int32_t ppb;        // error of the average rate in parts per billion
+        uint32_t jitter_ps; // edge jitter: one clk_sys period with a fractional divider, 0 when frac is 0
+    } pio_clock_t;
+
+    typedef struct plan_t
+    {
+        uint32_t pio_hz; // requested PIO clock
+        uint16_t fbdiv;
+        uint8_t postdiv1;
+        uint8_t postdiv2;
+        uint32_t vco_hz;
+        uint32_t sys_div[ProfileCount]; // integer clk_sys divider from the PLL output
+        uint32_t sys_hz[ProfileCount];
+        pio_clock_t pio[ProfileCount];
+    } plan_t;
+
+    // divider nearest to sys_hz / pio_hz in 1/256 steps
+    pio_clock_t pio_divider(uint32_t sys_hz, uint32_t pio_hz);
+
+    // Pick the PLL and clk_sys dividers for pio_hz: ProfileHigh between high_min_hz and high_max_hz, ProfileLow the
+    // same PLL divided down to at most low_max_hz, so switching profiles only changes the glitchless clk_sys divider.
+    // Preference: ProfileHigh not below high_min_hz, then per profile (ProfileHigh first) an integer PIO divider
+    // over a fractional one within CLOCK_PIO_TOLERANCE_PPB, then the fastest ProfileHigh (least jitter),
+    // the fastest ProfileLow, the smallest error.
+    bool plan(uint32_t pio_hz, uint32_t high_min_hz, uint32_t high_max_hz, uint32_t low_max_hz, plan_t *plan);
+
+} // namespace clockplan
@@ -0,0 +1,156 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "./ClockScaler.h"
+
+#if defined ARDUINO_ARCH_MBED_RP2040 || defined ARDUINO_ARCH_RP2040
+#include <mbed.h>
+#include "hardware/clocks.h"
+#include "hardware/pll.h"
+#include "hardware/pwm.h"
+#include "hardware/sync.h"
+
+#include "../ArduProfApp.h"
+
+#define CLOCK_USB_PLL_HZ 48000000u
+#define CLOCK_OS_TICK_HZ 1000 // RTX OS_TICK_FREQ, only used when the kernel ticks from SysTick
+
+ClockScaler *ClockScaler::_instance = nullptr;
+
+ClockScaler *ClockScaler::getInstance(void)
+{
+    if (!_instance)
+    {
+        static ClockScaler instance;
+        _instance = &instance;
+    }
+    return _instance;
+}
+
+ClockScaler::ClockScaler() : _plan(),
+                             _profile(clockplan::ProfileHigh),
+                             _planned(false),
+                             _pioCount(0),
+                             _pwmCount(0)
+{
+}
+
+static void updateSysTick(uint32_t sys_hz)
+{
+    SystemCoreClock = sys_hz;
+    if (SysTick->CTRL & SysTick_CTRL_ENABLE_Msk)
+    {
+        SysTick->LOAD = sys_hz / CLOCK_OS_TICK_HZ - 1;
+    }
+}
+
+bool ClockScaler::begin(uint32_t pio_hz)
+{
+    if (!clockplan::plan(pio_hz, CLOCK_HIGH_MIN_HZ, CLOCK_HIGH_MAX_HZ, CLOCK_LOW_MAX_HZ, &_plan))
+    {
+        return false;
+    }
+    uint32_t pll_hz = _plan.vco_hz / (_plan.postdiv1 * _plan.postdiv2);
+
+    // peripherals first, then clk_sys on clk_ref while the PLL relocks
+    clock_configure(clk_peri, 0, CLOCKS_CLK_PERI_CTRL_AUXSRC_VALUE_CLKSRC_PLL_USB, CLOCK_USB_PLL_HZ, CLOCK_USB_PLL_HZ);
+    clock_configure(clk_sys, CLOCKS_CLK_SYS_CTRL_SRC_VALUE_CLK_REF, 0, CLOCK_XOSC_HZ, CLOCK_XOSC_HZ);
+    pll_init(pll_sys, 1, _plan.vco_hz, _plan.postdiv1, _plan.postdiv2);
+    clock_configure(clk_sys, CLOCKS_CLK_SYS_CTRL_SRC_VALUE_CLKSRC_CLK_SYS_AUX, CLOCKS_CLK_SYS_CTRL_AUXSRC_VALUE_CLKSRC_PLL_SYS,
+                    pll_hz, _plan.sys_hz[clockplan::ProfileHigh]);
+    updateSysTick(_plan.sys_hz[clockplan::ProfileHigh]);
+
+    _profile = clockplan::ProfileHigh;
+    _planned = true;
+    return true;
+}
+
+bool ClockScaler::attach(PIO pio, uint sm)
+{
+    if (!_planned || (_pioCount >= CLOCK_MAX_PIO))
+    {
+        return false;
+    }
+    _pio[_pioCount] = pio;
+    _sm[_pioCount] = sm;
+    _pioCount++;
+    return true;
+}
+
+bool ClockScaler::attach(uint pwm_slice)
+{
+    if (!_planned || (_pwmCount >= CLOCK_MAX_PWM))
+    {
+        return false;
+    }
+    // the slice was set up for the current profile
+    uint32_t div = pwm_hw->slice[pwm_slice].div;
+    _pwmSlice[_pwmCount] = pwm_slice;
+    _pwmDiv[_pwmCount] = div * _plan.sys_div[_profile] / _plan.sys_div[clockplan::ProfileHigh];
+    _pwmCount++;
+    return true;
+}
+
+void ClockScaler::retimePio(clockplan::Profile profile)
+{
+    const clockplan::pio_clock_t &clock = _plan.pio[profile];
+    for (int i = 0; i < _pioCount; i++)
+    {
+        pio_sm_set_clkdiv_int_frac(_pio[i], _sm[i], clock.div, clock.frac);
+    }
+}
+
+void ClockScaler::retimePwm(clockplan::Profile profile)
+{
+    for (int i = 0; i < _pwmCount; i++)
+    {
+        uint32_t div = _pwmDiv[i] * _plan.sys_div[clockplan::ProfileHigh] / _plan.sys_div[profile];
+        div = div < (1u << PWM_CH0_DIV_INT_LSB) ? (1u << PWM_CH0_DIV_INT_LSB) : div; // 1.0 at least
+        pwm_hw->slice[_pwmSlice[i]].div = div;
+    }
+}
+
+void ClockScaler::setProfile(clockplan::Profile profile)
+{
+    if (!_planned || (profile == _profile))
+    {
+        return;
+    }
+
+    // Order the writes so that the PIO cycle spanning the switch is stretched, never shortened:
+    // the microphone sees one longer clock phase and no sample is lost.
+    bool slower = (_plan.sys_div[profile] > _plan.sys_div[_profile]);
+    uint32_t status = save_and_disable_interrupts();
+    if (slower)
+    {
+        clocks_hw->clk[clk_sys].div = _plan.sys_div[profile] << CLOCKS_CLK_SYS_DIV_INT_LSB;
+    }
+    retimePio(profile);
+    retimePwm(profile);
+    if (!slower)
+    {
+        clocks_hw->clk[clk_sys].div = _plan.sys_div[profile] << CLOCKS_CLK_SYS_DIV_INT_LSB;
+    }
+    updateSysTick(_plan.sys_hz[profile]);
+    restore_interrupts(status);
+
+    _profile = profile;
+}
+
+#endif
@@ -0,0 +1,87 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <stdint.h>
+#include "./ClockPlanner.h"
+
+#define CLOCK_PLAN_ENABLE  // boot with the PLL chosen by clockplan::plan() for the audio PIO clock, instead of 125 MHz
+#define CLOCK_SCALE_ENABLE // ThreadAudio switches to ProfileLow in quiet periods (needs CLOCK_PLAN_ENABLE)
+
+#define CLOCK_HIGH_MIN_HZ 100000000u // inference headroom
+#define CLOCK_HIGH_MAX_HZ CLOCK_SYS_MAX_HZ
+#define CLOCK_LOW_MAX_HZ 24000000u // spectrogram, AGC and network keep up at ~20 MHz
+#define CLOCK_MAX_PIO 4            // state machines retimed on a profile switch
+#define CLOCK_MAX_PWM 4            // PWM slices retimed on a profile switch
+
+#if defined CLOCK_SCALE_ENABLE && !defined CLOCK_PLAN_ENABLE
+#error "CLOCK_SCALE_ENABLE needs CLOCK_PLAN_ENABLE"
+#endif
+
+#if defined ARDUINO_ARCH_MBED_RP2040 || defined ARDUINO_ARCH_RP2040
+#include "hardware/pio.h"
+
+// Applies a clockplan::plan_t at boot and switches between its profiles at run time.
+// Both profiles share the PLL: a switch only writes the clk_sys integer divider, which is glitchless,
+// and the dividers of the PIO state machines and PWM slices attached, so their output rates do not change.
+// clk_peri runs from the USB PLL (48 MHz) so UART and SPI baud rates do not depend on the profile.
+// clock_get_hz(clk_sys) keeps the ProfileHigh rate: set up clk_sys dividers in ProfileHigh, or use sysHz().
+class ClockScaler
+{
+public:
+    static ClockScaler *getInstance(void);
+
+    bool begin(uint32_t pio_hz); // before any peripheral clocked from clk_sys or clk_peri is set up
+    bool attach(PIO pio, uint sm);
+    bool attach(uint pwm_slice);
+    void setProfile(clockplan::Profile profile);
+
+    inline clockplan::Profile profile(void) const
+    {
+        return _profile;
+    }
+    inline uint32_t sysHz(void) const
+    {
+        return _plan.sys_hz[_profile];
+    }
+    inline const clockplan::plan_t &plan(void) const
+    {
+        return _plan;
+    }
+
+private:
+    ClockScaler();
+
+    static ClockScaler *_instance;
+    clockplan::plan_t _plan;
+    clockplan::Profile _profile;
+    bool _planned;
+
+    int _pioCount;
+    PIO _pio[CLOCK_MAX_PIO];
+    uint _sm[CLOCK_MAX_PIO];
+
+    int _pwmCount;
+    uint _pwmSlice[CLOCK_MAX_PWM];
+    uint32_t _pwmDiv[CLOCK_MAX_PWM]; // 8.4 divider register in ProfileHigh
+
+    void retimePio(clockplan::Profile profile);
+    void retimePwm(clockplan::Profile profile);
+};
+#endif
@@ -28,7 +28,7 @@ Led *Led::instance = nullptr;
 
 Led::Led(uint8_t pin,
          uint8_t valueOn,
-         PinMode mode) : valueOn(valueOn), Gpio(pin, mode) //, timer()
+         PinMode mode) : valueOn(valueOn), pinNo(pin), Gpio(pin, mode) //, timer()
 {
     if (instance == nullptr)
     {
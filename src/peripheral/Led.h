@@ -29,8 +29,18 @@ public:
     virtual void off(void);
     void toggle(void);
 
+    inline uint8_t pinNumber(void) const
+    {
+        return pinNo;
+    }
+    inline bool activeHigh(void) const
+    {
+        return valueOn != LOW;
+    }
+
 protected:
     const uint8_t valueOn;
+    const uint8_t pinNo;
 
     uint8_t stateOnOff;
 
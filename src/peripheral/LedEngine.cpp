@@ -0,0 +1,194 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "./LedEngine.h"
+#include "./ClockScaler.h"
+
+#if defined ARDUINO_ARCH_MBED_RP2040 || defined ARDUINO_ARCH_RP2040
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/gpio.h"
+#include "hardware/pwm.h"
+#endif
+
+namespace ledpattern
+{
+    static const LedStep solidSteps[] = {{LED_LEVEL_MAX, 0, 2400}};
+    static const LedStep blinkSteps[] = {{LED_LEVEL_MAX, 0, 200}, {0, 0, 200}};
+    static const LedStep breatheSteps[] = {{LED_LEVEL_MAX, 1, 1200}, {0, 1, 1200}};
+    static const LedStep doubleBlipSteps[] = {{LED_LEVEL_MAX, 0, 100}, {0, 0, 100}, {LED_LEVEL_MAX, 0, 100}, {0, 0, 2100}};
+
+    const LedPattern solid = {solidSteps, sizeof(solidSteps) / sizeof(solidSteps[0])};
+    const LedPattern blink = {blinkSteps, sizeof(blinkSteps) / sizeof(blinkSteps[0])};
+    const LedPattern breathe = {breatheSteps, sizeof(breatheSteps) / sizeof(breatheSteps[0])};
+    const LedPattern doubleBlip = {doubleBlipSteps, sizeof(doubleBlipSteps) / sizeof(doubleBlipSteps[0])};
+}
+
+LedEngine::LedEngine(Led &led) : _led(led),
+                                 _layers{nullptr},
+                                 _shown(nullptr),
+                                 _started(false)
+{
+}
+
+void LedEngine::set(Layer layer, const LedPattern *pattern)
+{
+    _layers[layer] = pattern;
+
+    const LedPattern *top = nullptr;
+    for (int i = 0; (i < LayerCount) && !top; i++)
+    {
+        top = _layers[i];
+    }
+    if (_started && (top != _shown))
+    {
+        show(top);
+    }
+    _shown = top;
+}
+
+#if defined ARDUINO_ARCH_MBED_RP2040 || defined ARDUINO_ARCH_RP2040
+
+bool LedEngine::begin(void)
+{
+    uint pin = _led.pinNumber();
+    uint slice = pwm_gpio_to_slice_num(pin);
+    if (slice == LED_PACER_SLICE)
+    {
+        return false;
+    }
+    _shift = (pwm_gpio_to_channel(pin) == PWM_CHAN_B) ? 16 : 0;
+
+    // LED slice: brightness only
+    pwm_config c = pwm_get_default_config();
+    pwm_config_set_clkdiv_int(&c, 2);
+    pwm_config_set_wrap(&c, LED_PWM_TOP);
+    pwm_config_set_output_polarity(&c, !_led.activeHigh(), !_led.activeHigh());
+    pwm_init(slice, &c, false);
+    pwm_set_gpio_level(pin, 0);
+    gpio_set_function(pin, GPIO_FUNC_PWM);
+    pwm_set_enabled(slice, true);
+
+    // pacer slice: no output pin, wraps once per tick
+    c = pwm_get_default_config();
+    pwm_config_set_clkdiv(&c, (float)clock_get_hz(clk_sys) / (1000.0f / LED_TICK_MS * (LED_PACER_TOP + 1)));
+    pwm_config_set_wrap(&c, LED_PACER_TOP);
+    pwm_init(LED_PACER_SLICE, &c, true);
+#ifdef CLOCK_SCALE_ENABLE
+    ClockScaler::getInstance()->attach(slice); // both slices keep their rate in ProfileLow
+    ClockScaler::getInstance()->attach(LED_PACER_SLICE);
+#endif
+
+    _dmaCtrl = dma_claim_unused_channel(true);
+    _dmaData = dma_claim_unused_channel(true);
+    _tableAddr = _table;
+
+    dma_channel_config d = dma_channel_get_default_config(_dmaCtrl);
+    channel_config_set_transfer_data_size(&d, DMA_SIZE_32);
+    channel_config_set_read_increment(&d, false);
+    channel_config_set_write_increment(&d, false);
+    dma_channel_configure(_dmaCtrl,
+                          &d,
+                          &dma_hw->ch[_dmaData].al3_read_addr_trig, // restart the table
+                          &_tableAddr,
+                          1,
+                          false);
+
+    d = dma_channel_get_default_config(_dmaData);
+    channel_config_set_transfer_data_size(&d, DMA_SIZE_32);
+    channel_config_set_read_increment(&d, true);
+    channel_config_set_write_increment(&d, false);
+    channel_config_set_chain_to(&d, _dmaCtrl);
+    channel_config_set_dreq(&d, pwm_get_dreq(LED_PACER_SLICE));
+    dma_channel_configure(_dmaData,
+                          &d,
+                          &pwm_hw->slice[slice].cc,
+                          _table, // set by the control channel
+                          LED_PATTERN_TICKS,
+                          false);
+
+    _started = true;
+    show(_shown);
+    return true;
+}
+
+void LedEngine::show(const LedPattern *pattern)
+{
+    // aborting a channel can fire its CHAIN_TO (RP2040-E13): disable the control channel meanwhile
+    hw_clear_bits(&dma_hw->ch[_dmaCtrl].al1_ctrl, DMA_CH0_CTRL_TRIG_EN_BITS);
+    dma_channel_abort(_dmaData);
+    dma_channel_abort(_dmaCtrl);
+    hw_set_bits(&dma_hw->ch[_dmaCtrl].al1_ctrl, DMA_CH0_CTRL_TRIG_EN_BITS);
+
+    render(pattern);
+    dma_channel_start(_dmaCtrl);
+}
+
+// the pattern repeats until the table is full; ramps start from the level the loop ends with
+void LedEngine::render(const LedPattern *pattern)
+{
+    if (!pattern || (pattern->count == 0))
+    {
+        for (int t = 0; t < LED_PATTERN_TICKS; t++)
+        {
+            _table[t] = 0;
+        }
+        return;
+    }
+
+    int32_t from = pattern->steps[pattern->count - 1].level;
+    int t = 0;
+    for (int i = 0; t < LED_PATTERN_TICKS; i = (i + 1) % pattern->count)
+    {
+        const LedStep &step = pattern->steps[i];
+        int32_t n = (step.ms < LED_TICK_MS) ? 1 : (step.ms / LED_TICK_MS);
+        for (int32_t k = 1; (k <= n) && (t < LED_PATTERN_TICKS); k++)
+        {
+            uint32_t level = step.ramp ? (uint32_t)(from + (step.level - from) * k / n) : step.level;
+            // square law gamma: 255 -> LED_PWM_TOP + 1, always on
+            uint32_t duty = (level * level * (LED_PWM_TOP + 1) + (LED_LEVEL_MAX * LED_LEVEL_MAX) / 2) / (LED_LEVEL_MAX * LED_LEVEL_MAX);
+            _table[t++] = duty << _shift;
+        }
+        from = step.level;
+    }
+}
+
+#else
+
+// no PWM/DMA engine: the first step of the shown pattern sets the LED
+bool LedEngine::begin(void)
+{
+    _started = true;
+    show(_shown);
+    return true;
+}
+
+void LedEngine::show(const LedPattern *pattern)
+{
+    if (pattern && pattern->count && pattern->steps[0].level)
+    {
+        _led.on();
+    }
+    else
+    {
+        _led.off();
+    }
+}
+
+#endif
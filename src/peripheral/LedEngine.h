@@ -0,0 +1,95 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <stdint.h>
+#include "./Led.h"
+
+#define LED_TICK_MS 10        // pattern resolution: one PWM level per tick
+#define LED_PATTERN_TICKS 240 // a pattern loops every 2.4 s, step times should divide it
+#define LED_LEVEL_MAX 255     // perceived brightness, gamma corrected to the PWM duty
+#define LED_PWM_TOP 65534     // LED PWM counter wrap: ~780 Hz at 102.4 MHz with clkdiv 2, TOP + 1 (always on) fits the 16-bit CC
+#define LED_PACER_SLICE 7     // PWM slice of GPIO14/15 (unused): its wrap at 100 Hz paces the DMA
+#define LED_PACER_TOP 9999
+
+static_assert(LED_PATTERN_TICKS * LED_TICK_MS <= 65535, "pattern loop exceeds LedStep::ms");
+
+// one step of a pattern: hold the level, or ramp linearly to it from the previous step
+typedef struct _LedStep
+{
+    uint8_t level;
+    uint8_t ramp;
+    uint16_t ms;
+} LedStep;
+
+typedef struct _LedPattern
+{
+    const LedStep *steps;
+    uint8_t count;
+} LedPattern;
+
+namespace ledpattern
+{
+    extern const LedPattern solid;      // alarm
+    extern const LedPattern blink;      // 200 ms on / 200 ms off, network up notification
+    extern const LedPattern breathe;    // 2.4 s ramp up and down, waiting for the network
+    extern const LedPattern doubleBlip; // two 100 ms flashes every 2.4 s, network down
+}
+
+// Runs declarative LED patterns without CPU time per transition: the pattern is rendered once into a
+// table of PWM compare values, then DMA paced by a PWM slice wrap writes one value per tick and a
+// control channel restarts the table forever. The CPU only renders the table when the shown pattern changes.
+// Layers overlay by priority: the highest priority layer with a pattern is shown, no pattern is LED off.
+class LedEngine
+{
+public:
+    enum Layer
+    {
+        LayerAlarm,  // highest priority
+        LayerNotify, // short-lived notifications, cleared by the owner
+        LayerStatus, // boot and network state
+        LayerCount,
+    };
+
+    LedEngine(Led &led);
+
+    bool begin(void);
+    void set(Layer layer, const LedPattern *pattern);
+    inline void clear(Layer layer)
+    {
+        set(layer, nullptr);
+    }
+
+private:
+    Led &_led;
+    const LedPattern *_layers[LayerCount];
+    const LedPattern *_shown;
+    bool _started;
+
+#if defined ARDUINO_ARCH_MBED_RP2040 || defined ARDUINO_ARCH_RP2040
+    int _dmaCtrl;
+    int _dmaData;
+    uint32_t _shift;                    // 0 for PWM channel A, 16 for channel B
+    const uint32_t *_tableAddr;         // read by the control channel
+    uint32_t _table[LED_PATTERN_TICKS]; // PWM CC register values
+
+    void render(const LedPattern *pattern);
+#endif
+    void show(const LedPattern *pattern);
+};
@@ -0,0 +1,462 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "./W5100sSpi.h"
+
+#if defined ARDUINO_ARCH_MBED_RP2040 || defined ARDUINO_ARCH_RP2040
+#include "hardware/dma.h"
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+#include "hardware/spi.h"
+#include "../pins.h"
+
+#define W5100S_SPI_PORT spi0             // W5100S-EVB-Pico: MISO GPIO16, SCK GPIO18, MOSI GPIO19
+#define W5100S_SPI_DMA_IRQ DMA_IRQ_1     // DMA_IRQ_0 belongs to the audio capture
+#define W5100S_SPI_FLAG_DONE (1UL << 0)
+
+#ifdef ARDUINO_ARCH_MBED_RP2040
+#include <mbed.h>
+static rtos::EventFlags doneFlags; // set from the DMA interrupt, ThreadNet sleeps on it
+#endif
+
+#else
+// host builds (tools/host): bursts go to the W5100S emulator, transfers complete synchronously
+#include <W5100sEmulator.h>
+#endif
+
+// W5100S SPI opcodes and socket registers (datasheet 5.1, 4.2)
+enum
+{
+    OP_WRITE = 0xF0,
+    OP_READ = 0x0F,
+
+    SN_CR = 0x01,
+    SN_IR = 0x02,
+    SN_SR = 0x03,
+    SN_TXBUF_SIZE = 0x1F,
+    SN_TX_FSR = 0x20,
+
+    CR_SEND = 0x20,
+
+    IR_SEND_OK = 0x10,
+
+    SR_ESTABLISHED = 0x17,
+    SR_CLOSE_WAIT = 0x1C,
+    SR_UDP = 0x22,
+};
+
+#define SN_REG(sn, offset) (0x0400 + (sn) * 0x0100 + (offset))
+#define TX_MEMORY 0x4000
+#define SOCKETS 4
+
+enum Finish
+{
+    FinishNone,
+    FinishSend, // Sn_TX_WR, then SEND
+};
+
+// TX memory map, read by begin()
+static struct
+{
+    uint16_t txBase, txSize;
+} memory[SOCKETS];
+
+////////////////////////////////////////////////////////////////////////////////////////////
+W5100sSpi *W5100sSpi::_instance = nullptr;
+
+W5100sSpi *W5100sSpi::getInstance(void)
+{
+    if (!_instance)
+    {
+        static W5100sSpi instance;
+        _instance = &instance;
+    }
+    return _instance;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+W5100sSpi::W5100sSpi() : _busy(false),
+                         _started(false),
+                         _sn(0),
+                         _finish(FinishNone),
+                         _ptr(0),
+                         _runs(),
+                         _runCount(0),
+                         _run(0),
+                         _pending(0),
+                         _stats()
+{
+}
+
+bool W5100sSpi::begin(void)
+{
+    if (_started)
+    {
+        return true;
+    }
+
+#if defined ARDUINO_ARCH_MBED_RP2040 || defined ARDUINO_ARCH_RP2040
+    _dmaTx = dma_claim_unused_channel(false);
+    _dmaRx = dma_claim_unused_channel(false);
+    if ((_dmaTx < 0) || (_dmaRx < 0))
+    {
+        return false;
+    }
+    dma_channel_set_irq1_enabled(_dmaRx, true); // the RX channel finishes last
+    irq_add_shared_handler(W5100S_SPI_DMA_IRQ, dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(W5100S_SPI_DMA_IRQ, true);
+#endif
+
+    uint16_t txBase = TX_MEMORY;
+    for (int sn = 0; sn < SOCKETS; sn++)
+    {
+        uint8_t size; // Sn_TXBUF_SIZE in KB
+        read(SN_REG(sn, SN_TXBUF_SIZE), &size, 1);
+        memory[sn].txBase = txBase;
+        memory[sn].txSize = size * 1024;
+        txBase += memory[sn].txSize;
+    }
+    _started = true;
+    return true;
+}
+
+void W5100sSpi::read(uint16_t addr, uint8_t *buf, uint16_t len)
+{
+    _runs[0] = {nullptr, buf, len, addr, true};
+    start(1, FinishNone);
+    wait();
+}
+
+void W5100sSpi::write(uint16_t addr, const uint8_t *buf, uint16_t len)
+{
+    _runs[0] = {buf, nullptr, len, addr, true};
+    start(1, FinishNone);
+    wait();
+}
+
+// registers the chip updates on its own: read until the leading 16-bit register reads the same twice
+void W5100sSpi::readStable(uint16_t addr, uint8_t *buf, uint16_t len)
+{
+    uint8_t first[2];
+    read(addr, buf, len);
+    do
+    {
+        first[0] = buf[0];
+        first[1] = buf[1];
+        read(addr, buf, len);
+    } while ((buf[0] != first[0]) || (buf[1] != first[1]));
+}
+
+bool W5100sSpi::open(uint8_t sn)
+{
+    uint8_t sr;
+    read(SN_REG(sn, SN_SR), &sr, 1);
+    return (sr == SR_ESTABLISHED) || (sr == SR_CLOSE_WAIT) || (sr == SR_UDP);
+}
+
+// the chip takes no SEND while the previous one is in progress
+bool W5100sSpi::waitSendOk(uint8_t sn)
+{
+    uint8_t bit = 1 << sn;
+    while (_pending & bit)
+    {
+        uint8_t regs[2]; // Sn_IR, Sn_SR
+        read(SN_REG(sn, SN_IR), regs, sizeof(regs));
+        if (regs[0] & IR_SEND_OK)
+        {
+            uint8_t clear = IR_SEND_OK;
+            write(SN_REG(sn, SN_IR), &clear, 1);
+            _pending &= ~bit;
+        }
+        else if ((regs[1] != SR_ESTABLISHED) && (regs[1] != SR_CLOSE_WAIT) && (regs[1] != SR_UDP))
+        {
+            _pending &= ~bit;
+            return false;
+        }
+        else
+        {
+            // the socket interrupt handler of the library may have taken SEND_OK: done once Sn_TX_RD caught up
+            uint8_t ptrs[4]; // Sn_TX_RD, Sn_TX_WR
+            read(SN_REG(sn, SN_TX_FSR + 2), ptrs, sizeof(ptrs));
+            if ((ptrs[0] == ptrs[2]) && (ptrs[1] == ptrs[3]))
+            {
+                _pending &= ~bit;
+            }
+        }
+    }
+    return true;
+}
+
+uint16_t W5100sSpi::startSend(uint8_t sn, const uint8_t *const *ptr, const uint16_t *len, int count)
+{
+    wait();
+    if (!_started || (sn >= SOCKETS) || (count > W5100S_SPI_MAX_SEGMENTS) || !waitSendOk(sn))
+    {
+        return 0;
+    }
+
+    uint8_t regs[6]; // Sn_TX_FSR, Sn_TX_RD, Sn_TX_WR
+    readStable(SN_REG(sn, SN_TX_FSR), regs, sizeof(regs));
+    uint16_t free = (regs[0] << 8) | regs[1];
+    uint16_t wr = (regs[4] << 8) | regs[5];
+
+    // one run per segment, split where it crosses the end of the TX ring; a run continues the burst of
+    // the previous one unless it starts at the ring base
+    uint16_t size = memory[sn].txSize;
+    uint16_t taken = 0;
+    int runs = 0;
+    for (int i = 0; (i < count) && (taken < free); i++)
+    {
+        const uint8_t *p = ptr[i];
+        uint16_t n = (len[i] < free - taken) ? len[i] : (free - taken);
+        while (n)
+        {
+            uint16_t offset = (wr + taken) & (size - 1);
+            uint16_t chunk = (n < size - offset) ? n : (size - offset);
+            bool start = (runs == 0) || (offset == 0);
+            _runs[runs++] = {p, nullptr, chunk, (uint16_t)(memory[sn].txBase + offset), start};
+            p += chunk;
+            n -= chunk;
+            taken += chunk;
+        }
+    }
+    if (!taken)
+    {
+        return 0;
+    }
+
+    _sn = sn;
+    _ptr = wr + taken;
+    start(runs, FinishSend);
+    return taken;
+}
+
+uint32_t W5100sSpi::send(uint8_t sn, const uint8_t *const *ptr, const uint32_t *len, int count)
+{
+    uint32_t total = 0;
+    int i = 0;
+    uint32_t offset = 0; // into segment i
+    while (i < count)
+    {
+        // window of the remaining gather list
+        const uint8_t *p[W5100S_SPI_MAX_SEGMENTS];
+        uint16_t n[W5100S_SPI_MAX_SEGMENTS];
+        int segments = 0;
+        for (int j = i; (j < count) && (segments < W5100S_SPI_MAX_SEGMENTS); j++)
+        {
+            uint32_t skip = (j == i) ? offset : 0;
+            uint32_t rest = len[j] - skip;
+            if (rest)
+            {
+                p[segments] = ptr[j] + skip;
+                n[segments++] = (rest > 0xFFFF) ? 0xFFFF : rest;
+            }
+        }
+        if (!segments)
+        {
+            break;
+        }
+
+        uint16_t taken = startSend(sn, p, n, segments);
+        wait();
+        if (!taken)
+        {
+            if (!open(sn))
+            {
+                break;
+            }
+#ifdef ARDUINO_ARCH_MBED_RP2040
+            rtos::ThisThread::sleep_for(std::chrono::milliseconds(1)); // TX memory full until the peer acknowledges
+#endif
+            continue;
+        }
+        total += taken;
+        for (offset += taken; (i < count) && (offset >= len[i]); i++)
+        {
+            offset -= len[i];
+        }
+    }
+    return total;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// run chain: started by the caller, continued from the DMA interrupt
+///////////////////////////////////////////////////////////////////////////////
+void W5100sSpi::start(int runs, uint8_t finish)
+{
+    _runCount = runs;
+    _run = 0;
+    _finish = finish;
+    _busy = true;
+#if defined ARDUINO_ARCH_MBED_RP2040 || defined ARDUINO_ARCH_RP2040
+    next();
+#else
+    while (_busy)
+    {
+        next();
+    }
+#endif
+}
+
+void W5100sSpi::next(void)
+{
+    while (_run < _runCount)
+    {
+        const Run &run = _runs[_run++];
+        if (run.start)
+        {
+            deselect();
+            select(run.addr, run.tx != nullptr);
+        }
+        if (transfer(run))
+        {
+            return; // DMA running, the interrupt calls next()
+        }
+    }
+    deselect();
+
+    if (_finish == FinishSend)
+    {
+        // pointer register and command, polled
+        uint8_t value[2] = {(uint8_t)(_ptr >> 8), (uint8_t)_ptr};
+        select(SN_REG(_sn, SN_TX_FSR + 4), true);
+        transfer({value, nullptr, 2, 0, false});
+        deselect();
+        uint8_t cmd = CR_SEND;
+        select(SN_REG(_sn, SN_CR), true);
+        transfer({&cmd, nullptr, 1, 0, false});
+        deselect();
+        _pending |= 1 << _sn;
+        _stats.sends++;
+    }
+
+    _busy = false;
+#ifdef ARDUINO_ARCH_MBED_RP2040
+    doneFlags.set(W5100S_SPI_FLAG_DONE);
+#endif
+}
+
+void W5100sSpi::wait(void)
+{
+    while (_busy)
+    {
+#ifdef ARDUINO_ARCH_MBED_RP2040
+        doneFlags.wait_any(W5100S_SPI_FLAG_DONE);
+#endif
+    }
+}
+
+#if defined ARDUINO_ARCH_MBED_RP2040 || defined ARDUINO_ARCH_RP2040
+
+void W5100sSpi::select(uint16_t addr, bool write)
+{
+    uint8_t header[3] = {write ? OP_WRITE : OP_READ, (uint8_t)(addr >> 8), (uint8_t)addr};
+    gpio_put(PIN_ETH_CS, 0);
+    spi_write_blocking(W5100S_SPI_PORT, header, sizeof(header));
+    _stats.bursts++;
+    _stats.bytes += sizeof(header);
+}
+
+void W5100sSpi::deselect(void)
+{
+    gpio_put(PIN_ETH_CS, 1);
+}
+
+// returns true if the run goes by DMA, false once a polled run is done
+bool W5100sSpi::transfer(const Run &run)
+{
+    _stats.bytes += run.len;
+    if (run.len < W5100S_SPI_DMA_MIN)
+    {
+        if (run.tx)
+        {
+            spi_write_blocking(W5100S_SPI_PORT, run.tx, run.len);
+        }
+        else
+        {
+            spi_read_blocking(W5100S_SPI_PORT, 0, run.rx, run.len);
+        }
+        return false;
+    }
+
+    // TX feeds the data (or zeros), RX takes the answer (or drains the FIFO)
+    static uint8_t dummyTx = 0, dummyRx;
+    spi_hw_t *hw = spi_get_hw(W5100S_SPI_PORT);
+
+    dma_channel_config c = dma_channel_get_default_config(_dmaTx);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_dreq(&c, spi_get_dreq(W5100S_SPI_PORT, true));
+    channel_config_set_read_increment(&c, run.tx != nullptr);
+    channel_config_set_write_increment(&c, false);
+    dma_channel_configure(_dmaTx, &c, &hw->dr, run.tx ? run.tx : &dummyTx, run.len, false);
+
+    c = dma_channel_get_default_config(_dmaRx);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_dreq(&c, spi_get_dreq(W5100S_SPI_PORT, false));
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, run.rx != nullptr);
+    dma_channel_configure(_dmaRx, &c, run.rx ? run.rx : &dummyRx, &hw->dr, run.len, false);
+
+    _stats.dmaRuns++;
+    dma_start_channel_mask((1u << _dmaTx) | (1u << _dmaRx));
+    return true;
+}
+
+void W5100sSpi::dma_irq_handler(void)
+{
+    W5100sSpi *instance = _instance;
+    uint32_t mask = 1u << instance->_dmaRx;
+    if (!(dma_hw->ints1 & mask))
+    {
+        return; // shared with other channels
+    }
+    dma_hw->ints1 = mask;
+    instance->next();
+}
+
+#else
+
+void W5100sSpi::select(uint16_t addr, bool write)
+{
+    W5100sEmulator::getInstance()->spiBurstBegin(addr, write);
+    _stats.bursts++;
+    _stats.bytes += 3;
+}
+
+void W5100sSpi::deselect(void)
+{
+    W5100sEmulator::getInstance()->spiBurstEnd();
+}
+
+bool W5100sSpi::transfer(const Run &run)
+{
+    _stats.bytes += run.len;
+    if (run.tx)
+    {
+        W5100sEmulator::getInstance()->spiBurstWrite(run.tx, run.len);
+    }
+    else
+    {
+        W5100sEmulator::getInstance()->spiBurstRead(run.rx, run.len);
+    }
+    _stats.dmaRuns += (run.len >= W5100S_SPI_DMA_MIN); // as the board would
+    return false;
+}
+
+#endif
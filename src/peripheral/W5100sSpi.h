@@ -0,0 +1,109 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <stdint.h>
+
+#define W5100S_SPI_DMA_MIN 16     // shorter transfers are polled: DMA setup costs about as much as 16 bytes at 12 MHz
+#define W5100S_SPI_MAX_SEGMENTS 4 // gather list of one send
+#define W5100S_SPI_MAX_RUNS (W5100S_SPI_MAX_SEGMENTS + 1)
+
+// Burst SPI transport for the W5100S socket buffers.
+// The Ethernet library clocks one 4-byte frame (opcode, address, data) per byte. The W5100S also
+// accepts bursts: while nCS stays low the address auto-increments, so a whole buffer costs one 3-byte
+// header. A send reads Sn_TX_FSR / Sn_TX_RD / Sn_TX_WR in one burst, writes the gather list into the
+// TX ring in at most two bursts (split at the ring wrap) by DMA, then updates Sn_TX_WR and issues SEND
+// from the DMA interrupt. SEND_OK of the previous send is checked before the next one, not waited for.
+// The SPI bus, nCS and the socket registers are shared with the Ethernet library: use the transport from
+// ThreadNet only. The transport is blocking: ThreadNet sleeps while the DMA runs, and every call returns
+// with the bus idle. Socket data is read through the library.
+class W5100sSpi
+{
+public:
+    typedef struct _Stats
+    {
+        uint32_t bursts;    // nCS assertions
+        uint32_t dmaRuns;   // transfers moved by DMA
+        uint32_t bytes;     // clocked on the bus, headers included
+        uint32_t sends;     // SEND commands
+    } Stats;
+
+    static W5100sSpi *getInstance(void);
+
+    bool begin(void); // after Ethernet.begin(): the library has set up the SPI pins and clock
+
+    // one burst each
+    void read(uint16_t addr, uint8_t *buf, uint16_t len);
+    void write(uint16_t addr, const uint8_t *buf, uint16_t len);
+
+    // blocking gather send, waits for TX memory as needed; returns bytes sent, short if the socket closed
+    uint32_t send(uint8_t sn, const uint8_t *const *ptr, const uint32_t *len, int count);
+    inline uint32_t send(uint8_t sn, const uint8_t *buf, uint32_t len)
+    {
+        return send(sn, &buf, &len, 1);
+    }
+
+    inline const Stats &stats(void) const
+    {
+        return _stats;
+    }
+
+private:
+    typedef struct _Run
+    {
+        const uint8_t *tx; // data to write, or nullptr
+        uint8_t *rx;       // buffer to read into, or nullptr
+        uint16_t len;
+        uint16_t addr; // chip address of the first byte
+        bool start;    // starts a burst: nCS toggles and a header is sent
+    } Run;
+
+    W5100sSpi();
+
+    static W5100sSpi *_instance;
+
+    volatile bool _busy;
+    bool _started;
+    uint8_t _sn;
+    uint8_t _finish; // register update once the runs are done
+    uint16_t _ptr;   // new Sn_TX_WR
+    Run _runs[W5100S_SPI_MAX_RUNS]; // one per segment, plus one where the data crosses the ring wrap
+    int _runCount;
+    int _run;
+    uint8_t _pending; // sockets with a SEND not yet confirmed by SEND_OK
+    Stats _stats;
+
+#if defined ARDUINO_ARCH_MBED_RP2040 || defined ARDUINO_ARCH_RP2040
+    int _dmaTx;
+    int _dmaRx;
+
+    static void dma_irq_handler(void);
+#endif
+    void select(uint16_t addr, bool write); // nCS low and burst header
+    void deselect(void);
+    bool transfer(const Run &run);
+    void start(int runs, uint8_t finish);
+    void next(void);
+    void wait(void);
+    // starts a send of what fits the TX memory now (at most one TX buffer), returns the bytes taken
+    uint16_t startSend(uint8_t sn, const uint8_t *const *ptr, const uint16_t *len, int count);
+    void readStable(uint16_t addr, uint8_t *buf, uint16_t len);
+    bool open(uint8_t sn);
+    bool waitSendOk(uint8_t sn);
+};
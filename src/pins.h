@@ -42,6 +42,8 @@
 #define PIN_I2S_DI 9u
 #define PIN_I2S_BCLK 10u
 #define PIN_I2S_WS 11u
+#define PIN_PDM_DATA 9u // AUDIO_INPUT_PDM: shares the I2S header
+#define PIN_PDM_CLK 10u
 
 #define PIN_ETH_CS 17u   // W5100S-EVB-Pico: nCS = GPIO17
 #define PIN_ETH_INTN 21u // W5100S-EVB-Pico: INTn = GPIO21
@@ -38,3 +38,15 @@
 #define CALLMEBOT_HOST "api.callmebot.com"
 #define CALLMEBOT_PORT 80
 #define CALLMEBOT_PATH "/whatsapp.php?phone=" MOBILE_NUMBER "&apikey=" APIKEY "&text="
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// HTTP server receiving alarm audio clips, e.g. tools/clip_server.py
+#ifndef CLIP_UPLOAD_HOST
+#define CLIP_UPLOAD_HOST "192.168.0.100"
+#endif
+#ifndef CLIP_UPLOAD_PORT
+#define CLIP_UPLOAD_PORT 8080
+#endif
+#ifndef CLIP_UPLOAD_PATH
+#define CLIP_UPLOAD_PATH "/clip"
+#endif
@@ -20,6 +20,8 @@
 #include "./ThreadApp.h"
 #include "../AppContext.h"
 #include "../util/util.h"
+#include "../audio/ClipRecorder.h"
+#include "../util/Metrics.h"
 
 #define THRESHOLD_INFERENCE 0.3 //
 
@@ -166,6 +168,7 @@ static events::EventQueue threadQueue(THREAD_QUEUE_SIZE);
 ThreadApp::ThreadApp() : ardumbedos::ThreadBase(&threadQueue),
                          _handlerMap(),
                          _ledGreen(),
+                         _led(_ledGreen),
                          _kf(KF_E_MEA, KF_E_EST, KF_Q),
                          _state({0})
 /////////////////////////////////////////////////////////////////////////////
@@ -192,7 +195,18 @@ void ThreadApp::setup(void)
 {
     ThreadBase::setup();
 
+    _led.set(LedEngine::LayerStatus, &ledpattern::breathe); // waiting for the network
+    if (!_led.begin())
+    {
+        LOG_TRACE("LED pattern engine start failed!");
+    }
+
+    // detection does not depend on the network: capture, model allocation and DHCP run concurrently
     auto ctx = reinterpret_cast<AppContext *>(context());
+    if (ctx->threadAudio)
+    {
+        ctx->threadAudio->start(ctx);
+    }
     if (ctx->threadNet)
     {
         ctx->threadNet->start(ctx);
@@ -202,6 +216,7 @@ void ThreadApp::setup(void)
 /////////////////////////////////////////////////////////////////////////////
 void ThreadApp::onMessage(const Message &msg)
 {
+    Metrics::getInstance()->queueHandled(Metrics::QueueApp);
     // LOG_TRACE("event=", msg.event, ", iParam=", msg.iParam, ", uParam=", msg.uParam, ", lParam=", msg.lParam);
     auto func = _handlerMap[msg.event];
     if (func)
@@ -222,7 +237,7 @@ __EVENT_FUNC_DEFINITION(ThreadApp, EventApp, msg) // void ThreadApp::handlerEven
     switch (src)
     {
     case AppInference:
-        handlerInference(msg.lParam);
+        handlerInference(msg.uParam, msg.lParam);
         break;
     case AppEthUp:
         handlerEthUp();
@@ -247,35 +262,26 @@ __EVENT_FUNC_DEFINITION(ThreadApp, EventNull, msg) // void ThreadApp::handlerEve
 void ThreadApp::handlerEthUp(void)
 {
     LOG_TRACE("AppEthUp");
+    _state.netIfUp = true;
 
-    ///////////////////////////////////////////////////////////////////////////
-    // blink on-board LED three times
-    static const int BLINK_TIMES = 5;
-    for (int i = 0; i < BLINK_TIMES; i++)
-    {
-        _ledGreen.on();
-        rtos::ThisThread::sleep_for(200ms);
-        _ledGreen.off();
-        rtos::ThisThread::sleep_for(200ms);
-    }
-    ///////////////////////////////////////////////////////////////////////////
-
-    // launch ThreadAudio once eth is up
-    auto ctx = reinterpret_cast<AppContext *>(context());
-    if (ctx->threadAudio)
-    {
-        ctx->threadAudio->start(ctx);
-    }
+    // blink on-board LED five times (2 s of the blink pattern), then LED off; an alarm overlays it
+    _led.set(LedEngine::LayerNotify, &ledpattern::blink);
+    _led.clear(LedEngine::LayerStatus);
+    queue()->call_in(2s, [this]()
+                     { _led.clear(LedEngine::LayerNotify); });
 }
 
 void ThreadApp::handlerEthDn(void)
 {
     LOG_TRACE("AppEthDn");
+    _state.netIfUp = false;
+    _led.clear(LedEngine::LayerNotify);
+    _led.set(LedEngine::LayerStatus, &ledpattern::doubleBlip);
 }
 
-void ThreadApp::handlerInference(uint32_t prediction)
+void ThreadApp::handlerInference(uint16_t prediction, uint32_t detectedUs)
 {
-    float measured_value = uint32_to_float(prediction);
+    float measured_value = uint16_to_unit(prediction);
     float estimated_value = _kf.updateEstimate(measured_value);
     bool alarmState = (estimated_value >= THRESHOLD_INFERENCE);
     // LOG_TRACE("measured_value=", (uint32_t)(measured_value * 100.0));
@@ -287,15 +293,21 @@ void ThreadApp::handlerInference(uint32_t prediction)
     _state.alarmOn = alarmState;
     LOG_TRACE("_state.alarmOn=", (uint32_t)_state.alarmOn, ", measured_value=", measured_value, ", estimated_value=", estimated_value);
 
+    // the alert carries the time of the audio whose estimate crossed the threshold
     auto ctx = reinterpret_cast<AppContext *>(context());
     if (alarmState)
     {
-        _ledGreen.on();
-        postEvent(ctx->threadNet, EventApp, AppInference, InferenceAlarmOn);
+#ifdef CLIP_RECORDER_ENABLE
+        ClipRecorder::getInstance()->trigger(); // keep pre-roll and record post-roll for upload
+#endif
+        _led.set(LedEngine::LayerAlarm, &ledpattern::solid);
+        Metrics::getInstance()->queuePosted(Metrics::QueueNet);
+        postEvent(ctx->threadNet, EventApp, AppInference, InferenceAlarmOn, detectedUs);
     }
     else
     {
-        _ledGreen.off();
-        postEvent(ctx->threadNet, EventApp, AppInference, InferenceAlarmOff);
+        _led.clear(LedEngine::LayerAlarm);
+        Metrics::getInstance()->queuePosted(Metrics::QueueNet);
+        postEvent(ctx->threadNet, EventApp, AppInference, InferenceAlarmOff, detectedUs);
     }
 }
\ No newline at end of file
@@ -23,6 +23,7 @@
 #include "../ArduProfApp.h"
 #include "../AppEvent.h"
 #include "../peripheral/LedGreen.h"
+#include "../peripheral/LedEngine.h"
 
 #if defined ARDUPROF_FREERTOS
 class ThreadApp : public ardufreertos::ThreadBase
@@ -51,13 +52,14 @@ protected:
 private:
     static ThreadApp *_instance;
     LedGreen _ledGreen;
+    LedEngine _led;
     SimpleKalmanFilter _kf; // SimpleKalmanFilter(e_mea, e_est, q);
     ThreadState _state;
 
     virtual void setup(void);
     void handlerEthUp(void);
     void handlerEthDn(void);
-    void handlerInference(uint32_t prediction);
+    void handlerInference(uint16_t prediction, uint32_t detectedUs);
 
     ///////////////////////////////////////////////////////////////////////
     // declare event handler
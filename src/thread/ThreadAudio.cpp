@@ -20,13 +20,19 @@
 #include <Arduino.h>
 #include <mbed.h>
 #include <rtos.h>
+#include <atomic>
 
 #include "hardware/dma.h"
 #include "hardware/irq.h"
 #include "hardware/pio.h"
+#include "hardware/timer.h"
 
 #include "./ThreadAudio.h"
 #include "../audio/i2s.h"
+#include "../audio/pdm.h"
+#include "../audio/Agc.h"
+#include "../audio/Beamformer.h"
+#include "../audio/accel.h"
 
 #include "../AppContext.h"
 #include "../AppEvent.h"
@@ -34,29 +40,55 @@
 #include "../pins.h"
 #include "../util/util.h"
 #include "../thread/ThreadApp.h"
+#include "../util/AudioTap.h"
+#include "../audio/ClipRecorder.h"
+#include "../util/Metrics.h"
+#include "../util/BinLog.h"
 
 #include "../ml/PreProcessor.h"
 #include "../ml/audio_model.h"
 
-#define ASSERT_DMA_BUFFER_ALIGN // assert dma buffer 8-byte aligned
+#define ASSERT_DMA_BUFFER_ALIGN // check the completed DMA buffer address, drop the block on mismatch
 
-// select microphone digital gain
-#define MIC_GAIN MIC_GAIN_X16
+#ifdef AUDIO_INPUT_PDM
+#define MIC_SETTLE_MS PDM_MIC_SETTLE_MS
+#else
+#define MIC_SETTLE_MS I2S_MIC_SETTLE_MS
+#endif
+#define CAPTURE_BLOCK_US ((uint32_t)(AUDIO_CAPTURE_FRAME_LEN * 1000000ull / AUDIO_CAPTURE_RATE))
+#ifdef AUDIO_INPUT_PDM
+#define PDM_DMA_US ((uint32_t)(PDM_DMA_WORDS / 2 * 1000000ull / AUDIO_CAPTURE_RATE))
+#endif
 
-#define MIC_GAIN_X1 0
-#define MIC_GAIN_X2 1
-#define MIC_GAIN_X4 2
-#define MIC_GAIN_X8 3
-#define MIC_GAIN_X16 4
-#define MIC_GAIN_X32 5
+#ifdef CLOCK_SCALE_ENABLE
+// quiet: block peak referred to unity gain below -60 dBFS (about 60 dB SPL for the INMP441, -26 dBFS at 94 dB SPL)
+// and the model far from an alarm, for about 1 s; any louder block switches back to ProfileHigh before inference
+#define CLOCK_QUIET_PEAK 32
+#define CLOCK_QUIET_BLOCKS (1000000 / CAPTURE_BLOCK_US)
+#define CLOCK_QUIET_PREDICTION 0.1f
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 ThreadAudio *ThreadAudio::_instance = nullptr;
 
+#ifdef AUDIO_INPUT_PDM
+static __ALIGNED(8) pdm::pio_pdm_t _pdm;
+static_assert(alignof(_pdm) == 8, "Alignment of _pdm must be equal to 8 bytes");
+static int16_t _pdm_discard[PDM_DMA_WORDS / 2]; // decimator output while the pool is full, keeps the filter history
+#define EVENT_CAPTURE_DMA EVENT_PDM_DMA
+#else
 static __ALIGNED(8) pioi2s::pio_i2s_t _i2s;
 static_assert(alignof(_i2s) == 8, "Alignment of _i2s must be equal to 8 bytes");
+#define EVENT_CAPTURE_DMA EVENT_I2S_DMA
+#endif
+
+#if AUDIO_CAPTURE_RATE != AUDIO_SAMPLING_RATE
+// resampled audio collected into model frames: less than a frame left over, plus the output of one capture block
+static ML_DATA int16_t _frame_buffer[AUDIO_FRAME_LEN + AUDIO_CAPTURE_FRAME_LEN * AUDIO_SAMPLING_RATE / AUDIO_CAPTURE_RATE + 1];
+#endif
 
-static ML_DATA int16_t _audio_buffer[AUDIO_FRAME_LEN];
+#if NUM_CHANNELS == 2
+static ML_DATA int16_t _audio_buffer[AUDIO_CAPTURE_FRAME_LEN]; // beamformer output
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 int16_t *ThreadAudio::get_buffer_ptr(void)
@@ -68,31 +100,145 @@ size_t ThreadAudio::get_buffer_size(void)
 {
     return sizeof(_audio_buffer);
 }
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////
+#ifdef AUDIO_INPUT_PDM
+// every DMA block of PDM_DMA_WORDS words decimates to 64 samples, AUDIO_CAPTURE_FRAME_LEN of them fill a pool block
+void ThreadAudio::dma_pdm_in_handler(void)
+{
+#ifdef PIN_DEBUG_DMA
+    gpio_xor_mask(1u << PIN_DEBUG_DMA);
+#endif
+
+    const uint32_t *src = *(const uint32_t **)dma_hw->ch[_pdm.dma_ch_in_ctrl].read_addr;
+    auto inst = getInstance();
+    auto &pool = inst->_pool;
+
+#ifdef ASSERT_DMA_BUFFER_ALIGN
+    if ((src != _pdm.dma_in_buffer[0]) && (src != _pdm.dma_in_buffer[1]))
+    {
+        BINLOG(BL_DMA_ADDR, (uint32_t)src, (uint32_t)(_pdm.dma_in_buffer[0]), (uint32_t)(_pdm.dma_in_buffer[1]));
+        inst->_pdmBlock = nullptr; // the block loses samples: drop it
+        src = _pdm.dma_in_buffer[0];
+    }
+#endif // ASSERT_DMA_BUFFER_ALIGN
+
+    // samples overwritten in the DMA ring advance the fill unwritten: the block they fall into is dropped,
+    // and every block they complete takes its sequence number
+    uint32_t now = time_us_32();
+    uint8_t index = (src == _pdm.dma_in_buffer[1]) ? 1 : 0;
+    uint32_t missed = SampleClock::missedBlocks(now - inst->_lastDmaUs, PDM_DMA_US, index == inst->_lastDmaIndex);
+    inst->_lastDmaUs = now;
+    inst->_lastDmaIndex = index;
+    if (missed)
+    {
+        inst->_pdmBlock = nullptr;
+        inst->_pdmFill += missed * (PDM_DMA_WORDS / 2);
+        while (inst->_pdmFill >= AUDIO_CAPTURE_FRAME_LEN)
+        {
+            pool.next_sequence();
+            inst->_pdmFill -= AUDIO_CAPTURE_FRAME_LEN;
+        }
+    }
 
+    if (inst->_pdmFill == 0)
+    {
+        // the block is taken once per AUDIO_CAPTURE_FRAME_LEN samples, so a partial block is never committed
+        inst->_pdmBlock = pool.produce();
+        if (inst->_pdmBlock)
+        {
+            inst->_pdmBlock->clipped = 0;
+        }
+    }
+
+    AudioBlock *block = inst->_pdmBlock;
+    int16_t *dst = block ? &block->samples[0][inst->_pdmFill] : _pdm_discard;
+    size_t count = inst->_pdmDecimator.process(src, PDM_DMA_WORDS, dst);
+    if (block)
+    {
+        block->clipped += Agc::convert(dst, dst, count, inst->_agc.gain());
+    }
+
+    inst->_pdmFill += count;
+    bool complete = (inst->_pdmFill >= AUDIO_CAPTURE_FRAME_LEN);
+    if (complete)
+    {
+        // every pool block takes a sequence number, a block dropped here shows as a gap in ThreadAudio
+        uint32_t sequence = pool.next_sequence();
+        if (block)
+        {
+            block->sequence = sequence;
+            block->timestamp = time_us_32();
+            pool.commit();
+        }
+        inst->_pdmFill = 0;
+        inst->_pdmBlock = nullptr;
+    }
+
+    dma_hw->ints0 = 1u << _pdm.dma_ch_in_data; // clear the IRQ
+
+    if (complete && inst->_dmaCallback)
+    {
+        (*inst->_dmaCallback)();
+    }
+}
+#else
 void ThreadAudio::dma_i2s_in_handler(void)
 {
 #ifdef PIN_DEBUG_DMA
     gpio_xor_mask(1u << PIN_DEBUG_DMA);
 #endif
 
-    int32_t *src = *(int32_t **)dma_hw->ch[_i2s.dma_ch_in_ctrl].read_addr;
-    int16_t *dst = get_buffer_ptr();
+    dma_sample_t *src = *(dma_sample_t **)dma_hw->ch[_i2s.dma_ch_in_ctrl].read_addr;
+    auto inst = getInstance();
+    auto &pool = inst->_pool;
+
+    // every DMA block takes a sequence number, a block dropped here shows as a gap in ThreadAudio, and so do the
+    // blocks overwritten in the DMA ring before this coalesced interrupt
+    uint32_t now = time_us_32();
+    uint8_t index = (src == _i2s.dma_in_buffer[1]) ? 1 : 0;
+    pool.skip_sequence(SampleClock::missedBlocks(now - inst->_lastDmaUs, CAPTURE_BLOCK_US, index == inst->_lastDmaIndex));
+    inst->_lastDmaUs = now;
+    inst->_lastDmaIndex = index;
+    uint32_t sequence = pool.next_sequence();
+    AudioBlock *block = pool.produce();
 
-    // convert MSB 24-bit to 16-bit audio data with digital gain
-    for (int i = 0; i < DMA_BUFFER_SIZE; i += NUM_CHANNELS)
+#ifdef ASSERT_DMA_BUFFER_ALIGN
+    if ((src != _i2s.dma_in_buffer[0]) && (src != _i2s.dma_in_buffer[1]))
     {
-        *dst++ = (int16_t)(*src >> (16 - MIC_GAIN));
-        src += NUM_CHANNELS;
+        BINLOG(BL_DMA_ADDR, (uint32_t)src, (uint32_t)(_i2s.dma_in_buffer[0]), (uint32_t)(_i2s.dma_in_buffer[1]));
+        block = nullptr;
+    }
+#endif // ASSERT_DMA_BUFFER_ALIGN
+
+    if (block)
+    {
+        block->sequence = sequence;
+        block->timestamp = time_us_32();
+
+        // 16-bit audio data with digital gain (MSB 16 of the 24-bit samples)
+        int32_t gain = inst->_agc.gain();
+#if defined I2S_PACKED_16
+        block->clipped = Agc::convert(src, block->samples[0], AUDIO_CAPTURE_FRAME_LEN, gain);
+#elif NUM_CHANNELS == 1
+        block->clipped = Agc::convert(src, block->samples[0], AUDIO_CAPTURE_FRAME_LEN, NUM_CHANNELS, gain);
+#else
+        // deinterleave L, R words
+        block->clipped = Agc::convert(src, block->samples[0], AUDIO_CAPTURE_FRAME_LEN, NUM_CHANNELS, gain) +
+                         Agc::convert(src + 1, block->samples[1], AUDIO_CAPTURE_FRAME_LEN, NUM_CHANNELS, gain);
+#endif
+        pool.commit();
     }
 
     dma_hw->ints0 = 1u << _i2s.dma_ch_in_data; // clear the IRQ
 
-    auto inst = getInstance();
     if (inst->_dmaCallback)
     {
         (*inst->_dmaCallback)();
     }
 }
+#endif // AUDIO_INPUT_PDM
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 ThreadAudio *ThreadAudio::getInstance(void)
@@ -113,12 +259,37 @@ ThreadAudio::ThreadAudio() : ardumbedos::ThreadBase(nullptr, osPriorityRealtime)
                              _model(nullptr),
                              _preprocessor(nullptr),
                              _eventFlags(),
+                             _pool(),
+                             _sampleClock(),
+                             _frameEnd(0),
+                             _agc(),
+#if NUM_CHANNELS == 2
+                             _beamformer(),
+#endif
+#if AUDIO_CAPTURE_RATE != AUDIO_SAMPLING_RATE
+                             _resampler(),
+                             _frameFill(0),
+#endif
+#ifdef AUDIO_INPUT_PDM
+                             _pdmDecimator(),
+                             _pdmBlock(nullptr),
+                             _pdmFill(0),
+#endif
                              _dmaCallback([]()
                                           {
-                                              // signal audio task about I2S DMA IRQ
-                                              getInstance()->_eventFlags.set(EVENT_I2S_DMA);
+                                              // signal audio task about I2S / PDM DMA IRQ
+                                              getInstance()->_eventFlags.set(EVENT_CAPTURE_DMA);
                                               //
-                                          })
+                                          }),
+                             _lastDmaUs(0),
+                             _lastDmaIndex(1), // the first block fills buffer 0
+                             _settleUntil(0)
+#ifdef CLOCK_SCALE_ENABLE
+                             ,
+                             _quiet(false),
+                             _quietBlocks(0),
+                             _lastPrediction(0.0f)
+#endif
 {
 }
 
@@ -134,6 +305,22 @@ void ThreadAudio::start(void *ctx)
 void ThreadAudio::setup(void)
 {
     ThreadBase::setup();
+    accel::begin(); // interpolator state is per core, configured from this thread
+    auto metrics = Metrics::getInstance();
+
+#ifdef AUDIO_INPUT_PDM
+    _pdmDecimator.init();
+#endif
+
+    // capture first: the microphone settles while the model allocates its tensors (and ThreadNet runs DHCP)
+    _lastDmaUs = time_us_32();
+    if (!startCapture())
+    {
+        LOG_TRACE("audio input start failed!");
+        osThreadTerminate(osThreadGetId()); // Terminates the current thread
+    }
+    _settleUntil = time_us_32() + MIC_SETTLE_MS * 1000 + CAPTURE_BLOCK_US; // first block starting after settling
+    metrics->setBootPhase(Metrics::BootAudioStart, millis());
 
     auto model = AudioModel::getInstance();
     auto preprocessor = PreProcessor::getInstance();
@@ -145,13 +332,79 @@ void ThreadAudio::setup(void)
 
         LOG_TRACE("model->input_width()=", model->input_width(), ", ->input_height()=", model->input_height());
         LOG_TRACE("kSpectrogramWidth=", kSpectrogramWidth, ", kSpectrogramHeight=", kSpectrogramHeight);
+        metrics->setArena(model->arena_used_bytes(), model->arena_size());
+        metrics->setModel(model->generation(), false);
+        metrics->setBootPhase(Metrics::BootModelReady, millis());
     }
     else
     {
         osThreadTerminate(osThreadGetId()); // Terminates the current thread
     }
+
+#if AUDIO_CAPTURE_RATE != AUDIO_SAMPLING_RATE
+    if (!_resampler.init(Resampler::find(AUDIO_CAPTURE_RATE, AUDIO_SAMPLING_RATE)))
+    {
+        LOG_TRACE("no resampler bank for ", AUDIO_CAPTURE_RATE, " Hz to ", AUDIO_SAMPLING_RATE, " Hz");
+        osThreadTerminate(osThreadGetId()); // Terminates the current thread
+    }
+#endif
+}
+
+bool ThreadAudio::startCapture(void)
+{
+#if defined AUDIO_INPUT_PDM
+    bool started = pdm::mono_in_start(&pdm::pdm_config_default, &ThreadAudio::dma_pdm_in_handler, &_pdm);
+    PIO pio = _pdm.pio;
+    uint sm = _pdm.sm;
+#elif NUM_CHANNELS == 1
+    bool started = pioi2s::master_in_mono_left_start(&pioi2s::i2s_config_default, &ThreadAudio::dma_i2s_in_handler, &_i2s);
+    PIO pio = _i2s.pio;
+    uint sm = _i2s.sm_din;
+#elif NUM_CHANNELS == 2
+    bool started = pioi2s::master_in_stereo_start(&pioi2s::i2s_config_default, &ThreadAudio::dma_i2s_in_handler, &_i2s);
+    PIO pio = _i2s.pio;
+    uint sm = _i2s.sm_din;
+#else
+#error "Unsupported NUM_CHANNELS " STR(NUM_CHANNELS)
+#endif
+
+#ifdef CLOCK_SCALE_ENABLE
+    // the microphone clock keeps its rate across clk_sys profile switches
+    if (started)
+    {
+        ClockScaler::getInstance()->attach(pio, sm);
+    }
+#else
+    (void)pio;
+    (void)sm;
+#endif
+    return started;
 }
 
+#ifdef CLOCK_SCALE_ENABLE
+void ThreadAudio::updateClock(void)
+{
+    auto scaler = ClockScaler::getInstance();
+    uint32_t level = _agc.peak() * AGC_GAIN_UNITY / (uint32_t)_agc.gain(); // input referred
+    if ((level >= CLOCK_QUIET_PEAK) || (_lastPrediction >= CLOCK_QUIET_PREDICTION))
+    {
+        _quietBlocks = 0;
+        if (_quiet)
+        {
+            _quiet = false;
+            scaler->setProfile(clockplan::ProfileHigh);
+            Metrics::getInstance()->setClock(scaler->sysHz(), true);
+        }
+    }
+    else if (!_quiet && (++_quietBlocks >= CLOCK_QUIET_BLOCKS))
+    {
+        _quiet = true;
+        scaler->setProfile(clockplan::ProfileLow);
+        Metrics::getInstance()->setClock(scaler->sysHz(), true);
+    }
+}
+#endif
+
 void ThreadAudio::run(void)
 {
     setup();
@@ -159,20 +412,10 @@ void ThreadAudio::run(void)
     auto ctx = reinterpret_cast<AppContext *>(context());
     auto thread = reinterpret_cast<ThreadApp *>(ctx->threadApp);
     assert(thread);
+    auto metrics = Metrics::getInstance();
 
-    int16_t *raw_buffer_ptr = get_buffer_ptr(); // audio raw data
-
-#if NUM_CHANNELS == 1
-    auto bInit = pioi2s::master_in_mono_left_start(&pioi2s::i2s_config_default, &ThreadAudio::dma_i2s_in_handler, &_i2s);
-#else
-#error "Unsupported NUM_CHANNELS " STR(NUM_CHANNELS)
-#endif
-    if (!bInit)
-    {
-        LOG_TRACE("start_i2s_in() failed!");
-        osThreadTerminate(osThreadGetId()); // Terminates the current thread
-    }
-
+    uint32_t sequence = 0; // next expected block
+    bool settled = false;
     while (true)
     {
         auto flags = _eventFlags.wait_any(EVENT_I2S_DMA | EVENT_PDM_DMA);
@@ -182,20 +425,169 @@ void ThreadAudio::run(void)
             gpio_xor_mask(1u << PIN_DEBUG_AUDIO_TASK);
 #endif
 
-#ifdef ASSERT_DMA_BUFFER_ALIGN
-            int32_t *src = *(int32_t **)dma_hw->ch[_i2s.dma_ch_in_ctrl].read_addr;
-            if ((src != _i2s.dma_in_buffer[0]) && (src != _i2s.dma_in_buffer[1]))
+            AudioBlock *block;
+            while ((block = _pool.consume()) != nullptr)
             {
-                LOG_TRACE("Error: src=", (uint32_t)src,
-                          ", _i2s.dma_in_buffer[0]=", (uint32_t)(_i2s.dma_in_buffer[0]),
-                          ", _i2s.dma_in_buffer[1]=", (uint32_t)(_i2s.dma_in_buffer[1]));
-                panic(STR(ASSERT_DMA_BUFFER_ALIGN));
+                // drop blocks recorded while the microphone settled, and the gap left while the model allocated
+                if (!settled)
+                {
+                    if ((int32_t)(block->timestamp - _settleUntil) < 0)
+                    {
+                        _pool.release();
+                        continue;
+                    }
+                    settled = true;
+                    sequence = block->sequence;
+                    metrics->setBootPhase(Metrics::BootMicSettled, millis());
+                }
+
+                // blocks dropped by the DMA handler while the pool was full, or overwritten in the DMA ring while
+                // interrupts were held off (flash erase)
+                if (block->sequence != sequence)
+                {
+                    metrics->addDmaOverrun(block->sequence - sequence);
+                }
+                sequence = block->sequence + 1;
+                if (_sampleClock.update(block->sequence, block->timestamp))
+                {
+                    metrics->setAudioClock(_sampleClock.errorPpm());
+                }
+
+                // after a stall, older blocks only update the spectrogram so the model catches up with the newest one
+                bool infer = (_pool.pending() == 1);
+                processBlock(block, infer);
+                _pool.release();
             }
-#endif // ASSERT_DMA_BUFFER_ALIGN
+        }
+    }
+}
+
+void ThreadAudio::processBlock(const AudioBlock *block, bool infer)
+{
+    auto metrics = Metrics::getInstance();
+    metrics->addAudioBlock();
 
-            _preprocessor->update_spectrum(raw_buffer_ptr);
-            float prediction = _model->inference();
-            thread->postEvent(EventApp, AppInference, 0, float_to_uint32(prediction));
+#if NUM_CHANNELS == 1
+    const int16_t *capture = block->samples[0];
+#else
+    int16_t *capture = get_buffer_ptr();
+    _beamformer.process(block->samples[0], block->samples[1], capture);
+#endif
+
+    _agc.update(capture, AUDIO_CAPTURE_FRAME_LEN, block->clipped);
+    metrics->setAgc(_agc.gain(), _agc.peak(), _agc.rms(), block->clipped);
+
+#ifdef CLOCK_SCALE_ENABLE
+    updateClock();
+    if (_quiet)
+    {
+        metrics->addLowClockBlock();
+    }
+#endif
+
+#if AUDIO_CAPTURE_RATE == AUDIO_SAMPLING_RATE
+    _frameEnd = SampleClock::samples(block->sequence);
+    processFrame(capture, infer);
+#else
+    // a capture block resamples to about AUDIO_FRAME_LEN samples (a little more when AUDIO_CAPTURE_FRAME_LEN was
+    // rounded up), collected into model frames: the leftover then completes an extra frame now and then
+    _frameFill += _resampler.process(capture, AUDIO_CAPTURE_FRAME_LEN, &_frame_buffer[_frameFill]);
+    while (_frameFill >= AUDIO_FRAME_LEN)
+    {
+        // resampled samples beyond the frame came after its end
+        _frameEnd = SampleClock::samples(block->sequence) -
+                    (uint64_t)(_frameFill - AUDIO_FRAME_LEN) * AUDIO_CAPTURE_RATE / AUDIO_SAMPLING_RATE;
+        processFrame(_frame_buffer, infer);
+        _frameFill -= AUDIO_FRAME_LEN;
+        memmove(_frame_buffer, &_frame_buffer[AUDIO_FRAME_LEN], _frameFill * sizeof(int16_t));
+    }
+#endif
+}
+
+void ThreadAudio::processFrame(const int16_t *raw_buffer_ptr, bool infer)
+{
+    auto ctx = reinterpret_cast<AppContext *>(context());
+    auto metrics = Metrics::getInstance();
+
+    // between two hops: this hop and its inference already run on a model uploaded by ThreadNet
+    if (_model->swap())
+    {
+        _preprocessor->attach(_model);
+        metrics->setArena(_model->arena_used_bytes(), _model->arena_size());
+        metrics->setModel(_model->generation(), true);
+    }
+
+    uint32_t t0 = time_us_32();
+    _preprocessor->update_spectrum(raw_buffer_ptr);
+    uint32_t t1 = time_us_32();
+    metrics->addLatency(Metrics::StagePreprocess, t1 - t0);
+
+    publishAudioTap(AudioTap::getInstance(), raw_buffer_ptr);
+#ifdef CLIP_RECORDER_ENABLE
+    if (ClipRecorder::getInstance()->write(raw_buffer_ptr, AUDIO_FRAME_LEN))
+    {
+        metrics->queuePosted(Metrics::QueueNet);
+        ctx->threadNet->postEvent(EventApp, AppClipReady);
+    }
+#endif
+
+#ifdef CLOCK_SCALE_ENABLE
+    if (_quiet)
+    {
+        return; // the spectrogram stays current for the first loud block
+    }
+#endif
+    if (!infer)
+    {
+        metrics->addInferenceSkip();
+        return;
+    }
+
+    uint32_t t2 = time_us_32();
+    float prediction = _model->inference();
+    metrics->addLatency(Metrics::StageInference, time_us_32() - t2);
+    metrics->addInference();
+    metrics->setBootPhase(Metrics::BootFirstInference, millis());
+#ifdef CLOCK_SCALE_ENABLE
+    _lastPrediction = prediction;
+#endif
+
+    // the detection time is the end of the analysed audio, not the end of the inference
+    metrics->queuePosted(Metrics::QueueApp);
+    ctx->threadApp->postEvent(EventApp, AppInference, unit_to_uint16(prediction), (uint32_t)_sampleClock.micros(_frameEnd));
+}
+
+void ThreadAudio::publishAudioTap(AudioTap *audioTap, const int16_t *raw_buffer_ptr)
+{
+    // the frame buffer and the spectrogram move on with the next hop, so the packet takes its own copy
+    AudioTap::Packet *packet = audioTap->claim();
+    if (!packet)
+    {
+        return;
+    }
+    switch (packet->header.type)
+    {
+    case AudioTap::PayloadPcm16:
+        packet->header.length = AUDIO_FRAME_LEN * sizeof(int16_t);
+        packet->header.height = AUDIO_FRAME_LEN;
+        memcpy(packet->payload, raw_buffer_ptr, packet->header.length);
+        break;
+    case AudioTap::PayloadSpectrogram:
+        packet->header.length = SPECTROGRAM_SHIFT * _preprocessor->spectrogram_height();
+        if (packet->header.length > AUDIO_TAP_PAYLOAD_SIZE)
+        {
+            packet->header.length = AUDIO_TAP_PAYLOAD_SIZE;
         }
+        packet->header.height = _preprocessor->spectrogram_height();
+        memcpy(packet->payload, _preprocessor->latest_columns(), packet->header.length);
+        break;
+    default:
+        return;
     }
+    audioTap->commit();
+
+    // packet is handed over by index, ThreadNet sends it to W5100S
+    auto ctx = reinterpret_cast<AppContext *>(context());
+    Metrics::getInstance()->queuePosted(Metrics::QueueNet);
+    ctx->threadNet->postEvent(EventApp, AppAudioTap);
 }
@@ -21,9 +21,19 @@
 #include <mbed.h>
 #include <rtos.h>
 #include "../ArduProfApp.h"
+#include "../audio/Agc.h"
+#include "../audio/i2s.h"
+#include "../audio/pdm.h"
+#include "../audio/PdmDecimator.h"
+#include "../audio/Beamformer.h"
+#include "../audio/AudioBlockPool.h"
+#include "../audio/Resampler.h"
+#include "../audio/SampleClock.h"
+#include "../peripheral/ClockScaler.h"
 
 class AudioModel;
 class PreProcessor;
+class AudioTap;
 
 #if defined ARDUPROF_FREERTOS
 class ThreadAudio : public ardufreertos::ThreadBase
@@ -50,12 +60,48 @@ private:
     PreProcessor *_preprocessor;
 
     rtos::EventFlags _eventFlags;
+    AudioBlockPool _pool;
+    SampleClock _sampleClock;
+    uint64_t _frameEnd; // samples captured at the end of the frame being processed
+    Agc _agc;
+#if NUM_CHANNELS == 2
+    Beamformer _beamformer;
+#endif
+#if AUDIO_CAPTURE_RATE != AUDIO_SAMPLING_RATE
+    Resampler _resampler;
+    size_t _frameFill; // resampled samples in _frame_buffer
+#endif
+#ifdef AUDIO_INPUT_PDM
+    PdmDecimator _pdmDecimator;
+    AudioBlock *_pdmBlock; // block being filled by dma_pdm_in_handler, nullptr when dropped
+    size_t _pdmFill;       // samples decimated into the current block
+#endif
     DmaCallback _dmaCallback;
+    uint32_t _lastDmaUs;   // time_us_32() of the previous DMA interrupt
+    uint8_t _lastDmaIndex; // DMA buffer it served, 0 or 1
+    uint32_t _settleUntil; // time_us_32() after which capture blocks hold valid microphone output
+#ifdef CLOCK_SCALE_ENABLE
+    bool _quiet;           // ProfileLow: spectrogram only, no inference
+    uint32_t _quietBlocks; // consecutive quiet blocks
+    float _lastPrediction;
+#endif
 
     virtual void setup(void);
 
+#if NUM_CHANNELS == 2
     static int16_t *get_buffer_ptr(void);
     static size_t get_buffer_size(void);
+#endif
+#ifdef AUDIO_INPUT_PDM
+    static void dma_pdm_in_handler(void);
+#else
     static void dma_i2s_in_handler(void);
-    bool start_i2s_in(DmaCallback callback);
+#endif
+    bool startCapture(void);
+#ifdef CLOCK_SCALE_ENABLE
+    void updateClock(void);
+#endif
+    void processBlock(const AudioBlock *block, bool infer);
+    void processFrame(const int16_t *raw_buffer_ptr, bool infer);
+    void publishAudioTap(AudioTap *audioTap, const int16_t *raw_buffer_ptr);
 };
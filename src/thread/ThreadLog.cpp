@@ -0,0 +1,105 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <Arduino.h>
+#include <mbed.h>
+#include <rtos.h>
+
+#include "./ThreadLog.h"
+#include "../AppContext.h"
+#include "../util/util.h"
+#include "../util/BinLog.h"
+
+#define DRAIN_INTERVAL 20ms // ring holds BINLOG_RING_SIZE records between drains
+
+////////////////////////////////////////////////////////////////////////////////////////////
+ThreadLog *ThreadLog::_instance = nullptr;
+
+ThreadLog *ThreadLog::getInstance(void)
+{
+    if (!_instance)
+    {
+        static ThreadLog instance;
+        _instance = &instance;
+    }
+    return _instance;
+}
+
+#if defined ARDUPROF_MBED && defined ARDUINO_ARCH_MBED_RP2040
+////////////////////////////////////////////////////////////////////////////////////////////
+// Thread for Mbed RP2040
+////////////////////////////////////////////////////////////////////////////////////////////
+ThreadLog::ThreadLog() : ardumbedos::ThreadBase(nullptr, osPriorityLow) // no queue for log thread
+{
+}
+
+void ThreadLog::start(void *ctx)
+{
+    LOG_TRACE("core", get_core_num(), ", ctx=(hex)", DebugLogBase::HEX, (uint32_t)ctx);
+
+    ThreadBase::start(ctx);
+    _thread.start(mbed::callback(this, &ThreadLog::run));
+}
+#endif
+
+// Frame: SYNC0 SYNC1 id(2) nargs(1) checksum(1) timestamp(4) args(4 * nargs), little endian.
+// checksum makes the XOR of every byte after the sync marker zero.
+void ThreadLog::run(void)
+{
+    setup();
+
+    auto binlog = BinLog::getInstance();
+    BinLog::Record record;
+    uint8_t frame[4 + sizeof(record)];
+
+    while (true)
+    {
+        auto stream = binlog->stream();
+        uint32_t lost = binlog->takeLost();
+        if (lost)
+        {
+            BINLOG(BL_LOST, lost);
+        }
+
+        while (binlog->read(&record))
+        {
+            size_t size = 8 + 4 * record.nargs;
+            frame[0] = BINLOG_SYNC0;
+            frame[1] = BINLOG_SYNC1;
+            memcpy(&frame[2], &record.id, sizeof(record.id));
+            frame[4] = record.nargs;
+            frame[5] = 0;
+            memcpy(&frame[6], &record.timestamp, 4 + 4 * record.nargs);
+
+            uint8_t checksum = 0;
+            for (size_t i = 2; i < size + 2; i++)
+            {
+                checksum ^= frame[i];
+            }
+            frame[5] = checksum;
+
+            if (stream)
+            {
+                stream->write(frame, size + 2);
+            }
+        }
+
+        rtos::ThisThread::sleep_for(DRAIN_INTERVAL);
+    }
+}
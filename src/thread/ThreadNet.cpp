@@ -21,11 +21,19 @@
 #include <mbed.h>
 #include <EventEthernet.h>
 #include <utility/w5100.h>
+#include "hardware/timer.h"
 
 #include "./ThreadNet.h"
 #include "../AppContext.h"
 #include "../pins.h"
 #include "../util/util.h"
+#include "../util/AudioTap.h"
+#include "../audio/ClipRecorder.h"
+#include "../util/Metrics.h"
+#include "../util/BinLog.h"
+#include "../util/LinkManager.h"
+#include "../util/Sntp.h"
+#include "../peripheral/W5100sSpi.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 // Disable Logging Macro (Release Mode)
@@ -179,13 +187,24 @@ ThreadNet::ThreadNet() : ardumbedos::ThreadBase(&threadQueue),
                          _handlerMap(),
                          //  _inferenceState(InferenceUnknown),
                          _state({0}),
+                         _pendingAlert(InferenceUnknown),
+                         _pendingAlertUs(0),
+                         _sendingAlertUs(0),
+                         _alarmUs(0),
                          _callmebot([](Callmebot::MessageState state)
                                     {
                                         LOG_TRACE("Callmebot state=", state);
                                         auto instance = getInstance();
+                                        Metrics::getInstance()->queuePosted(Metrics::QueueNet);
                                         instance->postEvent(EventApp, AppCallmebotState, (uint32_t)state, 0);
                                         //
-                                    })
+                                    }),
+                         _clipUploader([](ClipUploader::UploadState state)
+                                       {
+                                           LOG_TRACE("ClipUploader state=", state);
+                                           //
+                                       }),
+                         _metricsServer()
 /////////////////////////////////////////////////////////////////////////////
 // threadQueue is dynamically allocate from heap
 // ThreadApp::ThreadApp() : ThreadBase(THREAD_QUEUE_SIZE),
@@ -215,15 +234,22 @@ void ThreadNet::setup(void)
 
     queue()->call_every(std::chrono::seconds(1), [this]()
                         {
+                            Metrics::getInstance()->queuePosted(Metrics::QueueNet);
                             postEvent(EventSystem, SysSoftwareTimer, 0, (uint32_t)TIMER_1HZ);
                             //
                         });
+    queue()->call_every(std::chrono::milliseconds(LINK_POLL_MS), [this]()
+                        {
+                            Metrics::getInstance()->queuePosted(Metrics::QueueNet);
+                            postEvent(EventSystem, SysSoftwareTimer, 0, (uint32_t)TIMER_LINK);
+                            //
+                        });
 }
 
 /////////////////////////////////////////////////////////////////////////////
 void ThreadNet::onEthernetEvent(uint8_t ir, uint8_t ir2, uint8_t slir)
 {
-    LOG_DEBUG("ir=(hex)", DebugLogBase::HEX, ir, ", ir2=(hex)", ir2, ", slir=(hex)", slir);
+    BINLOG(BL_ETH_IR, ir, ir2, slir);
     auto instance = getInstance();
     EthIR ethIR = {
         .data = {
@@ -231,6 +257,7 @@ void ThreadNet::onEthernetEvent(uint8_t ir, uint8_t ir2, uint8_t slir)
             .ir2 = ir2,
             .slir = slir,
         }};
+    Metrics::getInstance()->queuePosted(Metrics::QueueNet);
     instance->postEvent(EventSystem, SysEthIf, 0, ethIR.word);
 }
 
@@ -245,39 +272,82 @@ void ThreadNet::initEth(void)
     uint8_t ir = IR::CONFLICT | IR::UNREACH | IR::PPPTERM;
     uint8_t ir2 = IR2::WOL;
     uint8_t slir = SLIR::TIMEOUT | SLIR::ARP | SLIR::PING;
-    while (Ethernet.begin(mac, ir, ir2, slir, onEthernetEvent) == 0)
+
+    // DHCP now, then LinkManager::update() keeps the link up (TIMER_LINK)
+    LinkManager::getInstance()->begin(mac, ir, ir2, slir, onEthernetEvent, onLinkEvent);
+}
+
+void ThreadNet::onLinkEvent(LinkManager::LinkEvent event)
+{
+    // called from LinkManager::update() / begin() / interrupt(), i.e. on ThreadNet
+    getInstance()->handlerLinkEvent(event);
+}
+
+void ThreadNet::handlerLinkEvent(LinkManager::LinkEvent event)
+{
+    auto ctx = static_cast<AppContext *>(context());
+    if (event == LinkManager::LinkDown)
     {
-        LOG_DEBUG("Failed to configure Ethernet using DHCP");
+        LOG_DEBUG("link down");
+        _state.netIfUp = false;
 
-        // Check for Ethernet hardware present
-        if (Ethernet.hardwareStatus() == EthernetNoHardware)
+        // requests in flight die with the link: keep them for the recovery
+        Sntp::getInstance()->abort();
+        if (_callmebot.busy())
         {
-            LOG_ERROR("Ethernet was not found. Sorry, can't run without hardware. :(");
+            _callmebot.abort();
         }
-        else if (Ethernet.linkStatus() == LinkOFF)
+        if (_clipUploader.busy())
         {
-            LOG_DEBUG("Ethernet cable is not connected");
+            _clipUploader.abort();
+            _state.clipPending = true;
         }
+        Metrics::getInstance()->queuePosted(Metrics::QueueApp);
+        postEvent(ctx->threadApp, EventApp, AppEthDn);
+        return;
+    }
 
-        rtos::ThisThread::sleep_for(1s);
-        // delay(1000);
+    LOG_DEBUG("link up, localIP(): ", Ethernet.localIP(), ", recovered in ", LinkManager::getInstance()->stats().recoveryMs, " ms");
+    if (!W5100sSpi::getInstance()->begin())
+    {
+        LOG_ERROR("W5100sSpi::begin() failed: no DMA channel");
+    }
+    _state.netIfUp = true;
+    if (!_state.bootNetUp)
+    {
+        _state.bootNetUp = true;
+        Metrics::getInstance()->setBootPhase(Metrics::BootNetUp, millis());
     }
+    Metrics::getInstance()->queuePosted(Metrics::QueueApp);
+    postEvent(ctx->threadApp, EventApp, AppEthUp);
 
-    LOG_DEBUG("localIP(): ", Ethernet.localIP());
-    LOG_DEBUG("dnsServerIP(): ", Ethernet.dnsServerIP());
+    if (event == LinkManager::LinkUp)
+    {
+        // DHCP reset the chip: listen and stream again
+        _metricsServer.begin();
+#if AUDIO_TAP_MODE != AUDIO_TAP_OFF
+        static const IPAddress collectorIP(AUDIO_TAP_COLLECTOR_IP);
+        AudioTap::getInstance()->begin(collectorIP, AUDIO_TAP_COLLECTOR_PORT, static_cast<AudioTap::PayloadType>(AUDIO_TAP_MODE));
+#endif
+    }
 
-    static const IPAddress NullIP(0, 0, 0, 0);
-    if (Ethernet.localIP() != NullIP)
+    // deliver what the outage held back now, not at the next alert
+    if (getAlertText(_pendingAlert) && !_callmebot.busy())
     {
-        _state.netIfUp = true;
-        auto ctx = static_cast<AppContext *>(context());
-        postEvent(ctx->threadApp, EventApp, AppEthUp);
+        sendAlert();
     }
+    if (_state.clipPending)
+    {
+        _state.clipPending = false;
+        _clipUploader.upload(ClipRecorder::getInstance(), _alarmUs);
+    }
+    pollSntp(); // the clock ran free during the outage
 }
 
 /////////////////////////////////////////////////////////////////////////////
 void ThreadNet::onMessage(const Message &msg)
 {
+    Metrics::getInstance()->queueHandled(Metrics::QueueNet);
     // LOG_TRACE("event=", msg.event, ", iParam=", msg.iParam, ", uParam=", msg.uParam, ", lParam=", msg.lParam);
     auto func = _handlerMap[msg.event];
     if (func)
@@ -293,27 +363,75 @@ void ThreadNet::onMessage(const Message &msg)
 /////////////////////////////////////////////////////////////////////////////
 __EVENT_FUNC_DEFINITION(ThreadNet, EventApp, msg) // void ThreadNet::handlerEventApp(const Message &msg)
 {
-    LOG_TRACE("EventApp(", msg.event, "), iParam=", msg.iParam, ", uParam=", msg.uParam, ", lParam=", msg.lParam);
     auto src = static_cast<AppTriggerSource>(msg.iParam);
+    if (src == AppAudioTap)
+    {
+        // hot path: ~31 blocks per second, do not log
+        AudioTap::getInstance()->flush();
+        return;
+    }
+
+    LOG_TRACE("EventApp(", msg.event, "), iParam=", msg.iParam, ", uParam=", msg.uParam, ", lParam=", msg.lParam);
     switch (src)
     {
     case AppInference:
     {
         auto inferenceState = static_cast<InferenceState>(msg.uParam);
-        auto text = getAlertText(inferenceState);
-        if (text)
+        if (!getAlertText(inferenceState))
         {
-            _callmebot.send(text);
+            break;
         }
+        // lParam holds the low 32 bits of the detection time, a few milliseconds old
+        uint64_t now = time_us_64();
+        uint64_t detectedUs = now - (uint32_t)((uint32_t)now - msg.lParam);
+        Metrics::getInstance()->addAlertLatency(Metrics::AlertDispatch, (uint32_t)((now - detectedUs) / 1000));
+        if (inferenceState == InferenceAlarmOn)
+        {
+            _alarmUs = detectedUs;
+        }
+
+        // the latest alert is kept until delivered: sent as soon as the link is up (again)
+        _pendingAlert = inferenceState;
+        _pendingAlertUs = detectedUs;
+        if (!_state.netIfUp)
+        {
+            LOG_TRACE("network not up, alert pending");
+            break;
+        }
+        sendAlert();
         // rtos::ThisThread::sleep_for(1s);
         break;
     }
 
+    case AppClipReady:
+        if (!_state.netIfUp)
+        {
+            _state.clipPending = true; // keep the clip frozen, uploaded on recovery
+            break;
+        }
+        _clipUploader.upload(ClipRecorder::getInstance(), _alarmUs);
+        break;
+
     case AppCallmebotState:
     {
         auto callmebotState = static_cast<Callmebot::MessageState>(msg.uParam);
         LOG_TRACE("Callmebot state=", callmebotState);
         _state.callmebotReady = (callmebotState == Callmebot::Sending);
+        if ((callmebotState == Callmebot::SentSuccess) || (callmebotState == Callmebot::SentFail))
+        {
+            Metrics::getInstance()->addAlert(callmebotState == Callmebot::SentSuccess);
+            if ((callmebotState == Callmebot::SentSuccess) && _sendingAlertUs)
+            {
+                uint32_t ms = (uint32_t)((time_us_64() - _sendingAlertUs) / 1000);
+                LOG_DEBUG("alert delivered ", ms, " ms after detection");
+                Metrics::getInstance()->addAlertLatency(Metrics::AlertDelivery, ms);
+            }
+            _sendingAlertUs = 0;
+            if (_state.netIfUp && !_callmebot.busy())
+            {
+                _pendingAlert = InferenceUnknown; // delivered, or refused by a reachable server
+            }
+        }
         break;
     }
 
@@ -356,6 +474,18 @@ void ThreadNet::handlerSoftwareTimer(uint32_t xTimer)
     {
         // LOG_TRACE("_timer1Hz");
         _callmebot.update();
+        _clipUploader.update();
+        _metricsServer.update();
+        pollSntp();
+    }
+    else if (xTimer == TIMER_LINK)
+    {
+        LinkManager::getInstance()->update();
+    }
+    else if (xTimer == TIMER_SNTP)
+    {
+        _state.sntpTimer = false;
+        pollSntp();
     }
     else
     {
@@ -372,20 +502,24 @@ void ThreadNet::handlerEthIf(uint32_t ethIR)
     auto ir = regs.data.ir;
     auto ir2 = regs.data.ir2;
     auto slir = regs.data.slir;
+    auto metrics = Metrics::getInstance();
 
     ///////////////////////////////////////////////////////////////////////
     // Interrupt Register event
     if (ir & IR::CONFLICT)
     {
         LOG_DEBUG("Ir::CONFLICT");
+        metrics->addEthEvent(Metrics::EthConflict);
     }
     if (ir & IR::UNREACH)
     {
         LOG_DEBUG("Ir::UNREACH");
+        metrics->addEthEvent(Metrics::EthUnreach);
     }
     if (ir & IR::PPPTERM)
     {
         LOG_DEBUG("Ir::PPPTERM");
+        metrics->addEthEvent(Metrics::EthPppTerm);
     }
 
     ///////////////////////////////////////////////////////////////////////
@@ -393,6 +527,7 @@ void ThreadNet::handlerEthIf(uint32_t ethIR)
     if (ir2 & IR2::WOL)
     {
         LOG_DEBUG("Ir2::WOL");
+        metrics->addEthEvent(Metrics::EthWol);
     }
 
     ///////////////////////////////////////////////////////////////////////
@@ -400,15 +535,20 @@ void ThreadNet::handlerEthIf(uint32_t ethIR)
     if (slir & SLIR::TIMEOUT)
     {
         LOG_DEBUG("Slir::TIMEOUT");
+        metrics->addEthEvent(Metrics::EthTimeout);
     }
     if (slir & SLIR::ARP)
     {
         LOG_DEBUG("Slir::ARP");
+        metrics->addEthEvent(Metrics::EthArp);
     }
     if (slir & SLIR::PING)
     {
         LOG_DEBUG("Slir::PING");
+        metrics->addEthEvent(Metrics::EthPing);
     }
+
+    LinkManager::getInstance()->interrupt(ir, slir);
 }
 
 const char *ThreadNet::getAlertText(InferenceState state)
@@ -422,4 +562,44 @@ const char *ThreadNet::getAlertText(InferenceState state)
     default:
         return nullptr;
     }
-}
\ No newline at end of file
+}
+void ThreadNet::sendAlert(void)
+{
+    // absolute time once SNTP is synchronised, so the receiver can tell the delivery latency; until
+    // then the age of the detection
+    char text[MESSAGE_TEXT_SIZE / 2];
+    int len = snprintf(text, sizeof(text), "%s", getAlertText(_pendingAlert));
+    auto sntp = Sntp::getInstance();
+    if (sntp->synced())
+    {
+        len += snprintf(text + len, sizeof(text) - len, " at ");
+        Sntp::format(text + len, sizeof(text) - len, sntp->utc(_pendingAlertUs));
+    }
+    else
+    {
+        snprintf(text + len, sizeof(text) - len, " %lu ms ago", (unsigned long)((time_us_64() - _pendingAlertUs) / 1000));
+    }
+    _sendingAlertUs = _pendingAlertUs;
+    _callmebot.send(text);
+}
+
+void ThreadNet::pollSntp(void)
+{
+    if (!_state.netIfUp)
+    {
+        return;
+    }
+    auto sntp = Sntp::getInstance();
+    sntp->update();
+    if (sntp->waiting() && !_state.sntpTimer)
+    {
+        // polled every SNTP_WAIT_MS until the reply or the timeout
+        _state.sntpTimer = true;
+        queue()->call_in(std::chrono::milliseconds(SNTP_WAIT_MS), [this]()
+                         {
+                             Metrics::getInstance()->queuePosted(Metrics::QueueNet);
+                             postEvent(EventSystem, SysSoftwareTimer, 0, (uint32_t)TIMER_SNTP);
+                             //
+                         });
+    }
+}
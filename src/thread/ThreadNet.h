@@ -23,6 +23,9 @@
 #include "../ArduProfApp.h"
 #include "../AppEvent.h"
 #include "../util/Callmebot.h"
+#include "../util/ClipUploader.h"
+#include "../util/MetricsServer.h"
+#include "../util/LinkManager.h"
 
 #if defined ARDUPROF_FREERTOS
 class ThreadNet : public ardufreertos::ThreadBase
@@ -32,6 +35,8 @@ class ThreadNet : public ardumbedos::ThreadBase
 {
 public:
     static const uint32_t TIMER_1HZ = 1;
+    static const uint32_t TIMER_LINK = 2; // every LINK_POLL_MS
+    static const uint32_t TIMER_SNTP = 3; // every SNTP_WAIT_MS while a reply is awaited
 
     ThreadNet();
     static ThreadNet *getInstance(void);
@@ -49,17 +54,30 @@ private:
     {
         uint32_t netIfUp : 1;        // network interface is up
         uint32_t callmebotReady : 1; // callmebot is ready
+        uint32_t clipPending : 1;    // a frozen clip waits for the link to come back
+        uint32_t bootNetUp : 1;      // the first lease is recorded as boot phase
+        uint32_t sntpTimer : 1;      // a TIMER_SNTP is scheduled
     } _state;
+    InferenceState _pendingAlert; // last alert not yet delivered, InferenceUnknown: none
+    uint64_t _pendingAlertUs;     // detection time of _pendingAlert, time_us_64()
+    uint64_t _sendingAlertUs;     // detection time of the alert Callmebot is sending, 0: none
+    uint64_t _alarmUs;            // detection time of the last alarm, whose clip ClipRecorder records
     Callmebot _callmebot;
+    ClipUploader _clipUploader;
+    MetricsServer _metricsServer;
 
     static void onEthernetEvent(uint8_t ir, uint8_t ir2, uint8_t slir);
+    static void onLinkEvent(LinkManager::LinkEvent event);
 
     virtual void setup(void);
 
     void handlerSoftwareTimer(uint32_t xTimer);
     void handlerEthIf(uint32_t ethIR);
+    void handlerLinkEvent(LinkManager::LinkEvent event);
     void initEth(void);
     const char *getAlertText(InferenceState state);
+    void sendAlert(void);
+    void pollSntp(void);
 
     ///////////////////////////////////////////////////////////////////////
     // declare event handler
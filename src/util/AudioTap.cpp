@@ -0,0 +1,124 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "./AudioTap.h"
+#include "../ArduProfApp.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////
+AudioTap *AudioTap::_instance = nullptr;
+
+AudioTap *AudioTap::getInstance(void)
+{
+    if (!_instance)
+    {
+        static AudioTap instance;
+        _instance = &instance;
+    }
+    return _instance;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+AudioTap::AudioTap() : _udp(),
+                       _ip(),
+                       _port(0),
+                       _type(PayloadNone),
+                       _head(0),
+                       _tail(0),
+                       _dropped(0),
+                       _sequence(0)
+{
+}
+
+bool AudioTap::begin(const IPAddress &ip, uint16_t port, PayloadType type)
+{
+    if (type == PayloadNone)
+    {
+        return false;
+    }
+    if (!_udp.begin(AUDIO_TAP_LOCAL_PORT))
+    {
+        LOG_TRACE("_udp.begin() failed! port=", AUDIO_TAP_LOCAL_PORT);
+        return false;
+    }
+
+    _ip = ip;
+    _port = port;
+    _tail.store(_head.load(std::memory_order_acquire), std::memory_order_release);
+    _type.store(type, std::memory_order_release); // enable producer last
+    LOG_TRACE("streaming type=", (uint32_t)type, " to ", ip, ":", port);
+    return true;
+}
+
+void AudioTap::end(void)
+{
+    _type.store(PayloadNone, std::memory_order_release);
+    _udp.stop();
+}
+
+AudioTap::Packet *AudioTap::claim(void)
+{
+    uint8_t type = _type.load(std::memory_order_acquire);
+    if (type == PayloadNone)
+    {
+        return nullptr;
+    }
+
+    uint32_t sequence = _sequence++;
+    uint32_t head = _head.load(std::memory_order_relaxed);
+    if ((head - _tail.load(std::memory_order_acquire)) >= AUDIO_TAP_POOL_SIZE)
+    {
+        // all packets are in flight, drop the block rather than block the audio thread
+        _dropped.store(_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); // single writer, no RMW needed on M0+
+        return nullptr;
+    }
+
+    Packet *packet = &_pool[head & (AUDIO_TAP_POOL_SIZE - 1)];
+    packet->header.magic = AUDIO_TAP_MAGIC;
+    packet->header.version = AUDIO_TAP_VERSION;
+    packet->header.type = type;
+    packet->header.sequence = sequence;
+    packet->header.sample_rate = AUDIO_SAMPLING_RATE;
+    return packet;
+}
+
+void AudioTap::commit(void)
+{
+    // hand over the packet to consumer
+    _head.store(_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+int AudioTap::flush(void)
+{
+    int count = 0;
+    uint32_t tail = _tail.load(std::memory_order_relaxed);
+    while (tail != _head.load(std::memory_order_acquire))
+    {
+        const Packet *packet = &_pool[tail & (AUDIO_TAP_POOL_SIZE - 1)];
+        if (_udp.beginPacket(_ip, _port))
+        {
+            _udp.write((const uint8_t *)packet, sizeof(packet->header) + packet->header.length);
+            _udp.endPacket();
+        }
+        count++;
+
+        // return the packet to producer
+        _tail.store(++tail, std::memory_order_release);
+    }
+    return count;
+}
@@ -0,0 +1,110 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <Arduino.h>
+#include <atomic>
+#include <EventEthernet.h>
+
+#include "../audio/audio_const.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// select payload streamed by the audio tap
+#define AUDIO_TAP_OFF 0
+#define AUDIO_TAP_PCM 1         // raw int16 audio blocks from ThreadAudio
+#define AUDIO_TAP_SPECTROGRAM 2 // int8 spectrogram columns from PreProcessor
+
+#define AUDIO_TAP_MODE AUDIO_TAP_OFF
+
+#define AUDIO_TAP_COLLECTOR_IP 192, 168, 0, 100 // IP address of the host running tools/audio_tap_receiver.py
+#define AUDIO_TAP_COLLECTOR_PORT 5005
+#define AUDIO_TAP_LOCAL_PORT 5005
+
+#define AUDIO_TAP_POOL_SIZE 4 // number of packets in the pool, must be power of 2
+#define AUDIO_TAP_PAYLOAD_SIZE (AUDIO_FRAME_LEN * sizeof(int16_t))
+#define AUDIO_TAP_MAGIC 0x50415441 // "ATAP" in little endian
+#define AUDIO_TAP_VERSION 1
+
+static_assert((AUDIO_TAP_POOL_SIZE & (AUDIO_TAP_POOL_SIZE - 1)) == 0, "AUDIO_TAP_POOL_SIZE must be power of 2");
+
+// Single producer (ThreadAudio) / single consumer (ThreadNet) packet pool.
+// The producer never blocks: if every packet is in flight, the block is dropped and counted.
+class AudioTap
+{
+public:
+    enum PayloadType : uint8_t
+    {
+        PayloadNone = AUDIO_TAP_OFF,
+        PayloadPcm16 = AUDIO_TAP_PCM,
+        PayloadSpectrogram = AUDIO_TAP_SPECTROGRAM,
+    };
+
+    typedef struct __attribute__((packed)) _Header
+    {
+        uint32_t magic;       // AUDIO_TAP_MAGIC
+        uint8_t version;      // AUDIO_TAP_VERSION
+        uint8_t type;         // PayloadType
+        uint16_t length;      // payload length in bytes
+        uint32_t sequence;    // incremented on every published block, including dropped ones
+        uint16_t sample_rate; // AUDIO_SAMPLING_RATE
+        uint16_t height;      // PCM: samples per block; spectrogram: bins per column
+    } Header;
+    static_assert(sizeof(Header) == 16, "sizeof(AudioTap::Header) must be 16 bytes");
+
+    typedef struct _Packet
+    {
+        Header header;
+        uint8_t payload[AUDIO_TAP_PAYLOAD_SIZE];
+    } Packet;
+
+    AudioTap();
+
+    static AudioTap *getInstance(void);
+
+    bool begin(const IPAddress &ip, uint16_t port, PayloadType type);
+    void end(void);
+
+    inline uint32_t dropped(void) const
+    {
+        return _dropped.load(std::memory_order_relaxed);
+    }
+
+    // called by producer (ThreadAudio): returns the packet to fill in place, with magic, version, type,
+    // sequence and sample_rate set, or nullptr when the tap is off or every packet is still in flight
+    Packet *claim(void);
+    // called by producer (ThreadAudio): hands the packet filled after claim() to the consumer
+    void commit(void);
+
+    // called by consumer (ThreadNet), returns number of packets sent
+    int flush(void);
+
+private:
+    static AudioTap *_instance;
+
+    EthernetUDP _udp;
+    IPAddress _ip;
+    uint16_t _port;
+    std::atomic<uint8_t> _type; // PayloadType, written by ThreadNet, read by ThreadAudio
+
+    Packet _pool[AUDIO_TAP_POOL_SIZE];
+    std::atomic<uint32_t> _head; // written by producer only
+    std::atomic<uint32_t> _tail; // written by consumer only
+    std::atomic<uint32_t> _dropped;
+    uint32_t _sequence;
+};
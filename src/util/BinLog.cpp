@@ -0,0 +1,93 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <mbed.h>
+#include "./BinLog.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////
+BinLog *BinLog::_instance = nullptr;
+
+BinLog *BinLog::getInstance(void)
+{
+    if (!_instance)
+    {
+        static BinLog instance;
+        _instance = &instance;
+    }
+    return _instance;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+BinLog::BinLog() : _ring(),
+                   _head(0),
+                   _tail(0),
+                   _lost(0),
+                   _stream(nullptr)
+{
+}
+
+void BinLog::write(uint16_t id, uint32_t nargs, const uint32_t *args)
+{
+    uint32_t timestamp = time_us_32();
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t head = _head;
+    if ((head - _tail) >= BINLOG_RING_SIZE)
+    {
+        _lost = _lost + 1;
+    }
+    else
+    {
+        Record *record = &_ring[head & (BINLOG_RING_SIZE - 1)];
+        record->id = id;
+        record->nargs = nargs;
+        record->timestamp = timestamp;
+        for (uint32_t i = 0; i < nargs; i++)
+        {
+            record->args[i] = args[i];
+        }
+        _head = head + 1;
+    }
+    __set_PRIMASK(primask);
+}
+
+bool BinLog::read(Record *record)
+{
+    uint32_t tail = _tail;
+    if (tail == _head)
+    {
+        return false;
+    }
+    std::atomic_signal_fence(std::memory_order_acquire);
+    *record = _ring[tail & (BINLOG_RING_SIZE - 1)];
+    std::atomic_signal_fence(std::memory_order_release);
+    _tail = tail + 1;
+    return true;
+}
+
+uint32_t BinLog::takeLost(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t lost = _lost;
+    _lost = 0;
+    __set_PRIMASK(primask);
+    return lost;
+}
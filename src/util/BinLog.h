@@ -0,0 +1,112 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <Arduino.h>
+#include <atomic>
+#include "hardware/timer.h"
+
+#include "./BinLogMessages.h"
+#include "./util.h"
+
+#define BINLOG_ENABLE // comment out to compile BINLOG() calls out
+
+#define BINLOG_RING_SIZE 64 // number of records, must be power of 2
+#define BINLOG_MAX_ARGS 5
+#define BINLOG_SYNC0 0xA5 // frame marker, lets the decoder pick frames out of mixed text output
+#define BINLOG_SYNC1 0x5A
+
+static_assert((BINLOG_RING_SIZE & (BINLOG_RING_SIZE - 1)) == 0, "BINLOG_RING_SIZE must be power of 2");
+
+#define BINLOG_ENUM(id, format) id,
+enum BinLogId : uint16_t
+{
+    BINLOG_MESSAGES(BINLOG_ENUM) //
+    BinLogIdCount,
+};
+#undef BINLOG_ENUM
+
+// Deferred binary logger: call sites store a message id and raw 32-bit arguments into a ring,
+// ThreadLog formats nothing and streams the records as frames to the attached serial port.
+// Writers mask interrupts for the few stores of a record (RP2040 Mbed runs on a single core),
+// so any thread or ISR may log without a mutex.
+class BinLog
+{
+public:
+    typedef struct _Record
+    {
+        uint16_t id;
+        uint8_t nargs;
+        uint8_t reserved;
+        uint32_t timestamp; // time_us_32()
+        uint32_t args[BINLOG_MAX_ARGS];
+    } Record;
+
+    BinLog();
+
+    static BinLog *getInstance(void);
+
+    void write(uint16_t id, uint32_t nargs, const uint32_t *args);
+
+    // called by ThreadLog only, returns false if ring is empty
+    bool read(Record *record);
+
+    inline void attach(Stream *stream)
+    {
+        _stream = stream;
+    }
+    inline Stream *stream(void) const
+    {
+        return _stream;
+    }
+    uint32_t takeLost(void);
+
+private:
+    static BinLog *_instance;
+
+    Record _ring[BINLOG_RING_SIZE];
+    volatile uint32_t _head;
+    volatile uint32_t _tail;
+    volatile uint32_t _lost;
+    Stream *_stream;
+};
+
+inline uint32_t binlog_arg(float value)
+{
+    return float_to_uint32(value);
+}
+template <typename T>
+inline uint32_t binlog_arg(T value)
+{
+    return (uint32_t)value;
+}
+
+template <typename... Args>
+inline void binlog(uint16_t id, Args... args)
+{
+    static_assert(sizeof...(args) <= BINLOG_MAX_ARGS, "too many BINLOG() arguments");
+    const uint32_t values[] = {0, binlog_arg(args)...};
+    BinLog::getInstance()->write(id, sizeof...(args), &values[1]);
+}
+
+#ifdef BINLOG_ENABLE
+#define BINLOG(id, ...) binlog(id, ##__VA_ARGS__)
+#else
+#define BINLOG(id, ...)
+#endif
@@ -0,0 +1,38 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+// Binary log messages: X(id, format)
+// The id is the position in this list, so tools/binlog_decode.py parses this file to rebuild the text.
+// Append new messages at the end and keep one X() per line.
+// Supported conversions: %d %u %x (32-bit integer), %f (float bits), %I (IPv4 address)
+#define BINLOG_MESSAGES(X)                                                                          \
+    X(BL_LOST, "binlog: %u records lost")                                                           \
+    X(BL_ETH_IR, "ThreadNet::onEthernetEvent: ir=0x%x, ir2=0x%x, slir=0x%x")                        \
+    X(BL_TCP_IR, "Callmebot::onTcpClientEvent: SnIR=0x%x")                                          \
+    X(BL_CALLMEBOT_CONNECTING, "Callmebot: Connecting: time=%u seconds")                            \
+    X(BL_CALLMEBOT_CONNECTED, "Callmebot: Connected: time=%u seconds")                              \
+    X(BL_HTTP_RX, "Callmebot::readHttpResponse: received %u bytes from %I:%u")                      \
+    X(BL_HTTP_STATUS, "Callmebot::readHttpResponse: HTTP Status Code: %d")                          \
+    X(BL_PIO_DIV, "pio_div: clk=%u, freq=%u, div=%u, frac=%u, error=%d ppb")                          \
+    X(BL_DMA_ADDR, "ThreadAudio::dma_i2s_in_handler: block dropped, src=0x%x, buffer=0x%x, 0x%x")   \
+    X(BL_LINK_STATE, "LinkManager: state %u -> %u, cause=%u")                                       \
+    X(BL_SNTP_SYNC, "Sntp: error=%d us, delay=%u us, drift=%d ppb")                                 \
+    X(BL_SNTP_FAIL, "Sntp: poll failed, cause=%u")
@@ -20,6 +20,8 @@
 #include <UrlEncode.h>
 #include "Callmebot.h"
 #include "../ArduProfApp.h"
+#include "./BinLog.h"
+#include "../peripheral/W5100sSpi.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 const char Callmebot::_apiHost[] = CALLMEBOT_HOST;
@@ -87,7 +89,7 @@ void Callmebot::update(void)
         }
         else
         {
-            LOG_TRACE("Connecting: time=", _connectTimeout, " seconds");
+            BINLOG(BL_CALLMEBOT_CONNECTING, _connectTimeout);
         }
         break;
     }
@@ -118,7 +120,7 @@ void Callmebot::update(void)
         }
         else
         {
-            LOG_TRACE("Connected: time=", _connectTimeout, " seconds");
+            BINLOG(BL_CALLMEBOT_CONNECTED, _connectTimeout);
         }
         break;
     }
@@ -129,44 +131,33 @@ void Callmebot::update(void)
     }
 }
 
-void Callmebot::onTcpClientEvent(uint8_t sr_ir)
+void Callmebot::abort(void)
 {
-    if (sr_ir & SnIR::SEND_OK)
-    {
-        LOG_DEBUG("SnIR::SEND_OK");
-    }
-    if (sr_ir & SnIR::TIMEOUT)
-    {
-        LOG_DEBUG("SnIR::TIMEOUT");
-    }
-    if (sr_ir & SnIR::RECV)
-    {
-        LOG_DEBUG("SnIR::RECV");
-    }
-    if (sr_ir & SnIR::DISCON)
+    if (_tcpState != Ready)
     {
-        LOG_DEBUG("SnIR::DISCON");
-    }
-    if (sr_ir & SnIR::CON)
-    {
-        LOG_DEBUG("SnIR::CON");
+        _tcpClient.stop();
+        _tcpState = Ready;
     }
 }
 
+void Callmebot::onTcpClientEvent(uint8_t sr_ir)
+{
+    // SnIR bits: CON=0x01, DISCON=0x02, RECV=0x04, TIMEOUT=0x08, SEND_OK=0x10
+    BINLOG(BL_TCP_IR, sr_ir);
+}
+
 bool Callmebot::readHttpResponse(int *ptrResponseCode)
 {
     int tcpSize = _tcpClient.available();
     while (tcpSize > 0)
     {
-        LOG_DEBUG("tcpSize=", tcpSize);
         if (tcpSize >= sizeof(_shareRxBuf))
         {
             tcpSize = sizeof(_shareRxBuf) - 1; // truncate data if oversize
         }
         _tcpClient.read(_shareRxBuf, tcpSize);
         _shareRxBuf[tcpSize] = '\0';
-        LOG_DEBUG("Received ", tcpSize, " bytes from ", _tcpClient.remoteIP(), ":", _tcpClient.remotePort());
-        LOG_DEBUG("Content: ", (const char *)_shareRxBuf);
+        BINLOG(BL_HTTP_RX, tcpSize, (uint32_t)_tcpClient.remoteIP(), _tcpClient.remotePort());
 
         if (!_isHttpStatusLineReceived)
         {
@@ -177,7 +168,7 @@ bool Callmebot::readHttpResponse(int *ptrResponseCode)
 
                 int responseCode;
                 sscanf(strResponseCode, "HTTP/%*d.%*d %d", &responseCode);
-                LOG_DEBUG("HTTP Status Code: ", responseCode);
+                BINLOG(BL_HTTP_STATUS, responseCode);
 
                 *ptrResponseCode = responseCode;
                 return true;
@@ -186,7 +177,6 @@ bool Callmebot::readHttpResponse(int *ptrResponseCode)
 
         tcpSize = _tcpClient.available();
     }
-    LOG_DEBUG("tcpSize=", tcpSize);
     return false;
 }
 
@@ -194,14 +184,13 @@ void Callmebot::writeText(const char *text)
 {
     // LOG_DEBUG("_messageText=", text);
 
-    // Make a HTTP request:
-    _tcpClient.print("GET ");
-    _tcpClient.print(text);
-    _tcpClient.println(" HTTP/1.1");
-    _tcpClient.print("Host: ");
-    _tcpClient.println(_apiHost);
-    _tcpClient.println("Connection: close");
-    _tcpClient.println();
+    // Make a HTTP request: composed in the (idle) receive buffer, then one burst and one SEND
+    int len = snprintf((char *)_shareRxBuf, sizeof(_shareRxBuf),
+                       "GET %s HTTP/1.1\r\n"
+                       "Host: %s\r\n"
+                       "Connection: close\r\n\r\n",
+                       text, _apiHost);
+    W5100sSpi::getInstance()->send(_tcpClient.getSocketNumber(), _shareRxBuf, len);
 }
 
 // make text data to be sent
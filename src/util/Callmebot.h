@@ -47,6 +47,12 @@ public:
     void send(const char *text);
     void setStateCallback(StateCallback callback);
     void update(void);
+    void abort(void); // drops the request without a state callback, e.g. when the link goes down
+
+    inline bool busy(void) const
+    {
+        return _tcpState != Ready;
+    }
 
 private:
     typedef enum _TcpState
@@ -0,0 +1,262 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "ClipUploader.h"
+#include "../ArduProfApp.h"
+#include "../audio/ClipRecorder.h"
+#include "../peripheral/W5100sSpi.h"
+#include "./Sntp.h"
+
+#define WAVE_FORMAT_MULAW 7
+
+////////////////////////////////////////////////////////////////////////////////////////////
+const char ClipUploader::_host[] = CLIP_UPLOAD_HOST;
+const char ClipUploader::_path[] = CLIP_UPLOAD_PATH;
+const int ClipUploader::_port = CLIP_UPLOAD_PORT;
+
+typedef struct __attribute__((packed)) _WaveMulawHeader
+{
+    char riff[4];
+    uint32_t riff_size;
+    char wave[4];
+    char fmt[4];
+    uint32_t fmt_size;
+    uint16_t format_tag;
+    uint16_t channels;
+    uint32_t sample_rate;
+    uint32_t byte_rate;
+    uint16_t block_align;
+    uint16_t bits_per_sample;
+    uint16_t cb_size;
+    char fact[4];
+    uint32_t fact_size;
+    uint32_t sample_length;
+    char data[4];
+    uint32_t data_size;
+} WaveMulawHeader;
+static_assert(sizeof(WaveMulawHeader) == 58, "sizeof(WaveMulawHeader) must be 58 bytes");
+
+///////////////////////////////////////////////////////////////////////////////
+ClipUploader::ClipUploader(StateCallback callback) : _tcpClient(),
+                                                     _tcpState(Ready),
+                                                     _connectTimeout(0),
+                                                     _recorder(nullptr),
+                                                     _detectedUs(0),
+                                                     _callback(callback)
+{
+}
+
+void ClipUploader::upload(ClipRecorder *recorder, uint64_t detectedUs)
+{
+    if (busy())
+    {
+        LOG_TRACE("upload in progress, ignore");
+        return;
+    }
+
+    _recorder = recorder;
+    _detectedUs = detectedUs;
+    uint8_t sn_ir = SnIR::TIMEOUT | SnIR::DISCON;
+    if (_tcpClient.connect(_host, _port, sn_ir, onTcpClientEvent))
+    {
+        LOG_TRACE("connecting to server=", _host, ", port=", _port);
+        _tcpState = Connecting;
+        _connectTimeout = 0;
+        invokeCallbackIfNotNull(Uploading);
+    }
+    else
+    {
+        LOG_TRACE("Fail to connect server=", _host, ", port=", _port);
+        finish(UploadFail);
+    }
+}
+
+void ClipUploader::update(void)
+{
+    switch (_tcpState)
+    {
+    case Ready:
+        break;
+
+    case Connecting:
+    {
+        if (_tcpClient.connected())
+        {
+            writeRequest();
+            _tcpState = Connected;
+            _connectTimeout = 0;
+        }
+        else if (_connectTimeout++ >= CLIP_UPLOAD_TIMEOUT)
+        {
+            LOG_TRACE("Connecting: timeout! _connectTimeout=", _connectTimeout, " seconds");
+            finish(UploadFail);
+        }
+        break;
+    }
+
+    case Connected:
+    {
+        int responseCode;
+        if (readHttpResponse(&responseCode))
+        {
+            LOG_TRACE("HTTP server response statusCode=", responseCode);
+            finish(((responseCode >= 200) && (responseCode < 300)) ? UploadSuccess : UploadFail);
+        }
+        else if (_connectTimeout++ >= CLIP_UPLOAD_TIMEOUT)
+        {
+            LOG_TRACE("Connected: timeout! _connectTimeout=", _connectTimeout, " seconds");
+            finish(UploadFail);
+        }
+        break;
+    }
+
+    default:
+        LOG_TRACE("unsupported TCP state: ", (int)_tcpState);
+        break;
+    }
+}
+
+void ClipUploader::abort(void)
+{
+    if (_tcpState != Ready)
+    {
+        _tcpClient.stop();
+        _tcpState = Ready;
+        _recorder = nullptr;
+    }
+}
+
+void ClipUploader::onTcpClientEvent(uint8_t sr_ir)
+{
+    if (sr_ir & SnIR::TIMEOUT)
+    {
+        LOG_DEBUG("SnIR::TIMEOUT");
+    }
+    if (sr_ir & SnIR::DISCON)
+    {
+        LOG_DEBUG("SnIR::DISCON");
+    }
+}
+
+void ClipUploader::writeRequest(void)
+{
+    const uint8_t *ptr[2];
+    size_t len[2];
+    int count = _recorder->clip_segments(ptr, len);
+    uint32_t size = (count > 0 ? len[0] : 0) + (count > 1 ? len[1] : 0);
+
+    WaveMulawHeader header = {
+        .riff = {'R', 'I', 'F', 'F'},
+        .riff_size = sizeof(header) - 8 + size,
+        .wave = {'W', 'A', 'V', 'E'},
+        .fmt = {'f', 'm', 't', ' '},
+        .fmt_size = 18,
+        .format_tag = WAVE_FORMAT_MULAW,
+        .channels = 1,
+        .sample_rate = AUDIO_SAMPLING_RATE,
+        .byte_rate = AUDIO_SAMPLING_RATE,
+        .block_align = 1,
+        .bits_per_sample = 8,
+        .cb_size = 0,
+        .fact = {'f', 'a', 'c', 't'},
+        .fact_size = 4,
+        .sample_length = size,
+        .data = {'d', 'a', 't', 'a'},
+        .data_size = size,
+    };
+
+    // X-Detected-At: the alarm time, the server tells the delivery latency from it
+    char detectedAt[48] = "";
+    auto sntp = Sntp::getInstance();
+    if (_detectedUs && sntp->synced())
+    {
+        size_t n = snprintf(detectedAt, sizeof(detectedAt), "X-Detected-At: ");
+        n += Sntp::format(detectedAt + n, sizeof(detectedAt) - n, sntp->utc(_detectedUs));
+        snprintf(detectedAt + n, sizeof(detectedAt) - n, "\r\n");
+    }
+
+    // the request head and the chunk framing are text, the WAV header and the ring buffer segments are
+    // sent in place: one gather send, burst by burst into the TX memory
+    char head[256];
+    char framing[2][16];
+    static const char last[] = "\r\n0\r\n\r\n"; // ends the previous chunk, then last-chunk
+    const uint8_t *pieces[2 + 2 * 2 + 1];
+    uint32_t lengths[2 + 2 * 2 + 1];
+    int n = 0;
+
+    lengths[n] = snprintf(head, sizeof(head),
+                          "POST %s HTTP/1.1\r\n"
+                          "Host: %s\r\n"
+                          "Content-Type: audio/wav\r\n"
+                          "Transfer-Encoding: chunked\r\n"
+                          "%s"
+                          "Connection: close\r\n\r\n"
+                          "%X\r\n",
+                          _path, _host, detectedAt, (unsigned)sizeof(header));
+    pieces[n++] = (const uint8_t *)head;
+    lengths[n] = sizeof(header);
+    pieces[n++] = (const uint8_t *)&header;
+    for (int i = 0; i < count; i++)
+    {
+        lengths[n] = snprintf(framing[i], sizeof(framing[i]), "\r\n%X\r\n", (unsigned)len[i]);
+        pieces[n++] = (const uint8_t *)framing[i];
+        lengths[n] = len[i];
+        pieces[n++] = ptr[i];
+    }
+    lengths[n] = sizeof(last) - 1;
+    pieces[n++] = (const uint8_t *)last;
+
+    uint32_t sent = W5100sSpi::getInstance()->send(_tcpClient.getSocketNumber(), pieces, lengths, n);
+    LOG_TRACE("sent clip: ", size, " bytes, request ", sent, " bytes");
+}
+
+bool ClipUploader::readHttpResponse(int *ptrResponseCode)
+{
+    char line[64];
+    int tcpSize = _tcpClient.available();
+    if (tcpSize <= 0)
+    {
+        return false;
+    }
+
+    // status line is the first line of the response, the rest is discarded by stop()
+    if (tcpSize >= sizeof(line))
+    {
+        tcpSize = sizeof(line) - 1;
+    }
+    _tcpClient.read((uint8_t *)line, tcpSize);
+    line[tcpSize] = '\0';
+    if (sscanf(line, "HTTP/%*d.%*d %d", ptrResponseCode) != 1)
+    {
+        *ptrResponseCode = 0;
+    }
+    return true;
+}
+
+void ClipUploader::finish(UploadState state)
+{
+    _tcpState = Ready;
+    _tcpClient.stop();
+    if (_recorder)
+    {
+        _recorder->release();
+        _recorder = nullptr;
+    }
+    invokeCallbackIfNotNull(state);
+}
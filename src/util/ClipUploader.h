@@ -0,0 +1,88 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <Arduino.h>
+#include <EventEthernet.h>
+#include <utility/w5100.h>
+
+#include "../secret.h"
+
+#define CLIP_UPLOAD_TIMEOUT 30 // in unit of seconds
+
+class ClipRecorder;
+
+// Upload a frozen ClipRecorder clip as a mu-law WAV file by chunked HTTP POST.
+// The ring buffer segments are written to the socket as chunks, no intermediate copy (W5100sSpi gather send).
+class ClipUploader
+{
+public:
+    enum UploadState
+    {
+        Unknown,
+        Uploading,
+        UploadSuccess,
+        UploadFail,
+    };
+
+    typedef void (*StateCallback)(UploadState state);
+
+    ClipUploader(StateCallback callback = nullptr);
+
+    void upload(ClipRecorder *recorder, uint64_t detectedUs = 0); // detection time (time_us_64()) of the clip's alarm, 0: unknown
+    void update(void);
+    void abort(void); // drops the upload, the clip stays frozen for another upload()
+
+    inline bool busy(void) const
+    {
+        return _tcpState != Ready;
+    }
+
+private:
+    typedef enum _TcpState
+    {
+        Ready,
+        Connecting,
+        Connected,
+    } TcpState;
+
+    EventEthernetClient _tcpClient;
+    TcpState _tcpState;
+    uint32_t _connectTimeout;
+    ClipRecorder *_recorder;
+    uint64_t _detectedUs;
+    StateCallback _callback;
+
+    static void onTcpClientEvent(uint8_t sr_ir);
+    void writeRequest(void);
+    bool readHttpResponse(int *ptrResponseCode);
+    void finish(UploadState state);
+
+    inline void invokeCallbackIfNotNull(UploadState state)
+    {
+        if (_callback)
+        {
+            _callback(state);
+        }
+    }
+
+    static const char _host[];
+    static const char _path[];
+    static const int _port;
+};
@@ -0,0 +1,369 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "LinkManager.h"
+#include "../ArduProfApp.h"
+#include "./BinLog.h"
+#include "../peripheral/W5100sSpi.h"
+
+// Ethernet.maintain() results of the Arduino library, not exported by every version of its header
+#ifndef DHCP_CHECK_NONE
+#define DHCP_CHECK_NONE (0)
+#define DHCP_CHECK_RENEW_FAIL (1)
+#define DHCP_CHECK_RENEW_OK (2)
+#define DHCP_CHECK_REBIND_FAIL (3)
+#define DHCP_CHECK_REBIND_OK (4)
+#endif
+
+// SOCKET-less command registers (W5100S datasheet)
+enum
+{
+    SLCR = 0x004C,  // command: ARP or PING to SLPIPR
+    SLRTR = 0x004D, // retry time, 100 us units
+    SLPIPR = 0x0050,
+
+    SLCR_ARP = 0x02,
+};
+
+#define PROBE_RTR 2000 // 200 ms per try
+#define PROBE_RCR 2    // retries after the first try: answer within 600 ms
+
+////////////////////////////////////////////////////////////////////////////////////////////
+LinkManager *LinkManager::_instance = nullptr;
+
+LinkManager *LinkManager::getInstance(void)
+{
+    if (!_instance)
+    {
+        static LinkManager instance;
+        _instance = &instance;
+    }
+    return _instance;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+LinkManager::LinkManager() : _state(Acquiring),
+                             _cause(CausePhy),
+                             _mac(nullptr),
+                             _ir(0),
+                             _ir2(0),
+                             _slir(0),
+                             _ethCallback(nullptr),
+                             _callback(nullptr),
+                             _ip(),
+                             _hasLease(false),
+                             _reset(false),
+                             _probing(false),
+                             _downPolls(0),
+                             _probeFails(0),
+                             _retries(0),
+                             _probeStart(0),
+                             _probeAt(0),
+                             _retryAt(0),
+                             _downAt(0),
+                             _stats()
+{
+}
+
+void LinkManager::begin(uint8_t *mac, uint8_t ir, uint8_t ir2, uint8_t slir, EthernetEventCallback ethCallback, EventCallback callback)
+{
+    _mac = mac;
+    _ir = ir;
+    _ir2 = ir2;
+    _slir = slir | SLIR::ARP | SLIR::TIMEOUT; // the gateway check reports through SLIR
+    _ethCallback = ethCallback;
+    _callback = callback;
+    _downAt = millis();
+    acquire();
+}
+
+void LinkManager::update(void)
+{
+    uint32_t now = millis();
+    if (Ethernet.linkStatus() == LinkOFF)
+    {
+        if ((_state != NoLink) && (++_downPolls >= LINK_DOWN_POLLS))
+        {
+            down(CausePhy);
+            _probing = false;
+            setState(NoLink);
+        }
+        return;
+    }
+    _downPolls = 0;
+
+    switch (_state)
+    {
+    case NoLink:
+        // back after a link loss: keep the lease if the gateway is still there
+        if (_hasLease)
+        {
+            verify();
+        }
+        else
+        {
+            _retryAt = now;
+            setState(Acquiring);
+        }
+        break;
+
+    case Acquiring:
+        if (due(now, _retryAt))
+        {
+            acquire();
+        }
+        break;
+
+    case Verifying:
+    case Up:
+        if (_probing)
+        {
+            if (due(now, _probeStart + LINK_PROBE_TIMEOUT_MS))
+            {
+                probeDone(false); // no SLIR at all
+            }
+        }
+        else if (due(now, _probeAt))
+        {
+            probe();
+        }
+        if (_state == Up)
+        {
+            maintain();
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+void LinkManager::interrupt(uint8_t ir, uint8_t slir)
+{
+    if ((ir & IR::CONFLICT) && _hasLease)
+    {
+        // another host answers for our address: give it up and ask DHCP again
+        LOG_DEBUG("IP conflict on ", _ip);
+        down(CauseConflict);
+        _hasLease = false;
+        _probing = false;
+        _retryAt = millis();
+        setState(Acquiring);
+        return;
+    }
+    if ((ir & IR::UNREACH) && (_state == Up) && !_probing)
+    {
+        _probeAt = millis(); // check the gateway now rather than at the next period
+    }
+    if (_probing && (slir & (SLIR::ARP | SLIR::TIMEOUT)))
+    {
+        probeDone(slir & SLIR::ARP);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void LinkManager::acquire(void)
+{
+    static const IPAddress NullIP(0, 0, 0, 0);
+
+    // blocks for the DHCP exchange, up to LINK_DHCP_TIMEOUT_MS: the link poll and the metrics server wait meanwhile
+    if (Ethernet.begin(_mac, _ir, _ir2, _slir, _ethCallback, LINK_DHCP_TIMEOUT_MS, LINK_DHCP_RESPONSE_MS) &&
+        (Ethernet.localIP() != NullIP))
+    {
+        LOG_DEBUG("lease: localIP=", Ethernet.localIP(), ", gatewayIP=", Ethernet.gatewayIP());
+        _stats.acquires++;
+        _ip = Ethernet.localIP();
+        _hasLease = true;
+        _reset = true;
+        _probing = false;
+        if (_cause == CauseGateway)
+        {
+            verify(); // the DHCP server answers, the gateway may not
+        }
+        else
+        {
+            up();
+        }
+        return;
+    }
+
+    if (Ethernet.hardwareStatus() == EthernetNoHardware)
+    {
+        LOG_ERROR("Ethernet was not found");
+    }
+    else
+    {
+        LOG_DEBUG("DHCP failed, link=", (int)Ethernet.linkStatus());
+    }
+    _hasLease = false;
+    _reset = true;
+    retry();
+}
+
+void LinkManager::maintain(void)
+{
+    int rc = Ethernet.maintain();
+    switch (rc)
+    {
+    case DHCP_CHECK_RENEW_OK:
+    case DHCP_CHECK_REBIND_OK:
+        _stats.renewals++;
+        if (Ethernet.localIP() != _ip)
+        {
+            // connections on the old address are gone
+            LOG_DEBUG("address changed: ", _ip, " -> ", Ethernet.localIP());
+            down(CauseLease);
+            _ip = Ethernet.localIP();
+            up();
+        }
+        break;
+
+    case DHCP_CHECK_RENEW_FAIL:
+        LOG_DEBUG("lease renewal failed, rebind at T2");
+        break;
+
+    case DHCP_CHECK_REBIND_FAIL:
+        // the lease ends within 1/8 of its time and the library would keep the address past that
+        LOG_DEBUG("lease rebind failed");
+        down(CauseLease);
+        _hasLease = false;
+        _retryAt = millis();
+        setState(Acquiring);
+        break;
+
+    default:
+        break;
+    }
+}
+
+// SOCKET-less ARP request to the gateway, answered by SLIR ARP or SLIR TIMEOUT
+void LinkManager::probe(void)
+{
+    IPAddress gateway = Ethernet.gatewayIP();
+    if (gateway == IPAddress(0, 0, 0, 0))
+    {
+        _probing = true;
+        probeDone(true); // no router on this network, nothing to check
+        return;
+    }
+
+    uint8_t regs[7] = {PROBE_RTR >> 8, PROBE_RTR & 0xFF, PROBE_RCR, gateway[0], gateway[1], gateway[2], gateway[3]};
+    uint8_t cmd = SLCR_ARP;
+    auto spi = W5100sSpi::getInstance();
+    spi->write(SLRTR, regs, sizeof(regs)); // SLRTR, SLRCR, SLPIPR
+    spi->write(SLCR, &cmd, 1);
+    _stats.probes++;
+    _probing = true;
+    _probeStart = millis();
+}
+
+void LinkManager::probeDone(bool answered)
+{
+    _probing = false;
+    uint32_t now = millis();
+    if (answered)
+    {
+        _probeFails = 0;
+        _probeAt = now + LINK_PROBE_PERIOD_MS;
+        if (_state == Verifying)
+        {
+            up();
+        }
+        return;
+    }
+
+    _probeAt = now + LINK_PROBE_RETRY_MS;
+    if (++_probeFails < LINK_PROBE_FAILS)
+    {
+        return;
+    }
+    LOG_DEBUG("gateway does not answer ARP: ", Ethernet.gatewayIP());
+    if (_state == Up)
+    {
+        down(CauseGateway);
+    }
+    _cause = CauseGateway;
+    retry(); // maybe another network now: DHCP again
+}
+
+// DHCP again, after the back-off of the failures in a row
+void LinkManager::retry(void)
+{
+    uint32_t wait = _retries ? LINK_RETRY_MIN_MS << (_retries - 1) : 0;
+    if (wait > LINK_RETRY_MAX_MS)
+    {
+        wait = LINK_RETRY_MAX_MS;
+    }
+    else
+    {
+        _retries++;
+    }
+    _retryAt = millis() + wait;
+    setState(Acquiring);
+}
+
+void LinkManager::verify(void)
+{
+    _probing = false;
+    _probeFails = 0;
+    _probeAt = millis();
+    setState(Verifying);
+}
+
+void LinkManager::up(void)
+{
+    uint32_t now = millis();
+    _retries = 0;
+    _probeFails = 0;
+    _probeAt = now + LINK_PROBE_PERIOD_MS;
+    _stats.recoveryMs = now - _downAt;
+    setState(Up);
+    bool reset = _reset;
+    _reset = false;
+    if (_callback)
+    {
+        _callback(reset ? LinkUp : LinkResumed);
+    }
+}
+
+void LinkManager::down(DownCause cause)
+{
+    _cause = cause;
+    if (_state != Up)
+    {
+        return; // already reported
+    }
+    _stats.downs[cause]++;
+    _downAt = millis();
+    setState((cause == CausePhy) ? NoLink : Acquiring);
+    if (_callback)
+    {
+        _callback(LinkDown);
+    }
+}
+
+void LinkManager::setState(LinkState state)
+{
+    if (state != _state)
+    {
+        BINLOG(BL_LINK_STATE, _state, state, _cause);
+        LOG_TRACE("link state ", (int)_state, " -> ", (int)state);
+        _state = state;
+    }
+}
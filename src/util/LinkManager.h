@@ -0,0 +1,147 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <Arduino.h>
+#include <EventEthernet.h>
+#include <utility/w5100.h>
+
+#define LINK_POLL_MS 250            // update() period: one PHYSR read
+#define LINK_DOWN_POLLS 2           // polls without link before the link counts as lost
+#define LINK_PROBE_PERIOD_MS 60000  // gateway check while up
+#define LINK_PROBE_TIMEOUT_MS 1000  // no SLIR ARP / TIMEOUT by then: the check failed
+#define LINK_PROBE_RETRY_MS 500     // next check after a failed one
+#define LINK_PROBE_FAILS 3          // failed checks in a row before the gateway counts as lost
+#define LINK_RETRY_MIN_MS 1000      // back-off of DHCP after a failed recovery, doubles per failure
+#define LINK_RETRY_MAX_MS 32000
+#ifndef LINK_DHCP_TIMEOUT_MS
+#define LINK_DHCP_TIMEOUT_MS 2000   // Ethernet.begin() gives up DHCP after this, blocking ThreadNet (library default 60 s)
+#endif
+#ifndef LINK_DHCP_RESPONSE_MS
+#define LINK_DHCP_RESPONSE_MS 500   // wait for each OFFER / ACK before sending again (library default 4 s)
+#endif
+
+// Keeps the W5100S on the network: DHCP at start, lease renewal, and recovery from link loss, lease
+// loss, IP conflict and an unreachable gateway.
+//  - update() runs every LINK_POLL_MS on ThreadNet: it polls the PHY link, calls Ethernet.maintain()
+//    while up and drives the gateway checks
+//  - interrupt() takes the IR / SLIR bits of the Ethernet callback: CONFLICT, UNREACH, and the result of
+//    the gateway check, a SOCKET-less ARP request (SLCR) answered by SLIR ARP or SLIR TIMEOUT
+// After a short link loss (a switch reboot) the lease is kept if the gateway still answers ARP, so the
+// sockets survive; otherwise, and after a failed rebind or an IP conflict, Ethernet.begin() runs DHCP
+// again, which resets the chip. The Ethernet library renews at T1 and rebinds at T2 but does not track
+// the lease end, so a failed rebind takes the link down instead of keeping an expired address.
+class LinkManager
+{
+public:
+    enum LinkState
+    {
+        NoLink,    // PHY link down
+        Acquiring, // waiting to run DHCP
+        Verifying, // checking the gateway before the link counts as up
+        Up,
+    };
+
+    enum LinkEvent
+    {
+        LinkDown,
+        LinkUp,      // new lease, the chip was reset: sockets have to be opened again
+        LinkResumed, // same chip state, sockets kept (the address may have changed)
+    };
+
+    enum DownCause
+    {
+        CausePhy,
+        CauseLease,
+        CauseConflict,
+        CauseGateway,
+        CauseCount,
+    };
+
+    typedef void (*EventCallback)(LinkEvent event);
+
+    typedef struct _Stats
+    {
+        uint32_t downs[CauseCount];
+        uint32_t acquires;   // leases obtained by Ethernet.begin()
+        uint32_t renewals;   // leases renewed or rebound by Ethernet.maintain()
+        uint32_t probes;     // gateway checks
+        uint32_t recoveryMs; // last link down to link up
+    } Stats;
+
+    static LinkManager *getInstance(void);
+
+    // Ethernet.init() first; runs DHCP once, then update() takes over
+    void begin(uint8_t *mac, uint8_t ir, uint8_t ir2, uint8_t slir, EthernetEventCallback ethCallback, EventCallback callback);
+    void update(void);
+    void interrupt(uint8_t ir, uint8_t slir);
+
+    inline LinkState state(void) const
+    {
+        return _state;
+    }
+    inline bool isUp(void) const
+    {
+        return _state == Up;
+    }
+    inline const Stats &stats(void) const
+    {
+        return _stats;
+    }
+
+private:
+    LinkManager();
+
+    static LinkManager *_instance;
+
+    LinkState _state;
+    DownCause _cause; // of the last link down
+    uint8_t *_mac;
+    uint8_t _ir, _ir2, _slir;
+    EthernetEventCallback _ethCallback;
+    EventCallback _callback;
+
+    IPAddress _ip;   // address of the lease
+    bool _hasLease;  // the chip holds an address from DHCP
+    bool _reset;     // the chip was reset since the last LinkUp / LinkResumed
+    bool _probing;   // SOCKET-less ARP in progress
+    uint8_t _downPolls;
+    uint8_t _probeFails;
+    uint8_t _retries; // failed recoveries in a row
+    uint32_t _probeStart;
+    uint32_t _probeAt;
+    uint32_t _retryAt;
+    uint32_t _downAt;
+    Stats _stats;
+
+    void acquire(void);
+    void maintain(void);
+    void probe(void);
+    void probeDone(bool answered);
+    void retry(void);
+    void verify(void);
+    void up(void);
+    void down(DownCause cause);
+    void setState(LinkState state);
+
+    static inline bool due(uint32_t now, uint32_t at)
+    {
+        return (int32_t)(now - at) >= 0;
+    }
+};
@@ -0,0 +1,322 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <Arduino.h>
+#include <mbed.h>
+#include "./Metrics.h"
+#include "../audio/Agc.h"
+#include "../peripheral/W5100sSpi.h"
+#include "./LinkManager.h"
+#include "./Sntp.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////
+Metrics *Metrics::_instance = nullptr;
+
+Metrics *Metrics::getInstance(void)
+{
+    if (!_instance)
+    {
+        static Metrics instance;
+        _instance = &instance;
+    }
+    return _instance;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+Metrics::Metrics() : _inferences(0),
+                     _dmaOverruns(0),
+                     _audioBlocks(0),
+                     _inferenceSkips(0),
+                     _latency(),
+                     _latencySum(),
+                     _latencyMax(),
+                     _arenaUsed(0),
+                     _arenaSize(0),
+                     _modelGeneration(0),
+                     _modelSwaps(0),
+                     _clockHz(0),
+                     _clockSwitches(0),
+                     _lowClockBlocks(0),
+                     _audioClockPpm(0),
+                     _agcGain(0),
+                     _agcPeak(0),
+                     _agcRms(0),
+                     _clippedSamples(0),
+                     _queuePosted(),
+                     _queueHandled(),
+                     _queueHighWater(),
+                     _alertSuccess(0),
+                     _alertFail(0),
+                     _alertLatencySum(),
+                     _alertLatencyCount(),
+                     _alertLatencyLast(),
+                     _alertLatencyMax(),
+                     _ethEvents(),
+                     _bootPhase()
+{
+}
+
+void Metrics::addLatency(Stage stage, uint32_t us)
+{
+    // bucket = ceil(log2(us / METRICS_LATENCY_FIRST_US)), so that its upper bound is the inclusive "le" of
+    // Prometheus; a loop is cheaper than the libgcc clz call on M0+
+    uint32_t bucket = 0;
+    for (uint32_t v = us ? (us - 1) / METRICS_LATENCY_FIRST_US : 0; v && (bucket < METRICS_LATENCY_BUCKETS - 1); v >>= 1)
+    {
+        bucket++;
+    }
+    increment(_latency[stage][bucket]);
+    increment(_latencySum[stage], us);
+    if (us > _latencyMax[stage].load(std::memory_order_relaxed))
+    {
+        _latencyMax[stage].store(us, std::memory_order_relaxed);
+    }
+}
+
+void Metrics::setArena(uint32_t used, uint32_t size)
+{
+    _arenaUsed.store(used, std::memory_order_relaxed);
+    _arenaSize.store(size, std::memory_order_relaxed);
+}
+
+void Metrics::setBootPhase(BootPhase phase, uint32_t ms)
+{
+    if (_bootPhase[phase].load(std::memory_order_relaxed) == 0)
+    {
+        _bootPhase[phase].store(ms ? ms : 1, std::memory_order_relaxed);
+    }
+}
+
+void Metrics::setModel(uint32_t generation, bool swapped)
+{
+    _modelGeneration.store(generation, std::memory_order_relaxed);
+    if (swapped)
+    {
+        increment(_modelSwaps);
+    }
+}
+
+void Metrics::setClock(uint32_t sysHz, bool switched)
+{
+    _clockHz.store(sysHz, std::memory_order_relaxed);
+    if (switched)
+    {
+        increment(_clockSwitches);
+    }
+}
+
+void Metrics::setAgc(int32_t gain, uint32_t peak, uint32_t rms, uint32_t clipped)
+{
+    _agcGain.store(gain, std::memory_order_relaxed);
+    _agcPeak.store(peak, std::memory_order_relaxed);
+    _agcRms.store(rms, std::memory_order_relaxed);
+    if (clipped)
+    {
+        increment(_clippedSamples, clipped);
+    }
+}
+
+void Metrics::addAlertLatency(AlertStage stage, uint32_t ms)
+{
+    increment(_alertLatencySum[stage], ms);
+    increment(_alertLatencyCount[stage]);
+    _alertLatencyLast[stage].store(ms, std::memory_order_relaxed);
+    if (ms > _alertLatencyMax[stage].load(std::memory_order_relaxed))
+    {
+        _alertLatencyMax[stage].store(ms, std::memory_order_relaxed);
+    }
+}
+
+void Metrics::queuePosted(Queue queue)
+{
+    uint32_t posted = core_util_atomic_incr_u32(&_queuePosted[queue], 1);
+    uint32_t depth = posted - _queueHandled[queue];
+    if (depth > _queueHighWater[queue])
+    {
+        _queueHighWater[queue] = depth; // racing writers may lose a sample of the same magnitude only
+    }
+}
+
+void Metrics::queueHandled(Queue queue)
+{
+    _queueHandled[queue] = _queueHandled[queue] + 1; // only the owner thread dequeues
+}
+
+size_t Metrics::format(char *buf, size_t size) const
+{
+    static const char *stageName[StageCount] = {"preprocess", "inference"};
+    static const char *queueName[QueueCount] = {"app", "net"};
+    static const char *ethName[EthEventCount] = {"conflict", "unreach", "pppterm", "wol", "timeout", "arp", "ping"};
+    static const char *alertStageName[AlertStageCount] = {"dispatch", "delivery"};
+    static const char *bootName[BootPhaseCount] = {"audio_start", "model_ready", "mic_settled", "first_inference", "net_up"};
+
+    size_t len = 0;
+    auto append = [&](const char *fmt, auto... args)
+    {
+        if (len < size)
+        {
+            int n = snprintf(buf + len, size - len, fmt, args...);
+            len += (n > 0) ? n : 0;
+        }
+    };
+
+    append("# TYPE aiot_uptime_seconds counter\naiot_uptime_seconds %lu\n", (unsigned long)(millis() / 1000));
+    append("# TYPE aiot_inferences_total counter\naiot_inferences_total %lu\n",
+           (unsigned long)_inferences.load(std::memory_order_relaxed));
+
+    append("# TYPE aiot_stage_latency_microseconds histogram\n");
+    for (int s = 0; s < StageCount; s++)
+    {
+        // cumulative bucket counts, read once so that _count equals the +Inf bucket
+        uint32_t count = 0;
+        for (int i = 0; i < METRICS_LATENCY_BUCKETS - 1; i++)
+        {
+            count += _latency[s][i].load(std::memory_order_relaxed);
+            append("aiot_stage_latency_microseconds_bucket{stage=\"%s\",le=\"%lu\"} %lu\n", stageName[s],
+                   (unsigned long)METRICS_LATENCY_FIRST_US << i, (unsigned long)count);
+        }
+        count += _latency[s][METRICS_LATENCY_BUCKETS - 1].load(std::memory_order_relaxed);
+        append("aiot_stage_latency_microseconds_bucket{stage=\"%s\",le=\"+Inf\"} %lu\n", stageName[s], (unsigned long)count);
+        append("aiot_stage_latency_microseconds_sum{stage=\"%s\"} %lu\n", stageName[s],
+               (unsigned long)_latencySum[s].load(std::memory_order_relaxed));
+        append("aiot_stage_latency_microseconds_count{stage=\"%s\"} %lu\n", stageName[s], (unsigned long)count);
+    }
+    append("# TYPE aiot_stage_latency_max_microseconds gauge\n");
+    for (int s = 0; s < StageCount; s++)
+    {
+        append("aiot_stage_latency_max_microseconds{stage=\"%s\"} %lu\n", stageName[s],
+               (unsigned long)_latencyMax[s].load(std::memory_order_relaxed));
+    }
+
+    append("# TYPE aiot_dma_overruns_total counter\naiot_dma_overruns_total %lu\n",
+           (unsigned long)_dmaOverruns.load(std::memory_order_relaxed));
+    append("# TYPE aiot_audio_blocks_total counter\naiot_audio_blocks_total %lu\n",
+           (unsigned long)_audioBlocks.load(std::memory_order_relaxed));
+    append("# TYPE aiot_inferences_skipped_total counter\naiot_inferences_skipped_total %lu\n",
+           (unsigned long)_inferenceSkips.load(std::memory_order_relaxed));
+
+    int32_t gain = _agcGain.load(std::memory_order_relaxed);
+    append("# TYPE aiot_agc_gain gauge\naiot_agc_gain %ld.%03ld\n",
+           (long)(gain / AGC_GAIN_UNITY), (long)((gain % AGC_GAIN_UNITY) * 1000 / AGC_GAIN_UNITY));
+    append("# TYPE aiot_audio_peak gauge\naiot_audio_peak %lu\n", (unsigned long)_agcPeak.load(std::memory_order_relaxed));
+    append("# TYPE aiot_audio_rms gauge\naiot_audio_rms %lu\n", (unsigned long)_agcRms.load(std::memory_order_relaxed));
+    append("# TYPE aiot_clipped_samples_total counter\naiot_clipped_samples_total %lu\n",
+           (unsigned long)_clippedSamples.load(std::memory_order_relaxed));
+
+    append("# TYPE aiot_queue_depth gauge\n");
+    for (int q = 0; q < QueueCount; q++)
+    {
+        append("aiot_queue_depth{queue=\"%s\"} %lu\n", queueName[q], (unsigned long)(_queuePosted[q] - _queueHandled[q]));
+    }
+    append("# TYPE aiot_queue_high_water gauge\n");
+    for (int q = 0; q < QueueCount; q++)
+    {
+        append("aiot_queue_high_water{queue=\"%s\"} %lu\n", queueName[q], (unsigned long)_queueHighWater[q]);
+    }
+
+    append("# TYPE aiot_arena_used_bytes gauge\naiot_arena_used_bytes %lu\n",
+           (unsigned long)_arenaUsed.load(std::memory_order_relaxed));
+    append("# TYPE aiot_arena_size_bytes gauge\naiot_arena_size_bytes %lu\n",
+           (unsigned long)_arenaSize.load(std::memory_order_relaxed));
+    append("# TYPE aiot_model_generation gauge\naiot_model_generation %lu\n",
+           (unsigned long)_modelGeneration.load(std::memory_order_relaxed));
+    append("# TYPE aiot_model_swaps_total counter\naiot_model_swaps_total %lu\n",
+           (unsigned long)_modelSwaps.load(std::memory_order_relaxed));
+
+    append("# TYPE aiot_clock_sys_hertz gauge\naiot_clock_sys_hertz %lu\n", (unsigned long)_clockHz.load(std::memory_order_relaxed));
+    append("# TYPE aiot_clock_switches_total counter\naiot_clock_switches_total %lu\n",
+           (unsigned long)_clockSwitches.load(std::memory_order_relaxed));
+    append("# TYPE aiot_clock_low_blocks_total counter\naiot_clock_low_blocks_total %lu\n",
+           (unsigned long)_lowClockBlocks.load(std::memory_order_relaxed));
+    append("# TYPE aiot_audio_clock_error_ppm gauge\naiot_audio_clock_error_ppm %ld\n",
+           (long)_audioClockPpm.load(std::memory_order_relaxed));
+
+    append("# TYPE aiot_alerts_total counter\n");
+    append("aiot_alerts_total{result=\"success\"} %lu\n", (unsigned long)_alertSuccess.load(std::memory_order_relaxed));
+    append("aiot_alerts_total{result=\"fail\"} %lu\n", (unsigned long)_alertFail.load(std::memory_order_relaxed));
+    append("# TYPE aiot_alert_latency_milliseconds summary\n");
+    for (int s = 0; s < AlertStageCount; s++)
+    {
+        append("aiot_alert_latency_milliseconds_sum{stage=\"%s\"} %lu\n", alertStageName[s],
+               (unsigned long)_alertLatencySum[s].load(std::memory_order_relaxed));
+        append("aiot_alert_latency_milliseconds_count{stage=\"%s\"} %lu\n", alertStageName[s],
+               (unsigned long)_alertLatencyCount[s].load(std::memory_order_relaxed));
+    }
+    append("# TYPE aiot_alert_latency_last_milliseconds gauge\n");
+    for (int s = 0; s < AlertStageCount; s++)
+    {
+        append("aiot_alert_latency_last_milliseconds{stage=\"%s\"} %lu\n", alertStageName[s],
+               (unsigned long)_alertLatencyLast[s].load(std::memory_order_relaxed));
+    }
+    append("# TYPE aiot_alert_latency_max_milliseconds gauge\n");
+    for (int s = 0; s < AlertStageCount; s++)
+    {
+        append("aiot_alert_latency_max_milliseconds{stage=\"%s\"} %lu\n", alertStageName[s],
+               (unsigned long)_alertLatencyMax[s].load(std::memory_order_relaxed));
+    }
+
+    append("# TYPE aiot_eth_events_total counter\n");
+    for (int e = 0; e < EthEventCount; e++)
+    {
+        append("aiot_eth_events_total{event=\"%s\"} %lu\n", ethName[e],
+               (unsigned long)_ethEvents[e].load(std::memory_order_relaxed));
+    }
+
+    const W5100sSpi::Stats &spi = W5100sSpi::getInstance()->stats();
+    append("# TYPE aiot_w5100s_spi_bursts_total counter\naiot_w5100s_spi_bursts_total %lu\n", (unsigned long)spi.bursts);
+    append("# TYPE aiot_w5100s_spi_dma_total counter\naiot_w5100s_spi_dma_total %lu\n", (unsigned long)spi.dmaRuns);
+    append("# TYPE aiot_w5100s_spi_bytes_total counter\naiot_w5100s_spi_bytes_total %lu\n", (unsigned long)spi.bytes);
+    append("# TYPE aiot_w5100s_sends_total counter\naiot_w5100s_sends_total %lu\n", (unsigned long)spi.sends);
+
+    auto link = LinkManager::getInstance();
+    static const char *causeName[LinkManager::CauseCount] = {"phy", "lease", "conflict", "gateway"};
+    append("# TYPE aiot_link_up gauge\naiot_link_up %d\n", link->isUp() ? 1 : 0);
+    append("# TYPE aiot_link_down_total counter\n");
+    for (int c = 0; c < LinkManager::CauseCount; c++)
+    {
+        append("aiot_link_down_total{cause=\"%s\"} %lu\n", causeName[c], (unsigned long)link->stats().downs[c]);
+    }
+    append("# TYPE aiot_dhcp_leases_total counter\naiot_dhcp_leases_total %lu\n", (unsigned long)link->stats().acquires);
+    append("# TYPE aiot_dhcp_renewals_total counter\naiot_dhcp_renewals_total %lu\n", (unsigned long)link->stats().renewals);
+    append("# TYPE aiot_link_recovery_milliseconds gauge\naiot_link_recovery_milliseconds %lu\n",
+           (unsigned long)link->stats().recoveryMs);
+
+    auto sntp = Sntp::getInstance();
+    const Sntp::Stats &time = sntp->stats();
+    append("# TYPE aiot_sntp_synced gauge\naiot_sntp_synced %d\n", sntp->synced() ? 1 : 0);
+    append("# TYPE aiot_sntp_polls_total counter\n");
+    append("aiot_sntp_polls_total{result=\"sync\"} %lu\n", (unsigned long)time.syncs);
+    append("aiot_sntp_polls_total{result=\"fail\"} %lu\n", (unsigned long)time.failures);
+    append("# TYPE aiot_sntp_steps_total counter\naiot_sntp_steps_total %lu\n", (unsigned long)time.steps);
+    append("# TYPE aiot_sntp_error_microseconds gauge\naiot_sntp_error_microseconds %ld\n", (long)time.errorUs);
+    append("# TYPE aiot_sntp_delay_microseconds gauge\naiot_sntp_delay_microseconds %lu\n", (unsigned long)time.delayUs);
+    append("# TYPE aiot_sntp_drift_ppb gauge\naiot_sntp_drift_ppb %ld\n", (long)time.driftPpb);
+
+    append("# TYPE aiot_boot_phase_milliseconds gauge\n");
+    for (int p = 0; p < BootPhaseCount; p++)
+    {
+        uint32_t ms = _bootPhase[p].load(std::memory_order_relaxed);
+        if (ms)
+        {
+            append("aiot_boot_phase_milliseconds{phase=\"%s\"} %lu\n", bootName[p], (unsigned long)ms);
+        }
+    }
+
+    return (len < size) ? len : size - 1;
+}
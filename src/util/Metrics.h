@@ -0,0 +1,174 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+#define METRICS_LATENCY_BUCKETS 12  // log2 histogram buckets: (0, 64us], (64us, 128us], ..., (32.8ms, 65.5ms], (65.5ms, inf)
+#define METRICS_LATENCY_FIRST_US 64 // upper bound of the first bucket
+
+// Device health counters exported in Prometheus text format by MetricsServer.
+// Counters with a single writer are updated by plain atomic load/store (Cortex-M0+ has no
+// atomic read-modify-write); queue counters have several producers and use mbed atomics.
+class Metrics
+{
+public:
+    enum Stage
+    {
+        StagePreprocess,
+        StageInference,
+        StageCount,
+    };
+
+    enum Queue
+    {
+        QueueApp, // ThreadApp EventQueue
+        QueueNet, // ThreadNet EventQueue
+        QueueCount,
+    };
+
+    // milliseconds from reset until each phase, reached concurrently by different threads
+    enum BootPhase
+    {
+        BootAudioStart,     // capture DMA running (ThreadAudio)
+        BootModelReady,     // interpreter allocated (ThreadAudio)
+        BootMicSettled,     // first block past the microphone settling time (ThreadAudio)
+        BootFirstInference, // time to first inference (ThreadAudio)
+        BootNetUp,          // DHCP lease obtained (ThreadNet)
+        BootPhaseCount,
+    };
+
+    enum AlertStage
+    {
+        AlertDispatch, // end of the detected audio until ThreadNet takes the alert
+        AlertDelivery, // end of the detected audio until the alert server answered
+        AlertStageCount,
+    };
+
+    enum EthEvent
+    {
+        EthConflict,
+        EthUnreach,
+        EthPppTerm,
+        EthWol,
+        EthTimeout,
+        EthArp,
+        EthPing,
+        EthEventCount,
+    };
+
+    Metrics();
+
+    static Metrics *getInstance(void);
+
+    // written by ThreadAudio only
+    void addLatency(Stage stage, uint32_t us);
+    inline void addInference(void)
+    {
+        increment(_inferences);
+    }
+    inline void addDmaOverrun(uint32_t count)
+    {
+        increment(_dmaOverruns, count);
+    }
+    inline void addAudioBlock(void)
+    {
+        increment(_audioBlocks);
+    }
+    inline void addInferenceSkip(void)
+    {
+        increment(_inferenceSkips);
+    }
+    void setArena(uint32_t used, uint32_t size);
+    void setModel(uint32_t generation, bool swapped);
+    void setAgc(int32_t gain, uint32_t peak, uint32_t rms, uint32_t clipped);
+    void setClock(uint32_t sysHz, bool switched);
+    inline void addLowClockBlock(void)
+    {
+        increment(_lowClockBlocks);
+    }
+    inline void setAudioClock(int32_t ppm)
+    {
+        _audioClockPpm.store(ppm, std::memory_order_relaxed);
+    }
+
+    // written once per phase, by the thread reaching it
+    void setBootPhase(BootPhase phase, uint32_t ms);
+
+    // written by any thread or ISR
+    void queuePosted(Queue queue);
+    void queueHandled(Queue queue);
+
+    // written by ThreadNet only
+    inline void addAlert(bool success)
+    {
+        increment(success ? _alertSuccess : _alertFail);
+    }
+    inline void addEthEvent(EthEvent event)
+    {
+        increment(_ethEvents[event]);
+    }
+    void addAlertLatency(AlertStage stage, uint32_t ms);
+
+    // called by reader (MetricsServer), returns number of characters written
+    size_t format(char *buf, size_t size) const;
+
+private:
+    static Metrics *_instance;
+
+    std::atomic<uint32_t> _inferences;
+    std::atomic<uint32_t> _dmaOverruns;
+    std::atomic<uint32_t> _audioBlocks;
+    std::atomic<uint32_t> _inferenceSkips;
+    std::atomic<uint32_t> _latency[StageCount][METRICS_LATENCY_BUCKETS];
+    std::atomic<uint32_t> _latencySum[StageCount]; // us, wraps after 71 minutes of stage time
+    std::atomic<uint32_t> _latencyMax[StageCount];
+    std::atomic<uint32_t> _arenaUsed;
+    std::atomic<uint32_t> _arenaSize;
+    std::atomic<uint32_t> _modelGeneration;
+    std::atomic<uint32_t> _modelSwaps;
+    std::atomic<uint32_t> _clockHz;
+    std::atomic<uint32_t> _clockSwitches;
+    std::atomic<uint32_t> _lowClockBlocks;
+    std::atomic<int32_t> _audioClockPpm;
+    std::atomic<int32_t> _agcGain;
+    std::atomic<uint32_t> _agcPeak;
+    std::atomic<uint32_t> _agcRms;
+    std::atomic<uint32_t> _clippedSamples;
+
+    volatile uint32_t _queuePosted[QueueCount];
+    volatile uint32_t _queueHandled[QueueCount];
+    volatile uint32_t _queueHighWater[QueueCount];
+
+    std::atomic<uint32_t> _alertSuccess;
+    std::atomic<uint32_t> _alertFail;
+    std::atomic<uint32_t> _alertLatencySum[AlertStageCount]; // ms
+    std::atomic<uint32_t> _alertLatencyCount[AlertStageCount];
+    std::atomic<uint32_t> _alertLatencyLast[AlertStageCount];
+    std::atomic<uint32_t> _alertLatencyMax[AlertStageCount];
+    std::atomic<uint32_t> _ethEvents[EthEventCount];
+    std::atomic<uint32_t> _bootPhase[BootPhaseCount]; // 0 until reached
+
+    static inline void increment(std::atomic<uint32_t> &counter, uint32_t count = 1)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+    }
+};
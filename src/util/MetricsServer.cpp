@@ -0,0 +1,116 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "./MetricsServer.h"
+#include "./Metrics.h"
+#include "../ArduProfApp.h"
+#include "../peripheral/W5100sSpi.h"
+
+#define REQUEST_HEAD_SIZE 512 // request line and headers, kept in _buf
+#define REQUEST_HEAD_TIMEOUT_MS 1000
+
+static_assert(REQUEST_HEAD_SIZE <= METRICS_RESPONSE_BUFFER_SIZE, "request head is read into _buf");
+
+///////////////////////////////////////////////////////////////////////////////
+MetricsServer::MetricsServer() : _server(METRICS_PORT),
+                                 _started(false),
+                                 _modelUpdater()
+{
+}
+
+void MetricsServer::begin(void)
+{
+    _server.begin();
+    _started = true;
+    LOG_TRACE("listening on port ", METRICS_PORT);
+}
+
+void MetricsServer::update(void)
+{
+    if (!_started)
+    {
+        return;
+    }
+
+    EthernetClient client = _server.available();
+    if (client)
+    {
+        respond(client);
+        client.stop();
+    }
+}
+
+// reads up to the blank line ending the headers, the body (if any) stays in the socket
+int MetricsServer::readHead(EthernetClient &client)
+{
+    int size = 0;
+    uint32_t start = millis();
+    while ((size < REQUEST_HEAD_SIZE - 1) && (millis() - start < REQUEST_HEAD_TIMEOUT_MS))
+    {
+        int c = client.read();
+        if (c < 0)
+        {
+            if (!client.connected())
+            {
+                break;
+            }
+            rtos::ThisThread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        _buf[size++] = (char)c;
+        if ((size >= 4) && (memcmp(&_buf[size - 4], "\r\n\r\n", 4) == 0))
+        {
+            break;
+        }
+    }
+    _buf[size] = '\0';
+    return size;
+}
+
+void MetricsServer::respond(EthernetClient &client)
+{
+    // e.g. "GET /metrics HTTP/1.1", "PUT /model?offset=0 HTTP/1.1"
+    readHead(client);
+    if ((strncmp(_buf, "GET /model", 10) == 0) || (strncmp(_buf, "PUT /model", 10) == 0))
+    {
+        _modelUpdater.handle(client, _buf);
+        return;
+    }
+
+    if (strncmp(_buf, "GET /metrics", 12) != 0)
+    {
+        static const char notFound[] = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+        client.write((const uint8_t *)notFound, sizeof(notFound) - 1);
+        return;
+    }
+
+    // leave room for the header in front of the body
+    static const size_t HEADER_SIZE = 128;
+    size_t bodyLen = Metrics::getInstance()->format(_buf + HEADER_SIZE, sizeof(_buf) - HEADER_SIZE);
+    int headerLen = snprintf(_buf, HEADER_SIZE,
+                             "HTTP/1.1 200 OK\r\n"
+                             "Content-Type: text/plain; version=0.0.4\r\n"
+                             "Content-Length: %u\r\n"
+                             "Connection: close\r\n\r\n",
+                             (unsigned)bodyLen);
+    // header and body straight from _buf, the body is larger than the socket's TX memory
+    const uint8_t *pieces[] = {(const uint8_t *)_buf, (const uint8_t *)_buf + HEADER_SIZE};
+    uint32_t lengths[] = {(uint32_t)headerLen, (uint32_t)bodyLen};
+    W5100sSpi::getInstance()->send(client.getSocketNumber(), pieces, lengths, 2);
+}
@@ -0,0 +1,49 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <Arduino.h>
+#include <EventEthernet.h>
+
+#include "./ModelUpdater.h"
+
+#define METRICS_PORT 9100              // Prometheus scrape port
+#define METRICS_RESPONSE_BUFFER_SIZE 8192 // header and the full /metrics body, 5.6 KB (6.4 KB with 10-digit counters)
+
+// Tiny HTTP server on one W5100S socket, serving "GET /metrics" in Prometheus text format,
+// and "/model" for model uploads (ModelUpdater).
+// Polled by ThreadNet, so a scrape never runs in the audio thread.
+class MetricsServer
+{
+public:
+    MetricsServer();
+
+    void begin(void);
+    void update(void);
+
+private:
+    EthernetServer _server;
+    bool _started;
+
+    char _buf[METRICS_RESPONSE_BUFFER_SIZE];
+    ModelUpdater _modelUpdater;
+
+    void respond(EthernetClient &client);
+    int readHead(EthernetClient &client);
+};
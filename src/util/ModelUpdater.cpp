@@ -0,0 +1,210 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <stdarg.h>
+#include "./ModelUpdater.h"
+#include "../ml/ModelStore.h"
+#include "../ml/audio_model.h"
+#include "../ArduProfApp.h"
+
+// value of header "name" in head, nullptr when missing
+static const char *header_value(const char *head, const char *name)
+{
+    size_t len = strlen(name);
+    for (const char *p = strstr(head, "\r\n"); p; p = strstr(p + 2, "\r\n"))
+    {
+        if ((strncasecmp(p + 2, name, len) == 0) && (p[2 + len] == ':'))
+        {
+            const char *v = p + 3 + len;
+            while (*v == ' ')
+            {
+                v++;
+            }
+            return v;
+        }
+    }
+    return nullptr;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+ModelUpdater::ModelUpdater() : _size(0),
+                               _crc(0)
+{
+}
+
+void ModelUpdater::handle(EthernetClient &client, const char *head)
+{
+    if (strncmp(head, "PUT /model", 10) == 0)
+    {
+        upload(client, head);
+    }
+    else
+    {
+        status(client);
+    }
+}
+
+void ModelUpdater::status(EthernetClient &client)
+{
+    auto store = ModelStore::getInstance();
+    respond(client, 200, "OK", "slot %d generation %lu received %lu\n",
+            store->active_slot(), (unsigned long)AudioModel::getInstance()->generation(), (unsigned long)store->received());
+}
+
+void ModelUpdater::upload(EthernetClient &client, const char *head)
+{
+    auto store = ModelStore::getInstance();
+    const char *offsetArg = strstr(head, "offset=");
+    const char *length = header_value(head, "Content-Length");
+    const char *size = header_value(head, "X-Model-Size");
+    const char *crc = header_value(head, "X-Model-CRC32");
+    if (!offsetArg || !length || !size || !crc)
+    {
+        respond(client, 400, "Bad Request", "offset, Content-Length, X-Model-Size and X-Model-CRC32 required\n");
+        return;
+    }
+    if (AudioModel::getInstance()->swap_pending())
+    {
+        respond(client, 409, "Conflict", "previous model not swapped in yet\n");
+        return;
+    }
+
+    uint32_t offset = strtoul(offsetArg + 7, nullptr, 10);
+    uint32_t remaining = strtoul(length, nullptr, 10);
+    uint32_t modelSize = strtoul(size, nullptr, 10);
+    uint32_t modelCrc = strtoul(crc, nullptr, 16);
+
+    ModelStore::Status result = ModelStore::Ok;
+    if (offset == 0)
+    {
+        // the upload erases the inactive slot: nothing may use the model it holds
+        auto model = AudioModel::getInstance();
+        model->reclaim();
+        if (model->model_data() == store->model((store->active_slot() == 0) ? 1 : 0, nullptr))
+        {
+            respond(client, 409, "Conflict", "running model is in the upload slot (active slot failed at boot)\n");
+            return;
+        }
+        store->abort(); // a new upload replaces an unfinished one
+        result = store->begin(modelSize, modelCrc);
+        _size = modelSize;
+        _crc = modelCrc;
+        LOG_TRACE("model upload: ", modelSize, " bytes, crc32=", DebugLogBase::HEX, modelCrc);
+    }
+    else if (!store->busy() || (modelSize != _size) || (modelCrc != _crc))
+    {
+        respond(client, 409, "Conflict", "no upload of this model in progress, start at offset 0\n");
+        return;
+    }
+
+    // stream the body to flash as it arrives
+    uint32_t last = millis();
+    while ((result == ModelStore::Ok) && remaining)
+    {
+        int n = client.read(_buf, (remaining < sizeof(_buf)) ? remaining : sizeof(_buf));
+        if (n > 0)
+        {
+            result = store->write(offset, _buf, n);
+            offset += n;
+            remaining -= n;
+            last = millis();
+        }
+        else if (!client.connected() || (millis() - last > MODEL_UPLOAD_TIMEOUT_MS))
+        {
+            break;
+        }
+        else
+        {
+            rtos::ThisThread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    switch (result)
+    {
+    case ModelStore::Ok:
+        break;
+    case ModelStore::ErrorSize:
+        respond(client, 413, "Payload Too Large", "model exceeds %u bytes or its X-Model-Size\n", (unsigned)MODEL_MAX_SIZE);
+        return;
+    case ModelStore::ErrorOffset:
+        respond(client, 416, "Range Not Satisfiable", "received %lu\n", (unsigned long)store->received());
+        return;
+    default:
+        respond(client, 500, "Internal Server Error", "flash error %d\n", result);
+        return;
+    }
+
+    if (store->received() < _size)
+    {
+        respond(client, remaining ? 408 : 200, remaining ? "Request Timeout" : "OK", "received %lu\n", (unsigned long)store->received());
+        return;
+    }
+    finish(client);
+}
+
+void ModelUpdater::finish(EthernetClient &client)
+{
+    auto store = ModelStore::getInstance();
+    auto model = AudioModel::getInstance();
+
+    const uint8_t *data;
+    if (store->verify(&data) != ModelStore::Ok)
+    {
+        respond(client, 422, "Unprocessable Entity", "CRC-32 mismatch, upload discarded\n");
+        return;
+    }
+
+    // the slot becomes active (also for the next boot) only when the interpreter accepted the model
+    if (model->prepare(data) != kTfLiteOk)
+    {
+        store->abort();
+        respond(client, 422, "Unprocessable Entity", "model rejected by the interpreter, upload discarded\n");
+        return;
+    }
+    if (store->commit() != ModelStore::Ok)
+    {
+        model->discard();
+        respond(client, 500, "Internal Server Error", "slot header not written, upload discarded\n");
+        return;
+    }
+    model->publish(store->generation());
+
+    LOG_TRACE("model generation ", store->generation(), " in slot ", store->active_slot(), ", swap pending");
+    respond(client, 200, "OK", "slot %d generation %lu\n", store->active_slot(), (unsigned long)store->generation());
+}
+
+void ModelUpdater::respond(EthernetClient &client, int code, const char *reason, const char *format, ...)
+{
+    char body[96];
+    va_list args;
+    va_start(args, format);
+    int bodyLen = vsnprintf(body, sizeof(body), format, args);
+    va_end(args);
+    bodyLen = (bodyLen < (int)sizeof(body)) ? bodyLen : (int)sizeof(body) - 1;
+
+    char header[128];
+    int headerLen = snprintf(header, sizeof(header),
+                             "HTTP/1.1 %d %s\r\n"
+                             "Content-Type: text/plain\r\n"
+                             "Content-Length: %d\r\n"
+                             "Connection: close\r\n\r\n",
+                             code, reason, bodyLen);
+    client.write((const uint8_t *)header, headerLen);
+    client.write((const uint8_t *)body, bodyLen);
+}
@@ -0,0 +1,50 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <Arduino.h>
+#include <EventEthernet.h>
+
+#define MODEL_UPLOAD_TIMEOUT_MS 5000 // no body data for this long ends the request, the client resumes from "received"
+#define MODEL_UPLOAD_BUFFER_SIZE 512
+
+// Model upload over HTTP, served on the MetricsServer socket (the W5100S has no socket to spare):
+//   GET /model                      -> "slot <active> generation <running> received <bytes of the upload in progress>"
+//   PUT /model?offset=<bytes>       -> one chunk of the .tflite file, headers X-Model-Size and X-Model-CRC32 (hex)
+// offset=0 starts an upload into the inactive ModelStore slot; a chunk already received is accepted again, so a
+// client resumes an interrupted upload from "received". After the last chunk the CRC-32 is checked on the flash
+// contents, AudioModel prepares the new interpreter, the slot header is committed and ThreadAudio swaps models
+// between two hops. Runs in ThreadNet (tools/model_upload.py is the client).
+class ModelUpdater
+{
+public:
+    ModelUpdater();
+
+    void handle(EthernetClient &client, const char *head); // head: request line and headers
+
+private:
+    uint32_t _size; // X-Model-Size and X-Model-CRC32 of the upload in progress
+    uint32_t _crc;
+    uint8_t _buf[MODEL_UPLOAD_BUFFER_SIZE];
+
+    void status(EthernetClient &client);
+    void upload(EthernetClient &client, const char *head);
+    void finish(EthernetClient &client);
+    void respond(EthernetClient &client, int code, const char *reason, const char *format, ...);
+};
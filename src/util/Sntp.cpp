@@ -0,0 +1,291 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "hardware/timer.h"
+#include "Sntp.h"
+#include "../ArduProfApp.h"
+#include "./BinLog.h"
+
+#define NTP_PACKET_SIZE 48
+#define NTP_UNIX_OFFSET 2208988800ull // seconds from 1900 to 1970
+
+// packet fields (RFC 4330)
+enum
+{
+    NtpFlags = 0, // LI (2 bits), VN (3 bits), mode (3 bits)
+    NtpStratum = 1,
+    NtpOriginate = 24,
+    NtpReceive = 32,
+    NtpTransmit = 40,
+
+    NtpVersion = 4,
+    NtpModeClient = 3,
+    NtpModeServer = 4,
+    NtpLeapAlarm = 3, // LI: server not synchronised
+};
+
+// 64-bit NTP timestamp (seconds since 1900, 32-bit fraction) to Unix time in microseconds;
+// seconds with the MSB clear are in era 1, from 2036 (RFC 4330 section 3)
+static uint64_t ntp_to_unix_us(const uint8_t *p)
+{
+    uint32_t seconds = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+    uint32_t fraction = ((uint32_t)p[4] << 24) | ((uint32_t)p[5] << 16) | ((uint32_t)p[6] << 8) | p[7];
+    uint64_t s = seconds;
+    if (!(seconds & 0x80000000u))
+    {
+        s += 1ull << 32;
+    }
+    return (s - NTP_UNIX_OFFSET) * 1000000 + (((uint64_t)fraction * 1000000) >> 32);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+Sntp *Sntp::_instance = nullptr;
+
+Sntp *Sntp::getInstance(void)
+{
+    if (!_instance)
+    {
+        static Sntp instance;
+        _instance = &instance;
+    }
+    return _instance;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+Sntp::Sntp() : _udp(),
+               _synced(false),
+               _waiting(false),
+               _cookie(),
+               _sentUs(0),
+               _pollAt(0),
+               _intervalS(SNTP_POLL_MIN_S),
+               _offset(0),
+               _offsetAt(0),
+               _driftPpb(0),
+               _driftSpan(0),
+               _bestDelay(SNTP_MAX_DELAY_MS * 1000),
+               _stats()
+{
+}
+
+void Sntp::update(void)
+{
+    uint64_t now = time_us_64();
+    if (_waiting)
+    {
+        receive(now);
+    }
+    else if ((int64_t)(now - _pollAt) >= 0)
+    {
+        poll(now);
+    }
+}
+
+void Sntp::abort(void)
+{
+    if (_waiting)
+    {
+        _udp.stop();
+        _waiting = false;
+    }
+    _pollAt = time_us_64();
+}
+
+uint64_t Sntp::utc(uint64_t localUs) const
+{
+    return localUs + offsetAt(localUs);
+}
+
+int64_t Sntp::offsetAt(uint64_t localUs) const
+{
+    return _offset + (int64_t)(localUs - _offsetAt) * _driftPpb / 1000000000;
+}
+
+void Sntp::poll(uint64_t now)
+{
+    if (!_udp.begin(SNTP_LOCAL_PORT))
+    {
+        fail(FailSocket, now);
+        return;
+    }
+
+    // the transmit timestamp is only a cookie: the server copies it to the originate timestamp
+    uint8_t packet[NTP_PACKET_SIZE] = {0};
+    packet[NtpFlags] = (NtpVersion << 3) | NtpModeClient;
+    for (int i = 0; i < 8; i++)
+    {
+        _cookie[i] = (uint8_t)(now >> (56 - 8 * i));
+    }
+    memcpy(&packet[NtpTransmit], _cookie, sizeof(_cookie));
+
+    if (!_udp.beginPacket(SNTP_SERVER, SNTP_PORT))
+    {
+        _udp.stop();
+        fail(FailSocket, now);
+        return;
+    }
+    _udp.write(packet, sizeof(packet));
+    _sentUs = time_us_64();
+    if (!_udp.endPacket())
+    {
+        _udp.stop();
+        fail(FailSocket, now);
+        return;
+    }
+    _waiting = true;
+}
+
+void Sntp::receive(uint64_t now)
+{
+    // the reply arrived between the previous update() and now
+    int size = _udp.parsePacket();
+    if (size == 0)
+    {
+        if (now - _sentUs >= SNTP_TIMEOUT_MS * 1000ull)
+        {
+            _udp.stop();
+            _waiting = false;
+            fail(FailTimeout, now);
+        }
+        return;
+    }
+
+    uint8_t packet[NTP_PACKET_SIZE];
+    if ((size < NTP_PACKET_SIZE) || (_udp.read(packet, sizeof(packet)) != sizeof(packet)) ||
+        (_udp.remotePort() != SNTP_PORT) || ((packet[NtpFlags] & 0x07) != NtpModeServer) ||
+        memcmp(&packet[NtpOriginate], _cookie, sizeof(_cookie)))
+    {
+        return; // not the reply to this request, e.g. a late reply to a previous one
+    }
+    _udp.stop();
+    _waiting = false;
+
+    // stratum 0 is a kiss-o'-death (RATE, DENY): back off like a failure
+    if (((packet[NtpFlags] >> 6) == NtpLeapAlarm) || (packet[NtpStratum] == 0) || (packet[NtpStratum] > 15))
+    {
+        fail(FailServer, now);
+        return;
+    }
+
+    // T1, T4 local time; T2, T3 server time
+    uint64_t t2 = ntp_to_unix_us(&packet[NtpReceive]);
+    uint64_t t3 = ntp_to_unix_us(&packet[NtpTransmit]);
+    int64_t delay = (int64_t)(now - _sentUs) - (int64_t)(t3 - t2);
+    if (delay < 0)
+    {
+        delay = 0;
+    }
+    // a round trip well above the best recent one was queued on one path: the offset is off by up to
+    // half of it. The best doubles on every skipped reply, so a slower route is accepted after a few polls.
+    if ((delay > SNTP_MAX_DELAY_MS * 1000) || (delay > 2 * (int64_t)_bestDelay + SNTP_WAIT_MS * 1000))
+    {
+        _bestDelay = (_bestDelay < SNTP_MAX_DELAY_MS * 1000) ? 2 * _bestDelay : _bestDelay;
+        fail(FailDelay, now);
+        return;
+    }
+    // the receive time is known to SNTP_WAIT_MS only: a best round trip below that (a reply claiming more
+    // processing time than it took) would leave no room to double and lock out every later reply
+    if (delay < _bestDelay)
+    {
+        _bestDelay = (delay > SNTP_WAIT_MS * 1000) ? (uint32_t)delay : SNTP_WAIT_MS * 1000;
+    }
+    int64_t offset = ((int64_t)(t2 - _sentUs) + (int64_t)(t3 - now)) / 2;
+    sample(offset, _sentUs + (now - _sentUs) / 2, (uint32_t)delay, now);
+}
+
+void Sntp::sample(int64_t offset, uint64_t at, uint32_t delay, uint64_t now)
+{
+    _stats.syncs++;
+    _stats.delayUs = delay;
+    if (!_synced)
+    {
+        _synced = true;
+        _stats.errorUs = 0;
+    }
+    else
+    {
+        int64_t error = offset - offsetAt(at);
+        _stats.errorUs = (int32_t)((error > INT32_MAX) ? INT32_MAX : (error < INT32_MIN) ? INT32_MIN : error);
+        if ((error > SNTP_STEP_MS * 1000) || (error < -SNTP_STEP_MS * 1000))
+        {
+            _stats.steps++;
+            _driftPpb = 0;
+            _driftSpan = 0;
+            _intervalS = SNTP_POLL_MIN_S;
+        }
+        else
+        {
+            // the error accumulated since the previous sample is the rate still uncorrected; its noise
+            // falls with the span, so it is weighted against the span of the previous measurement
+            int64_t span = (int64_t)(at - _offsetAt);
+            int64_t correction = error * 1000000000 / span;
+            _driftPpb += correction * span / (span + (int64_t)_driftSpan);
+            _driftSpan = span;
+            if (_driftPpb > SNTP_MAX_DRIFT_PPM * 1000)
+            {
+                _driftPpb = SNTP_MAX_DRIFT_PPM * 1000;
+            }
+            else if (_driftPpb < -SNTP_MAX_DRIFT_PPM * 1000)
+            {
+                _driftPpb = -SNTP_MAX_DRIFT_PPM * 1000;
+            }
+            if (_intervalS < SNTP_POLL_MAX_S)
+            {
+                _intervalS *= 2;
+            }
+        }
+    }
+    _offset = offset;
+    _offsetAt = at;
+    _stats.driftPpb = (int32_t)_driftPpb;
+    _pollAt = now + _intervalS * 1000000ull;
+    BINLOG(BL_SNTP_SYNC, _stats.errorUs, delay, _stats.driftPpb);
+}
+
+void Sntp::fail(FailCause cause, uint64_t now)
+{
+    // retry soon; the clock keeps running on the last offset and drift
+    _stats.failures++;
+    _pollAt = now + SNTP_POLL_MIN_S * 1000000ull;
+    BINLOG(BL_SNTP_FAIL, cause);
+    LOG_TRACE("SNTP poll failed, cause=", cause);
+}
+
+size_t Sntp::format(char *buf, size_t size, uint64_t utcUs)
+{
+    uint64_t seconds = utcUs / 1000000;
+    uint32_t ms = (uint32_t)((utcUs / 1000) % 1000);
+    uint32_t days = (uint32_t)(seconds / 86400);
+    uint32_t daySeconds = (uint32_t)(seconds % 86400);
+
+    // civil date from days since 1970-01-01 (H. Hinnant's algorithm, years from March)
+    uint32_t z = days + 719468;
+    uint32_t era = z / 146097;
+    uint32_t doe = z - era * 146097;
+    uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    uint32_t mp = (5 * doy + 2) / 153;
+    uint32_t day = doy - (153 * mp + 2) / 5 + 1;
+    uint32_t month = (mp < 10) ? mp + 3 : mp - 9;
+    uint32_t year = yoe + era * 400 + (month <= 2);
+
+    int n = snprintf(buf, size, "%04u-%02u-%02uT%02u:%02u:%02u.%03uZ", (unsigned)year, (unsigned)month, (unsigned)day,
+                     (unsigned)(daySeconds / 3600), (unsigned)(daySeconds / 60 % 60), (unsigned)(daySeconds % 60), (unsigned)ms);
+    return (n < 0) ? 0 : ((size_t)n < size) ? n : size - 1;
+}
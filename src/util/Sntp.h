@@ -0,0 +1,119 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify,
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+ * OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <Arduino.h>
+#include <EventEthernet.h>
+
+#ifndef SNTP_SERVER
+#define SNTP_SERVER "pool.ntp.org"
+#endif
+#define SNTP_PORT 123
+#define SNTP_LOCAL_PORT 4123    // the socket is open during a poll only
+#ifndef SNTP_POLL_MIN_S
+#define SNTP_POLL_MIN_S 16      // first polls, after a failure and after a step
+#endif
+#ifndef SNTP_POLL_MAX_S
+#define SNTP_POLL_MAX_S 1024    // the interval doubles after every good sample up to this
+#endif
+#define SNTP_TIMEOUT_MS 1000    // no valid reply by then: the poll failed
+#define SNTP_WAIT_MS 1          // update() period while a reply is awaited, bounds the receive time error
+#define SNTP_MAX_DELAY_MS 250   // replies with a longer round trip are discarded
+#define SNTP_STEP_MS 128        // error beyond which the clock steps and the drift estimate starts again
+#define SNTP_MAX_DRIFT_PPM 500
+
+// SNTP client (RFC 4330) on a W5100S UDP socket, keeping UTC against the local microsecond clock
+// (time_us_64()) with drift compensation:
+//  - every poll measures the offset of the local clock from the server time, corrected for the round
+//    trip and the server processing time; replies are matched to the request by the originate timestamp
+//  - the error of the prediction at the next sample, over the time since the previous one, corrects the
+//    rate of the local clock (drift, in ppb), so UTC stays accurate between polls and through outages
+//  - the poll interval doubles from SNTP_POLL_MIN_S to SNTP_POLL_MAX_S while samples agree
+// update() runs on ThreadNet while the link is up, every second and every SNTP_WAIT_MS while a reply is
+// awaited: the chip has no receive timestamp, so the poll period bounds the receive time error.
+class Sntp
+{
+public:
+    enum FailCause
+    {
+        FailSocket,  // no free socket or no route to the server
+        FailTimeout, // no valid reply within SNTP_TIMEOUT_MS
+        FailDelay,   // round trip longer than SNTP_MAX_DELAY_MS, or a spike against the best recent one
+        FailServer,  // kiss-o'-death or unsynchronised server
+    };
+
+    typedef struct _Stats
+    {
+        uint32_t syncs;    // samples taken
+        uint32_t failures; // polls without a sample
+        uint32_t steps;    // samples off the prediction by more than SNTP_STEP_MS
+        int32_t errorUs;   // last sample against the prediction
+        uint32_t delayUs;  // last round trip
+        int32_t driftPpb;  // rate correction of the local clock
+    } Stats;
+
+    static Sntp *getInstance(void);
+
+    void update(void);
+    void abort(void); // drops the poll in flight (link down), the next update() polls again
+
+    inline bool waiting(void) const
+    {
+        return _waiting;
+    }
+    inline bool synced(void) const
+    {
+        return _synced;
+    }
+    inline const Stats &stats(void) const
+    {
+        return _stats;
+    }
+
+    // Unix time in microseconds of a time_us_64() value, valid once synced()
+    uint64_t utc(uint64_t localUs) const;
+
+    // ISO 8601 UTC with milliseconds, e.g. "2026-10-19T12:34:56.789Z"; returns number of characters written
+    static size_t format(char *buf, size_t size, uint64_t utcUs);
+
+private:
+    Sntp();
+
+    static Sntp *_instance;
+
+    EthernetUDP _udp;
+    bool _synced;
+    bool _waiting;
+    uint8_t _cookie[8]; // transmit timestamp of the request, returned as originate timestamp
+    uint64_t _sentUs;   // request sent, local time
+    uint64_t _pollAt;
+    uint32_t _intervalS;
+    int64_t _offset;    // UTC minus local time at _offsetAt, microseconds
+    uint64_t _offsetAt;
+    int64_t _driftPpb;
+    uint64_t _driftSpan; // of the last rate measurement, 0: none since the last step
+    uint32_t _bestDelay; // lowest recent round trip, microseconds, at least SNTP_WAIT_MS
+    Stats _stats;
+
+    void poll(uint64_t now);
+    void receive(uint64_t now);
+    void sample(int64_t offset, uint64_t at, uint32_t delay, uint64_t now);
+    void fail(FailCause cause, uint64_t now);
+    int64_t offsetAt(uint64_t localUs) const;
+};
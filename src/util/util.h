@@ -18,6 +18,7 @@
  * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #pragma once
+#include <math.h>
 #include "hardware/structs/sio.h"
 
 __attribute__((weak)) inline uint32_t get_core_num(void)
@@ -46,4 +47,23 @@ inline float uint32_to_float(uint32_t value)
     } ret;
     ret.u = value;
     return ret.f;
-}
\ No newline at end of file
+}
+// a value in [0.0, 1.0] (e.g. a model prediction) as a 16-bit message parameter; values outside the range
+// saturate, NaN (AudioModel::inference() failed) maps to 0: casting it is undefined
+inline uint16_t unit_to_uint16(float value)
+{
+    if (isnan(value) || (value <= 0.0f))
+    {
+        return 0;
+    }
+    if (value >= 1.0f)
+    {
+        return UINT16_MAX;
+    }
+    return (uint16_t)(value * UINT16_MAX + 0.5f);
+}
+
+inline float uint16_to_unit(uint16_t value)
+{
+    return (float)value / UINT16_MAX;
+}
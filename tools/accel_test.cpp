@@ -0,0 +1,88 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Host equivalence test of src/audio/accel against the code it replaces:
+ *  - window_q15() versus arm_mult_q15() semantics, exhaustive over the window values
+ *  - sat_q15() versus the former round/shift/saturate, and against a model of the RP2040 interp1
+ *    lane 0 configured by accel::begin() (shift, mask, sign extension, clamp as in the datasheet)
+ *
+ * build and run from the repository root:
+ *   g++ -O2 -std=c++17 -I. tools/accel_test.cpp src/audio/accel.cpp -o accel_test
+ *   ./accel_test
+ */
+#include <cstdio>
+#include <random>
+
+#include "src/audio/accel.h"
+
+static int16_t ssat16(int32_t x)
+{
+    return (int16_t)((x > 32767) ? 32767 : ((x < -32768) ? -32768 : x));
+}
+
+// arm_mult_q15() on cores without DSP extension
+static int16_t reference_mult_q15(int16_t a, int16_t b)
+{
+    return ssat16(((int32_t)a * b) >> 15);
+}
+
+// RP2040 datasheet 2.3.1.6: lane result = sign-extend(mask(accum >> shift)), clamped to [BASE0, BASE1] on interp1
+static int16_t interp1_lane0(uint32_t accum)
+{
+    const uint32_t shift = 15, mask_lsb = 0, mask_msb = 16;
+    const int32_t base0 = -32768, base1 = 32767;
+    uint32_t mask = (0xFFFFFFFFu >> (31 - mask_msb)) & (0xFFFFFFFFu << mask_lsb);
+    uint32_t v = (accum >> shift) & mask;
+    if (v & (1u << mask_msb))
+    {
+        v |= ~mask; // sign extension
+    }
+    int32_t s = (int32_t)v;
+    return (int16_t)((s < base0) ? base0 : ((s > base1) ? base1 : s));
+}
+
+int main()
+{
+    int failures = 0;
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int32_t> q15(-32768, 32767);
+    std::uniform_int_distribution<int32_t> q31(INT32_MIN + (1 << 14), INT32_MAX - (1 << 14));
+
+    // window_q15: every non-negative window value against edge and random samples
+    const int16_t edges[] = {-32768, -32767, -16384, -1, 0, 1, 16384, 32767};
+    int16_t window[64], src[64], dst[64];
+    for (int32_t w = 0; w <= 32767; w += 64)
+    {
+        for (int i = 0; i < 64; i++)
+        {
+            window[i] = (int16_t)(w + i);
+            src[i] = (i < 8) ? edges[i] : (int16_t)q15(rng);
+        }
+        accel::window_q15(window, src, dst, 63); // odd count covers the tail
+        for (int i = 0; i < 63; i++)
+        {
+            if (dst[i] != reference_mult_q15(window[i], src[i]))
+            {
+                printf("window_q15(%d, %d) = %d, expected %d\n", window[i], src[i], dst[i], reference_mult_q15(window[i], src[i]));
+                failures++;
+            }
+        }
+    }
+
+    // sat_q15: former output stage and the interpolator model
+    const int32_t acc_edges[] = {INT32_MIN + (1 << 14), INT32_MAX - (1 << 14), -(1 << 14), (1 << 14) - 1};
+    for (int i = 0; i < 1000000; i++)
+    {
+        int32_t acc = (i < 4) ? acc_edges[i] : q31(rng) >> (i % 17);
+        int16_t expected = ssat16((acc + (1 << 14)) >> 15);
+        int16_t model = interp1_lane0((uint32_t)(acc + (1 << 14)));
+        if ((accel::sat_q15(acc) != expected) || (model != expected))
+        {
+            printf("sat_q15(%d) = %d, interp1 model %d, expected %d\n", acc, accel::sat_q15(acc), model, expected);
+            failures++;
+            break;
+        }
+    }
+
+    printf("%s\n", failures ? "FAILED" : "passed");
+    return failures ? 1 : 0;
+}
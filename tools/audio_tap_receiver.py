@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+# Copyright 2026 teamprof.net@gmail.com
+#
+# Receive audio tap packets streamed by the device (see src/util/AudioTap.h) and
+# reassemble them into a WAV file (PCM) or a PGM image (spectrogram).
+#
+# usage:
+#   python3 tools/audio_tap_receiver.py -o capture.wav            # AUDIO_TAP_PCM
+#   python3 tools/audio_tap_receiver.py -o capture.pgm            # AUDIO_TAP_SPECTROGRAM
+#
+# Lost packets are filled with silence (PCM) or zero columns (spectrogram) so the
+# output stays time-aligned with the device.
+import argparse
+import socket
+import struct
+import sys
+import wave
+
+AUDIO_TAP_MAGIC = 0x50415441
+AUDIO_TAP_VERSION = 1
+HEADER = struct.Struct("<IBBHIHH")
+
+PAYLOAD_PCM16 = 1
+PAYLOAD_SPECTROGRAM = 2
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description="audio tap receiver")
+    parser.add_argument("-o", "--output", required=True, help="output file (.wav for PCM, .pgm for spectrogram)")
+    parser.add_argument("-p", "--port", type=int, default=5005, help="UDP port (AUDIO_TAP_COLLECTOR_PORT)")
+    parser.add_argument("-d", "--duration", type=float, default=0, help="stop after N seconds of audio (0 = until Ctrl-C)")
+    return parser.parse_args()
+
+
+def receive(port, duration):
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.bind(("0.0.0.0", port))
+    print("listening on udp port", port, file=sys.stderr)
+
+    blocks = {}
+    info = None
+    seconds = 0.0
+    try:
+        while duration <= 0 or seconds < duration:
+            data, addr = sock.recvfrom(2048)
+            if len(data) < HEADER.size:
+                continue
+            magic, version, ptype, length, sequence, sample_rate, height = HEADER.unpack_from(data)
+            if magic != AUDIO_TAP_MAGIC or version != AUDIO_TAP_VERSION:
+                continue
+            if info is None:
+                info = (ptype, sample_rate, height, length)
+                print("from", addr[0], "type", ptype, "sample_rate", sample_rate, "height", height, file=sys.stderr)
+            blocks[sequence] = data[HEADER.size:HEADER.size + length]
+            if ptype == PAYLOAD_PCM16:
+                seconds += (length // 2) / sample_rate
+            else:
+                seconds += (length // height) * 128 / sample_rate  # AUDIO_FRAME_STEP samples per column
+    except KeyboardInterrupt:
+        pass
+    finally:
+        sock.close()
+    return info, blocks
+
+
+def reassemble(blocks, block_size):
+    first, last = min(blocks), max(blocks)
+    missing = 0
+    out = bytearray()
+    for seq in range(first, last + 1):
+        block = blocks.get(seq)
+        if block is None:
+            missing += 1
+            block = bytes(block_size)
+        out += block
+    total = last - first + 1
+    print("blocks", total, "lost", missing, "({:.2f}%)".format(100.0 * missing / total), file=sys.stderr)
+    return bytes(out)
+
+
+def main():
+    args = parse_args()
+    info, blocks = receive(args.port, args.duration)
+    if not blocks:
+        print("no packet received", file=sys.stderr)
+        return 1
+
+    ptype, sample_rate, height, length = info
+    data = reassemble(blocks, length)
+    if ptype == PAYLOAD_PCM16:
+        with wave.open(args.output, "wb") as wav:
+            wav.setnchannels(1)
+            wav.setsampwidth(2)
+            wav.setframerate(sample_rate)
+            wav.writeframes(data)
+    elif ptype == PAYLOAD_SPECTROGRAM:
+        # one column per spectrogram frame: transpose to width=frames, height=bins,
+        # and map int8 to 0-255 grey levels
+        width = len(data) // height
+        with open(args.output, "wb") as pgm:
+            pgm.write("P5\n{} {}\n255\n".format(width, height).encode())
+            for row in range(height - 1, -1, -1):
+                pgm.write(bytes(((data[col * height + row] + 128) & 0xFF) for col in range(width)))
+    else:
+        print("unsupported payload type", ptype, file=sys.stderr)
+        return 1
+
+    print("written", args.output, file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,61 @@
+#!/usr/bin/env python3
+# Copyright 2026 teamprof.net@gmail.com
+#
+# Compare two JSON reports of tools/frontend_bench.cpp stage by stage (ns per frame and host
+# instructions per call). Exits with 1 when a stage got slower than the threshold.
+#
+# usage:
+#   python3 tools/bench_compare.py before.json after.json
+#   python3 tools/bench_compare.py before.json after.json -t 10
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        return {s["name"]: s for s in json.load(f)["stages"]}
+
+
+def delta(old, new):
+    if old is None or new is None or old == 0:
+        return None
+    return 100.0 * (new - old) / old
+
+
+def text(value):
+    return "-" if value is None else "{:+.1f}%".format(value)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="compare two frontend_bench reports")
+    parser.add_argument("before", help="JSON report of the baseline build")
+    parser.add_argument("after", help="JSON report of the changed build")
+    parser.add_argument("-t", "--threshold", type=float, default=5.0, help="slowdown in percent reported as regression")
+    args = parser.parse_args()
+
+    before = load(args.before)
+    after = load(args.after)
+    regressions = 0
+    print("{:<22} {:>12} {:>12} {:>9} {:>9}".format("stage", "ns/frame", "ns/frame", "time", "instr"))
+    for name, new in after.items():
+        old = before.get(name)
+        if old is None:
+            print("{:<22} {:>12} {:>12.1f} {:>9} {:>9}".format(name, "-", new["ns_per_frame"], "new", "-"))
+            continue
+        time = delta(old["ns_per_frame"], new["ns_per_frame"])
+        instr = delta(old.get("instructions_per_call"), new.get("instructions_per_call"))
+        flag = ""
+        if time is not None and time > args.threshold:
+            flag = "  slower"
+            regressions += 1
+        print("{:<22} {:>12.1f} {:>12.1f} {:>9} {:>9}{}".format(
+            name, old["ns_per_frame"], new["ns_per_frame"], text(time), text(instr), flag))
+    for name in before:
+        if name not in after:
+            print("{:<22} {:>12.1f} {:>12} {:>9} {:>9}".format(name, before[name]["ns_per_frame"], "-", "removed", "-"))
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
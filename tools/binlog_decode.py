@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+# Copyright 2026 teamprof.net@gmail.com
+#
+# Decode binary log frames written by ThreadLog (see src/util/BinLog.h) back to text.
+# Ordinary text output on the same port is passed through unchanged.
+#
+# usage:
+#   python3 tools/binlog_decode.py < capture.bin
+#   python3 tools/binlog_decode.py /dev/ttyACM0
+import os
+import re
+import struct
+import sys
+
+SYNC = b"\xa5\x5a"
+HEADER = struct.Struct("<HBBI")  # id, nargs, checksum, timestamp
+MAX_ARGS = 5
+
+MESSAGES_H = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src", "util", "BinLogMessages.h")
+
+
+def load_messages(path=MESSAGES_H):
+    with open(path) as f:
+        return re.findall(r'X\(\s*(\w+)\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)', f.read())
+
+
+def format_message(fmt, args):
+    args = iter(args)
+
+    def convert(match):
+        spec = match.group(1)
+        if spec == "%":
+            return "%"
+        value = next(args, 0)
+        if spec == "d":
+            return str(struct.unpack("<i", struct.pack("<I", value))[0])
+        if spec == "u":
+            return str(value)
+        if spec == "x":
+            return "{:x}".format(value)
+        if spec == "f":
+            return "{:.2f}".format(struct.unpack("<f", struct.pack("<I", value))[0])
+        if spec == "I":
+            return ".".join(str(b) for b in struct.pack("<I", value))
+        return match.group(0)
+
+    return re.sub(r"%([duxfI%])", convert, fmt)
+
+
+def decode(stream, out, messages):
+    buf = b""
+    while True:
+        data = stream.read(256)
+        if not data:
+            break
+        buf += data
+        while True:
+            pos = buf.find(SYNC)
+            if pos < 0:
+                # keep a trailing 0xA5 that may start the next frame
+                keep = 1 if buf.endswith(SYNC[:1]) else 0
+                out.write(buf[: len(buf) - keep].decode(errors="replace"))
+                buf = buf[len(buf) - keep:]
+                break
+            if pos:
+                out.write(buf[:pos].decode(errors="replace"))
+                buf = buf[pos:]
+            if len(buf) < 2 + HEADER.size:
+                break
+            msg_id, nargs, _, timestamp = HEADER.unpack_from(buf, 2)
+            size = 2 + HEADER.size + 4 * nargs
+            if nargs > MAX_ARGS:
+                out.write(buf[:1].decode(errors="replace"))
+                buf = buf[1:]
+                continue
+            if len(buf) < size:
+                break
+            checksum = 0
+            for b in buf[2:size]:
+                checksum ^= b
+            if checksum:
+                out.write(buf[:1].decode(errors="replace"))
+                buf = buf[1:]
+                continue
+
+            args = struct.unpack_from("<{}I".format(nargs), buf, 2 + HEADER.size)
+            if msg_id < len(messages):
+                name, fmt = messages[msg_id]
+                text = format_message(fmt, args)
+            else:
+                text = "unknown id {} args {}".format(msg_id, args)
+            out.write("[{:10.6f}] {}\n".format(timestamp / 1e6, text))
+            buf = buf[size:]
+        out.flush()
+
+
+def main():
+    messages = load_messages()
+    if len(sys.argv) > 1:
+        with open(sys.argv[1], "rb", buffering=0) as stream:
+            decode(stream, sys.stdout, messages)
+    else:
+        decode(sys.stdin.buffer, sys.stdout, messages)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+# Copyright 2026 teamprof.net@gmail.com
+#
+# Minimal HTTP server receiving alarm clips uploaded by the device (see src/util/ClipUploader.h).
+# Each clip is saved as a mu-law WAV file named after the sender IP and the receive time.
+# Once the device clock is synchronised (SNTP) the request carries X-Detected-At, the alarm time, and the
+# delivery latency is printed; it is only as good as the clock of this host (run an NTP client here too).
+#
+# usage:
+#   python3 tools/clip_server.py -p 8080 -d clips
+import argparse
+import datetime
+import os
+import sys
+from http.server import BaseHTTPRequestHandler, HTTPServer
+
+
+class ClipHandler(BaseHTTPRequestHandler):
+    directory = "."
+
+    def read_chunked(self):
+        body = bytearray()
+        while True:
+            size = int(self.rfile.readline().split(b";")[0].strip(), 16)
+            if size == 0:
+                self.rfile.readline()  # blank line after last-chunk
+                return bytes(body)
+            body += self.rfile.read(size)
+            self.rfile.readline()  # CRLF after chunk data
+
+    def do_POST(self):
+        if self.headers.get("Transfer-Encoding", "").lower() == "chunked":
+            body = self.read_chunked()
+        else:
+            body = self.rfile.read(int(self.headers.get("Content-Length", 0)))
+
+        received = datetime.datetime.now(datetime.timezone.utc)
+        stamp = received.astimezone().strftime("%Y%m%d-%H%M%S")
+        name = os.path.join(self.directory, "{}-{}.wav".format(self.client_address[0], stamp))
+        with open(name, "wb") as f:
+            f.write(body)
+        print("saved", name, len(body), "bytes", file=sys.stderr)
+
+        detected = self.headers.get("X-Detected-At")
+        if detected:
+            # e.g. 2026-10-19T12:34:56.789Z
+            at = datetime.datetime.strptime(detected, "%Y-%m-%dT%H:%M:%S.%fZ").replace(tzinfo=datetime.timezone.utc)
+            print("detected at", detected, "delivered after", int((received - at).total_seconds() * 1000), "ms",
+                  file=sys.stderr)
+
+        self.send_response(200)
+        self.send_header("Content-Length", "0")
+        self.end_headers()
+
+
+def main():
+    parser = argparse.ArgumentParser(description="alarm clip upload server")
+    parser.add_argument("-p", "--port", type=int, default=8080, help="TCP port (CLIP_UPLOAD_PORT)")
+    parser.add_argument("-d", "--directory", default=".", help="directory to save clips")
+    args = parser.parse_args()
+
+    os.makedirs(args.directory, exist_ok=True)
+    ClipHandler.directory = args.directory
+    server = HTTPServer(("0.0.0.0", args.port), ClipHandler)
+    print("listening on tcp port", args.port, file=sys.stderr)
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
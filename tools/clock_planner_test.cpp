@@ -0,0 +1,151 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Host test of the PIO clock planner in src/peripheral/ClockPlanner:
+ *  1. pio_divider() against the float divider it replaces (pioi2s::pio_div truncated the fraction)
+ *  2. plans for 8 and 16 kHz: PLL limits, integer PIO dividers, and the same clk_sys as an exhaustive search
+ *  3. rates without an exact clk_sys of at least HIGH_MIN_HZ (22.05/32/44.1/48 kHz): the high profile keeps
+ *     its speed with a fractional divider, error and jitter are reported
+ *
+ * build and run from the repository root:
+ *   g++ -O2 -std=c++17 -I. tools/clock_planner_test.cpp src/peripheral/ClockPlanner.cpp -o clock_planner_test
+ *   ./clock_planner_test
+ */
+#include <cmath>
+#include <cstdio>
+
+#include "src/peripheral/ClockPlanner.h"
+
+using namespace clockplan;
+
+#define PIO_CYCLES_PER_SAMPLE 256 // AUDIO_PIO_CYCLES_PER_SAMPLE
+#define HIGH_MIN_HZ 100000000u
+#define HIGH_MAX_HZ 133000000u
+#define LOW_MAX_HZ 24000000u
+
+static bool check(bool ok, const char *what)
+{
+    printf("%-64s %s\n", what, ok ? "ok" : "FAILED");
+    return ok;
+}
+
+// PLL settings are legal and every clock follows from them
+static bool valid(const plan_t &p)
+{
+    bool ok = (p.vco_hz == CLOCK_XOSC_HZ * p.fbdiv) && (p.vco_hz >= CLOCK_VCO_MIN_HZ) && (p.vco_hz <= CLOCK_VCO_MAX_HZ);
+    ok &= (p.postdiv1 >= 1) && (p.postdiv1 <= CLOCK_POSTDIV_MAX) && (p.postdiv2 >= 1) && (p.postdiv2 <= p.postdiv1);
+    uint32_t pll = p.vco_hz / (p.postdiv1 * p.postdiv2);
+    ok &= (p.vco_hz % (p.postdiv1 * p.postdiv2) == 0) && (pll <= CLOCK_SYS_MAX_HZ);
+    for (int i = 0; i < ProfileCount; i++)
+    {
+        ok &= (pll % p.sys_div[i] == 0) && (p.sys_hz[i] == pll / p.sys_div[i]);
+        double div = p.pio[i].div + p.pio[i].frac / 256.0;
+        ok &= (fabs((double)p.sys_hz[i] / div - p.pio_hz) / p.pio_hz < 1.0 / 256);
+    }
+    ok &= (p.sys_hz[ProfileHigh] <= HIGH_MAX_HZ) && (p.sys_hz[ProfileLow] <= LOW_MAX_HZ);
+    return ok;
+}
+
+// fastest clk_sys <= limit with an integer PIO divider, by brute force over every PLL setting
+static uint32_t fastest_exact(uint32_t pio_hz, uint32_t limit)
+{
+    uint32_t best = 0;
+    for (uint32_t fb = CLOCK_FBDIV_MIN; fb <= CLOCK_FBDIV_MAX; fb++)
+    {
+        uint64_t vco = (uint64_t)CLOCK_XOSC_HZ * fb;
+        if ((vco < CLOCK_VCO_MIN_HZ) || (vco > CLOCK_VCO_MAX_HZ))
+        {
+            continue;
+        }
+        for (uint32_t d = 1; d <= 49 * 64; d++)
+        {
+            if ((vco % d == 0) && (vco / d <= limit) && ((vco / d) % pio_hz == 0) && (vco / d > best))
+            {
+                // d = postdiv1 * postdiv2 * sys_div
+                for (uint32_t pd = 1; pd <= 49; pd++)
+                {
+                    uint32_t p1, p2;
+                    bool product = false;
+                    for (p1 = 1; p1 <= 7 && !product; p1++)
+                    {
+                        for (p2 = 1; p2 <= p1 && !product; p2++)
+                        {
+                            product = (p1 * p2 == pd);
+                        }
+                    }
+                    if (product && (d % pd == 0))
+                    {
+                        best = (uint32_t)(vco / d);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    return best;
+}
+
+int main()
+{
+    bool ok = true;
+
+    // 1. divider rounding: the float version truncated the fraction, the error is now at most half a step
+    double worst_float = 0, worst_int = 0;
+    for (uint32_t sys = 100000000; sys <= 133000000; sys += 1234567)
+    {
+        for (uint32_t pio = 2000000; pio <= 13000000; pio += 98765)
+        {
+            float ratio = (float)sys / pio, d;
+            float f = modff(ratio, &d);
+            double truncated = (double)sys / (d + (uint8_t)(f * 256.0f) / 256.0);
+            worst_float = fmax(worst_float, fabs(truncated - pio) / pio);
+
+            auto clock = pio_divider(sys, pio);
+            double average = (double)sys / (clock.div + clock.frac / 256.0);
+            worst_int = fmax(worst_int, fabs(average - pio) / pio);
+            ok &= (fabs(average - clock.hz) <= 1.0) && (fabs((average - pio) / pio * 1e9 - clock.ppb) <= 1.0);
+            ok &= ((clock.frac == 0) == (clock.jitter_ps == 0));
+        }
+    }
+    printf("worst divider error: float truncation %.0f ppm, rounded %.0f ppm\n", worst_float * 1e6, worst_int * 1e6);
+    ok &= check(worst_int <= worst_float / 1.9, "rounded divider halves the worst error");
+    ok &= check(pio_divider(102400000, 4096000).div == 25 && pio_divider(102400000, 4096000).frac == 0, "102.4 MHz / 4.096 MHz = 25, integer");
+
+    // 2. exact rates
+    static const uint32_t exact_rates[] = {8000, 16000};
+    for (auto fs : exact_rates)
+    {
+        plan_t p;
+        uint32_t pio_hz = fs * PIO_CYCLES_PER_SAMPLE;
+        bool found = plan(pio_hz, HIGH_MIN_HZ, HIGH_MAX_HZ, LOW_MAX_HZ, &p);
+        char what[96];
+        printf("%5u Hz: VCO %u MHz /%u/%u, high %.3f MHz (PIO /%u), low %.3f MHz (PIO /%u)\n", fs, p.vco_hz / 1000000, p.postdiv1, p.postdiv2,
+               p.sys_hz[ProfileHigh] / 1e6, p.pio[ProfileHigh].div, p.sys_hz[ProfileLow] / 1e6, p.pio[ProfileLow].div);
+        snprintf(what, sizeof(what), "%u Hz: valid PLL, integer PIO dividers", fs);
+        ok &= check(found && valid(p) && !p.pio[ProfileHigh].frac && !p.pio[ProfileLow].frac && !p.pio[ProfileHigh].jitter_ps, what);
+        snprintf(what, sizeof(what), "%u Hz: high profile is the fastest exact clk_sys", fs);
+        ok &= check(p.sys_hz[ProfileHigh] == fastest_exact(pio_hz, HIGH_MAX_HZ), what);
+    }
+
+    // 3. no exact clk_sys above HIGH_MIN_HZ: fractional divider at the fastest clock
+    static const uint32_t fractional_rates[] = {22050, 32000, 44100, 48000};
+    for (auto fs : fractional_rates)
+    {
+        plan_t p;
+        uint32_t pio_hz = fs * PIO_CYCLES_PER_SAMPLE;
+        bool found = plan(pio_hz, HIGH_MIN_HZ, HIGH_MAX_HZ, LOW_MAX_HZ, &p);
+        char what[96];
+        printf("%5u Hz: high %.3f MHz (PIO %u+%u/256, %d ppb, jitter %u ps), low %.3f MHz (%d ppb)\n", fs, p.sys_hz[ProfileHigh] / 1e6,
+               p.pio[ProfileHigh].div, p.pio[ProfileHigh].frac, p.pio[ProfileHigh].ppb, p.pio[ProfileHigh].jitter_ps,
+               p.sys_hz[ProfileLow] / 1e6, p.pio[ProfileLow].ppb);
+        snprintf(what, sizeof(what), "%u Hz: valid PLL, error below 100 ppm", fs);
+        ok &= check(found && valid(p) && abs(p.pio[ProfileHigh].ppb) < 100000 && abs(p.pio[ProfileLow].ppb) < 100000, what);
+        snprintf(what, sizeof(what), "%u Hz: no exact clock above %u MHz, high profile keeps it", fs, HIGH_MIN_HZ / 1000000);
+        ok &= check(fastest_exact(pio_hz, HIGH_MAX_HZ) < HIGH_MIN_HZ && p.sys_hz[ProfileHigh] >= HIGH_MIN_HZ, what);
+    }
+
+    plan_t p;
+    ok &= check(!plan(200000000, HIGH_MIN_HZ, HIGH_MAX_HZ, LOW_MAX_HZ, &p), "PIO clock above clk_sys rejected");
+
+    printf("%s\n", ok ? "passed" : "FAILED");
+    return ok ? 0 : 1;
+}
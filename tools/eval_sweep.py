@@ -0,0 +1,409 @@
+#!/usr/bin/env python3
+# Copyright 2026 teamprof.net@gmail.com
+#
+# Sweep alarm detection configurations over labeled recordings and report accuracy and compute together.
+# Every configuration runs the device chain on the recordings:
+#   front-end   FFT size, hop, MAG_MODE and REQUANT_MODE of src/ml (q15 arithmetic emulated with numpy)
+#   model       the .tflite model (default: the one built into src/ml/tflite_model.h), once per AUDIO_FRAME_LEN
+#   decision    SimpleKalmanFilter(KF_E_MEA, KF_E_EST, KF_Q) and THRESHOLD_INFERENCE as ThreadApp::handlerInference
+# and reports per configuration:
+#   frame precision / recall, ROC AUC of the filtered prediction (ROC points in the JSON report)
+#   event recall, detection latency (median, 90th percentile), false alarms per hour of non-alarm audio
+#   Cortex-M0+ cycles per second of audio (front-end + model, see COST) and the Pareto front over
+#   (cycles, false alarms, event recall)
+# Model outputs are cached per recording and front-end setting, so threshold and filter sweeps are cheap.
+#
+# Labels: "name.txt" next to "name.wav" in Audacity label format ("start<TAB>end[<TAB>text]" in seconds)
+# marks the alarm intervals; a recording without a label file contains no alarm.
+# Requires numpy and a TensorFlow Lite interpreter (ai-edge-litert, tflite-runtime or tensorflow).
+#
+# usage:
+#   python3 tools/eval_sweep.py dataset/*.wav
+#   python3 tools/eval_sweep.py --grid sweep.json --measured 2100,18000 --json report.json dataset/
+# sweep.json, every key optional, lists are combined:
+#   {"model": ["a.tflite", "b.tflite"], "fft": [256], "hop": [128, 64], "mag": ["exact", "power_lut"],
+#    "requant": ["linear", "table"], "threshold": [0.2, 0.3, 0.5], "kf_e_mea": [0.01, 0.05], "kf_q": [0.0005]}
+import argparse
+import hashlib
+import itertools
+import json
+import math
+import os
+import re
+import sys
+import wave
+
+import numpy as np
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import requant_calibrate  # noqa: E402
+
+SRC = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src")
+SAMPLING_RATE = 16000   # AUDIO_SAMPLING_RATE
+FRAME_LEN = 512         # AUDIO_FRAME_LEN, one inference per frame
+SCALE_FACTOR = 64       # PreProcessor.cpp
+AMPB_ALPHA = 31472      # Magnitude.cpp
+AMPB_BETA = 13036
+EVENT_TOLERANCE = 1.0   # s after a labeled alarm still counted as its detection (spectrogram length)
+
+# firmware settings (src/ml/PreProcessor.h, Magnitude.h, Requantizer.h, src/thread/ThreadApp.cpp)
+DEFAULT = {"model": None, "fft": 256, "hop": 128, "mag": "power_lut", "requant": "linear",
+           "threshold": 0.3, "kf_e_mea": 0.01, "kf_e_est": 0.01, "kf_q": 0.0005}
+DEFAULT_THRESHOLDS = [0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9]
+FRONTEND_KEYS = ("model", "fft", "hop", "mag", "requant")
+
+# Cortex-M0+ cycle estimates, replaced by --cost FILE or scaled to the device with --measured
+COST = {
+    "window_per_sample": 6,        # accel::window_q15
+    "fft_per_point_stage": 6,      # rfft256 / arm_rfft_q15, x N log2(N)
+    "mag_per_bin": {"exact": 90, "ampb": 14, "power_lut": 22},
+    "requant_per_bin": 9,
+    "shift_per_byte": 0.3,         # memmove of the spectrogram and the audio buffer
+    "model_per_mac": 5,            # CMSIS-NN int8 kernels without SIMD
+    "model_cycles": None,          # fixed model cost when the interpreter cannot list its operators
+}
+
+
+def load_interpreter():
+    for name in ("ai_edge_litert.interpreter", "tflite_runtime.interpreter", "tensorflow.lite"):
+        try:
+            module = __import__(name, fromlist=["Interpreter"])
+            return module.Interpreter
+        except ImportError:
+            continue
+    raise SystemExit("a TensorFlow Lite interpreter is required: pip install ai-edge-litert")
+
+
+def builtin_model():
+    with open(os.path.join(SRC, "ml", "tflite_model.h")) as f:
+        text = f.read()
+    body = text[text.index("{") + 1:text.index("}")]
+    return bytes(int(v, 16) for v in re.findall(r"0x([0-9a-fA-F]{2})", body))
+
+
+def requant_table():
+    with open(os.path.join(SRC, "ml", "requant_table.h")) as f:
+        text = f.read()
+    body = text[text.index("{") + 1:text.rindex("}")]
+    return np.array([int(v) for v in re.findall(r"-?\d+", body)], dtype=np.int32)
+
+
+class Model:
+    def __init__(self, path):
+        content = builtin_model() if path is None else open(path, "rb").read()
+        self.name = "tflite_model.h" if path is None else os.path.basename(path)
+        self.digest = hashlib.sha1(content).hexdigest()[:12]
+        self.interpreter = load_interpreter()(model_content=content)
+        self.interpreter.allocate_tensors()
+        self.input = self.interpreter.get_input_details()[0]
+        self.output = self.interpreter.get_output_details()[0]
+        self.width = int(self.input["shape"][1])   # columns (time)
+        self.height = int(self.input["shape"][2])  # FFT bins
+        self.scale, self.zero_point = self.input["quantization"]
+        self.macs = self.count_macs()
+
+    def count_macs(self):
+        try:
+            ops = self.interpreter._get_ops_details()
+            shapes = {t["index"]: list(t["shape"]) for t in self.interpreter.get_tensor_details()}
+        except AttributeError:
+            return None
+        macs = 0
+        for op in ops:
+            name = op["op_name"]
+            out = shapes[op["outputs"][0]]
+            if name == "CONV_2D":
+                kernel = shapes[op["inputs"][1]]
+                macs += int(np.prod(out)) * kernel[1] * kernel[2] * kernel[3]
+            elif name == "DEPTHWISE_CONV_2D":
+                kernel = shapes[op["inputs"][1]]
+                macs += int(np.prod(out)) * kernel[1] * kernel[2]
+            elif name == "FULLY_CONNECTED":
+                macs += int(np.prod(out)) * shapes[op["inputs"][1]][-1]
+        return macs
+
+    def predict(self, spectrogram):
+        self.interpreter.set_tensor(self.input["index"], spectrogram.reshape(self.input["shape"]))
+        self.interpreter.invoke()
+        y = int(self.interpreter.get_tensor(self.output["index"]).flatten()[0])
+        scale, zero_point = self.output["quantization"]
+        return (y - zero_point) * scale
+
+
+def read_wav(path):
+    with wave.open(path, "rb") as w:
+        if w.getnchannels() != 1 or w.getsampwidth() != 2:
+            raise ValueError("{}: 16-bit mono WAV required".format(path))
+        if w.getframerate() != SAMPLING_RATE:
+            print("{}: {} Hz, the model expects {} Hz".format(path, w.getframerate(), SAMPLING_RATE), file=sys.stderr)
+        samples = np.frombuffer(w.readframes(w.getnframes()), dtype="<i2").astype(np.int32)
+        return samples, w.getframerate()
+
+
+def read_labels(path):
+    name = os.path.splitext(path)[0] + ".txt"
+    intervals = []
+    if os.path.exists(name):
+        with open(name) as f:
+            for line in f:
+                fields = line.split()
+                if len(fields) >= 2 and not line.startswith("\\"):
+                    intervals.append((float(fields[0]), float(fields[1])))
+    return sorted(intervals)
+
+
+def spectrogram_columns(samples, fft, hop, mag, requant, model):
+    # column c covers samples [(c + 1) * hop - fft, (c + 1) * hop), as PreProcessor::update_spectrum
+    window = np.floor(0.5 * (1 - np.cos(2 * np.pi * np.arange(fft) / fft)) * 32768).clip(max=32767).astype(np.int64)
+    padded = np.concatenate([np.zeros(fft - hop, dtype=np.int64), samples.astype(np.int64)])
+    count = (len(padded) - fft) // hop + 1
+    frames = np.lib.stride_tricks.sliding_window_view(padded, fft)[::hop][:count]
+    windowed = (frames * window) >> 15                           # arm_mult_q15
+    spectrum = np.fft.rfft(windowed, axis=1) / fft               # arm_rfft_q15 scaling
+    re = np.trunc(spectrum.real).astype(np.int64)
+    im = np.trunc(spectrum.imag).astype(np.int64)
+    if mag == "ampb":
+        a, b = np.abs(re), np.abs(im)
+        mags = (AMPB_ALPHA * np.maximum(a, b) + AMPB_BETA * np.minimum(a, b)) >> 16
+    else:  # power_lut is within 0.6% of exact
+        mags = np.floor(np.sqrt(re * re + im * im) / 2).astype(np.int64)
+    mags = mags.clip(0, 32767)
+    if requant == "table":
+        # requant_calibrate.index() on arrays
+        bits = requant_calibrate.MANTISSA_BITS
+        shift = np.maximum(0, np.frexp(mags.astype(np.float64))[1] - 1 - bits)
+        return requant_table()[(shift << bits) + (mags >> shift)].astype(np.int8)
+    divider = max(1, int(SCALE_FACTOR * model.scale))
+    return (mags // divider + int(model.zero_point)).clip(-128, 127).astype(np.int8)
+
+
+def predictions(path, setting, model, cache):
+    fft, hop = setting["fft"], setting["hop"]
+    key = "{}-{}-{}-{}-{}-{}".format(os.path.basename(path), model.digest, fft, hop, setting["mag"], setting["requant"])
+    name = os.path.join(cache, key + ".json") if cache else None
+    if name and os.path.exists(name) and os.path.getmtime(name) >= os.path.getmtime(path):
+        with open(name) as f:
+            return json.load(f)
+
+    samples, rate = read_wav(path)
+    columns = spectrogram_columns(samples, fft, hop, setting["mag"], setting["requant"], model)
+    per_frame = FRAME_LEN // hop
+    spectrogram = np.full((model.width, model.height), int(model.zero_point), dtype=np.int8)
+    result = {"rate": rate, "duration": len(samples) / rate, "times": [], "values": []}
+    for f in range(len(samples) // FRAME_LEN):
+        new = columns[f * per_frame:(f + 1) * per_frame]
+        spectrogram = np.concatenate([spectrogram[len(new):], new])
+        result["times"].append((f + 1) * FRAME_LEN / rate)
+        result["values"].append(model.predict(spectrogram))
+    if name:
+        with open(name, "w") as f:
+            json.dump(result, f)
+    return result
+
+
+def kalman(values, e_mea, e_est, q):
+    # SimpleKalmanFilter::updateEstimate
+    last, estimates = 0.0, []
+    for v in values:
+        gain = e_est / (e_est + e_mea)
+        current = last + gain * (v - last)
+        e_est = (1.0 - gain) * e_est + abs(last - current) * q
+        last = current
+        estimates.append(current)
+    return estimates
+
+
+def inside(t, intervals, tolerance=0.0):
+    return any(start <= t <= end + tolerance for start, end in intervals)
+
+
+def evaluate(records, threshold):
+    # records: [(times, estimates, intervals, duration)]
+    tp = fp = fn = 0
+    events = detected = false_alarms = 0
+    latencies = []
+    negative_s = 0.0
+    for times, estimates, intervals, duration in records:
+        negative_s += duration - sum(min(end, duration) - start for start, end in intervals)
+        state = False
+        onsets = []
+        for t, e in zip(times, estimates):
+            alarm = e >= threshold
+            label = inside(t, intervals)
+            tp += alarm and label
+            fp += alarm and not label
+            fn += label and not alarm
+            if alarm and not state:
+                onsets.append(t)
+                false_alarms += not inside(t, intervals, EVENT_TOLERANCE)
+            state = alarm
+        for start, end in intervals:
+            events += 1
+            # an alarm already on at the start of the interval detects it with zero latency
+            on = [t for t, e in zip(times, estimates) if start <= t <= end + EVENT_TOLERANCE and e >= threshold]
+            if on:
+                detected += 1
+                latencies.append(max(0.0, on[0] - start))
+    latencies.sort()
+    return {
+        "precision": tp / (tp + fp) if tp + fp else None,
+        "recall": tp / (tp + fn) if tp + fn else None,
+        "event_recall": detected / events if events else None,
+        "latency_median_s": latencies[len(latencies) // 2] if latencies else None,
+        "latency_p90_s": latencies[min(len(latencies) - 1, int(0.9 * len(latencies)))] if latencies else None,
+        "false_alarms_per_hour": false_alarms * 3600.0 / negative_s if negative_s > 0 else None,
+    }
+
+
+def roc(records):
+    labels, scores = [], []
+    for times, estimates, intervals, _ in records:
+        labels += [inside(t, intervals) for t in times]
+        scores += estimates
+    labels, scores = np.array(labels), np.array(scores)
+    positives, negatives = labels.sum(), (~labels).sum()
+    if not positives or not negatives:
+        return [], None
+    points = [(float(((scores >= t) & ~labels).sum() / negatives), float(((scores >= t) & labels).sum() / positives))
+              for t in np.linspace(1.0, 0.0, 101)]
+    points = [(0.0, 0.0)] + points + [(1.0, 1.0)]
+    auc = sum((x1 - x0) * (y0 + y1) / 2 for (x0, y0), (x1, y1) in zip(points, points[1:]))
+    return points, auc
+
+
+def cycles_per_second(setting, model, cost, rate):
+    fft, hop = setting["fft"], setting["hop"]
+    bins = fft // 2 + 1
+    column = (cost["window_per_sample"] * fft + cost["fft_per_point_stage"] * fft * math.log2(fft) +
+              (cost["mag_per_bin"][setting["mag"]] + cost["requant_per_bin"]) * bins)
+    frame = (FRAME_LEN // hop) * column + cost["shift_per_byte"] * (model.width * model.height + 2 * (FRAME_LEN + hop))
+    if model.macs is not None:
+        frame += cost["model_per_mac"] * model.macs
+    elif cost["model_cycles"]:
+        frame += cost["model_cycles"]
+    return frame * rate / FRAME_LEN
+
+
+def calibrate(cost, measured, clk_hz, model):
+    # scale the estimates so that the firmware configuration costs what the device measured
+    # (aiot_stage_latency_microseconds_sum / _count, preprocess and inference)
+    preprocess_us, inference_us = measured
+    setting = dict(DEFAULT)
+    model_cost = dict(cost, model_per_mac=0, model_cycles=0)
+    frontend = cycles_per_second(setting, model, model_cost, FRAME_LEN)  # at rate FRAME_LEN: cycles per frame
+    factor = preprocess_us * clk_hz / 1e6 / frontend
+    scaled = dict(cost, mag_per_bin={k: v * factor for k, v in cost["mag_per_bin"].items()})
+    for k in ("window_per_sample", "fft_per_point_stage", "requant_per_bin", "shift_per_byte"):
+        scaled[k] = cost[k] * factor
+    if model.macs:
+        scaled["model_per_mac"] = inference_us * clk_hz / 1e6 / model.macs
+    else:
+        scaled["model_cycles"] = inference_us * clk_hz / 1e6
+    return scaled
+
+
+def expand(grid):
+    keys = list(DEFAULT)
+    values = [grid.get(k, DEFAULT_THRESHOLDS if k == "threshold" else [DEFAULT[k]]) for k in keys]
+    values = [v if isinstance(v, list) else [v] for v in values]
+    return [dict(zip(keys, combination)) for combination in itertools.product(*values)]
+
+
+def pareto(rows):
+    # minimize cycles and false alarms, maximize event recall
+    def key(r):
+        return (r["cycles_per_second"], r["false_alarms_per_hour"] or 0.0, -(r["event_recall"] or 0.0))
+
+    for r in rows:
+        k = key(r)
+        r["pareto"] = not any(key(o) != k and all(a <= b for a, b in zip(key(o), k)) for o in rows)
+
+
+def fmt(value, spec):
+    return "-" if value is None else spec.format(value)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="accuracy versus compute sweep of the alarm detector")
+    parser.add_argument("inputs", nargs="+", help="16-bit mono WAV files or directories, labels in name.txt")
+    parser.add_argument("--grid", help="JSON file with the values to sweep (see the header of this file)")
+    parser.add_argument("--cost", help="JSON file overriding the cycle estimates of COST")
+    parser.add_argument("--measured", help="preprocess,inference latency in us of the firmware configuration")
+    parser.add_argument("--clk-hz", type=float, default=102.4e6, help="clk_sys of the --measured latencies")
+    parser.add_argument("--cache", default=".eval_cache", help="directory of cached model outputs ('' disables)")
+    parser.add_argument("--json", help="write the full report (including ROC points)")
+    args = parser.parse_args()
+
+    wavs = []
+    for item in args.inputs:
+        if os.path.isdir(item):
+            wavs += sorted(os.path.join(item, n) for n in os.listdir(item) if n.lower().endswith(".wav"))
+        else:
+            wavs.append(item)
+    if not wavs:
+        print("no recordings", file=sys.stderr)
+        return 1
+    if args.cache:
+        os.makedirs(args.cache, exist_ok=True)
+
+    grid = {}
+    if args.grid:
+        with open(args.grid) as f:
+            grid = json.load(f)
+    cost = dict(COST)
+    if args.cost:
+        with open(args.cost) as f:
+            cost.update(json.load(f))
+
+    labels = {path: read_labels(path) for path in wavs}
+    print("{} recordings, {} labeled alarms".format(len(wavs), sum(len(v) for v in labels.values())), file=sys.stderr)
+
+    models, rows = {}, []
+    if args.measured:
+        models[None] = Model(None)
+        cost = calibrate(cost, [float(v) for v in args.measured.split(",")], args.clk_hz, models[None])
+    settings = expand(grid)
+    for frontend, group in itertools.groupby(settings, key=lambda s: tuple(s[k] for k in FRONTEND_KEYS)):
+        group = list(group)
+        setting = group[0]
+        if setting["model"] not in models:
+            models[setting["model"]] = Model(setting["model"])
+        model = models[setting["model"]]
+        if setting["fft"] // 2 + 1 != model.height or FRAME_LEN % setting["hop"] or setting["fft"] < setting["hop"]:
+            print("skipped fft {} hop {}: model {} takes {} bins, hop must divide {}".format(
+                setting["fft"], setting["hop"], model.name, model.height, FRAME_LEN), file=sys.stderr)
+            continue
+        outputs = {path: predictions(path, setting, model, args.cache) for path in wavs}
+        rate = next(iter(outputs.values()))["rate"]
+        cycles = cycles_per_second(setting, model, cost, rate)
+        filtered = {}
+        for s in group:
+            kf = (s["kf_e_mea"], s["kf_e_est"], s["kf_q"])
+            if kf not in filtered:
+                records = [(o["times"], kalman(o["values"], *kf), labels[p], o["duration"]) for p, o in outputs.items()]
+                filtered[kf] = (records, roc(records))
+            records, (points, auc) = filtered[kf]
+            row = dict(s, model=model.name, cycles_per_second=cycles, roc_auc=auc, roc=points)
+            row.update(evaluate(records, s["threshold"]))
+            rows.append(row)
+
+    pareto(rows)
+    print("{:<16} {:>4} {:>4} {:>9} {:>6} {:>18} {:>5} {:>6} {:>6} {:>6} {:>6} {:>7} {:>8} {:>6} {:>8}".format(
+        "model", "fft", "hop", "mag", "req", "kf", "thr", "prec", "recall", "AUC", "event", "lat50", "FA/h", "Mcyc/s", "pareto"))
+    for r in rows:
+        print("{:<16} {:>4} {:>4} {:>9} {:>6} {:>18} {:>5.2f} {:>6} {:>6} {:>6} {:>6} {:>7} {:>8} {:>6.1f} {:>8}".format(
+            r["model"][:16], r["fft"], r["hop"], r["mag"], r["requant"],
+            "{:g}/{:g}/{:g}".format(r["kf_e_mea"], r["kf_e_est"], r["kf_q"]), r["threshold"],
+            fmt(r["precision"], "{:.3f}"), fmt(r["recall"], "{:.3f}"), fmt(r["roc_auc"], "{:.3f}"),
+            fmt(r["event_recall"], "{:.3f}"), fmt(r["latency_median_s"], "{:.2f}s"),
+            fmt(r["false_alarms_per_hour"], "{:.2f}"), r["cycles_per_second"] / 1e6, "*" if r["pareto"] else ""))
+
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump({"recordings": wavs, "cost": cost, "configurations": rows}, f, indent=1)
+        print("written", args.json, file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
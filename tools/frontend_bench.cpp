@@ -0,0 +1,397 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Host microbenchmark of every audio front-end kernel, each stage in isolation on the frames of a recording:
+ *   isr_convert_*     Agc::convert() as called by ThreadAudio::dma_i2s_in_handler (packed int16 and 32-bit I2S words)
+ *   shift_q15         arm_shift_q15() (CMSIS scalar code, AUDIO_INPUT_SHIFT) in PreProcessor::update_spectrum
+ *   window_*          accel::window_q15() and the arm_mult_q15() loop it replaced
+ *   rfft256           rfft256::transform(), in place of arm_rfft_q15()
+ *   magnitude_*       the three MAG_MODE estimators; magnitude_exact has the arm_cmplx_mag_q15() semantics
+ *   requantize        Requantizer::quantize()
+ *   shift_spectrogram PreProcessor::shift_spectrogram()
+ *   update_spectrum   the whole PreProcessor chain for one frame, as built (MAG_MODE, REQUANT_MODE)
+ *
+ * Per stage: ns per call and per frame (AUDIO_FRAME_LEN samples, one ThreadAudio::processFrame), bytes read and
+ * written per call, and host instructions per call from the Linux perf counters where the kernel allows them
+ * (null otherwise). Host numbers rank changes; the Cortex-M0+ cost is aiot_stage_latency_microseconds on /metrics.
+ * The JSON report is compared between two builds by tools/bench_compare.py.
+ *
+ * build and run from the repository root:
+ *   g++ -O2 -std=c++17 -I. tools/frontend_bench.cpp src/audio/Agc.cpp src/audio/accel.cpp src/ml/Rfft256.cpp \
+ *       src/ml/Magnitude.cpp src/ml/Requantizer.cpp -o frontend_bench
+ *   ./frontend_bench sound/alarm-sound.wav --json before.json
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#if defined __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "src/audio/audio_const.h"
+#include "src/audio/Agc.h"
+#include "src/audio/accel.h"
+#include "src/ml/Magnitude.h"
+#include "src/ml/Requantizer.h"
+#include "src/ml/Rfft256.h"
+
+#define SPECTROGRAM_WIDTH 124  // kSpectrogramWidth in src/ml/audio_model.h
+#define SPECTROGRAM_HEIGHT 129 // kSpectrogramHeight
+#define FFT_BINS (AUDIO_FFT_LEN / 2 + 1)
+#define REPEAT 5 // runs per stage, the median is reported
+
+static bool read_wav(const char *path, std::vector<int16_t> &samples)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f)
+    {
+        return false;
+    }
+    char id[4];
+    uint32_t size;
+    uint16_t channels = 0, bits = 0;
+    fseek(f, 12, SEEK_SET);
+    while (fread(id, 1, 4, f) == 4 && fread(&size, 4, 1, f) == 1)
+    {
+        long next = ftell(f) + size + (size & 1);
+        if (!memcmp(id, "fmt ", 4))
+        {
+            fseek(f, 2, SEEK_CUR);
+            fread(&channels, 2, 1, f);
+            fseek(f, 10, SEEK_CUR);
+            fread(&bits, 2, 1, f);
+        }
+        else if (!memcmp(id, "data", 4))
+        {
+            samples.resize(size / sizeof(int16_t));
+            fread(samples.data(), sizeof(int16_t), samples.size(), f);
+        }
+        fseek(f, next, SEEK_SET);
+    }
+    fclose(f);
+    return (channels == 1) && (bits == 16) && !samples.empty();
+}
+
+// CMSIS-DSP arm_shift_q15() scalar path (Cortex-M0+ has no SIMD)
+static void arm_shift_q15_ref(const int16_t *src, int8_t shift, int16_t *dst, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        int32_t v = (shift >= 0) ? ((int32_t)src[i] << shift) : (src[i] >> -shift);
+        dst[i] = (int16_t)((v > 32767) ? 32767 : ((v < -32768) ? -32768 : v));
+    }
+}
+
+// CMSIS-DSP arm_mult_q15() scalar path
+static void arm_mult_q15_ref(const int16_t *a, const int16_t *b, int16_t *dst, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        int32_t v = ((int32_t)a[i] * b[i]) >> 15;
+        dst[i] = (int16_t)((v > 32767) ? 32767 : v);
+    }
+}
+
+// host instruction counter, -1 when perf events are not available
+class InstructionCounter
+{
+public:
+    InstructionCounter()
+    {
+#if defined __linux__
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        _fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+    }
+    ~InstructionCounter()
+    {
+#if defined __linux__
+        if (_fd >= 0)
+        {
+            close(_fd);
+        }
+#endif
+    }
+    bool available(void) const
+    {
+        return _fd >= 0;
+    }
+    void start(void)
+    {
+#if defined __linux__
+        if (_fd >= 0)
+        {
+            ioctl(_fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(_fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+    long long stop(void)
+    {
+        long long count = -1;
+#if defined __linux__
+        if ((_fd >= 0) && !ioctl(_fd, PERF_EVENT_IOC_DISABLE, 0) && (read(_fd, &count, sizeof(count)) != sizeof(count)))
+        {
+            count = -1;
+        }
+#endif
+        return count;
+    }
+
+private:
+    int _fd = -1;
+};
+
+typedef struct
+{
+    std::string name;
+    int calls_per_frame;
+    size_t bytes_per_call; // read + written, excluding tables and stack
+    double ns_per_call;
+    double instructions_per_call; // < 0: not available
+} Result;
+
+// runs body(frame) over every frame REPEAT times, reports the median
+static Result measure(const char *name, int calls_per_frame, size_t bytes, size_t frames, InstructionCounter &counter,
+                      const std::function<void(size_t)> &body)
+{
+    std::vector<double> ns;
+    std::vector<double> instructions;
+    for (int r = 0; r < REPEAT; r++)
+    {
+        counter.start();
+        auto t0 = std::chrono::steady_clock::now();
+        for (size_t f = 0; f < frames; f++)
+        {
+            body(f);
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        long long count = counter.stop();
+        ns.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count() / frames / calls_per_frame);
+        instructions.push_back((count < 0) ? -1.0 : (double)count / frames / calls_per_frame);
+    }
+    std::sort(ns.begin(), ns.end());
+    std::sort(instructions.begin(), instructions.end());
+    return Result{name, calls_per_frame, bytes, ns[REPEAT / 2], instructions[REPEAT / 2]};
+}
+
+int main(int argc, char **argv)
+{
+    const char *path = "sound/alarm-sound.wav";
+    const char *json = nullptr;
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--json") && (i + 1 < argc))
+        {
+            json = argv[++i];
+        }
+        else
+        {
+            path = argv[i];
+        }
+    }
+
+    std::vector<int16_t> pcm;
+    if (!read_wav(path, pcm))
+    {
+        fprintf(stderr, "cannot read 16-bit mono PCM WAV file: %s\n", path);
+        return 1;
+    }
+    size_t frames = (pcm.size() > AUDIO_FFT_LEN) ? (pcm.size() - AUDIO_FFT_LEN) / AUDIO_FRAME_LEN : 0; // last window inside
+    if (frames == 0)
+    {
+        fprintf(stderr, "%s: shorter than one frame\n", path);
+        return 1;
+    }
+
+    // DMA buffers as captured: the microphone level is the recording / AGC_GAIN_INIT, the AGC brings it back
+    std::vector<int16_t> packed(frames * AUDIO_FRAME_LEN);
+    std::vector<int32_t> words(frames * AUDIO_FRAME_LEN);
+    for (size_t i = 0; i < packed.size(); i++)
+    {
+        int32_t mic = pcm[i] * AGC_GAIN_UNITY / AGC_GAIN_INIT;
+        packed[i] = (int16_t)mic;
+        words[i] = (int32_t)((uint32_t)mic << 16) | (int32_t)((i * 2654435761u) & 0xFF00); // 24-bit word, noisy low bits
+    }
+
+    // Hanning window as PreProcessor::init
+    int16_t window[AUDIO_FFT_LEN];
+    for (int i = 0; i < AUDIO_FFT_LEN; i++)
+    {
+        double w = 0.5 * (1.0 - cos(2.0 * M_PI * i / AUDIO_FFT_LEN));
+        window[i] = (int16_t)std::min(32767.0, w * 32768.0);
+    }
+
+    // per-frame intermediate data of the real chain, so every stage sees realistic input
+    std::vector<int16_t> windowed(frames * SPECTROGRAM_SHIFT * AUDIO_FFT_LEN);
+    std::vector<int16_t> spectrum(frames * SPECTROGRAM_SHIFT * 2 * AUDIO_FFT_LEN);
+    std::vector<int16_t> mags(frames * SPECTROGRAM_SHIFT * FFT_BINS);
+    rfft256::begin();
+    magnitude::begin();
+    Requantizer requantizer;
+    requantizer.init_linear(64 * 0.0625, 0); // SCALE_FACTOR * a typical input_scale: divider 4
+    for (size_t f = 0; f < frames; f++)
+    {
+        for (int s = 0; s < SPECTROGRAM_SHIFT; s++)
+        {
+            size_t k = f * SPECTROGRAM_SHIFT + s;
+            const int16_t *src = &pcm[f * AUDIO_FRAME_LEN + s * AUDIO_FRAME_STEP];
+            size_t n = std::min<size_t>(AUDIO_FFT_LEN, pcm.size() - (src - pcm.data()));
+            int16_t frame[AUDIO_FFT_LEN] = {0};
+            memcpy(frame, src, n * sizeof(int16_t));
+            accel::window_q15(window, frame, &windowed[k * AUDIO_FFT_LEN], AUDIO_FFT_LEN);
+            rfft256::transform(&windowed[k * AUDIO_FFT_LEN], &spectrum[k * 2 * AUDIO_FFT_LEN]);
+            magnitude::compute(&spectrum[k * 2 * AUDIO_FFT_LEN], &mags[k * FFT_BINS], FFT_BINS);
+        }
+    }
+
+    static int16_t out16[AUDIO_FRAME_LEN + AUDIO_FRAME_STEP];
+    static int16_t fft[2 * AUDIO_FFT_LEN];
+    static int8_t spectrogram[SPECTROGRAM_WIDTH * SPECTROGRAM_HEIGHT];
+    volatile uint32_t sink = 0;
+    accel::begin();
+
+    InstructionCounter counter;
+    std::vector<Result> results;
+    const int S = SPECTROGRAM_SHIFT;
+
+    results.push_back(measure("isr_convert_packed16", 1, AUDIO_FRAME_LEN * 4, frames, counter, [&](size_t f)
+                              { sink += Agc::convert(&packed[f * AUDIO_FRAME_LEN], out16, AUDIO_FRAME_LEN, AGC_GAIN_INIT); }));
+    results.push_back(measure("isr_convert_i2s32", 1, AUDIO_FRAME_LEN * 6, frames, counter, [&](size_t f)
+                              { sink += Agc::convert(&words[f * AUDIO_FRAME_LEN], out16, AUDIO_FRAME_LEN, 1, AGC_GAIN_INIT); }));
+    results.push_back(measure("shift_q15", 1, AUDIO_FRAME_LEN * 4, frames, counter, [&](size_t f)
+                              { arm_shift_q15_ref(&pcm[f * AUDIO_FRAME_LEN], AUDIO_INPUT_SHIFT, &out16[AUDIO_FRAME_STEP], AUDIO_FRAME_LEN); }));
+    results.push_back(measure("window_q15", S, AUDIO_FFT_LEN * 6, frames, counter, [&](size_t f)
+                              {
+                                  for (int s = 0; s < S; s++)
+                                  {
+                                      accel::window_q15(window, &pcm[f * AUDIO_FRAME_LEN + s * AUDIO_FRAME_STEP], out16, AUDIO_FFT_LEN);
+                                  } }));
+    results.push_back(measure("window_arm_mult_q15", S, AUDIO_FFT_LEN * 6, frames, counter, [&](size_t f)
+                              {
+                                  for (int s = 0; s < S; s++)
+                                  {
+                                      arm_mult_q15_ref(window, &pcm[f * AUDIO_FRAME_LEN + s * AUDIO_FRAME_STEP], out16, AUDIO_FFT_LEN);
+                                  } }));
+    results.push_back(measure("rfft256", S, AUDIO_FFT_LEN * 2 + FFT_BINS * 4, frames, counter, [&](size_t f)
+                              {
+                                  for (int s = 0; s < S; s++)
+                                  {
+                                      rfft256::transform(&windowed[(f * S + s) * AUDIO_FFT_LEN], fft);
+                                  } }));
+    results.push_back(measure("magnitude_exact", S, FFT_BINS * 6, frames, counter, [&](size_t f)
+                              {
+                                  for (int s = 0; s < S; s++)
+                                  {
+                                      magnitude::exact(&spectrum[(f * S + s) * 2 * AUDIO_FFT_LEN], out16, FFT_BINS);
+                                  } }));
+    results.push_back(measure("magnitude_ampb", S, FFT_BINS * 6, frames, counter, [&](size_t f)
+                              {
+                                  for (int s = 0; s < S; s++)
+                                  {
+                                      magnitude::ampb(&spectrum[(f * S + s) * 2 * AUDIO_FFT_LEN], out16, FFT_BINS);
+                                  } }));
+    results.push_back(measure("magnitude_power_lut", S, FFT_BINS * 6, frames, counter, [&](size_t f)
+                              {
+                                  for (int s = 0; s < S; s++)
+                                  {
+                                      magnitude::power_lut(&spectrum[(f * S + s) * 2 * AUDIO_FFT_LEN], out16, FFT_BINS);
+                                  } }));
+    results.push_back(measure("requantize", S, FFT_BINS * 3, frames, counter, [&](size_t f)
+                              {
+                                  for (int s = 0; s < S; s++)
+                                  {
+                                      requantizer.quantize(&mags[(f * S + s) * FFT_BINS], spectrogram, FFT_BINS);
+                                  } }));
+    results.push_back(measure("shift_spectrogram", 1, 2 * SPECTROGRAM_HEIGHT * (SPECTROGRAM_WIDTH - S), frames, counter, [&](size_t f)
+                              {
+                                  memmove(spectrogram, spectrogram + SPECTROGRAM_HEIGHT * S, SPECTROGRAM_HEIGHT * (SPECTROGRAM_WIDTH - S));
+                                  sink += spectrogram[f % sizeof(spectrogram)]; }));
+
+    size_t chain_bytes = 0;
+    for (auto &r : results)
+    {
+        if ((r.name == "shift_q15") || (r.name == "window_q15") || (r.name == "rfft256") || (r.name == "requantize") ||
+            (r.name == "shift_spectrogram") || (r.name == "magnitude_power_lut"))
+        {
+            chain_bytes += r.bytes_per_call * r.calls_per_frame;
+        }
+    }
+    static int16_t audio_buf[AUDIO_FRAME_LEN + AUDIO_FRAME_STEP];
+    results.push_back(measure("update_spectrum", 1, chain_bytes, frames, counter, [&](size_t f)
+                              {
+                                  int16_t windowed_input[AUDIO_FFT_LEN];
+                                  int16_t mag[FFT_BINS];
+                                  memmove(audio_buf, &audio_buf[AUDIO_FRAME_LEN], AUDIO_FRAME_STEP);
+                                  arm_shift_q15_ref(&pcm[f * AUDIO_FRAME_LEN], AUDIO_INPUT_SHIFT, &audio_buf[AUDIO_FRAME_STEP], AUDIO_FRAME_LEN);
+                                  memmove(spectrogram, spectrogram + SPECTROGRAM_HEIGHT * S, SPECTROGRAM_HEIGHT * (SPECTROGRAM_WIDTH - S));
+                                  for (int s = 0; s < S; s++)
+                                  {
+                                      accel::window_q15(window, &audio_buf[s * AUDIO_FRAME_STEP], windowed_input, AUDIO_FFT_LEN);
+                                      rfft256::transform(windowed_input, fft);
+                                      magnitude::compute(fft, mag, FFT_BINS);
+                                      requantizer.quantize(mag, spectrogram + SPECTROGRAM_HEIGHT * (SPECTROGRAM_WIDTH - S + s), FFT_BINS);
+                                  } }));
+
+    printf("%s: %zu frames of %d samples, instructions: %s\n\n", path, frames, AUDIO_FRAME_LEN,
+           counter.available() ? "host perf counter" : "not available");
+    printf("%-22s %6s %12s %12s %10s %14s\n", "stage", "calls", "ns/call", "ns/frame", "bytes/call", "instr/call");
+    for (auto &r : results)
+    {
+        char instructions[32] = "-";
+        if (r.instructions_per_call >= 0)
+        {
+            snprintf(instructions, sizeof(instructions), "%.0f", r.instructions_per_call);
+        }
+        printf("%-22s %6d %12.1f %12.1f %10zu %14s\n", r.name.c_str(), r.calls_per_frame, r.ns_per_call,
+               r.ns_per_call * r.calls_per_frame, r.bytes_per_call, instructions);
+    }
+
+    if (json)
+    {
+        FILE *f = fopen(json, "w");
+        if (!f)
+        {
+            fprintf(stderr, "cannot write %s\n", json);
+            return 1;
+        }
+        fprintf(f, "{\n  \"tool\": \"frontend_bench\",\n  \"input\": \"%s\",\n  \"frames\": %zu,\n  \"frame_samples\": %d,\n",
+                path, frames, AUDIO_FRAME_LEN);
+        fprintf(f, "  \"compiler\": \"%s\",\n  \"mag_mode\": %d,\n  \"requant_mode\": %d,\n  \"stages\": [\n",
+                __VERSION__, MAG_MODE, REQUANT_MODE);
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            auto &r = results[i];
+            fprintf(f, "    {\"name\": \"%s\", \"calls_per_frame\": %d, \"ns_per_call\": %.1f, \"ns_per_frame\": %.1f, \"bytes_per_call\": %zu, ",
+                    r.name.c_str(), r.calls_per_frame, r.ns_per_call, r.ns_per_call * r.calls_per_frame, r.bytes_per_call);
+            if (r.instructions_per_call >= 0)
+            {
+                fprintf(f, "\"instructions_per_call\": %.0f}", r.instructions_per_call);
+            }
+            else
+            {
+                fprintf(f, "\"instructions_per_call\": null}");
+            }
+            fprintf(f, "%s\n", (i + 1 < results.size()) ? "," : "");
+        }
+        fprintf(f, "  ]\n}\n");
+        fclose(f);
+        printf("\nwritten %s\n", json);
+    }
+    return (sink == 0xFFFFFFFF) ? 2 : 0; // keep the results alive
+}
@@ -0,0 +1,26 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Host stand-in for ArduProf: the logging macros only, printed to stderr when HOST_LOG is defined.
+ */
+#pragma once
+#include <iostream>
+
+#ifdef HOST_LOG
+inline void host_log(void)
+{
+    std::cerr << std::endl;
+}
+template <typename T, typename... Args>
+inline void host_log(T value, Args... args)
+{
+    std::cerr << value;
+    host_log(args...);
+}
+#define LOG_TRACE(...) host_log(__VA_ARGS__)
+#else
+template <typename... Args>
+inline void host_log(Args...) {}
+#define LOG_TRACE(...) host_log(__VA_ARGS__)
+#endif
+#define LOG_DEBUG(...) LOG_TRACE(__VA_ARGS__)
+#define LOG_ERROR(...) LOG_TRACE(__VA_ARGS__)
@@ -0,0 +1,184 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Minimal Arduino core for host builds (tools/host): Print, Stream, String, IPAddress and the time functions
+ * used by the networking code in src/util.
+ */
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include <thread>
+
+typedef uint8_t byte;
+
+#define DEC 10
+#define HEX 16
+
+inline uint32_t micros(void)
+{
+    static const auto start = std::chrono::steady_clock::now();
+    return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+inline uint32_t millis(void)
+{
+    return micros() / 1000;
+}
+inline void delay(uint32_t ms)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+inline long random(long howsmall, long howbig)
+{
+    return (howsmall < howbig) ? howsmall + rand() % (howbig - howsmall) : howsmall;
+}
+
+class String
+{
+public:
+    String(const char *s = "") : _s(s) {}
+    String(const std::string &s) : _s(s) {}
+    const char *c_str(void) const
+    {
+        return _s.c_str();
+    }
+    unsigned int length(void) const
+    {
+        return _s.length();
+    }
+    String &operator+=(const String &other)
+    {
+        _s += other._s;
+        return *this;
+    }
+    String &operator+=(char c)
+    {
+        _s += c;
+        return *this;
+    }
+
+private:
+    std::string _s;
+};
+
+class Print
+{
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buf, size_t size)
+    {
+        size_t n = 0;
+        while (size-- && write(*buf++))
+        {
+            n++;
+        }
+        return n;
+    }
+    size_t write(const char *s)
+    {
+        return write((const uint8_t *)s, strlen(s));
+    }
+
+    size_t print(const char *s)
+    {
+        return write(s);
+    }
+    size_t print(const String &s)
+    {
+        return write(s.c_str());
+    }
+    size_t print(char c)
+    {
+        return write((uint8_t)c);
+    }
+    size_t print(unsigned long value, int base = DEC)
+    {
+        char buf[24];
+        snprintf(buf, sizeof(buf), (base == HEX) ? "%lX" : "%lu", value);
+        return write(buf);
+    }
+    size_t print(long value, int base = DEC)
+    {
+        return (base == DEC) ? print_signed(value) : print((unsigned long)value, base);
+    }
+    size_t print(unsigned int value, int base = DEC)
+    {
+        return print((unsigned long)value, base);
+    }
+    size_t print(int value, int base = DEC)
+    {
+        return print((long)value, base);
+    }
+
+    size_t println(void)
+    {
+        return write("\r\n");
+    }
+    template <typename T>
+    size_t println(T value)
+    {
+        size_t n = print(value);
+        return n + println();
+    }
+    template <typename T>
+    size_t println(T value, int base)
+    {
+        size_t n = print(value, base);
+        return n + println();
+    }
+
+private:
+    size_t print_signed(long value)
+    {
+        char buf[24];
+        snprintf(buf, sizeof(buf), "%ld", value);
+        return write(buf);
+    }
+};
+
+class Stream : public Print
+{
+public:
+    virtual int available(void) = 0;
+    virtual int read(void) = 0;
+    virtual int peek(void) = 0;
+};
+
+class IPAddress
+{
+public:
+    IPAddress() : _address(0) {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : _address(a | (b << 8) | (c << 16) | ((uint32_t)d << 24)) {}
+    IPAddress(uint32_t address) : _address(address) {} // network order, as in the W5100S registers
+    IPAddress(const uint8_t *bytes)
+    {
+        memcpy(&_address, bytes, 4);
+    }
+
+    operator uint32_t() const
+    {
+        return _address;
+    }
+    bool operator==(const IPAddress &other) const
+    {
+        return _address == other._address;
+    }
+    bool operator!=(const IPAddress &other) const
+    {
+        return _address != other._address;
+    }
+    uint8_t operator[](int index) const
+    {
+        return (_address >> (8 * index)) & 0xFF;
+    }
+    const uint8_t *raw(void) const
+    {
+        return (const uint8_t *)&_address;
+    }
+
+private:
+    uint32_t _address;
+};
@@ -0,0 +1,1122 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Host version of the EventEthernet library, see EventEthernet.h
+ */
+#include "EventEthernet.h"
+
+EthernetClass Ethernet;
+W5100Class W5100;
+
+#define LOCAL_PORT_FIRST 49152 // ephemeral ports of client sockets
+#define RX_RD_UPDATE 250       // Sn_RX_RD is written back after this many bytes (or when all is read)
+
+#define DHCP_SERVER_PORT 67
+#define DHCP_CLIENT_PORT 68
+#define DHCP_DEFAULT_LEASE 900 // seconds, if the server gives no lease time
+#define DHCP_MESSAGE_SIZE 548
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// per socket cache of the receive pointers, as in the Arduino Ethernet library
+static struct
+{
+    uint16_t rsr; // bytes known to be in the RX memory
+    uint16_t rd;  // Sn_RX_RD not yet written back
+    uint16_t inc; // bytes read since the last RECV command
+    uint8_t mask; // Sn_IR bits reported to the socket callback
+} sockets[MAX_SOCK_NUM];
+
+static uint16_t txSizes[MAX_SOCK_NUM], rxSizes[MAX_SOCK_NUM];
+static uint16_t serverPorts[MAX_SOCK_NUM];
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// DHCP client state, as the DhcpClass of the Arduino Ethernet library
+enum
+{
+    STATE_DHCP_START,
+    STATE_DHCP_DISCOVER,
+    STATE_DHCP_REQUEST,
+    STATE_DHCP_LEASED,
+    STATE_DHCP_REREQUEST,
+};
+
+enum
+{
+    DHCP_DISCOVER = 1,
+    DHCP_OFFER = 2,
+    DHCP_REQUEST = 3,
+    DHCP_ACK = 5,
+    DHCP_NAK = 6,
+};
+
+static struct
+{
+    bool enabled;
+    unsigned long timeout;
+    unsigned long responseTimeout;
+    uint8_t state;
+    uint32_t xid;
+    uint32_t initialXid;
+    uint32_t leaseTime, t1, t2; // seconds
+    uint32_t renewInSec, rebindInSec;
+    unsigned long lastCheckLeaseMillis;
+    uint8_t mac[6];
+    IPAddress localIP, subnet, gateway, dns, server;
+} dhcp;
+static EthernetUDP dhcpUdp;
+
+///////////////////////////////////////////////////////////////////////////////
+EthernetClass::EthernetClass() : _localPort(0),
+                                 _dns(),
+                                 _lease{IPAddress(127, 0, 0, 1), IPAddress(127, 0, 0, 1), IPAddress(255, 0, 0, 0), IPAddress(127, 0, 0, 1)},
+                                 _callback(nullptr),
+                                 _socketCallbacks()
+{
+    for (int sn = 0; sn < MAX_SOCK_NUM; sn++)
+    {
+        txSizes[sn] = rxSizes[sn] = 2048;
+    }
+}
+
+void EthernetClass::init(uint8_t, uint8_t)
+{
+}
+
+void EthernetClass::setLease(IPAddress ip, IPAddress gateway, IPAddress subnet, IPAddress dns)
+{
+    _lease[0] = ip;
+    _lease[1] = gateway;
+    _lease[2] = subnet;
+    _lease[3] = dns;
+}
+
+void EthernetClass::setDhcp(void)
+{
+    dhcp.enabled = true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// DHCP client, as the Arduino library: requestLease() blocks until an ACK or the timeout, a response
+// timeout starts over with DISCOVER; checkLease() counts T1 / T2 down in whole seconds, renews at T1
+// and rebinds at T2, and after a failed rebind tries again on every call. The lease end is not tracked.
+///////////////////////////////////////////////////////////////////////////////
+static void dhcpSend(uint8_t type, uint16_t secs)
+{
+    uint8_t msg[300] = {1, 1, 6, 0}; // BOOTREQUEST, Ethernet, 6-byte hardware address
+    msg[4] = dhcp.xid >> 24;
+    msg[5] = dhcp.xid >> 16;
+    msg[6] = dhcp.xid >> 8;
+    msg[7] = dhcp.xid;
+    msg[8] = secs >> 8;
+    msg[9] = secs;
+    msg[10] = 0x80; // broadcast reply
+    memcpy(&msg[28], dhcp.mac, 6);
+    static const uint8_t cookie[4] = {99, 130, 83, 99};
+    memcpy(&msg[236], cookie, 4);
+
+    uint8_t *opt = &msg[240];
+    *opt++ = 53; // message type
+    *opt++ = 1;
+    *opt++ = type;
+    *opt++ = 61; // client identifier
+    *opt++ = 7;
+    *opt++ = 1;
+    memcpy(opt, dhcp.mac, 6);
+    opt += 6;
+    if (type == DHCP_REQUEST)
+    {
+        *opt++ = 50; // requested address
+        *opt++ = 4;
+        memcpy(opt, dhcp.localIP.raw(), 4);
+        opt += 4;
+        *opt++ = 54; // server identifier
+        *opt++ = 4;
+        memcpy(opt, dhcp.server.raw(), 4);
+        opt += 4;
+    }
+    static const uint8_t params[] = {55, 4, 1, 3, 6, 51}; // subnet, router, DNS, lease time
+    memcpy(opt, params, sizeof(params));
+    opt += sizeof(params);
+    *opt = 255;
+
+    dhcpUdp.beginPacket(IPAddress(255, 255, 255, 255), DHCP_SERVER_PORT);
+    dhcpUdp.write(msg, sizeof(msg));
+    dhcpUdp.endPacket();
+}
+
+// message type of the reply, 255 on response timeout
+static uint8_t dhcpParse(unsigned long responseTimeout, uint32_t *xid)
+{
+    unsigned long start = millis();
+    while (dhcpUdp.parsePacket() <= 0)
+    {
+        if ((millis() - start) > responseTimeout)
+        {
+            return 255;
+        }
+        delay(50);
+    }
+
+    uint8_t msg[DHCP_MESSAGE_SIZE];
+    int len = dhcpUdp.read(msg, sizeof(msg));
+    if (len < 240)
+    {
+        return 0;
+    }
+    *xid = ((uint32_t)msg[4] << 24) | (msg[5] << 16) | (msg[6] << 8) | msg[7];
+    if ((msg[0] != 2) || memcmp(&msg[28], dhcp.mac, 6) || (*xid < dhcp.initialXid) || (*xid > dhcp.xid))
+    {
+        return 0;
+    }
+    dhcp.localIP = IPAddress(&msg[16]);
+
+    uint8_t type = 0;
+    for (int i = 240; i < len;)
+    {
+        uint8_t code = msg[i++];
+        if (code == 0)
+        {
+            continue;
+        }
+        if ((code == 255) || (i >= len))
+        {
+            break;
+        }
+        uint8_t n = msg[i++];
+        const uint8_t *v = &msg[i];
+        i += n;
+        if (i > len)
+        {
+            break;
+        }
+        uint32_t value = (n >= 4) ? (((uint32_t)v[0] << 24) | (v[1] << 16) | (v[2] << 8) | v[3]) : 0;
+        switch (code)
+        {
+        case 53:
+            type = v[0];
+            break;
+        case 1:
+            dhcp.subnet = IPAddress(v);
+            break;
+        case 3:
+            dhcp.gateway = IPAddress(v);
+            break;
+        case 6:
+            dhcp.dns = IPAddress(v);
+            break;
+        case 54:
+            dhcp.server = IPAddress(v);
+            break;
+        case 51:
+            dhcp.leaseTime = value;
+            break;
+        case 58:
+            dhcp.t1 = value;
+            break;
+        case 59:
+            dhcp.t2 = value;
+            break;
+        default:
+            break;
+        }
+    }
+    return type;
+}
+
+static int dhcpRequestLease(void)
+{
+    dhcp.xid = dhcp.initialXid = random(1, 2000);
+    dhcpUdp.stop();
+    if (!dhcpUdp.begin(DHCP_CLIENT_PORT))
+    {
+        return 0;
+    }
+
+    int result = 0;
+    unsigned long start = millis();
+    while (dhcp.state != STATE_DHCP_LEASED)
+    {
+        uint8_t type = 0;
+        uint32_t xid;
+        if (dhcp.state == STATE_DHCP_START)
+        {
+            dhcp.xid++;
+            dhcpSend(DHCP_DISCOVER, (millis() - start) / 1000);
+            dhcp.state = STATE_DHCP_DISCOVER;
+        }
+        else if (dhcp.state == STATE_DHCP_REREQUEST)
+        {
+            dhcp.xid++;
+            dhcpSend(DHCP_REQUEST, (millis() - start) / 1000);
+            dhcp.state = STATE_DHCP_REQUEST;
+        }
+        else if (dhcp.state == STATE_DHCP_DISCOVER)
+        {
+            type = dhcpParse(dhcp.responseTimeout, &xid);
+            if (type == DHCP_OFFER)
+            {
+                dhcp.xid = xid;
+                dhcpSend(DHCP_REQUEST, (millis() - start) / 1000);
+                dhcp.state = STATE_DHCP_REQUEST;
+            }
+        }
+        else if (dhcp.state == STATE_DHCP_REQUEST)
+        {
+            type = dhcpParse(dhcp.responseTimeout, &xid);
+            if (type == DHCP_ACK)
+            {
+                dhcp.state = STATE_DHCP_LEASED;
+                result = 1;
+                if (dhcp.leaseTime == 0)
+                {
+                    dhcp.leaseTime = DHCP_DEFAULT_LEASE;
+                }
+                if (dhcp.t1 == 0)
+                {
+                    dhcp.t1 = dhcp.leaseTime >> 1;
+                }
+                if (dhcp.t2 == 0)
+                {
+                    dhcp.t2 = dhcp.leaseTime - (dhcp.leaseTime >> 3);
+                }
+                dhcp.renewInSec = dhcp.t1;
+                dhcp.rebindInSec = dhcp.t2;
+            }
+            else if (type == DHCP_NAK)
+            {
+                dhcp.state = STATE_DHCP_START;
+            }
+        }
+        if (type == 255)
+        {
+            dhcp.state = STATE_DHCP_START;
+        }
+        if ((result != 1) && ((millis() - start) > dhcp.timeout))
+        {
+            break;
+        }
+    }
+    dhcpUdp.stop();
+    dhcp.xid++;
+    dhcp.lastCheckLeaseMillis = millis();
+    return result;
+}
+
+static void dhcpResetLease(void)
+{
+    dhcp.leaseTime = dhcp.t1 = dhcp.t2 = 0;
+    dhcp.renewInSec = dhcp.rebindInSec = 0;
+    dhcp.localIP = dhcp.subnet = dhcp.gateway = dhcp.dns = dhcp.server = IPAddress();
+}
+
+static int dhcpCheckLease(void)
+{
+    int rc = DHCP_CHECK_NONE;
+    unsigned long now = millis();
+    unsigned long elapsed = now - dhcp.lastCheckLeaseMillis;
+    if (elapsed >= 1000)
+    {
+        dhcp.lastCheckLeaseMillis = now - (elapsed % 1000);
+        elapsed /= 1000;
+        dhcp.renewInSec = (dhcp.renewInSec < elapsed * 2) ? 0 : dhcp.renewInSec - elapsed;
+        dhcp.rebindInSec = (dhcp.rebindInSec < elapsed * 2) ? 0 : dhcp.rebindInSec - elapsed;
+    }
+    if ((dhcp.renewInSec == 0) && (dhcp.state == STATE_DHCP_LEASED))
+    {
+        dhcp.state = STATE_DHCP_REREQUEST;
+        rc = 1 + dhcpRequestLease();
+    }
+    if ((dhcp.rebindInSec == 0) && ((dhcp.state == STATE_DHCP_LEASED) || (dhcp.state == STATE_DHCP_START)))
+    {
+        dhcp.state = STATE_DHCP_START;
+        dhcpResetLease();
+        rc = 3 + dhcpRequestLease();
+    }
+    return rc;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int EthernetClass::begin(uint8_t *mac, uint8_t ir, uint8_t ir2, uint8_t slir, EthernetEventCallback callback,
+                         unsigned long timeout, unsigned long responseTimeout)
+{
+    W5100.write8(W5100S_MR, 0x80); // software reset
+    if (hardwareStatus() == EthernetNoHardware)
+    {
+        return 0;
+    }
+    W5100.write(W5100S_SHAR, mac, 6);
+    for (int sn = 0; sn < MAX_SOCK_NUM; sn++)
+    {
+        txSizes[sn] = W5100.readSn8(sn, W5100S_SN_TXBUF_SIZE) * 1024;
+        rxSizes[sn] = W5100.readSn8(sn, W5100S_SN_RXBUF_SIZE) * 1024;
+        _socketCallbacks[sn] = nullptr;
+    }
+    if (dhcp.enabled)
+    {
+        memcpy(dhcp.mac, mac, 6);
+        dhcp.timeout = timeout;
+        dhcp.responseTimeout = responseTimeout;
+        dhcp.state = STATE_DHCP_START;
+        dhcpResetLease();
+        if (!dhcpRequestLease())
+        {
+            return 0;
+        }
+        setLease(dhcp.localIP, dhcp.gateway, dhcp.subnet, dhcp.dns);
+    }
+    else if (linkStatus() != LinkON)
+    {
+        return 0; // DHCP would time out
+    }
+
+    W5100.write(W5100S_SIPR, _lease[0].raw(), 4);
+    W5100.write(W5100S_GAR, _lease[1].raw(), 4);
+    W5100.write(W5100S_SUBR, _lease[2].raw(), 4);
+    _dns = _lease[3];
+
+    W5100.write8(W5100S_IMR, ir | IR::SOCKETS);
+    W5100.write8(W5100S_IMR2, ir2);
+    W5100.write8(W5100S_SLIMR, slir);
+    _callback = callback;
+    return 1;
+}
+
+int EthernetClass::maintain(void)
+{
+    if (!dhcp.enabled)
+    {
+        return DHCP_CHECK_NONE;
+    }
+    int rc = dhcpCheckLease();
+    if ((rc == DHCP_CHECK_RENEW_OK) || (rc == DHCP_CHECK_REBIND_OK))
+    {
+        // the address may have changed
+        setLease(dhcp.localIP, dhcp.gateway, dhcp.subnet, dhcp.dns);
+        W5100.write(W5100S_SIPR, _lease[0].raw(), 4);
+        W5100.write(W5100S_GAR, _lease[1].raw(), 4);
+        W5100.write(W5100S_SUBR, _lease[2].raw(), 4);
+        _dns = _lease[3];
+    }
+    return rc;
+}
+
+EthernetHardwareStatus EthernetClass::hardwareStatus(void)
+{
+    return (W5100.read8(W5100S_VERR) == W5100S_VERSION) ? EthernetW5100S : EthernetNoHardware;
+}
+
+EthernetLinkStatus EthernetClass::linkStatus(void)
+{
+    return (W5100.read8(W5100S_PHYSR) & 0x01) ? LinkON : LinkOFF;
+}
+
+static IPAddress readIP(uint16_t addr)
+{
+    uint8_t ip[4];
+    W5100.read(addr, ip, 4);
+    return IPAddress(ip);
+}
+
+IPAddress EthernetClass::localIP(void)
+{
+    return readIP(W5100S_SIPR);
+}
+
+IPAddress EthernetClass::subnetMask(void)
+{
+    return readIP(W5100S_SUBR);
+}
+
+IPAddress EthernetClass::gatewayIP(void)
+{
+    return readIP(W5100S_GAR);
+}
+
+IPAddress EthernetClass::dnsServerIP(void)
+{
+    return _dns;
+}
+
+bool EthernetClass::poll(void)
+{
+    if (!W5100sEmulator::getInstance()->intn())
+    {
+        return false;
+    }
+
+    uint8_t ir = W5100.read8(W5100S_IR);
+    uint8_t ir2 = W5100.read8(W5100S_IR2);
+    uint8_t slir = W5100.read8(W5100S_SLIR);
+    for (int sn = 0; sn < MAX_SOCK_NUM; sn++)
+    {
+        if (ir & (1 << sn))
+        {
+            uint8_t sn_ir = W5100.readSnIR(sn) & sockets[sn].mask;
+            W5100.writeSnIR(sn, sn_ir);
+            if (_socketCallbacks[sn] && sn_ir)
+            {
+                _socketCallbacks[sn](sn_ir);
+            }
+        }
+    }
+
+    ir &= W5100.read8(W5100S_IMR) & ~IR::SOCKETS;
+    ir2 &= W5100.read8(W5100S_IMR2);
+    slir &= W5100.read8(W5100S_SLIMR);
+    if (ir || ir2 || slir)
+    {
+        W5100.write8(W5100S_IR, ir);
+        W5100.write8(W5100S_IR2, ir2);
+        W5100.write8(W5100S_SLIR, slir);
+        if (_callback)
+        {
+            _callback(ir, ir2, slir);
+        }
+    }
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// socket layer
+///////////////////////////////////////////////////////////////////////////////
+uint16_t EthernetClass::txBase(uint8_t sn, uint16_t *size)
+{
+    uint16_t base = W5100S_TX_BASE;
+    for (int i = 0; i < sn; i++)
+    {
+        base += txSizes[i];
+    }
+    *size = txSizes[sn];
+    return base;
+}
+
+uint16_t EthernetClass::rxBase(uint8_t sn, uint16_t *size)
+{
+    uint16_t base = W5100S_RX_BASE;
+    for (int i = 0; i < sn; i++)
+    {
+        base += rxSizes[i];
+    }
+    *size = rxSizes[sn];
+    return base;
+}
+
+void EthernetClass::readBuffer(uint16_t base, uint16_t size, uint16_t ptr, uint8_t *buf, uint16_t len)
+{
+    uint16_t offset = ptr & (size - 1);
+    if (offset + len > size)
+    {
+        uint16_t first = size - offset;
+        W5100.read(base + offset, buf, first);
+        W5100.read(base, buf + first, len - first);
+    }
+    else
+    {
+        W5100.read(base + offset, buf, len);
+    }
+}
+
+void EthernetClass::writeBuffer(uint16_t base, uint16_t size, uint16_t ptr, const uint8_t *buf, uint16_t len)
+{
+    uint16_t offset = ptr & (size - 1);
+    if (offset + len > size)
+    {
+        uint16_t first = size - offset;
+        W5100.write(base + offset, buf, first);
+        W5100.write(base, buf + first, len - first);
+    }
+    else
+    {
+        W5100.write(base + offset, buf, len);
+    }
+}
+
+uint8_t EthernetClass::socketBegin(uint8_t protocol, uint16_t port)
+{
+    uint8_t sn;
+    for (sn = 0; sn < MAX_SOCK_NUM; sn++)
+    {
+        if (W5100.readSnSR(sn) == SnSR::CLOSED)
+        {
+            break;
+        }
+    }
+    if (sn == MAX_SOCK_NUM)
+    {
+        // take a socket that is only closing
+        for (sn = 0; sn < MAX_SOCK_NUM; sn++)
+        {
+            uint8_t status = W5100.readSnSR(sn);
+            if ((status == SnSR::LAST_ACK) || (status == SnSR::TIME_WAIT) || (status == SnSR::FIN_WAIT) ||
+                (status == SnSR::CLOSING) || (status == SnSR::CLOSE_WAIT))
+            {
+                W5100.execCmdSn(sn, Sock_CLOSE);
+                break;
+            }
+        }
+        if (sn == MAX_SOCK_NUM)
+        {
+            return MAX_SOCK_NUM; // all 4 sockets in use
+        }
+    }
+
+    serverPorts[sn] = 0;
+    _socketCallbacks[sn] = nullptr;
+    sockets[sn].mask = 0;
+    W5100.writeSn8(sn, W5100S_SN_MR, protocol);
+    W5100.writeSn8(sn, W5100S_SN_IMR, 0);
+    W5100.writeSnIR(sn, 0xFF);
+    if (port == 0)
+    {
+        if (++_localPort < LOCAL_PORT_FIRST)
+        {
+            _localPort = LOCAL_PORT_FIRST;
+        }
+        port = _localPort;
+    }
+    W5100.writeSn16(sn, W5100S_SN_PORT, port);
+    W5100.execCmdSn(sn, Sock_OPEN);
+    sockets[sn].rsr = 0;
+    sockets[sn].rd = W5100.readSn16(sn, W5100S_SN_RX_RD);
+    sockets[sn].inc = 0;
+    return sn;
+}
+
+void EthernetClass::socketCallback(uint8_t sn, uint8_t sn_ir, SocketEventCallback callback)
+{
+    sockets[sn].mask = sn_ir;
+    _socketCallbacks[sn] = callback;
+    W5100.writeSn8(sn, W5100S_SN_IMR, sn_ir);
+}
+
+uint8_t EthernetClass::socketStatus(uint8_t sn)
+{
+    return W5100.readSnSR(sn);
+}
+
+void EthernetClass::socketClose(uint8_t sn)
+{
+    W5100.execCmdSn(sn, Sock_CLOSE);
+}
+
+void EthernetClass::socketDisconnect(uint8_t sn)
+{
+    W5100.execCmdSn(sn, Sock_DISCON);
+}
+
+bool EthernetClass::socketConnect(uint8_t sn, IPAddress ip, uint16_t port)
+{
+    if ((uint32_t)ip == 0 || port == 0)
+    {
+        return false;
+    }
+    W5100.write(W5100S_SN_BASE(sn) + W5100S_SN_DIPR, ip.raw(), 4);
+    W5100.writeSn16(sn, W5100S_SN_DPORT, port);
+    W5100.execCmdSn(sn, Sock_CONNECT);
+    return true;
+}
+
+bool EthernetClass::socketListen(uint8_t sn)
+{
+    if (W5100.readSnSR(sn) != SnSR::INIT)
+    {
+        return false;
+    }
+    W5100.execCmdSn(sn, Sock_LISTEN);
+    return true;
+}
+
+uint16_t EthernetClass::socketSendAvailable(uint8_t sn)
+{
+    return W5100.readSnStable16(sn, W5100S_SN_TX_FSR);
+}
+
+// at most one TX buffer per call, as the Arduino library
+uint16_t EthernetClass::socketSend(uint8_t sn, const uint8_t *buf, uint16_t len)
+{
+    uint16_t size;
+    uint16_t base = txBase(sn, &size);
+    uint16_t ret = (len > size) ? size : len;
+
+    uint16_t free;
+    do
+    {
+        free = socketSendAvailable(sn);
+        uint8_t status = W5100.readSnSR(sn);
+        if ((status != SnSR::ESTABLISHED) && (status != SnSR::CLOSE_WAIT))
+        {
+            return 0;
+        }
+    } while (free < ret);
+
+    uint16_t wr = W5100.readSn16(sn, W5100S_SN_TX_WR);
+    writeBuffer(base, size, wr, buf, ret);
+    W5100.writeSn16(sn, W5100S_SN_TX_WR, wr + ret);
+    W5100.execCmdSn(sn, Sock_SEND);
+
+    while ((W5100.readSnIR(sn) & SnIR::SEND_OK) != SnIR::SEND_OK)
+    {
+        if (W5100.readSnSR(sn) == SnSR::CLOSED)
+        {
+            return 0;
+        }
+    }
+    W5100.writeSnIR(sn, SnIR::SEND_OK);
+    return ret;
+}
+
+uint16_t EthernetClass::socketBufferData(uint8_t sn, uint16_t offset, const uint8_t *buf, uint16_t len)
+{
+    uint16_t size;
+    uint16_t base = txBase(sn, &size);
+    uint16_t free = socketSendAvailable(sn);
+    uint16_t ret = (len > free) ? free : len;
+    uint16_t wr = W5100.readSn16(sn, W5100S_SN_TX_WR);
+    writeBuffer(base, size, wr, buf, ret);
+    W5100.writeSn16(sn, W5100S_SN_TX_WR, wr + ret);
+    (void)offset; // Sn_TX_WR already covers the bytes buffered so far
+    return ret;
+}
+
+bool EthernetClass::socketStartUDP(uint8_t sn, IPAddress ip, uint16_t port)
+{
+    if ((uint32_t)ip == 0 || port == 0)
+    {
+        return false;
+    }
+    W5100.write(W5100S_SN_BASE(sn) + W5100S_SN_DIPR, ip.raw(), 4);
+    W5100.writeSn16(sn, W5100S_SN_DPORT, port);
+    return true;
+}
+
+bool EthernetClass::socketSendUDP(uint8_t sn)
+{
+    W5100.execCmdSn(sn, Sock_SEND);
+    while (true)
+    {
+        uint8_t sn_ir = W5100.readSnIR(sn);
+        if (sn_ir & SnIR::SEND_OK)
+        {
+            W5100.writeSnIR(sn, SnIR::SEND_OK);
+            return true;
+        }
+        if (sn_ir & SnIR::TIMEOUT)
+        {
+            W5100.writeSnIR(sn, SnIR::SEND_OK | SnIR::TIMEOUT);
+            return false;
+        }
+    }
+}
+
+uint16_t EthernetClass::socketRecvAvailable(uint8_t sn)
+{
+    uint16_t ret = sockets[sn].rsr;
+    if (ret == 0)
+    {
+        ret = W5100.readSnStable16(sn, W5100S_SN_RX_RSR) - sockets[sn].inc;
+        sockets[sn].rsr = ret;
+    }
+    return ret;
+}
+
+int EthernetClass::socketRecv(uint8_t sn, uint8_t *buf, int16_t len)
+{
+    int ret = sockets[sn].rsr;
+    if (ret < len)
+    {
+        ret = W5100.readSnStable16(sn, W5100S_SN_RX_RSR) - sockets[sn].inc;
+        sockets[sn].rsr = ret;
+    }
+    if (ret == 0)
+    {
+        uint8_t status = W5100.readSnSR(sn);
+        return ((status == SnSR::LISTEN) || (status == SnSR::CLOSED) || (status == SnSR::CLOSE_WAIT)) ? 0 : -1;
+    }
+
+    if (ret > len)
+    {
+        ret = len;
+    }
+    uint16_t size;
+    uint16_t base = rxBase(sn, &size);
+    readBuffer(base, size, sockets[sn].rd, buf, ret);
+    sockets[sn].rd += ret;
+    sockets[sn].rsr -= ret;
+    uint16_t inc = sockets[sn].inc + ret;
+    if ((inc >= RX_RD_UPDATE) || (sockets[sn].rsr == 0))
+    {
+        sockets[sn].inc = 0;
+        W5100.writeSn16(sn, W5100S_SN_RX_RD, sockets[sn].rd);
+        W5100.execCmdSn(sn, Sock_RECV);
+    }
+    else
+    {
+        sockets[sn].inc = inc;
+    }
+    return ret;
+}
+
+int EthernetClass::socketPeek(uint8_t sn)
+{
+    uint16_t size;
+    uint16_t base = rxBase(sn, &size);
+    uint8_t b;
+    readBuffer(base, size, sockets[sn].rd, &b, 1);
+    return b;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// EthernetClient
+///////////////////////////////////////////////////////////////////////////////
+int EthernetClient::connect(const char *host, uint16_t port)
+{
+    return connect(IPAddress(W5100sEmulator::getInstance()->resolve(host)), port);
+}
+
+int EthernetClient::connect(IPAddress ip, uint16_t port)
+{
+    if (_sockindex < MAX_SOCK_NUM)
+    {
+        if (Ethernet.socketStatus(_sockindex) != SnSR::CLOSED)
+        {
+            Ethernet.socketDisconnect(_sockindex);
+        }
+        _sockindex = MAX_SOCK_NUM;
+    }
+    _sockindex = Ethernet.socketBegin(SnMR::TCP, 0);
+    if (_sockindex >= MAX_SOCK_NUM)
+    {
+        return 0;
+    }
+    Ethernet.socketConnect(_sockindex, ip, port);
+    uint32_t start = millis();
+    while (true)
+    {
+        uint8_t status = Ethernet.socketStatus(_sockindex);
+        if ((status == SnSR::ESTABLISHED) || (status == SnSR::CLOSE_WAIT))
+        {
+            return 1;
+        }
+        if (status == SnSR::CLOSED)
+        {
+            return 0;
+        }
+        if (millis() - start > _timeout)
+        {
+            break;
+        }
+        delay(1);
+    }
+    Ethernet.socketClose(_sockindex);
+    _sockindex = MAX_SOCK_NUM;
+    return 0;
+}
+
+size_t EthernetClient::write(uint8_t c)
+{
+    return write(&c, 1);
+}
+
+size_t EthernetClient::write(const uint8_t *buf, size_t size)
+{
+    if (_sockindex >= MAX_SOCK_NUM)
+    {
+        return 0;
+    }
+    return Ethernet.socketSend(_sockindex, buf, size) ? size : 0;
+}
+
+int EthernetClient::available(void)
+{
+    return (_sockindex < MAX_SOCK_NUM) ? Ethernet.socketRecvAvailable(_sockindex) : 0;
+}
+
+int EthernetClient::read(void)
+{
+    uint8_t b;
+    return ((_sockindex < MAX_SOCK_NUM) && (Ethernet.socketRecv(_sockindex, &b, 1) > 0)) ? b : -1;
+}
+
+int EthernetClient::read(uint8_t *buf, size_t size)
+{
+    return (_sockindex < MAX_SOCK_NUM) ? Ethernet.socketRecv(_sockindex, buf, size) : -1;
+}
+
+int EthernetClient::peek(void)
+{
+    return ((_sockindex < MAX_SOCK_NUM) && available()) ? Ethernet.socketPeek(_sockindex) : -1;
+}
+
+void EthernetClient::flush(void)
+{
+    while (_sockindex < MAX_SOCK_NUM)
+    {
+        uint8_t status = Ethernet.socketStatus(_sockindex);
+        if ((status != SnSR::ESTABLISHED) && (status != SnSR::CLOSE_WAIT))
+        {
+            return;
+        }
+        if (Ethernet.socketSendAvailable(_sockindex) >= txSizes[_sockindex])
+        {
+            return;
+        }
+    }
+}
+
+void EthernetClient::stop(void)
+{
+    if (_sockindex >= MAX_SOCK_NUM)
+    {
+        return;
+    }
+    Ethernet.socketDisconnect(_sockindex);
+    uint32_t start = millis();
+    do
+    {
+        if (Ethernet.socketStatus(_sockindex) == SnSR::CLOSED)
+        {
+            _sockindex = MAX_SOCK_NUM;
+            return;
+        }
+        delay(1);
+    } while (millis() - start < _timeout);
+    Ethernet.socketClose(_sockindex);
+    _sockindex = MAX_SOCK_NUM;
+}
+
+uint8_t EthernetClient::status(void)
+{
+    return (_sockindex < MAX_SOCK_NUM) ? Ethernet.socketStatus(_sockindex) : SnSR::CLOSED;
+}
+
+uint8_t EthernetClient::connected(void)
+{
+    if (_sockindex >= MAX_SOCK_NUM)
+    {
+        return 0;
+    }
+    uint8_t s = status();
+    return !((s == SnSR::LISTEN) || (s == SnSR::CLOSED) || (s == SnSR::FIN_WAIT) || (s == SnSR::TIME_WAIT) ||
+             ((s == SnSR::CLOSE_WAIT) && !available()));
+}
+
+IPAddress EthernetClient::remoteIP(void)
+{
+    return (_sockindex < MAX_SOCK_NUM) ? readIP(W5100S_SN_BASE(_sockindex) + W5100S_SN_DIPR) : IPAddress();
+}
+
+uint16_t EthernetClient::remotePort(void)
+{
+    return (_sockindex < MAX_SOCK_NUM) ? W5100.readSn16(_sockindex, W5100S_SN_DPORT) : 0;
+}
+
+uint16_t EthernetClient::localPort(void)
+{
+    return (_sockindex < MAX_SOCK_NUM) ? W5100.readSn16(_sockindex, W5100S_SN_PORT) : 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// EventEthernetClient
+///////////////////////////////////////////////////////////////////////////////
+int EventEthernetClient::connect(const char *host, uint16_t port, uint8_t sn_ir, SocketEventCallback callback)
+{
+    return connect(IPAddress(W5100sEmulator::getInstance()->resolve(host)), port, sn_ir, callback);
+}
+
+int EventEthernetClient::connect(IPAddress ip, uint16_t port, uint8_t sn_ir, SocketEventCallback callback)
+{
+    if (_sockindex < MAX_SOCK_NUM)
+    {
+        if (Ethernet.socketStatus(_sockindex) != SnSR::CLOSED)
+        {
+            Ethernet.socketDisconnect(_sockindex);
+        }
+        _sockindex = MAX_SOCK_NUM;
+    }
+    _sockindex = Ethernet.socketBegin(SnMR::TCP, 0);
+    if (_sockindex >= MAX_SOCK_NUM)
+    {
+        return 0;
+    }
+    Ethernet.socketCallback(_sockindex, sn_ir, callback);
+    if (!Ethernet.socketConnect(_sockindex, ip, port))
+    {
+        Ethernet.socketClose(_sockindex);
+        _sockindex = MAX_SOCK_NUM;
+        return 0;
+    }
+    return 1;
+}
+
+uint8_t EventEthernetClient::connected(void)
+{
+    uint8_t s = status();
+    if ((s == SnSR::INIT) || (s == SnSR::SYNSENT) || (s == SnSR::SYNRECV))
+    {
+        return 0; // still connecting
+    }
+    return EthernetClient::connected();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// EthernetServer
+///////////////////////////////////////////////////////////////////////////////
+void EthernetServer::begin(void)
+{
+    uint8_t sn = Ethernet.socketBegin(SnMR::TCP, _port);
+    if (sn < MAX_SOCK_NUM)
+    {
+        if (Ethernet.socketListen(sn))
+        {
+            serverPorts[sn] = _port;
+        }
+        else
+        {
+            Ethernet.socketDisconnect(sn);
+        }
+    }
+}
+
+EthernetClient EthernetServer::available(void)
+{
+    bool listening = false;
+    uint8_t found = MAX_SOCK_NUM;
+    for (uint8_t sn = 0; sn < MAX_SOCK_NUM; sn++)
+    {
+        if (serverPorts[sn] != _port)
+        {
+            continue;
+        }
+        uint8_t status = Ethernet.socketStatus(sn);
+        if ((status == SnSR::ESTABLISHED) || (status == SnSR::CLOSE_WAIT))
+        {
+            if (Ethernet.socketRecvAvailable(sn) > 0)
+            {
+                found = sn;
+            }
+            else if (status == SnSR::CLOSE_WAIT)
+            {
+                Ethernet.socketDisconnect(sn);
+            }
+        }
+        else if (status == SnSR::LISTEN)
+        {
+            listening = true;
+        }
+        else if (status == SnSR::CLOSED)
+        {
+            serverPorts[sn] = 0;
+        }
+    }
+    if (!listening)
+    {
+        begin(); // the accepted connection took the listening socket
+    }
+    return EthernetClient(found);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// EthernetUDP
+///////////////////////////////////////////////////////////////////////////////
+uint8_t EthernetUDP::begin(uint16_t port)
+{
+    if (_sockindex < MAX_SOCK_NUM)
+    {
+        Ethernet.socketClose(_sockindex);
+    }
+    _sockindex = Ethernet.socketBegin(SnMR::UDP, port);
+    if (_sockindex >= MAX_SOCK_NUM)
+    {
+        return 0;
+    }
+    _port = port;
+    _remaining = 0;
+    return 1;
+}
+
+void EthernetUDP::stop(void)
+{
+    if (_sockindex < MAX_SOCK_NUM)
+    {
+        Ethernet.socketClose(_sockindex);
+        _sockindex = MAX_SOCK_NUM;
+    }
+}
+
+int EthernetUDP::beginPacket(const char *host, uint16_t port)
+{
+    return beginPacket(IPAddress(W5100sEmulator::getInstance()->resolve(host)), port);
+}
+
+int EthernetUDP::beginPacket(IPAddress ip, uint16_t port)
+{
+    _offset = 0;
+    return (_sockindex < MAX_SOCK_NUM) && Ethernet.socketStartUDP(_sockindex, ip, port);
+}
+
+int EthernetUDP::endPacket(void)
+{
+    return Ethernet.socketSendUDP(_sockindex);
+}
+
+size_t EthernetUDP::write(uint8_t c)
+{
+    return write(&c, 1);
+}
+
+size_t EthernetUDP::write(const uint8_t *buf, size_t size)
+{
+    uint16_t n = Ethernet.socketBufferData(_sockindex, _offset, buf, size);
+    _offset += n;
+    return n;
+}
+
+int EthernetUDP::parsePacket(void)
+{
+    while (_remaining)
+    {
+        uint8_t b;
+        read(&b, 1); // discard the rest of the previous packet
+    }
+    if (Ethernet.socketRecvAvailable(_sockindex) > 0)
+    {
+        uint8_t header[8];
+        if (Ethernet.socketRecv(_sockindex, header, 8) > 0)
+        {
+            _remoteIP = IPAddress(header);
+            _remotePort = (header[4] << 8) | header[5];
+            _remaining = (header[6] << 8) | header[7];
+            return _remaining;
+        }
+    }
+    return 0;
+}
+
+int EthernetUDP::available(void)
+{
+    return _remaining;
+}
+
+int EthernetUDP::read(void)
+{
+    uint8_t b;
+    return (read(&b, 1) > 0) ? b : -1;
+}
+
+int EthernetUDP::read(uint8_t *buf, size_t size)
+{
+    if (_remaining == 0)
+    {
+        return -1;
+    }
+    int n = Ethernet.socketRecv(_sockindex, buf, (size < _remaining) ? size : _remaining);
+    if (n > 0)
+    {
+        _remaining -= n;
+    }
+    return n;
+}
+
+int EthernetUDP::peek(void)
+{
+    return (_remaining > 0) ? Ethernet.socketPeek(_sockindex) : -1;
+}
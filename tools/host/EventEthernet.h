@@ -0,0 +1,196 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Host version of the EventEthernet library on W5100sEmulator: Ethernet, EthernetClient,
+ * EventEthernetClient, EthernetServer and EthernetUDP with the socket code of the Arduino Ethernet
+ * library, so register and buffer accesses (and their SPI cost) match the board.
+ * The INTn pin is a GPIO interrupt on the board; on the host Ethernet.poll() samples it and runs the
+ * same service routine: Sn_IR of the flagged sockets to their callbacks, then IR / IR2 / SLIR to the
+ * callback given to Ethernet.begin().
+ * begin() takes the lease set by setLease(), or after setDhcp() runs the DHCP client of the Arduino
+ * library on UDP port 68 against a server on the device port 67 (W5100sEmulator::mapPort()): blocking
+ * DISCOVER / REQUEST until the timeout given to begin(), renew at T1 and rebind at T2 from maintain().
+ * DNS does not run on the chip: connect(host) resolves with W5100sEmulator::mapHost().
+ */
+#pragma once
+#include <Arduino.h>
+#include "utility/w5100.h"
+
+enum EthernetHardwareStatus
+{
+    EthernetNoHardware,
+    EthernetW5100,
+    EthernetW5200,
+    EthernetW5500,
+    EthernetW5100S,
+};
+
+enum EthernetLinkStatus
+{
+    Unknown,
+    LinkON,
+    LinkOFF,
+};
+
+// maintain() results, as the Arduino library
+#define DHCP_CHECK_NONE (0)
+#define DHCP_CHECK_RENEW_FAIL (1)
+#define DHCP_CHECK_RENEW_OK (2)
+#define DHCP_CHECK_REBIND_FAIL (3)
+#define DHCP_CHECK_REBIND_OK (4)
+
+typedef void (*EthernetEventCallback)(uint8_t ir, uint8_t ir2, uint8_t slir);
+typedef void (*SocketEventCallback)(uint8_t sn_ir);
+
+class EthernetClass
+{
+public:
+    EthernetClass();
+
+    void init(uint8_t csPin, uint8_t intnPin);
+    // DHCP timeouts in ms, with the defaults of the Arduino begin(mac, timeout, responseTimeout)
+    int begin(uint8_t *mac, uint8_t ir, uint8_t ir2, uint8_t slir, EthernetEventCallback callback,
+              unsigned long timeout = 60000, unsigned long responseTimeout = 4000);
+    int maintain(void);
+
+    EthernetHardwareStatus hardwareStatus(void);
+    EthernetLinkStatus linkStatus(void);
+    IPAddress localIP(void);
+    IPAddress subnetMask(void);
+    IPAddress gatewayIP(void);
+    IPAddress dnsServerIP(void);
+
+    // host only
+    void setLease(IPAddress ip, IPAddress gateway, IPAddress subnet, IPAddress dns);
+    void setDhcp(void); // begin() runs DHCP instead of taking the setLease() lease
+    bool poll(void); // services INTn, returns true if it was asserted
+
+    // socket layer, as the Arduino Ethernet library
+    uint8_t socketBegin(uint8_t protocol, uint16_t port);
+    uint8_t socketStatus(uint8_t sn);
+    void socketClose(uint8_t sn);
+    void socketDisconnect(uint8_t sn);
+    bool socketConnect(uint8_t sn, IPAddress ip, uint16_t port);
+    bool socketListen(uint8_t sn);
+    uint16_t socketSend(uint8_t sn, const uint8_t *buf, uint16_t len);
+    uint16_t socketSendAvailable(uint8_t sn);
+    uint16_t socketBufferData(uint8_t sn, uint16_t offset, const uint8_t *buf, uint16_t len);
+    bool socketStartUDP(uint8_t sn, IPAddress ip, uint16_t port);
+    bool socketSendUDP(uint8_t sn);
+    int socketRecv(uint8_t sn, uint8_t *buf, int16_t len);
+    uint16_t socketRecvAvailable(uint8_t sn);
+    int socketPeek(uint8_t sn);
+    void socketCallback(uint8_t sn, uint8_t sn_ir, SocketEventCallback callback);
+
+private:
+    uint16_t _localPort;
+    IPAddress _dns;
+    IPAddress _lease[4]; // ip, gateway, subnet, dns
+    EthernetEventCallback _callback;
+    SocketEventCallback _socketCallbacks[MAX_SOCK_NUM];
+
+    void readBuffer(uint16_t base, uint16_t size, uint16_t ptr, uint8_t *buf, uint16_t len);
+    void writeBuffer(uint16_t base, uint16_t size, uint16_t ptr, const uint8_t *buf, uint16_t len);
+    uint16_t txBase(uint8_t sn, uint16_t *size);
+    uint16_t rxBase(uint8_t sn, uint16_t *size);
+};
+
+extern EthernetClass Ethernet;
+
+class EthernetClient : public Stream
+{
+public:
+    EthernetClient() : _sockindex(MAX_SOCK_NUM), _timeout(1000) {}
+    EthernetClient(uint8_t sn) : _sockindex(sn), _timeout(1000) {}
+
+    virtual int connect(IPAddress ip, uint16_t port);
+    virtual int connect(const char *host, uint16_t port);
+    virtual size_t write(uint8_t c);
+    virtual size_t write(const uint8_t *buf, size_t size);
+    using Print::write;
+    virtual int available(void);
+    virtual int read(void);
+    virtual int read(uint8_t *buf, size_t size);
+    virtual int peek(void);
+    virtual void flush(void);
+    virtual void stop(void);
+    virtual uint8_t connected(void);
+    virtual operator bool(void)
+    {
+        return _sockindex < MAX_SOCK_NUM;
+    }
+
+    uint8_t status(void);
+    IPAddress remoteIP(void);
+    uint16_t remotePort(void);
+    uint16_t localPort(void);
+    uint8_t getSocketNumber(void) const
+    {
+        return _sockindex;
+    }
+    void setConnectionTimeout(uint16_t timeout)
+    {
+        _timeout = timeout;
+    }
+
+protected:
+    uint8_t _sockindex; // MAX_SOCK_NUM: no socket
+    uint16_t _timeout;
+};
+
+// connect() returns once CONNECT is issued; the socket events selected by sn_ir go to callback
+class EventEthernetClient : public EthernetClient
+{
+public:
+    int connect(IPAddress ip, uint16_t port, uint8_t sn_ir, SocketEventCallback callback);
+    int connect(const char *host, uint16_t port, uint8_t sn_ir, SocketEventCallback callback);
+    using EthernetClient::connect;
+    virtual uint8_t connected(void);
+};
+
+class EthernetServer
+{
+public:
+    EthernetServer(uint16_t port) : _port(port) {}
+
+    void begin(void);
+    EthernetClient available(void);
+
+private:
+    uint16_t _port;
+};
+
+class EthernetUDP : public Stream
+{
+public:
+    EthernetUDP() : _sockindex(MAX_SOCK_NUM), _port(0), _remaining(0), _offset(0), _remoteIP(), _remotePort(0) {}
+
+    uint8_t begin(uint16_t port);
+    void stop(void);
+    int beginPacket(IPAddress ip, uint16_t port);
+    int beginPacket(const char *host, uint16_t port);
+    int endPacket(void);
+    virtual size_t write(uint8_t c);
+    virtual size_t write(const uint8_t *buf, size_t size);
+    using Print::write;
+    int parsePacket(void);
+    virtual int available(void);
+    virtual int read(void);
+    int read(uint8_t *buf, size_t size);
+    virtual int peek(void);
+    IPAddress remoteIP(void) const
+    {
+        return _remoteIP;
+    }
+    uint16_t remotePort(void) const
+    {
+        return _remotePort;
+    }
+
+private:
+    uint8_t _sockindex;
+    uint16_t _port;
+    uint16_t _remaining; // bytes left of the received packet
+    uint16_t _offset;    // bytes of the packet being built
+    IPAddress _remoteIP;
+    uint16_t _remotePort;
+};
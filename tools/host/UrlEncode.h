@@ -0,0 +1,31 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Host stand-in for the UrlEncode library.
+ */
+#pragma once
+#include <ctype.h>
+#include <Arduino.h>
+
+inline String urlEncode(const char *text)
+{
+    static const char hex[] = "0123456789ABCDEF";
+    std::string out;
+    for (const unsigned char *p = (const unsigned char *)text; *p; p++)
+    {
+        if (isalnum(*p) || (*p == '-') || (*p == '_') || (*p == '.') || (*p == '~'))
+        {
+            out += (char)*p;
+        }
+        else
+        {
+            out += '%';
+            out += hex[*p >> 4];
+            out += hex[*p & 0x0F];
+        }
+    }
+    return String(out);
+}
+inline String urlEncode(const String &text)
+{
+    return urlEncode(text.c_str());
+}
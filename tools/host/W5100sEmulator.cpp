@@ -0,0 +1,822 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Host emulation of the WIZnet W5100S, see W5100sEmulator.h
+ */
+#include "W5100sEmulator.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Sn_MR protocol, Sn_CR commands, Sn_IR bits and Sn_SR states (W5100S datasheet)
+enum
+{
+    MR_TCP = 0x01,
+    MR_UDP = 0x02,
+
+    CR_OPEN = 0x01,
+    CR_LISTEN = 0x02,
+    CR_CONNECT = 0x04,
+    CR_DISCON = 0x08,
+    CR_CLOSE = 0x10,
+    CR_SEND = 0x20,
+    CR_RECV = 0x40,
+
+    IR_CON = 0x01,
+    IR_DISCON = 0x02,
+    IR_RECV = 0x04,
+    IR_TIMEOUT = 0x08,
+    IR_SEND_OK = 0x10,
+
+    SR_CLOSED = 0x00,
+    SR_INIT = 0x13,
+    SR_LISTEN = 0x14,
+    SR_SYNSENT = 0x15,
+    SR_ESTABLISHED = 0x17,
+    SR_FIN_WAIT = 0x18,
+    SR_CLOSE_WAIT = 0x1C,
+    SR_UDP = 0x22,
+};
+
+// SLCR commands and SLIR bits
+enum
+{
+    SLCR_PING = 0x01,
+    SLCR_ARP = 0x02,
+
+    SLIR_PING = 0x01,
+    SLIR_ARP = 0x02,
+    SLIR_TIMEOUT = 0x04,
+};
+
+#define IR_SOCKETS ((1 << W5100S_SOCKETS) - 1) // IR bits 0..3: S0_INT..S3_INT
+#define UDP_HEADER 8                           // RX memory: peer IP, peer port, length
+
+////////////////////////////////////////////////////////////////////////////////////////////
+W5100sEmulator *W5100sEmulator::_instance = nullptr;
+
+W5100sEmulator *W5100sEmulator::getInstance(void)
+{
+    if (!_instance)
+    {
+        static W5100sEmulator instance;
+        _instance = &instance;
+    }
+    return _instance;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+W5100sEmulator::W5100sEmulator() : _mem(),
+                                   _sockets(),
+                                   _spi(),
+                                   _burstAddr(0),
+                                   _burstWrite(false)
+{
+    for (auto &s : _sockets)
+    {
+        s.fd = -1;
+        s.listenFd = -1;
+    }
+    _mem[W5100S_PHYSR] = 0x01; // link up
+    reset();
+}
+
+W5100sEmulator::~W5100sEmulator()
+{
+    for (int sn = 0; sn < W5100S_SOCKETS; sn++)
+    {
+        closeSocket(sn, SR_CLOSED);
+    }
+}
+
+void W5100sEmulator::reset(void)
+{
+    uint8_t physr = _mem[W5100S_PHYSR];
+    for (int sn = 0; sn < W5100S_SOCKETS; sn++)
+    {
+        closeSocket(sn, SR_CLOSED);
+        _sockets[sn].stats = SocketStats();
+    }
+    memset(_mem, 0, sizeof(_mem));
+    setReg16(W5100S_RTR, 2000); // 200 ms
+    _mem[W5100S_RCR] = 8;
+    _mem[W5100S_RMSR] = 0x55; // 2 KB per socket
+    _mem[W5100S_TMSR] = 0x55;
+    _mem[W5100S_PHYSR] = physr;
+    _mem[W5100S_VERR] = W5100S_VERSION;
+    for (int sn = 0; sn < W5100S_SOCKETS; sn++)
+    {
+        setSn8(sn, W5100S_SN_RXBUF_SIZE, 2);
+        setSn8(sn, W5100S_SN_TXBUF_SIZE, 2);
+        setSn8(sn, W5100S_SN_IMR, 0xFF);
+        setSn16(sn, W5100S_SN_TX_FSR, txSize(sn));
+    }
+}
+
+void W5100sEmulator::clearStats(void)
+{
+    _spi = SpiStats();
+    for (auto &s : _sockets)
+    {
+        s.stats = SocketStats();
+    }
+}
+
+void W5100sEmulator::setLink(bool up)
+{
+    _mem[W5100S_PHYSR] = up ? 0x01 : 0x00;
+}
+
+void W5100sEmulator::mapPort(uint16_t devicePort, uint16_t hostPort)
+{
+    _ports[devicePort] = hostPort;
+}
+
+void W5100sEmulator::mapHost(const char *name, uint32_t ip)
+{
+    _hosts[name] = ip;
+}
+
+uint32_t W5100sEmulator::resolve(const char *name) const
+{
+    auto it = _hosts.find(name);
+    if (it != _hosts.end())
+    {
+        return it->second;
+    }
+    struct in_addr addr;
+    if (inet_pton(AF_INET, name, &addr) == 1)
+    {
+        return addr.s_addr;
+    }
+    return htonl(INADDR_LOOPBACK); // every name resolves to the host
+}
+
+void W5100sEmulator::setReachable(uint32_t ip, bool reachable)
+{
+    if (reachable)
+    {
+        _unreachable.erase(ip);
+    }
+    else
+    {
+        _unreachable.insert(ip);
+    }
+}
+
+void W5100sEmulator::raise(uint8_t ir, uint8_t ir2, uint8_t slir)
+{
+    _mem[W5100S_IR] |= ir & ~IR_SOCKETS;
+    _mem[W5100S_IR2] |= ir2;
+    _mem[W5100S_SLIR] |= slir;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// SPI
+///////////////////////////////////////////////////////////////////////////////
+static bool is_status(uint16_t addr)
+{
+    if ((addr == W5100S_IR) || (addr == W5100S_IR2) || (addr == W5100S_SLIR))
+    {
+        return true;
+    }
+    if ((addr < W5100S_SN_BASE(0)) || (addr >= W5100S_SN_BASE(W5100S_SOCKETS)))
+    {
+        return false;
+    }
+    uint8_t offset = addr & 0xFF;
+    return (offset == W5100S_SN_IR) || (offset == W5100S_SN_SR) || (offset == W5100S_SN_TX_FSR) ||
+           (offset == W5100S_SN_RX_RSR);
+}
+
+void W5100sEmulator::spiRead(uint16_t addr, uint8_t *buf, size_t len)
+{
+    if (len && is_status(addr))
+    {
+        step();
+    }
+    for (size_t i = 0; i < len; i++)
+    {
+        buf[i] = readByte((addr + i) & (W5100S_MEM_SIZE - 1));
+    }
+    _spi.frames += len;
+    _spi.bytes += len * (W5100S_SPI_HEADER + 1);
+    _spi.read += len;
+}
+
+void W5100sEmulator::spiWrite(uint16_t addr, const uint8_t *buf, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        writeByte((addr + i) & (W5100S_MEM_SIZE - 1), buf[i]);
+    }
+    _spi.frames += len;
+    _spi.bytes += len * (W5100S_SPI_HEADER + 1);
+    _spi.written += len;
+}
+
+void W5100sEmulator::spiBurstBegin(uint16_t addr, bool write)
+{
+    if (!write && is_status(addr))
+    {
+        step();
+    }
+    _burstAddr = addr;
+    _burstWrite = write;
+    _spi.frames++;
+    _spi.bytes += W5100S_SPI_HEADER;
+}
+
+void W5100sEmulator::spiBurstRead(uint8_t *buf, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        buf[i] = _burstWrite ? 0 : readByte(_burstAddr++ & (W5100S_MEM_SIZE - 1));
+    }
+    _spi.bytes += len;
+    _spi.read += len;
+}
+
+void W5100sEmulator::spiBurstWrite(const uint8_t *buf, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        if (_burstWrite)
+        {
+            writeByte(_burstAddr++ & (W5100S_MEM_SIZE - 1), buf[i]);
+        }
+    }
+    _spi.bytes += len;
+    _spi.written += len;
+}
+
+void W5100sEmulator::spiBurstEnd(void)
+{
+}
+
+bool W5100sEmulator::intn(void)
+{
+    step();
+    return (_mem[W5100S_IR] & _mem[W5100S_IMR]) || (_mem[W5100S_IR2] & _mem[W5100S_IMR2]) ||
+           (_mem[W5100S_SLIR] & _mem[W5100S_SLIMR]);
+}
+
+uint8_t W5100sEmulator::readByte(uint16_t addr)
+{
+    if ((addr >= W5100S_SN_BASE(0)) && (addr < W5100S_SN_BASE(W5100S_SOCKETS)))
+    {
+        int sn = (addr - W5100S_SN_BASE(0)) >> 8;
+        uint8_t offset = addr & 0xFF;
+        if ((offset & ~1) == W5100S_SN_TX_FSR)
+        {
+            setSn16(sn, W5100S_SN_TX_FSR, txSize(sn) - (uint16_t)(sn16(sn, W5100S_SN_TX_WR) - sn16(sn, W5100S_SN_TX_RD)));
+        }
+        else if ((offset & ~1) == W5100S_SN_RX_RSR)
+        {
+            setSn16(sn, W5100S_SN_RX_RSR, rxUsed(sn));
+        }
+    }
+    return _mem[addr];
+}
+
+void W5100sEmulator::writeByte(uint16_t addr, uint8_t value)
+{
+    switch (addr)
+    {
+    case W5100S_MR:
+        if (value & 0x80)
+        {
+            reset(); // software reset, the bit clears itself
+            return;
+        }
+        break;
+    case W5100S_IR:
+        _mem[addr] &= ~(value & ~IR_SOCKETS); // socket bits follow Sn_IR
+        return;
+    case W5100S_IR2:
+    case W5100S_SLIR:
+        _mem[addr] &= ~value;
+        return;
+    case W5100S_PHYSR:
+    case W5100S_VERR:
+        return;
+    case W5100S_SLCR:
+        _mem[addr] = value & (SLCR_PING | SLCR_ARP); // runs on the next step(), then clears
+        return;
+    case W5100S_RMSR:
+    case W5100S_TMSR:
+        _mem[addr] = value;
+        for (int sn = 0; sn < W5100S_SOCKETS; sn++)
+        {
+            setSn8(sn, (addr == W5100S_RMSR) ? W5100S_SN_RXBUF_SIZE : W5100S_SN_TXBUF_SIZE, 1 << ((value >> (2 * sn)) & 3));
+        }
+        return;
+    case W5100S_IMR:
+        _mem[addr] = value;
+        return;
+    default:
+        break;
+    }
+
+    if ((addr >= W5100S_SN_BASE(0)) && (addr < W5100S_SN_BASE(W5100S_SOCKETS)))
+    {
+        int sn = (addr - W5100S_SN_BASE(0)) >> 8;
+        uint8_t offset = addr & 0xFF;
+        switch (offset)
+        {
+        case W5100S_SN_CR:
+            command(sn, value); // the chip clears Sn_CR once the command is accepted
+            return;
+        case W5100S_SN_IR:
+            _mem[addr] &= ~value;
+            updateIR();
+            return;
+        case W5100S_SN_IMR:
+            _mem[addr] = value;
+            updateIR();
+            return;
+        case W5100S_SN_SR:
+        case W5100S_SN_TX_FSR:
+        case W5100S_SN_TX_FSR + 1:
+        case W5100S_SN_TX_RD:
+        case W5100S_SN_TX_RD + 1:
+        case W5100S_SN_RX_RSR:
+        case W5100S_SN_RX_RSR + 1:
+        case W5100S_SN_RX_WR:
+        case W5100S_SN_RX_WR + 1:
+            return; // read only
+        default:
+            break;
+        }
+    }
+    _mem[addr] = value;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// registers
+///////////////////////////////////////////////////////////////////////////////
+uint8_t W5100sEmulator::reg8(uint16_t addr) const
+{
+    return _mem[addr];
+}
+
+uint16_t W5100sEmulator::reg16(uint16_t addr) const
+{
+    return (_mem[addr] << 8) | _mem[addr + 1];
+}
+
+void W5100sEmulator::setReg16(uint16_t addr, uint16_t value)
+{
+    _mem[addr] = value >> 8;
+    _mem[addr + 1] = value & 0xFF;
+}
+
+uint8_t W5100sEmulator::sn8(int sn, uint8_t offset) const
+{
+    return reg8(W5100S_SN_BASE(sn) + offset);
+}
+
+uint16_t W5100sEmulator::sn16(int sn, uint8_t offset) const
+{
+    return reg16(W5100S_SN_BASE(sn) + offset);
+}
+
+void W5100sEmulator::setSn8(int sn, uint8_t offset, uint8_t value)
+{
+    _mem[W5100S_SN_BASE(sn) + offset] = value;
+}
+
+void W5100sEmulator::setSn16(int sn, uint8_t offset, uint16_t value)
+{
+    setReg16(W5100S_SN_BASE(sn) + offset, value);
+}
+
+uint16_t W5100sEmulator::txSize(int sn) const
+{
+    return sn8(sn, W5100S_SN_TXBUF_SIZE) * 1024;
+}
+
+uint16_t W5100sEmulator::rxSize(int sn) const
+{
+    return sn8(sn, W5100S_SN_RXBUF_SIZE) * 1024;
+}
+
+uint16_t W5100sEmulator::txBase(int sn) const
+{
+    uint16_t base = W5100S_TX_BASE;
+    for (int i = 0; i < sn; i++)
+    {
+        base += txSize(i);
+    }
+    return base;
+}
+
+uint16_t W5100sEmulator::rxBase(int sn) const
+{
+    uint16_t base = W5100S_RX_BASE;
+    for (int i = 0; i < sn; i++)
+    {
+        base += rxSize(i);
+    }
+    return base;
+}
+
+uint16_t W5100sEmulator::rxUsed(int sn) const
+{
+    return sn16(sn, W5100S_SN_RX_WR) - sn16(sn, W5100S_SN_RX_RD);
+}
+
+void W5100sEmulator::interrupt(int sn, uint8_t bits)
+{
+    setSn8(sn, W5100S_SN_IR, sn8(sn, W5100S_SN_IR) | bits);
+    _sockets[sn].stats.interrupts++;
+    updateIR();
+}
+
+void W5100sEmulator::updateIR(void)
+{
+    uint8_t ir = _mem[W5100S_IR] & ~IR_SOCKETS;
+    for (int sn = 0; sn < W5100S_SOCKETS; sn++)
+    {
+        if (sn8(sn, W5100S_SN_IR) & sn8(sn, W5100S_SN_IMR))
+        {
+            ir |= 1 << sn;
+        }
+    }
+    _mem[W5100S_IR] = ir;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// sockets
+///////////////////////////////////////////////////////////////////////////////
+uint16_t W5100sEmulator::hostPort(uint16_t port) const
+{
+    auto it = _ports.find(port);
+    return (it == _ports.end()) ? port : it->second;
+}
+
+uint16_t W5100sEmulator::devicePort(uint16_t port) const
+{
+    for (auto &it : _ports)
+    {
+        if (it.second == port)
+        {
+            return it.first;
+        }
+    }
+    return port;
+}
+
+static sockaddr_in loopback(uint16_t port)
+{
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    return addr;
+}
+
+void W5100sEmulator::closeSocket(int sn, uint8_t state)
+{
+    Socket &s = _sockets[sn];
+    if (s.fd >= 0)
+    {
+        close(s.fd);
+        s.fd = -1;
+    }
+    if (s.listenFd >= 0)
+    {
+        close(s.listenFd);
+        s.listenFd = -1;
+    }
+    s.connecting = false;
+    s.peerClosed = false;
+    s.pending.clear();
+    setSn8(sn, W5100S_SN_SR, state);
+}
+
+void W5100sEmulator::command(int sn, uint8_t cmd)
+{
+    Socket &s = _sockets[sn];
+    uint8_t sr = sn8(sn, W5100S_SN_SR);
+    s.stats.commands++;
+
+    switch (cmd)
+    {
+    case CR_OPEN:
+    {
+        closeSocket(sn, SR_CLOSED);
+        for (uint8_t offset : {W5100S_SN_TX_RD, W5100S_SN_TX_WR, W5100S_SN_RX_RD, W5100S_SN_RX_WR})
+        {
+            setSn16(sn, offset, 0);
+        }
+        setSn8(sn, W5100S_SN_IR, 0);
+        updateIR();
+        uint8_t protocol = sn8(sn, W5100S_SN_MR) & 0x0F;
+        if (protocol == MR_TCP)
+        {
+            setSn8(sn, W5100S_SN_SR, SR_INIT);
+        }
+        else if (protocol == MR_UDP)
+        {
+            s.fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+            sockaddr_in addr = loopback(hostPort(sn16(sn, W5100S_SN_PORT)));
+            if ((s.fd >= 0) && (bind(s.fd, (sockaddr *)&addr, sizeof(addr)) == 0))
+            {
+                setSn8(sn, W5100S_SN_SR, SR_UDP);
+            }
+            else
+            {
+                closeSocket(sn, SR_CLOSED);
+            }
+        }
+        break;
+    }
+
+    case CR_LISTEN:
+    {
+        if (sr != SR_INIT)
+        {
+            break;
+        }
+        s.listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+        int on = 1;
+        setsockopt(s.listenFd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        sockaddr_in addr = loopback(hostPort(sn16(sn, W5100S_SN_PORT)));
+        if ((s.listenFd >= 0) && (bind(s.listenFd, (sockaddr *)&addr, sizeof(addr)) == 0) && (listen(s.listenFd, 1) == 0))
+        {
+            setSn8(sn, W5100S_SN_SR, SR_LISTEN);
+        }
+        else
+        {
+            closeSocket(sn, SR_CLOSED);
+        }
+        break;
+    }
+
+    case CR_CONNECT:
+    {
+        if (sr != SR_INIT)
+        {
+            break;
+        }
+        s.fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+        sockaddr_in addr = loopback(hostPort(sn16(sn, W5100S_SN_DPORT)));
+        int ret = (s.fd >= 0) ? connect(s.fd, (sockaddr *)&addr, sizeof(addr)) : -1;
+        if (ret == 0)
+        {
+            setSn8(sn, W5100S_SN_SR, SR_ESTABLISHED);
+            interrupt(sn, IR_CON);
+        }
+        else if (errno == EINPROGRESS)
+        {
+            s.connecting = true;
+            setSn8(sn, W5100S_SN_SR, SR_SYNSENT);
+        }
+        else
+        {
+            closeSocket(sn, SR_CLOSED);
+            interrupt(sn, IR_TIMEOUT);
+        }
+        break;
+    }
+
+    case CR_DISCON:
+        if ((sr == SR_ESTABLISHED) || (sr == SR_CLOSE_WAIT))
+        {
+            flush(sn);
+            if (s.peerClosed)
+            {
+                closeSocket(sn, SR_CLOSED);
+                interrupt(sn, IR_DISCON);
+            }
+            else
+            {
+                shutdown(s.fd, SHUT_WR);
+                setSn8(sn, W5100S_SN_SR, SR_FIN_WAIT);
+            }
+        }
+        else if (sr != SR_FIN_WAIT)
+        {
+            closeSocket(sn, SR_CLOSED);
+        }
+        break;
+
+    case CR_CLOSE:
+        closeSocket(sn, SR_CLOSED);
+        break;
+
+    case CR_SEND:
+    {
+        uint16_t rd = sn16(sn, W5100S_SN_TX_RD);
+        uint16_t wr = sn16(sn, W5100S_SN_TX_WR);
+        uint16_t size = txSize(sn);
+        uint16_t base = txBase(sn);
+        std::vector<uint8_t> data;
+        for (uint16_t p = rd; p != wr; p++)
+        {
+            data.push_back(_mem[base + (p & (size - 1))]);
+        }
+        if (sr == SR_UDP)
+        {
+            sockaddr_in addr = loopback(hostPort(sn16(sn, W5100S_SN_DPORT)));
+            if (_mem[W5100S_PHYSR] & 0x01) // without link the frame goes nowhere, SEND_OK all the same
+            {
+                sendto(s.fd, data.data(), data.size(), 0, (sockaddr *)&addr, sizeof(addr));
+            }
+            s.stats.txBytes += data.size();
+            setSn16(sn, W5100S_SN_TX_RD, wr);
+            interrupt(sn, IR_SEND_OK);
+        }
+        else if ((sr == SR_ESTABLISHED) || (sr == SR_CLOSE_WAIT))
+        {
+            s.pending.insert(s.pending.end(), data.begin(), data.end());
+            setSn16(sn, W5100S_SN_TX_RD, wr); // TX memory is free once the data is on its way
+            flush(sn);
+        }
+        break;
+    }
+
+    case CR_RECV:
+        break; // Sn_RX_RD is already advanced, the freed space is used by the next step()
+
+    default:
+        break;
+    }
+}
+
+void W5100sEmulator::flush(int sn)
+{
+    Socket &s = _sockets[sn];
+    if (s.pending.empty() || (s.fd < 0))
+    {
+        return;
+    }
+    while (!s.pending.empty())
+    {
+        ssize_t n = send(s.fd, s.pending.data(), s.pending.size(), MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (n > 0)
+        {
+            s.stats.txBytes += n;
+            s.pending.erase(s.pending.begin(), s.pending.begin() + n);
+        }
+        else if ((n < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)))
+        {
+            return;
+        }
+        else
+        {
+            closeSocket(sn, SR_CLOSED); // peer reset: retransmissions time out on the chip
+            interrupt(sn, IR_TIMEOUT);
+            return;
+        }
+    }
+    interrupt(sn, IR_SEND_OK);
+}
+
+void W5100sEmulator::storeRx(int sn, const uint8_t *data, size_t len)
+{
+    uint16_t wr = sn16(sn, W5100S_SN_RX_WR);
+    uint16_t size = rxSize(sn);
+    uint16_t base = rxBase(sn);
+    for (size_t i = 0; i < len; i++)
+    {
+        _mem[base + ((wr + i) & (size - 1))] = data[i];
+    }
+    setSn16(sn, W5100S_SN_RX_WR, wr + len);
+    _sockets[sn].stats.rxBytes += len;
+}
+
+void W5100sEmulator::stepSocket(int sn)
+{
+    Socket &s = _sockets[sn];
+    uint8_t sr = sn8(sn, W5100S_SN_SR);
+    uint16_t free = rxSize(sn) - rxUsed(sn);
+    uint8_t buf[W5100S_BUF_TOTAL];
+
+    if ((sr == SR_SYNSENT) && s.connecting)
+    {
+        pollfd p = {s.fd, POLLOUT, 0};
+        if (poll(&p, 1, 0) == 1)
+        {
+            int error = 0;
+            socklen_t len = sizeof(error);
+            getsockopt(s.fd, SOL_SOCKET, SO_ERROR, &error, &len);
+            s.connecting = false;
+            if (error == 0)
+            {
+                setSn8(sn, W5100S_SN_SR, SR_ESTABLISHED);
+                interrupt(sn, IR_CON);
+            }
+            else
+            {
+                closeSocket(sn, SR_CLOSED);
+                interrupt(sn, IR_TIMEOUT);
+            }
+        }
+    }
+    else if (sr == SR_LISTEN)
+    {
+        sockaddr_in peer;
+        socklen_t len = sizeof(peer);
+        int fd = accept4(s.listenFd, (sockaddr *)&peer, &len, SOCK_NONBLOCK);
+        if (fd >= 0)
+        {
+            close(s.listenFd);
+            s.listenFd = -1;
+            s.fd = fd;
+            memcpy(&_mem[W5100S_SN_BASE(sn) + W5100S_SN_DIPR], &peer.sin_addr.s_addr, 4);
+            setSn16(sn, W5100S_SN_DPORT, ntohs(peer.sin_port));
+            setSn8(sn, W5100S_SN_SR, SR_ESTABLISHED);
+            interrupt(sn, IR_CON);
+        }
+    }
+    else if ((sr == SR_ESTABLISHED) || (sr == SR_FIN_WAIT) || (sr == SR_CLOSE_WAIT))
+    {
+        flush(sn);
+        if ((s.fd < 0) || s.peerClosed || (free == 0))
+        {
+            return;
+        }
+        ssize_t n = recv(s.fd, buf, free, MSG_DONTWAIT);
+        if (n > 0)
+        {
+            storeRx(sn, buf, n);
+            interrupt(sn, IR_RECV);
+        }
+        else if ((n == 0) || ((errno != EAGAIN) && (errno != EWOULDBLOCK)))
+        {
+            s.peerClosed = true;
+            if (sr == SR_FIN_WAIT)
+            {
+                closeSocket(sn, SR_CLOSED);
+            }
+            else
+            {
+                setSn8(sn, W5100S_SN_SR, SR_CLOSE_WAIT);
+            }
+            interrupt(sn, IR_DISCON);
+        }
+    }
+    else if (sr == SR_UDP)
+    {
+        bool received = false;
+        while (free > UDP_HEADER)
+        {
+            sockaddr_in peer;
+            socklen_t len = sizeof(peer);
+            ssize_t n = recvfrom(s.fd, buf, sizeof(buf), MSG_DONTWAIT | MSG_PEEK | MSG_TRUNC, (sockaddr *)&peer, &len);
+            if ((n < 0) || (n + UDP_HEADER > free))
+            {
+                break; // nothing, or no room: the datagram waits like in the chip's RX memory
+            }
+            n = recv(s.fd, buf + UDP_HEADER, sizeof(buf) - UDP_HEADER, MSG_DONTWAIT);
+            if (!(_mem[W5100S_PHYSR] & 0x01))
+            {
+                continue; // arrived while the link is down: lost
+            }
+            uint16_t port = devicePort(ntohs(peer.sin_port)); // a mapped server port shows as on the network
+            memcpy(buf, &peer.sin_addr.s_addr, 4);
+            buf[4] = port >> 8;
+            buf[5] = port & 0xFF;
+            buf[6] = n >> 8;
+            buf[7] = n & 0xFF;
+            storeRx(sn, buf, n + UDP_HEADER);
+            free -= n + UDP_HEADER;
+            received = true;
+        }
+        if (received)
+        {
+            interrupt(sn, IR_RECV);
+        }
+    }
+}
+
+void W5100sEmulator::stepSocketless(void)
+{
+    uint8_t cmd = _mem[W5100S_SLCR];
+    if (!cmd)
+    {
+        return;
+    }
+    uint32_t ip;
+    memcpy(&ip, &_mem[W5100S_SLPIPR], 4);
+    bool answered = (_mem[W5100S_PHYSR] & 0x01) && !_unreachable.count(ip);
+    _mem[W5100S_SLCR] = 0;
+    _mem[W5100S_SLIR] |= answered ? ((cmd & SLCR_ARP) ? SLIR_ARP : SLIR_PING) : SLIR_TIMEOUT;
+}
+
+void W5100sEmulator::step(void)
+{
+    for (int sn = 0; sn < W5100S_SOCKETS; sn++)
+    {
+        stepSocket(sn);
+    }
+    stepSocketless();
+}
@@ -0,0 +1,185 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Host emulation of the WIZnet W5100S register and socket model, backed by Linux sockets:
+ *  - 32 KB address space: common registers, 4 socket register blocks, 8 KB TX and 8 KB RX memory
+ *    split by Sn_TXBUF_SIZE / Sn_RXBUF_SIZE (or RMSR / TMSR), 2 KB per socket after reset
+ *  - Sn_CR commands OPEN, LISTEN, CONNECT, DISCON, CLOSE, SEND, RECV on TCP and UDP sockets,
+ *    Sn_SR state machine, Sn_TX_FSR / Sn_RX_RSR and the ring pointers as the chip updates them
+ *  - Sn_IR / Sn_IMR, IR / IMR (socket bits and CONFLICT, UNREACH, PPPTERM), IR2 / IMR2, SLIR / SLIMR,
+ *    write-1-to-clear, and the INTn level
+ *  - SOCKET-less ARP and PING (SLCR, SLPIPR): SLIR ARP / PING for a reachable address, SLIR TIMEOUT
+ *    while the link is down or for an address marked with setReachable(ip, false)
+ *  - PHY link (PHYSR) set by setLink(); while it is down UDP datagrams are dropped both ways
+ *  - SPI accounting: the W5100S SPI frame is opcode, 16-bit address and one data byte, so every
+ *    register or buffer byte costs a 4-byte frame with its own chip select; bursts (one header, then
+ *    auto-increment while nCS stays low) cost the header once
+ * Socket traffic goes to loopback; mapPort() moves device ports (e.g. 80) to unprivileged host ports,
+ * and UDP datagrams from a mapped host port carry the device port as source.
+ * The chip advances (accepts, connects, receives, sends) whenever a status register is read, so host
+ * runs are deterministic apart from the kernel.
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#define W5100S_SOCKETS 4
+#define W5100S_MEM_SIZE 0x8000
+#define W5100S_TX_BASE 0x4000
+#define W5100S_RX_BASE 0x6000
+#define W5100S_BUF_TOTAL 0x2000 // TX and RX memory, each
+#define W5100S_SPI_HEADER 3     // opcode, address high, address low
+#define W5100S_VERSION 0x51
+
+// common registers
+#define W5100S_MR 0x0000
+#define W5100S_GAR 0x0001
+#define W5100S_SUBR 0x0005
+#define W5100S_SHAR 0x0009
+#define W5100S_SIPR 0x000F
+#define W5100S_IR 0x0015
+#define W5100S_IMR 0x0016
+#define W5100S_RTR 0x0017
+#define W5100S_RCR 0x0019
+#define W5100S_RMSR 0x001A
+#define W5100S_TMSR 0x001B
+#define W5100S_IR2 0x0020
+#define W5100S_IMR2 0x0021
+#define W5100S_PHYSR 0x003C
+#define W5100S_SLCR 0x004C
+#define W5100S_SLRTR 0x004D
+#define W5100S_SLRCR 0x004F
+#define W5100S_SLPIPR 0x0050
+#define W5100S_SLIMR 0x005E
+#define W5100S_SLIR 0x005F
+#define W5100S_VERR 0x0080
+
+// socket registers, offset from W5100S_SN_BASE(n)
+#define W5100S_SN_BASE(n) (0x0400 + (n) * 0x0100)
+#define W5100S_SN_MR 0x00
+#define W5100S_SN_CR 0x01
+#define W5100S_SN_IR 0x02
+#define W5100S_SN_SR 0x03
+#define W5100S_SN_PORT 0x04
+#define W5100S_SN_DIPR 0x0C
+#define W5100S_SN_DPORT 0x10
+#define W5100S_SN_RXBUF_SIZE 0x1E
+#define W5100S_SN_TXBUF_SIZE 0x1F
+#define W5100S_SN_TX_FSR 0x20
+#define W5100S_SN_TX_RD 0x22
+#define W5100S_SN_TX_WR 0x24
+#define W5100S_SN_RX_RSR 0x26
+#define W5100S_SN_RX_RD 0x28
+#define W5100S_SN_RX_WR 0x2A
+#define W5100S_SN_IMR 0x2C
+
+class W5100sEmulator
+{
+public:
+    typedef struct
+    {
+        uint64_t frames;  // chip select assertions
+        uint64_t bytes;   // bytes clocked on the bus, header included
+        uint64_t read;    // data bytes read from the chip
+        uint64_t written; // data bytes written to the chip
+    } SpiStats;
+
+    typedef struct
+    {
+        uint64_t txBytes; // payload handed to the network
+        uint64_t rxBytes; // payload stored in the RX memory
+        uint32_t commands;
+        uint32_t interrupts; // Sn_IR bits set
+    } SocketStats;
+
+    static W5100sEmulator *getInstance(void);
+
+    void reset(void); // hardware reset: registers to default, sockets closed
+
+    // SPI slave, one frame per data byte
+    void spiRead(uint16_t addr, uint8_t *buf, size_t len);
+    void spiWrite(uint16_t addr, const uint8_t *buf, size_t len);
+
+    // SPI burst: one header, then the address auto-increments until nCS goes high
+    void spiBurstBegin(uint16_t addr, bool write);
+    void spiBurstRead(uint8_t *buf, size_t len);
+    void spiBurstWrite(const uint8_t *buf, size_t len);
+    void spiBurstEnd(void);
+    bool intn(void); // true while INTn is asserted (pin low)
+
+    // advance all sockets, also done on every status register read
+    void step(void);
+
+    // host side configuration and fault injection
+    void setLink(bool up);
+    void mapPort(uint16_t devicePort, uint16_t hostPort);
+    void mapHost(const char *name, uint32_t ip); // resolver for connect(host), ip in network order
+    uint32_t resolve(const char *name) const;    // 0: unknown
+    void setReachable(uint32_t ip, bool reachable); // SOCKET-less ARP / PING answered, ip in network order
+    void raise(uint8_t ir, uint8_t ir2, uint8_t slir);
+
+    inline const SpiStats &spiStats(void) const
+    {
+        return _spi;
+    }
+    inline const SocketStats &socketStats(int sn) const
+    {
+        return _sockets[sn].stats;
+    }
+    void clearStats(void);
+
+private:
+    W5100sEmulator();
+    ~W5100sEmulator();
+
+    typedef struct
+    {
+        int fd;       // data socket, -1 if none
+        int listenFd; // TCP LISTEN socket, -1 if none
+        bool connecting;
+        bool peerClosed;
+        std::vector<uint8_t> pending; // sent by SEND, not yet taken by the kernel
+        SocketStats stats;
+    } Socket;
+
+    static W5100sEmulator *_instance;
+
+    uint8_t _mem[W5100S_MEM_SIZE];
+    Socket _sockets[W5100S_SOCKETS];
+    std::map<uint16_t, uint16_t> _ports;
+    std::map<std::string, uint32_t> _hosts;
+    std::set<uint32_t> _unreachable;
+    SpiStats _spi;
+    uint16_t _burstAddr;
+    bool _burstWrite;
+
+    uint8_t reg8(uint16_t addr) const;
+    uint16_t reg16(uint16_t addr) const;
+    void setReg16(uint16_t addr, uint16_t value);
+    uint8_t sn8(int sn, uint8_t offset) const;
+    uint16_t sn16(int sn, uint8_t offset) const;
+    void setSn8(int sn, uint8_t offset, uint8_t value);
+    void setSn16(int sn, uint8_t offset, uint16_t value);
+
+    uint16_t txSize(int sn) const;
+    uint16_t rxSize(int sn) const;
+    uint16_t txBase(int sn) const;
+    uint16_t rxBase(int sn) const;
+    uint16_t rxUsed(int sn) const;
+
+    uint8_t readByte(uint16_t addr);
+    void writeByte(uint16_t addr, uint8_t value);
+    void interrupt(int sn, uint8_t bits);
+    void updateIR(void);
+    void command(int sn, uint8_t cmd);
+    void closeSocket(int sn, uint8_t state);
+    uint16_t hostPort(uint16_t port) const;
+    uint16_t devicePort(uint16_t port) const; // inverse of hostPort()
+    void stepSocket(int sn);
+    void flush(int sn);
+    void storeRx(int sn, const uint8_t *data, size_t len);
+    void stepSocketless(void);
+};
@@ -0,0 +1,14 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Host stand-in for the RP2040 SIO registers: always core 0.
+ */
+#pragma once
+#include <stdint.h>
+
+typedef struct
+{
+    uint32_t cpuid;
+} sio_hw_t;
+
+static sio_hw_t host_sio_hw = {0};
+#define sio_hw (&host_sio_hw)
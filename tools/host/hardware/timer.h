@@ -0,0 +1,17 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Host stand-in for the Pico SDK timer.
+ */
+#pragma once
+#include <Arduino.h>
+
+inline uint32_t time_us_32(void)
+{
+    return micros();
+}
+
+inline uint64_t time_us_64(void)
+{
+    static const auto start = std::chrono::steady_clock::now() - std::chrono::microseconds(micros());
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
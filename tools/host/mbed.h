@@ -0,0 +1,27 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Host stand-in for the parts of Mbed OS used by src/util: interrupt masking and thread sleep.
+ */
+#pragma once
+#include <stdint.h>
+#include <chrono>
+#include <thread>
+
+inline uint32_t __get_PRIMASK(void)
+{
+    return 0;
+}
+inline void __set_PRIMASK(uint32_t) {}
+inline void __disable_irq(void) {}
+inline void __enable_irq(void) {}
+
+namespace rtos
+{
+    namespace ThisThread
+    {
+        inline void sleep_for(std::chrono::milliseconds ms)
+        {
+            std::this_thread::sleep_for(ms);
+        }
+    } // namespace ThisThread
+} // namespace rtos
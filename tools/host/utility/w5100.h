@@ -0,0 +1,169 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Host version of the W5100S register access of the Ethernet library: every access is an SPI
+ * transaction on W5100sEmulator, so the SPI traffic of a host run is the traffic of the board.
+ */
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "../W5100sEmulator.h"
+
+#define MAX_SOCK_NUM W5100S_SOCKETS
+
+class SnMR
+{
+public:
+    static const uint8_t CLOSE = 0x00;
+    static const uint8_t TCP = 0x01;
+    static const uint8_t UDP = 0x02;
+};
+
+enum SockCMD
+{
+    Sock_OPEN = 0x01,
+    Sock_LISTEN = 0x02,
+    Sock_CONNECT = 0x04,
+    Sock_DISCON = 0x08,
+    Sock_CLOSE = 0x10,
+    Sock_SEND = 0x20,
+    Sock_RECV = 0x40,
+};
+
+class SnIR
+{
+public:
+    static const uint8_t SEND_OK = 0x10;
+    static const uint8_t TIMEOUT = 0x08;
+    static const uint8_t RECV = 0x04;
+    static const uint8_t DISCON = 0x02;
+    static const uint8_t CON = 0x01;
+};
+
+class SnSR
+{
+public:
+    static const uint8_t CLOSED = 0x00;
+    static const uint8_t INIT = 0x13;
+    static const uint8_t LISTEN = 0x14;
+    static const uint8_t SYNSENT = 0x15;
+    static const uint8_t SYNRECV = 0x16;
+    static const uint8_t ESTABLISHED = 0x17;
+    static const uint8_t FIN_WAIT = 0x18;
+    static const uint8_t CLOSING = 0x1A;
+    static const uint8_t TIME_WAIT = 0x1B;
+    static const uint8_t CLOSE_WAIT = 0x1C;
+    static const uint8_t LAST_ACK = 0x1D;
+    static const uint8_t UDP = 0x22;
+};
+
+// IR: Interrupt Register
+class IR
+{
+public:
+    static const uint8_t CONFLICT = 0x80;
+    static const uint8_t UNREACH = 0x40;
+    static const uint8_t PPPTERM = 0x20;
+    static const uint8_t SOCKETS = 0x0F;
+};
+
+// IR2: Interrupt Register 2
+class IR2
+{
+public:
+    static const uint8_t WOL = 0x01;
+};
+
+// SLIR: SOCKET-less Interrupt Register
+class SLIR
+{
+public:
+    static const uint8_t TIMEOUT = 0x04;
+    static const uint8_t ARP = 0x02;
+    static const uint8_t PING = 0x01;
+};
+
+class W5100Class
+{
+public:
+    static inline void read(uint16_t addr, uint8_t *buf, size_t len)
+    {
+        W5100sEmulator::getInstance()->spiRead(addr, buf, len);
+    }
+    static inline void write(uint16_t addr, const uint8_t *buf, size_t len)
+    {
+        W5100sEmulator::getInstance()->spiWrite(addr, buf, len);
+    }
+    static inline uint8_t read8(uint16_t addr)
+    {
+        uint8_t value;
+        read(addr, &value, 1);
+        return value;
+    }
+    static inline void write8(uint16_t addr, uint8_t value)
+    {
+        write(addr, &value, 1);
+    }
+    static inline uint16_t read16(uint16_t addr)
+    {
+        uint8_t buf[2];
+        read(addr, buf, 2);
+        return (buf[0] << 8) | buf[1];
+    }
+    static inline void write16(uint16_t addr, uint16_t value)
+    {
+        uint8_t buf[2] = {(uint8_t)(value >> 8), (uint8_t)value};
+        write(addr, buf, 2);
+    }
+
+    static inline uint8_t readSn8(uint8_t sn, uint8_t offset)
+    {
+        return read8(W5100S_SN_BASE(sn) + offset);
+    }
+    static inline void writeSn8(uint8_t sn, uint8_t offset, uint8_t value)
+    {
+        write8(W5100S_SN_BASE(sn) + offset, value);
+    }
+    static inline uint16_t readSn16(uint8_t sn, uint8_t offset)
+    {
+        return read16(W5100S_SN_BASE(sn) + offset);
+    }
+    static inline void writeSn16(uint8_t sn, uint8_t offset, uint16_t value)
+    {
+        write16(W5100S_SN_BASE(sn) + offset, value);
+    }
+
+    // registers the chip updates on its own are read until two reads agree
+    static inline uint16_t readSnStable16(uint8_t sn, uint8_t offset)
+    {
+        uint16_t value, previous;
+        value = readSn16(sn, offset);
+        do
+        {
+            previous = value;
+            value = readSn16(sn, offset);
+        } while (value != previous);
+        return value;
+    }
+
+    static inline uint8_t readSnSR(uint8_t sn)
+    {
+        return readSn8(sn, W5100S_SN_SR);
+    }
+    static inline uint8_t readSnIR(uint8_t sn)
+    {
+        return readSn8(sn, W5100S_SN_IR);
+    }
+    static inline void writeSnIR(uint8_t sn, uint8_t value)
+    {
+        writeSn8(sn, W5100S_SN_IR, value);
+    }
+    static inline void execCmdSn(uint8_t sn, SockCMD cmd)
+    {
+        writeSn8(sn, W5100S_SN_CR, cmd);
+        while (readSn8(sn, W5100S_SN_CR))
+        {
+        }
+    }
+};
+
+extern W5100Class W5100;
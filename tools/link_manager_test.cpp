@@ -0,0 +1,403 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Host test of LinkManager on the W5100S emulator (tools/host) against a stand-in DHCP server on
+ * loopback, with the DHCP client of the Arduino library (EventEthernet host version):
+ *  - boot: DISCOVER / OFFER / REQUEST / ACK, LinkUp
+ *  - renewal at T1 while up, no link down
+ *  - switch reboot: PHY link lost and back, the gateway still answers ARP: LinkResumed without DHCP
+ *  - DHCP server outage: renew and rebind fail, the link goes down before the lease ends, and comes
+ *    back up once the server answers again
+ *  - IP conflict: the address is given up, DHCP again
+ *  - gateway lost while the link stays up (UNREACH, SOCKET-less ARP timeouts), and back
+ *  - moved to another network during a link loss: the old gateway is gone, a new lease is taken
+ * Each fault reports the time to detect it and the time to recover once the fault is gone.
+ *
+ * build and run from the repository root:
+ *   g++ -O2 -std=c++17 -I. -Itools/host tools/link_manager_test.cpp src/util/LinkManager.cpp \
+ *       tools/host/W5100sEmulator.cpp tools/host/EventEthernet.cpp src/peripheral/W5100sSpi.cpp \
+ *       src/util/BinLog.cpp -lpthread -o link_manager_test
+ *   ./link_manager_test
+ */
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <EventEthernet.h>
+#include "src/util/LinkManager.h"
+
+#define DHCP_TIMEOUT LINK_DHCP_TIMEOUT_MS // the firmware timeouts, passed to Ethernet.begin() by LinkManager
+#define LEASE_TIME 10                     // s
+#define LEASE_T1 2
+#define LEASE_T2 4
+
+static int failures = 0;
+
+#define CHECK(cond, ...)                \
+    do                                  \
+    {                                   \
+        if (!(cond))                    \
+        {                               \
+            printf("FAIL %s: ", #cond); \
+            printf(__VA_ARGS__);        \
+            printf("\n");               \
+            failures++;                 \
+        }                               \
+    } while (0)
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// stand-in DHCP server: one address per network, answers DISCOVER with OFFER and REQUEST with ACK
+// (NAK for an address of another network); silent while disabled
+////////////////////////////////////////////////////////////////////////////////////////////
+class DhcpServer
+{
+public:
+    std::atomic<bool> enabled{true};
+    std::atomic<int> discovers{0};
+    std::atomic<int> requests{0};
+    std::atomic<int> acks{0};
+    std::atomic<int> naks{0};
+    std::atomic<uint32_t> leaseEnd{0}; // millis() of the end of the last lease given
+
+    DhcpServer(uint16_t port, uint16_t clientPort) : _clientPort(clientPort), _stop(false)
+    {
+        _fd = socket(AF_INET, SOCK_DGRAM, 0);
+        sockaddr_in addr = loopback(port);
+        bind(_fd, (sockaddr *)&addr, sizeof(addr));
+        setNetwork(IPAddress(192, 168, 1, 50), IPAddress(192, 168, 1, 1));
+        _thread = std::thread(&DhcpServer::run, this);
+    }
+    ~DhcpServer()
+    {
+        _stop = true;
+        _thread.join();
+        close(_fd);
+    }
+
+    void setNetwork(IPAddress ip, IPAddress gateway)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _ip = ip;
+        _gateway = gateway;
+    }
+
+private:
+    int _fd;
+    uint16_t _clientPort;
+    std::atomic<bool> _stop;
+    std::thread _thread;
+    std::mutex _mutex;
+    IPAddress _ip, _gateway;
+
+    static sockaddr_in loopback(uint16_t port)
+    {
+        sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = htons(port);
+        return addr;
+    }
+
+    void run(void)
+    {
+        while (!_stop)
+        {
+            pollfd pfd = {_fd, POLLIN, 0};
+            if (poll(&pfd, 1, 10) <= 0)
+            {
+                continue;
+            }
+            uint8_t msg[576];
+            ssize_t len = recv(_fd, msg, sizeof(msg), 0);
+            if ((len < 240) || !enabled)
+            {
+                continue;
+            }
+            uint8_t type = 0;
+            IPAddress requested;
+            for (ssize_t i = 240; (i + 1 < len) && (msg[i] != 255);)
+            {
+                if (msg[i] == 0)
+                {
+                    i++;
+                    continue;
+                }
+                if (msg[i] == 53)
+                {
+                    type = msg[i + 2];
+                }
+                else if ((msg[i] == 50) && (msg[i + 1] == 4))
+                {
+                    requested = IPAddress(&msg[i + 2]);
+                }
+                i += 2 + msg[i + 1];
+            }
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (type == 1)
+            {
+                discovers++;
+                reply(msg, 2); // OFFER
+            }
+            else if (type == 3)
+            {
+                requests++;
+                if (requested == _ip)
+                {
+                    acks++;
+                    leaseEnd = millis() + LEASE_TIME * 1000;
+                    reply(msg, 5); // ACK
+                }
+                else
+                {
+                    naks++;
+                    reply(msg, 6); // NAK
+                }
+            }
+        }
+    }
+
+    void reply(const uint8_t *request, uint8_t type)
+    {
+        uint8_t msg[300] = {2, 1, 6, 0};
+        memcpy(&msg[4], &request[4], 4);    // xid
+        memcpy(&msg[28], &request[28], 16); // chaddr
+        memcpy(&msg[16], _ip.raw(), 4);     // yiaddr
+        static const uint8_t cookie[4] = {99, 130, 83, 99};
+        memcpy(&msg[236], cookie, 4);
+        uint8_t *opt = &msg[240];
+        auto option = [&opt](uint8_t code, const uint8_t *value, uint8_t len)
+        {
+            *opt++ = code;
+            *opt++ = len;
+            memcpy(opt, value, len);
+            opt += len;
+        };
+        auto option32 = [&option](uint8_t code, uint32_t value)
+        {
+            uint8_t v[4] = {(uint8_t)(value >> 24), (uint8_t)(value >> 16), (uint8_t)(value >> 8), (uint8_t)value};
+            option(code, v, 4);
+        };
+        IPAddress subnet(255, 255, 255, 0);
+        option(53, &type, 1);
+        option(54, _gateway.raw(), 4); // the router is the server
+        option(1, subnet.raw(), 4);
+        option(3, _gateway.raw(), 4);
+        option(6, _gateway.raw(), 4);
+        option32(51, LEASE_TIME);
+        option32(58, LEASE_T1);
+        option32(59, LEASE_T2);
+        *opt = 255;
+        sockaddr_in addr = loopback(_clientPort);
+        sendto(_fd, msg, sizeof(msg), 0, (sockaddr *)&addr, sizeof(addr));
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// the device side: ThreadNet's INTn service and LINK_POLL_MS timer
+////////////////////////////////////////////////////////////////////////////////////////////
+static struct
+{
+    int downs;
+    int ups;
+    int resumes;
+    uint32_t downAt; // millis() of the last event of each kind
+    uint32_t upAt;
+} events;
+
+static void onEthernetEvent(uint8_t ir, uint8_t, uint8_t slir)
+{
+    LinkManager::getInstance()->interrupt(ir, slir);
+}
+
+static void onLinkEvent(LinkManager::LinkEvent event)
+{
+    if (event == LinkManager::LinkDown)
+    {
+        events.downs++;
+        events.downAt = millis();
+    }
+    else
+    {
+        (event == LinkManager::LinkUp) ? events.ups++ : events.resumes++;
+        events.upAt = millis();
+    }
+}
+
+// runs the device until done() or timeout ms, returns true if done
+static bool run(uint32_t timeout, std::function<bool(void)> done)
+{
+    auto link = LinkManager::getInstance();
+    uint32_t start = millis();
+    uint32_t nextPoll = start;
+    while ((int32_t)(millis() - start) < (int32_t)timeout)
+    {
+        if (done())
+        {
+            return true;
+        }
+        Ethernet.poll();
+        if ((int32_t)(millis() - nextPoll) >= 0)
+        {
+            nextPoll += LINK_POLL_MS;
+            link->update();
+        }
+        delay(5);
+    }
+    return done();
+}
+
+static uint16_t free_udp_port(void)
+{
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t len = sizeof(addr);
+    bind(fd, (sockaddr *)&addr, len);
+    getsockname(fd, (sockaddr *)&addr, &len);
+    close(fd);
+    return ntohs(addr.sin_port);
+}
+
+static void report(const char *name, uint32_t detectMs, uint32_t recoverMs, int dhcp)
+{
+    printf("%-16s detect %5u ms  recover %5u ms  DHCP exchanges %d\n", name, detectMs, recoverMs, dhcp);
+}
+
+int main(void)
+{
+    W5100sEmulator *emu = W5100sEmulator::getInstance();
+    auto link = LinkManager::getInstance();
+    uint16_t serverPort = free_udp_port(), clientPort = free_udp_port();
+    emu->mapPort(67, serverPort);
+    emu->mapPort(68, clientPort);
+    DhcpServer server(serverPort, clientPort);
+    Ethernet.setDhcp();
+
+    // boot
+    uint8_t mac[] = {0x00, 0xAA, 0xBB, 0xCC, 0xDE, 0x02};
+    uint8_t ir = IR::CONFLICT | IR::UNREACH | IR::PPPTERM;
+    uint8_t slir = SLIR::TIMEOUT | SLIR::ARP | SLIR::PING;
+    Ethernet.init(17, 21);
+    uint32_t start = millis();
+    link->begin(mac, ir, IR2::WOL, slir, onEthernetEvent, onLinkEvent);
+    CHECK(link->isUp() && (events.ups == 1), "up after begin(), state %d", link->state());
+    CHECK(Ethernet.localIP() == IPAddress(192, 168, 1, 50), "leased address");
+    CHECK(Ethernet.gatewayIP() == IPAddress(192, 168, 1, 1), "gateway");
+    report("boot", 0, millis() - start, server.acks);
+
+    // renewal at T1, the link stays up
+    int acks = server.acks;
+    run((LEASE_T1 + 1) * 1000, [&]()
+        { return link->stats().renewals > 0; });
+    CHECK(link->stats().renewals == 1, "renewals %u", link->stats().renewals);
+    CHECK((events.downs == 0) && link->isUp(), "no link down on renewal");
+    CHECK(server.acks == acks + 1, "one ACK for the renewal");
+
+    // switch reboot: 2 s without link, the gateway still answers
+    acks = server.acks;
+    emu->setLink(false);
+    start = millis();
+    CHECK(run(2000, [&]()
+              { return events.downs == 1; }),
+          "link down detected");
+    uint32_t detect = events.downAt - start;
+    CHECK(detect <= 3 * LINK_POLL_MS, "link loss detected in %u ms", detect);
+    delay(2000 - (millis() - start));
+    emu->setLink(true);
+    start = millis();
+    CHECK(run(2000, [&]()
+              { return link->isUp(); }),
+          "up after link loss");
+    report("switch reboot", detect, events.upAt - start, server.acks - acks);
+    CHECK((events.resumes == 1) && (events.ups == 1), "resumed, not reacquired: ups %d resumes %d", events.ups, events.resumes);
+    CHECK(server.acks == acks, "no DHCP after a link loss on the same network");
+    CHECK(link->stats().downs[LinkManager::CausePhy] == 1, "cause phy");
+
+    // DHCP server outage: renew at T1 and rebind at T2 fail, the link goes down before the lease ends
+    run((LEASE_T1 + 1) * 1000, [&]()
+        { return link->stats().renewals > 1; }); // fresh lease
+    server.enabled = false;
+    start = millis();
+    CHECK(run((LEASE_TIME + 2 * DHCP_TIMEOUT / 1000) * 1000, [&]()
+              { return events.downs == 2; }),
+          "down after the rebind failed");
+    detect = events.downAt - start;
+    int32_t margin = (int32_t)(server.leaseEnd - events.downAt);
+    printf("lease outage: down %d ms before the lease end (the library alone keeps the address)\n", margin);
+    CHECK(margin > 0, "down %d ms after the lease end", -margin);
+    CHECK(link->stats().downs[LinkManager::CauseLease] == 1, "cause lease");
+    acks = server.acks;
+    run(1000, []()
+        { return false; });
+    server.enabled = true;
+    start = millis();
+    CHECK(run(DHCP_TIMEOUT + LINK_RETRY_MAX_MS, [&]()
+              { return link->isUp(); }),
+          "up after the DHCP server is back");
+    report("DHCP outage", detect, events.upAt - start, server.acks - acks);
+    CHECK(events.ups == 2, "LinkUp after new lease");
+
+    // IP conflict
+    acks = server.acks;
+    emu->raise(IR::CONFLICT, 0, 0);
+    start = millis();
+    CHECK(run(DHCP_TIMEOUT + 1000, [&]()
+              { return (events.downs == 3) && link->isUp(); }),
+          "reacquired after a conflict");
+    report("IP conflict", events.downAt - start, events.upAt - events.downAt, server.acks - acks);
+    CHECK(link->stats().downs[LinkManager::CauseConflict] == 1, "cause conflict");
+    CHECK(server.acks == acks + 1, "one DHCP exchange");
+
+    // gateway lost with the link up: UNREACH triggers the check, ARP times out
+    uint32_t gateway = IPAddress(192, 168, 1, 1);
+    emu->setReachable(gateway, false);
+    emu->raise(IR::UNREACH, 0, 0);
+    start = millis();
+    CHECK(run(5000, [&]()
+              { return events.downs == 4; }),
+          "down when the gateway is lost");
+    detect = events.downAt - start;
+    CHECK(link->stats().downs[LinkManager::CauseGateway] == 1, "cause gateway");
+    run(3000, []()
+        { return false; });
+    CHECK(!link->isUp(), "stays down while the gateway is lost");
+    acks = server.acks;
+    emu->setReachable(gateway, true);
+    start = millis();
+    CHECK(run(DHCP_TIMEOUT + LINK_RETRY_MAX_MS, [&]()
+              { return link->isUp(); }),
+          "up when the gateway is back");
+    report("gateway lost", detect, events.upAt - start, server.acks - acks);
+
+    // moved to another network during a link loss
+    acks = server.acks;
+    emu->setLink(false);
+    run(1000, [&]()
+        { return events.downs == 5; });
+    emu->setReachable(gateway, false);
+    server.setNetwork(IPAddress(10, 0, 0, 20), IPAddress(10, 0, 0, 1));
+    emu->setLink(true);
+    start = millis();
+    CHECK(run(DHCP_TIMEOUT + 5000, [&]()
+              { return link->isUp(); }),
+          "up on the new network");
+    report("new network", 0, events.upAt - start, server.acks - acks);
+    CHECK(Ethernet.localIP() == IPAddress(10, 0, 0, 20), "address of the new network");
+    CHECK(events.downs == 5, "one link down, %d", events.downs);
+
+    const LinkManager::Stats &stats = link->stats();
+    printf("leases %u, renewals %u, gateway checks %u\n", stats.acquires, stats.renewals, stats.probes);
+    printf(failures ? "FAILED\n" : "passed\n");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,202 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Host accuracy check of the FFT magnitude estimators in src/ml/Magnitude (MAG_MODE):
+ *  1. error bounds against the exact magnitude over random complex bins of every size
+ *  2. end-to-end on a recording: PreProcessor pipeline (Hanning window, FFT scaled as arm_rfft_q15,
+ *     magnitude, linear Requantizer) compared bin by bin with the exact path in int8 model input units
+ *
+ * build and run from the repository root:
+ *   g++ -O2 -std=c++17 -I. tools/magnitude_test.cpp src/ml/Magnitude.cpp src/ml/Requantizer.cpp src/audio/accel.cpp -o magnitude_test
+ *   ./magnitude_test sound/alarm-sound.wav [divider]
+ */
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "src/audio/audio_const.h"
+#include "src/ml/Magnitude.h"
+#include "src/ml/Requantizer.h"
+
+typedef void (*estimator_t)(const int16_t *src, int16_t *dst, size_t bins);
+
+static const struct
+{
+    const char *name;
+    estimator_t func;
+} modes[] = {
+    {"exact", magnitude::exact},
+    {"ampb", magnitude::ampb},
+    {"power_lut", magnitude::power_lut},
+};
+
+static bool read_wav(const char *path, std::vector<int16_t> &samples)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f)
+    {
+        return false;
+    }
+    char id[4];
+    uint32_t size;
+    uint16_t channels = 0, bits = 0;
+    fseek(f, 12, SEEK_SET);
+    while (fread(id, 1, 4, f) == 4 && fread(&size, 4, 1, f) == 1)
+    {
+        long next = ftell(f) + size + (size & 1);
+        if (!memcmp(id, "fmt ", 4))
+        {
+            fseek(f, 2, SEEK_CUR);
+            fread(&channels, 2, 1, f);
+            fseek(f, 10, SEEK_CUR);
+            fread(&bits, 2, 1, f);
+        }
+        else if (!memcmp(id, "data", 4))
+        {
+            samples.resize(size / sizeof(int16_t));
+            fread(samples.data(), sizeof(int16_t), samples.size(), f);
+        }
+        fseek(f, next, SEEK_SET);
+    }
+    fclose(f);
+    return (channels == 1) && (bits == 16) && !samples.empty();
+}
+
+static void fft(std::vector<std::complex<double>> &x)
+{
+    size_t n = x.size();
+    for (size_t i = 1, j = 0; i < n; i++)
+    {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+        {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j)
+        {
+            std::swap(x[i], x[j]);
+        }
+    }
+    for (size_t len = 2; len <= n; len <<= 1)
+    {
+        std::complex<double> w = std::polar(1.0, -2 * M_PI / len);
+        for (size_t i = 0; i < n; i += len)
+        {
+            std::complex<double> wk = 1;
+            for (size_t k = 0; k < len / 2; k++, wk *= w)
+            {
+                auto u = x[i + k], v = x[i + k + len / 2] * wk;
+                x[i + k] = u + v;
+                x[i + k + len / 2] = u - v;
+            }
+        }
+    }
+}
+
+static int16_t sat16(double x)
+{
+    long y = lround(x);
+    return (int16_t)(y > 32767 ? 32767 : (y < -32768 ? -32768 : y));
+}
+
+int main(int argc, char **argv)
+{
+    const char *path = (argc > 1) ? argv[1] : "sound/alarm-sound.wav";
+    int divider = (argc > 2) ? atoi(argv[2]) : 64; // SCALE_FACTOR * model input scale
+    int failures = 0;
+    magnitude::begin();
+
+    // 1. error bounds: random bins with magnitudes spread over every octave
+    printf("estimator   max rel err  mean rel err  max abs err (LSB), relative error over magnitude >= 256\n");
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> phase(0, 2 * M_PI), octave(2, 15);
+    const size_t N = 200000;
+    std::vector<int16_t> cplx(2 * N), mag(N);
+    std::vector<double> ref(N);
+    for (size_t i = 0; i < N; i++)
+    {
+        double m = std::min(pow(2, octave(rng)), 32767.0), a = phase(rng);
+        cplx[2 * i] = sat16(m * cos(a));
+        cplx[2 * i + 1] = sat16(m * sin(a));
+        ref[i] = std::hypot((double)cplx[2 * i], (double)cplx[2 * i + 1]) / 2;
+    }
+    const double bound[] = {0.001, 0.0397, 0.008};
+    for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++)
+    {
+        modes[m].func(cplx.data(), mag.data(), N);
+        double max_rel = 0, sum_rel = 0, max_abs = 0;
+        for (size_t i = 0; i < N; i++)
+        {
+            double err = fabs(mag[i] - ref[i]);
+            max_abs = std::max(max_abs, err);
+            if (ref[i] >= 256)
+            {
+                max_rel = std::max(max_rel, err / ref[i]);
+                sum_rel += err / ref[i];
+            }
+        }
+        printf("%-10s  %10.3f%%  %11.3f%%  %11.1f\n", modes[m].name, 100 * max_rel, 100 * sum_rel / N, max_abs);
+        if (max_rel > bound[m] + 1.0 / 256)
+        {
+            failures++;
+        }
+    }
+
+    // 2. end-to-end on the recording, int8 model input
+    std::vector<int16_t> pcm;
+    if (!read_wav(path, pcm))
+    {
+        fprintf(stderr, "cannot read 16-bit mono WAV file: %s\n", path);
+        return 1;
+    }
+    Requantizer requantizer;
+    requantizer.init_linear(divider, -128);
+    const int bins = AUDIO_FFT_LEN / 2 + 1;
+    std::vector<std::vector<int8_t>> spectrogram(sizeof(modes) / sizeof(modes[0]));
+    for (size_t start = 0; start + AUDIO_FFT_LEN <= pcm.size(); start += AUDIO_FRAME_STEP)
+    {
+        std::vector<std::complex<double>> x(AUDIO_FFT_LEN);
+        for (int i = 0; i < AUDIO_FFT_LEN; i++)
+        {
+            double w = 0.5 * (1 - cos(2 * M_PI * i / AUDIO_FFT_LEN));
+            x[i] = w * pcm[start + i] / 32768.0;
+        }
+        fft(x);
+        int16_t fft_q15[2 * bins], fft_mag[bins];
+        for (int k = 0; k < bins; k++)
+        {
+            fft_q15[2 * k] = sat16(x[k].real() / AUDIO_FFT_LEN * 32768);
+            fft_q15[2 * k + 1] = sat16(x[k].imag() / AUDIO_FFT_LEN * 32768);
+        }
+        for (size_t m = 0; m < spectrogram.size(); m++)
+        {
+            int8_t q[bins];
+            modes[m].func(fft_q15, fft_mag, bins);
+            requantizer.quantize(fft_mag, q, bins);
+            spectrogram[m].insert(spectrogram[m].end(), q, q + bins);
+        }
+    }
+    printf("\n%s, divider %d: %zu spectrogram bins\nestimator   bins changed  max int8 diff  mean int8 diff\n",
+           path, divider, spectrogram[0].size());
+    for (size_t m = 1; m < spectrogram.size(); m++)
+    {
+        size_t changed = 0;
+        int max_diff = 0;
+        double sum_diff = 0;
+        for (size_t i = 0; i < spectrogram[0].size(); i++)
+        {
+            int d = abs(spectrogram[m][i] - spectrogram[0][i]);
+            changed += (d != 0);
+            max_diff = std::max(max_diff, d);
+            sum_diff += d;
+        }
+        printf("%-10s  %11.3f%%  %13d  %14.4f\n", modes[m].name, 100.0 * changed / spectrogram[0].size(), max_diff,
+               sum_diff / spectrogram[0].size());
+    }
+
+    printf("\n%s\n", failures ? "FAILED" : "passed");
+    return failures ? 1 : 0;
+}
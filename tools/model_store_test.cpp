@@ -0,0 +1,256 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Host test of the dual-slot model store in src/ml/ModelStore on an emulated NOR flash
+ * (4 KB sector erase to 0xFF, 256-byte page program that can only clear bits):
+ *  1. CRC-32 check value, empty flash
+ *  2. uploads in random chunk sizes with retransmitted chunks, alternating slots and generations,
+ *     the store rebuilt from flash after each step (reboot)
+ *  3. rejected uploads: wrong CRC, oversize, out-of-order chunk, upload while busy
+ *  4. power loss at every flash operation of an upload: after reboot the previous model or the new
+ *     one is active and intact, never none
+ *
+ * build and run from the repository root:
+ *   g++ -O2 -std=c++17 -I. tools/model_store_test.cpp src/ml/ModelStore.cpp -o model_store_test
+ *   ./model_store_test
+ */
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "src/ml/ModelStore.h"
+
+class FlashEmulator : public ModelFlash
+{
+public:
+    FlashEmulator(uint32_t base, size_t size) : _base(base), _mem(size, 0xFF) {}
+
+    bool erase(uint32_t offset, size_t size) override
+    {
+        if ((offset % MODEL_FLASH_SECTOR) || (size % MODEL_FLASH_SECTOR) || !inside(offset, size))
+        {
+            violations++;
+            return false;
+        }
+        if (cut())
+        {
+            memset(&_mem[offset - _base], 0xFF, size / 2); // torn: part of the sector erased
+            return false;
+        }
+        memset(&_mem[offset - _base], 0xFF, size);
+        erases++;
+        return true;
+    }
+
+    bool program(uint32_t offset, const uint8_t *data, size_t size) override
+    {
+        if ((offset % MODEL_FLASH_PAGE) || (size % MODEL_FLASH_PAGE) || !inside(offset, size))
+        {
+            violations++;
+            return false;
+        }
+        bool torn = cut();
+        size_t n = torn ? size / 2 : size;
+        for (size_t i = 0; i < n; i++)
+        {
+            uint8_t &m = _mem[offset - _base + i];
+            violations += ((data[i] & ~m) != 0); // a 0 bit cannot be programmed back to 1
+            m &= data[i];
+        }
+        programs += !torn;
+        return !torn && !_dead;
+    }
+
+    const uint8_t *map(uint32_t offset) override
+    {
+        return &_mem[offset - _base];
+    }
+
+    // power is lost during the n-th erase/program from now (0 = never), every later operation fails
+    void power_loss_after(int n)
+    {
+        _countdown = n;
+        _dead = false;
+    }
+    void power_on(void)
+    {
+        _countdown = 0;
+        _dead = false;
+    }
+
+    int erases = 0, programs = 0, violations = 0;
+
+private:
+    uint32_t _base;
+    std::vector<uint8_t> _mem;
+    int _countdown = 0;
+    bool _dead = false;
+
+    bool inside(uint32_t offset, size_t size) const
+    {
+        return (offset >= _base) && (offset + size <= _base + _mem.size());
+    }
+    bool cut(void)
+    {
+        if (_dead)
+        {
+            return true;
+        }
+        if (_countdown && (--_countdown == 0))
+        {
+            _dead = true;
+            return true;
+        }
+        return false;
+    }
+};
+
+static std::mt19937 rng(1);
+
+static std::vector<uint8_t> make_model(size_t size)
+{
+    std::vector<uint8_t> m(size);
+    for (auto &b : m)
+    {
+        b = (uint8_t)rng();
+    }
+    return m;
+}
+
+// random chunks of 1 .. 700 bytes, every fifth chunk sent twice (lost acknowledge)
+static ModelStore::Status upload(ModelStore &store, const std::vector<uint8_t> &m, uint32_t crc)
+{
+    auto status = store.begin(m.size(), crc);
+    size_t offset = 0, last = 0;
+    int chunks = 0;
+    while ((status == ModelStore::Ok) && (offset < m.size()))
+    {
+        if ((++chunks % 5) == 0)
+        {
+            status = store.write(last, &m[last], offset - last);
+            continue;
+        }
+        size_t n = std::min<size_t>(1 + rng() % 700, m.size() - offset);
+        status = store.write(offset, &m[offset], n);
+        last = offset;
+        offset += n;
+    }
+    const uint8_t *mapped = nullptr;
+    if (status == ModelStore::Ok)
+    {
+        status = store.verify(&mapped);
+    }
+    if ((status == ModelStore::Ok) && memcmp(mapped, m.data(), m.size()))
+    {
+        status = ModelStore::ErrorFlash;
+    }
+    if (status == ModelStore::Ok)
+    {
+        status = store.commit();
+    }
+    return status;
+}
+
+static bool holds(ModelStore &store, const std::vector<uint8_t> &m)
+{
+    size_t size = 0;
+    const uint8_t *p = store.model(store.active_slot(), &size);
+    return p && (size == m.size()) && !memcmp(p, m.data(), size);
+}
+
+static bool check(bool ok, const char *what)
+{
+    printf("%-56s %s\n", what, ok ? "ok" : "FAILED");
+    return ok;
+}
+
+int main()
+{
+    bool ok = true;
+    FlashEmulator flash(MODEL_STORE_OFFSET, MODEL_SLOT_COUNT * MODEL_SLOT_SIZE);
+
+    ok &= check(ModelStore::crc32(0, (const uint8_t *)"123456789", 9) == 0xCBF43926, "crc32(\"123456789\") = 0xCBF43926");
+
+    ModelStore store(&flash, MODEL_STORE_OFFSET);
+    store.init();
+    ok &= check(store.active_slot() < 0, "erased flash: no active slot");
+
+    // alternating uploads, each followed by a reboot
+    std::vector<uint8_t> models[4] = {make_model(3944), make_model(4096 - MODEL_HEADER_SIZE), make_model(MODEL_MAX_SIZE), make_model(1)};
+    bool alternate = true;
+    for (int i = 0; i < 4; i++)
+    {
+        int erases = flash.erases;
+        auto crc = ModelStore::crc32(0, models[i].data(), models[i].size());
+        alternate &= (upload(store, models[i], crc) == ModelStore::Ok);
+        int sectors = (MODEL_HEADER_SIZE + models[i].size() + MODEL_FLASH_SECTOR - 1) / MODEL_FLASH_SECTOR;
+        alternate &= (flash.erases - erases == sectors); // only the sectors the model needs
+
+        ModelStore reboot(&flash, MODEL_STORE_OFFSET);
+        reboot.init();
+        alternate &= (reboot.active_slot() == (i & 1)) && (reboot.generation() == (uint32_t)i + 1) && holds(reboot, models[i]);
+    }
+    ok &= check(alternate, "4 uploads: slots alternate, generation 1..4, reboot");
+
+    // rejected uploads keep the active model
+    auto active = models[3];
+    auto m = make_model(20000);
+    auto crc = ModelStore::crc32(0, m.data(), m.size());
+    ok &= check(upload(store, m, crc ^ 1) == ModelStore::ErrorCrc && holds(store, active) && !store.busy(), "wrong CRC rejected, active model kept");
+    ok &= check(store.begin(MODEL_MAX_SIZE + 1, 0) == ModelStore::ErrorSize, "model larger than a slot rejected");
+    ok &= check(store.begin(m.size(), crc) == ModelStore::Ok && store.begin(m.size(), crc) == ModelStore::ErrorState, "second begin() while busy rejected");
+    ok &= check(store.write(10, m.data(), 10) == ModelStore::ErrorOffset, "chunk beyond received data rejected");
+    ok &= check(store.write(0, m.data(), m.size() + 1) == ModelStore::ErrorSize, "more data than announced rejected");
+    ok &= check(store.verify(nullptr) == ModelStore::ErrorSize, "verify() before the last chunk rejected");
+    store.abort();
+    {
+        ModelStore reboot(&flash, MODEL_STORE_OFFSET);
+        reboot.init();
+        ok &= check(holds(reboot, active) && (reboot.generation() == 4), "aborted uploads: reboot keeps generation 4");
+    }
+
+    // power loss at each flash operation of an upload
+    int cuts = 0, kept = 0, updated = 0;
+    bool safe = true;
+    for (int n = 1;; n++)
+    {
+        ModelStore before(&flash, MODEL_STORE_OFFSET);
+        before.init();
+        size_t size = 0;
+        const uint8_t *p = before.model(before.active_slot(), &size);
+        std::vector<uint8_t> old(p, p + size);
+        uint32_t generation = before.generation();
+
+        auto next = make_model(9000);
+        flash.power_loss_after(n);
+        auto status = upload(before, next, ModelStore::crc32(0, next.data(), next.size()));
+        flash.power_on();
+
+        ModelStore reboot(&flash, MODEL_STORE_OFFSET);
+        reboot.init();
+        if (status == ModelStore::Ok)
+        {
+            safe &= holds(reboot, next); // no operation left to cut: done
+            break;
+        }
+        cuts++;
+        if (holds(reboot, old) && (reboot.generation() == generation))
+        {
+            kept++;
+        }
+        else if (holds(reboot, next) && (reboot.generation() == generation + 1))
+        {
+            updated++;
+        }
+        else
+        {
+            safe = false;
+        }
+    }
+    printf("power loss at %d flash operations: previous model %d, new model %d\n", cuts, kept, updated);
+    ok &= check(safe && cuts > 0, "power loss: a valid model is always active");
+    ok &= check(flash.violations == 0, "no unaligned or unerased flash writes");
+
+    printf("%s\n", ok ? "passed" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+# Copyright 2026 teamprof.net@gmail.com
+#
+# Upload a .tflite model to the device (see src/util/ModelUpdater.h). The file is sent in chunks by
+# HTTP PUT to the metrics port; after a dropped connection the upload resumes from the byte count the
+# device reports. The device checks the CRC-32, prepares the new interpreter and swaps it in between two
+# audio hops, the running model keeps detecting meanwhile.
+#
+# usage:
+#   python3 tools/model_upload.py 192.168.0.50 model.tflite
+#   python3 tools/model_upload.py 192.168.0.50 model.tflite -p 9100 -c 16384
+import argparse
+import http.client
+import re
+import sys
+import time
+import zlib
+
+
+def request(host, port, method, path, body=None, headers=None, timeout=30):
+    conn = http.client.HTTPConnection(host, port, timeout=timeout)
+    try:
+        conn.request(method, path, body=body, headers=headers or {})
+        response = conn.getresponse()
+        return response.status, response.read().decode(errors="replace").strip()
+    finally:
+        conn.close()
+
+
+def received(host, port):
+    status, text = request(host, port, "GET", "/model")
+    match = re.search(r"received (\d+)", text)
+    return int(match.group(1)) if status == 200 and match else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="model upload")
+    parser.add_argument("host", help="device IP address")
+    parser.add_argument("model", help=".tflite file")
+    parser.add_argument("-p", "--port", type=int, default=9100, help="TCP port (METRICS_PORT)")
+    parser.add_argument("-c", "--chunk", type=int, default=16384, help="bytes per request")
+    parser.add_argument("-r", "--retries", type=int, default=5, help="resume attempts after an error")
+    args = parser.parse_args()
+
+    with open(args.model, "rb") as f:
+        data = f.read()
+    crc = zlib.crc32(data)
+    headers = {"X-Model-Size": str(len(data)), "X-Model-CRC32": "{:08x}".format(crc)}
+    print("{}: {} bytes, crc32 {:08x}".format(args.model, len(data), crc), file=sys.stderr)
+
+    offset, retries = 0, args.retries
+    while True:
+        chunk = data[offset:offset + args.chunk]
+        try:
+            status, text = request(args.host, args.port, "PUT", "/model?offset={}".format(offset), chunk, headers)
+        except OSError as e:
+            status, text = 0, str(e)
+        print("offset {}: {} {}".format(offset, status, text), file=sys.stderr)
+
+        if status == 200 and text.startswith("slot"):
+            return 0  # last chunk: committed, swap pending on the device
+        if status == 200:
+            offset = int(re.search(r"received (\d+)", text).group(1))
+            continue
+        if status in (400, 409, 413, 422) or retries == 0:
+            return 1
+        retries -= 1
+        time.sleep(1)
+        try:
+            offset = received(args.host, args.port)  # resume, 0 restarts the upload
+        except OSError:
+            pass
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,154 @@
+#!/usr/bin/env python3
+# Copyright 2026 teamprof.net@gmail.com
+#
+# Design the FIR stages of the PDM decimator (src/audio/PdmDecimator) and write src/audio/pdm_filters.h.
+# The CIC stage needs no coefficients; the half-band (64 -> 32 kHz) is a Kaiser-windowed sinc and the last
+# stage (32 -> 16 kHz) a frequency-sampled, Kaiser-windowed low-pass that also flattens the CIC droop.
+# The pass-band ripple and the worst alias of the whole chain, from PDM clock down to 16 kHz, are printed
+# for review.
+#
+# usage:
+#   python3 tools/pdm_design.py                       # rewrite src/audio/pdm_filters.h
+#   python3 tools/pdm_design.py -o filters.h
+import argparse
+import math
+import os
+import sys
+
+PDM_RATE = 1024000
+CIC_ORDER = 4
+CIC_DECIMATION = 16
+HALFBAND_TAPS = 19  # 4k - 1
+HALFBAND_BETA = 8.0
+COMP_TAPS = 63
+COMP_BETA = 6.0
+CUTOFF = 8000  # ideal edge of the last stage, the window spreads it over PASSBAND .. STOPBAND
+PASSBAND = 7000  # flat to here at 16 kHz output
+STOPBAND = 9000  # folds onto PASSBAND at 16 kHz
+
+OUTPUT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src", "audio", "pdm_filters.h")
+
+
+def bessel_i0(x):
+    total, term, k = 1.0, 1.0, 1
+    while term > 1e-12 * total:
+        term *= (x / (2 * k)) ** 2
+        total += term
+        k += 1
+    return total
+
+
+def kaiser(n, taps, beta):
+    t = 2 * n / (taps - 1) - 1
+    return bessel_i0(beta * math.sqrt(max(0.0, 1 - t * t))) / bessel_i0(beta)
+
+
+def cic_response(freq):
+    x = math.pi * freq / PDM_RATE
+    if x == 0:
+        return 1.0
+    return abs(math.sin(CIC_DECIMATION * x) / (CIC_DECIMATION * math.sin(x))) ** CIC_ORDER
+
+
+def fir_response(coeffs, freq, rate):
+    # magnitude of Q15 coefficients at freq
+    re = sum(c * math.cos(2 * math.pi * freq * k / rate) for k, c in enumerate(coeffs))
+    im = sum(c * math.sin(2 * math.pi * freq * k / rate) for k, c in enumerate(coeffs))
+    return math.hypot(re, im) / 32768
+
+
+def quantize(h):
+    return [max(-32768, min(32767, round(v * 32768))) for v in h]
+
+
+def design_halfband():
+    center = (HALFBAND_TAPS - 1) // 2
+    h = []
+    for n in range(HALFBAND_TAPS):
+        t = n - center
+        if t == 0:
+            h.append(0.5)
+        elif t % 2 == 0:
+            h.append(0.0)  # exact zeros of a half-band
+        else:
+            h.append(math.sin(math.pi * t / 2) / (math.pi * t) * kaiser(n, HALFBAND_TAPS, HALFBAND_BETA))
+    return quantize(h)
+
+
+def design_compensation(halfband):
+    rate = PDM_RATE / CIC_DECIMATION / 2
+    center = (COMP_TAPS - 1) / 2
+
+    def desired(f):
+        if f > CUTOFF:
+            return 0.0
+        f = min(f, PASSBAND)
+        return 1.0 / (cic_response(f) * fir_response(halfband, f, 2 * rate))
+
+    grid = 4096
+    response = [desired(0.5 * rate * i / grid) for i in range(grid + 1)]
+    h = []
+    for n in range(COMP_TAPS):
+        t = n - center
+        # inverse DTFT of a real, even response by the trapezoidal rule
+        acc = sum((0.5 if i in (0, grid) else 1.0) * response[i] * math.cos(math.pi * i * t / grid) for i in range(grid + 1))
+        h.append(acc / grid * kaiser(n, COMP_TAPS, COMP_BETA))
+    return quantize(h)
+
+
+def fold(freq, rate):
+    freq %= rate
+    return rate - freq if freq > rate / 2 else freq
+
+
+def chain_response(halfband, comp, freq):
+    # gain of a tone at freq (PDM domain) and where it lands at 16 kHz
+    f1 = fold(freq, PDM_RATE / CIC_DECIMATION)
+    f2 = fold(f1, PDM_RATE / CIC_DECIMATION / 2)
+    f3 = fold(f2, PDM_RATE / CIC_DECIMATION / 4)
+    gain = cic_response(freq) * fir_response(halfband, f1, PDM_RATE / CIC_DECIMATION) * \
+        fir_response(comp, f2, PDM_RATE / CIC_DECIMATION / 2)
+    return gain, f3
+
+
+def c_array(name, coeffs):
+    return "static const int16_t {}[{}] = {{\n    {}\n}};".format(name, len(coeffs), ", ".join(str(c) for c in coeffs))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="PDM decimator coefficient generator")
+    parser.add_argument("-o", "--output", default=OUTPUT, help="generated C header")
+    args = parser.parse_args()
+
+    with open(os.path.join(os.path.dirname(OUTPUT), "Agc.h")) as f:
+        license_header = f.read().split("*/")[0] + "*/\n"
+
+    halfband = design_halfband()
+    comp = design_compensation(halfband)
+    assert sum(abs(c) for c in comp) < 65536, "compensation FIR may overflow the int32 accumulator"
+
+    passband = [20 * math.log10(chain_response(halfband, comp, f)[0]) for f in range(50, PASSBAND + 1, 50)]
+    alias = max(20 * math.log10(max(g, 1e-12)) for g, f3 in
+                (chain_response(halfband, comp, f) for f in range(STOPBAND, PDM_RATE // 2, 25)) if f3 <= PASSBAND)
+    print("pass band 50 - {} Hz: {:+.2f} .. {:+.2f} dB".format(PASSBAND, min(passband), max(passband)), file=sys.stderr)
+    print("worst alias into 0 - {} Hz: {:.1f} dB".format(PASSBAND, alias), file=sys.stderr)
+    print("half-band {} taps, compensation {} taps".format(len(halfband), len(comp)), file=sys.stderr)
+
+    with open(args.output, "w") as f:
+        f.write(license_header)
+        f.write("// generated by tools/pdm_design.py, do not edit\n")
+        f.write("// pass band 50 - {} Hz: {:+.2f} .. {:+.2f} dB, worst alias {:.1f} dB\n".format(
+            PASSBAND, min(passband), max(passband), alias))
+        f.write("#pragma once\n#include <stdint.h>\n\n")
+        f.write("#define PDM_HALFBAND_TAPS {}\n#define PDM_COMP_TAPS {}\n\n".format(len(halfband), len(comp)))
+        f.write("// {} -> {} Hz, Q15\n".format(PDM_RATE // CIC_DECIMATION, PDM_RATE // CIC_DECIMATION // 2))
+        f.write(c_array("pdm_halfband", halfband) + "\n\n")
+        f.write("// {} -> {} Hz with CIC droop compensation, Q15\n".format(
+            PDM_RATE // CIC_DECIMATION // 2, PDM_RATE // CIC_DECIMATION // 4))
+        f.write(c_array("pdm_compensation", comp) + "\n")
+    print("written", args.output, file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,176 @@
+#!/usr/bin/env python3
+# Copyright 2026 teamprof.net@gmail.com
+#
+# Derive the spectrogram requantization table (src/ml/Requantizer.h, REQUANT_CALIBRATED) from recorded audio.
+# The FFT magnitudes of PreProcessor are emulated on the recordings, then a companding curve is fitted so that
+# the observed magnitude range covers the whole int8 input of the model:
+#   log:  mu-law like curve between the 1st and the 99.9th percentile
+#   cdf:  piecewise-linear histogram equalization through percentile breakpoints
+# The int8 code usage of the current linear mapping (model input scale / zero point) is reported for comparison.
+# Train the model with requantize() of this module (or the generated table) before switching REQUANT_MODE.
+#
+# usage:
+#   python3 tools/requant_calibrate.py --scale 0.5 --zero-point -128 sound/*.wav
+#   python3 tools/requant_calibrate.py --method cdf -o src/ml/requant_table.h recordings/*.wav
+import argparse
+import cmath
+import math
+import os
+import sys
+import wave
+
+FFT_LEN = 256           # AUDIO_FFT_LEN
+FRAME_STEP = 128        # AUDIO_FRAME_STEP
+SCALE_FACTOR = 64       # PreProcessor.cpp
+MANTISSA_BITS = 7       # REQUANT_MANTISSA_BITS
+LUT_SIZE = (16 - MANTISSA_BITS) << MANTISSA_BITS
+
+OUTPUT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src", "ml", "requant_table.h")
+
+
+def index(mag):
+    shift = max(0, mag.bit_length() - 1 - MANTISSA_BITS)
+    return (shift << MANTISSA_BITS) + (mag >> shift)
+
+
+def bucket(i):
+    if i < (2 << MANTISSA_BITS):
+        return i, 1
+    shift = (i >> MANTISSA_BITS) - 1
+    return (i - (shift << MANTISSA_BITS)) << shift, 1 << shift
+
+
+def fft(x):
+    n = len(x)
+    if n == 1:
+        return x
+    even, odd = fft(x[0::2]), fft(x[1::2])
+    out = [0] * n
+    for k in range(n // 2):
+        t = cmath.exp(-2j * math.pi * k / n) * odd[k]
+        out[k], out[k + n // 2] = even[k] + t, even[k] - t
+    return out
+
+
+def magnitudes(path):
+    # q15 magnitudes as produced by arm_mult_q15 (Hanning) + arm_rfft_q15 (1/N) + arm_cmplx_mag_q15 (2.14)
+    with wave.open(path, "rb") as w:
+        if w.getnchannels() != 1 or w.getsampwidth() != 2:
+            raise ValueError("{}: 16-bit mono WAV required".format(path))
+        raw = w.readframes(w.getnframes())
+    samples = [int.from_bytes(raw[i:i + 2], "little", signed=True) for i in range(0, len(raw), 2)]
+    window = [0.5 * (1 - math.cos(2 * math.pi * i / FFT_LEN)) for i in range(FFT_LEN)]
+    mags = []
+    for start in range(0, len(samples) - FFT_LEN + 1, FRAME_STEP):
+        frame = [samples[start + i] * window[i] / 32768 for i in range(FFT_LEN)]
+        spectrum = fft(frame)
+        for k in range(FFT_LEN // 2 + 1):
+            mags.append(min(32767, int(abs(spectrum[k]) / FFT_LEN * 16384)))
+    return mags
+
+
+def percentile(sorted_values, p):
+    return sorted_values[min(len(sorted_values) - 1, int(p / 100.0 * len(sorted_values)))]
+
+
+def table_linear(scale, zero_point):
+    divider = max(1, int(SCALE_FACTOR * scale))
+    table = []
+    for i in range(LUT_SIZE):
+        low, width = bucket(i)
+        table.append(max(-128, min(127, (low + width // 2) // divider + zero_point)))
+    return table
+
+
+def table_log(mags):
+    # mags: sorted non-zero magnitudes, zero always maps to -128
+    lo = max(1, percentile(mags, 1))
+    hi = max(lo + 1, percentile(mags, 99.9))
+    top = math.log1p(hi / lo)
+    table = []
+    for i in range(LUT_SIZE):
+        low, width = bucket(i)
+        q = -128 + 255 * math.log1p((low + (width - 1) / 2) / lo) / top
+        table.append(max(-128, min(127, int(round(q)))))
+    return table
+
+
+def table_cdf(mags, breakpoints=16):
+    # mags: sorted non-zero magnitudes; breakpoints at equally spaced percentiles, linear in between
+    points = [(0, -128)] + [(percentile(mags, 100.0 * b / breakpoints), -127 + 254 * b / breakpoints)
+                            for b in range(breakpoints + 1)]
+    table = []
+    for i in range(LUT_SIZE):
+        low, width = bucket(i)
+        m = low + (width - 1) / 2
+        q = 127
+        for (m0, q0), (m1, q1) in zip(points, points[1:]):
+            if m <= m1:
+                q = q0 if m1 == m0 else q0 + (q1 - q0) * (m - m0) / (m1 - m0)
+                break
+        table.append(max(-128, min(127, int(round(q)))))
+    return table
+
+
+def usage(table, mags):
+    codes = [0] * 256
+    for m in mags:
+        codes[table[index(m)] + 128] += 1
+    total = float(len(mags))
+    entropy = -sum(c / total * math.log2(c / total) for c in codes if c)
+    return sum(1 for c in codes if c), codes[0] / total, codes[255] / total, entropy
+
+
+def write_header(path, table, method, sources):
+    with open(os.path.join(os.path.dirname(OUTPUT), "..", "audio", "Agc.h")) as f:
+        license_header = f.read().split("*/")[0] + "*/\n"
+    with open(path, "w") as f:
+        f.write(license_header)
+        f.write("// generated by tools/requant_calibrate.py --method {}, do not edit\n".format(method))
+        f.write("// calibrated on: {}\n".format(", ".join(os.path.basename(s) for s in sources)))
+        f.write("#pragma once\n#include <stdint.h>\n#include \"./Requantizer.h\"\n\n")
+        f.write("static const int8_t requant_table[REQUANT_LUT_SIZE] = {\n")
+        for i in range(0, LUT_SIZE, 16):
+            f.write("    " + ", ".join("{:4d}".format(v) for v in table[i:i + 16]) + ",\n")
+        f.write("};\n")
+
+
+def requantize(mag, table):
+    # mapping applied by the device, for the training pipeline
+    return table[index(min(32767, int(mag)))]
+
+
+def main():
+    parser = argparse.ArgumentParser(description="spectrogram requantization table calibration")
+    parser.add_argument("wav", nargs="+", help="16-bit mono recordings at AUDIO_SAMPLING_RATE")
+    parser.add_argument("--scale", type=float, default=1.0, help="model input scale (linear mapping report)")
+    parser.add_argument("--zero-point", type=int, default=-128, help="model input zero point (linear mapping report)")
+    parser.add_argument("--method", choices=["log", "cdf"], default="log")
+    parser.add_argument("-o", "--output", default=OUTPUT, help="generated header")
+    args = parser.parse_args()
+
+    mags = []
+    for path in args.wav:
+        mags += magnitudes(path)
+    mags.sort()
+    nonzero = [m for m in mags if m]
+    if not nonzero:
+        print("no signal in the recordings", file=sys.stderr)
+        return 1
+    print("{} magnitudes, {:.1f}% zero, non-zero percentiles 1/50/99/99.9%: {} {} {} {}".format(
+        len(mags), 100.0 * (len(mags) - len(nonzero)) / len(mags), percentile(nonzero, 1), percentile(nonzero, 50),
+        percentile(nonzero, 99), percentile(nonzero, 99.9)), file=sys.stderr)
+
+    table = table_log(nonzero) if args.method == "log" else table_cdf(nonzero)
+    for name, t in (("linear", table_linear(args.scale, args.zero_point)), (args.method, table)):
+        used, low, high, entropy = usage(t, mags)
+        print("{:>6}: {:3d} int8 codes used, {:5.1f}% at -128, {:5.1f}% at 127, {:.2f} bits/bin".format(
+            name, used, 100 * low, 100 * high, entropy), file=sys.stderr)
+
+    write_header(args.output, table, args.method, args.wav)
+    print("written", args.output, file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
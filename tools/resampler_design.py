@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+# Copyright 2026 teamprof.net@gmail.com
+#
+# Design the polyphase coefficient banks used by src/audio/Resampler and write src/audio/resampler_banks.cpp.
+# Each bank is a Kaiser-windowed sinc low-pass of up * taps coefficients, split into "up" phases of "taps"
+# Q15 coefficients. The stop-band attenuation of every bank is printed for review.
+#
+# usage:
+#   python3 tools/resampler_design.py                 # rewrite src/audio/resampler_banks.cpp
+#   python3 tools/resampler_design.py -o banks.cpp
+import argparse
+import math
+import os
+import sys
+from fractions import Fraction
+
+# (input rate, output rate, taps per phase)
+BANKS = [
+    (48000, 16000, 96),
+    (16000, 8000, 64),
+    (22050, 16000, 32),
+]
+
+PASSBAND = 0.9  # cut-off (-6 dB) relative to the Nyquist frequency of the lower rate
+KAISER_BETA = 7.0  # ~70 dB stop band
+
+OUTPUT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src", "audio", "resampler_banks.cpp")
+
+
+def bessel_i0(x):
+    total, term, k = 1.0, 1.0, 1
+    while term > 1e-12 * total:
+        term *= (x / (2 * k)) ** 2
+        total += term
+        k += 1
+    return total
+
+
+def design(in_rate, out_rate, taps):
+    ratio = Fraction(out_rate, in_rate)
+    up, down = ratio.numerator, ratio.denominator
+    n = up * taps
+    # cut-off in cycles per sample of the up-sampled stream
+    fc = PASSBAND * 0.5 * min(in_rate, out_rate) / (in_rate * up)
+    center = (n - 1) / 2
+    h = []
+    for i in range(n):
+        t = i - center
+        sinc = 2 * fc if t == 0 else math.sin(2 * math.pi * fc * t) / (math.pi * t)
+        w = bessel_i0(KAISER_BETA * math.sqrt(1 - (2 * t / (n - 1)) ** 2)) / bessel_i0(KAISER_BETA)
+        h.append(up * sinc * w)
+
+    # phase p, tap j multiplies x[n - j]: coefficient h[p + up * j]
+    coeffs = [[max(-32768, min(32767, round(h[p + up * j] * 32768))) for j in range(taps)] for p in range(up)]
+    return up, down, coeffs
+
+
+def response_db(coeffs, up, in_rate, freq):
+    # response of the quantized prototype at freq (Hz, in the up-sampled domain), normalized to DC
+    fs = in_rate * up
+    re = im = dc = 0.0
+    for p in range(up):
+        for j, c in enumerate(coeffs[p]):
+            k = p + up * j
+            re += c * math.cos(2 * math.pi * freq * k / fs)
+            im -= c * math.sin(2 * math.pi * freq * k / fs)
+            dc += c
+    return 20 * math.log10(max(math.hypot(re, im), 1e-9) / dc)
+
+
+def c_array(name, up, taps, coeffs):
+    lines = ["static const int16_t {}[{} * {}] = {{".format(name, up, taps)]
+    for p, row in enumerate(coeffs):
+        lines.append("    " + ", ".join(str(c) for c in row) + ", // phase {}".format(p))
+    lines.append("};")
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="polyphase resampler coefficient generator")
+    parser.add_argument("-o", "--output", default=OUTPUT, help="generated C++ file")
+    args = parser.parse_args()
+
+    with open(os.path.join(os.path.dirname(OUTPUT), "Agc.h")) as f:
+        license_header = f.read().split("*/")[0] + "*/\n"
+
+    tables, entries = [], []
+    for in_rate, out_rate, taps in BANKS:
+        up, down, coeffs = design(in_rate, out_rate, taps)
+        name = "_coeffs_{}_{}".format(in_rate, out_rate)
+        tables.append(c_array(name, up, taps, coeffs))
+        entries.append("    {{{}, {}, {}, {}, {}, {}}},".format(in_rate, out_rate, up, down, taps, name))
+
+        nyquist = 0.5 * min(in_rate, out_rate)
+        passband = response_db(coeffs, up, in_rate, 0.75 * nyquist)
+        # worst alias: everything above the output Nyquist folds back into the band
+        stop = max(response_db(coeffs, up, in_rate, f) for f in
+                   [nyquist * (1.1 + 0.05 * i) for i in range(40)] if f < 0.5 * in_rate * up)
+        print("{:>5} -> {:>5} Hz: up {:>3}, down {:>3}, {} taps/phase, {:>5} bytes, "
+              "{:.2f} dB at {:.0f} Hz, <= {:.1f} dB above {:.0f} Hz".format(
+                  in_rate, out_rate, up, down, taps, up * taps * 2, passband, 0.75 * nyquist, stop, 1.1 * nyquist),
+              file=sys.stderr)
+
+    with open(args.output, "w") as f:
+        f.write(license_header)
+        f.write("// generated by tools/resampler_design.py, do not edit\n")
+        f.write('#include "./Resampler.h"\n\n')
+        f.write("\n\n".join(tables))
+        f.write("\n\nconst resampler_bank_t resampler_banks[] = {\n")
+        f.write("\n".join(entries))
+        f.write("\n};\n\nconst size_t resampler_bank_count = sizeof(resampler_banks) / sizeof(resampler_banks[0]);\n")
+    print("written", args.output, file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
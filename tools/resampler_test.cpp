@@ -0,0 +1,108 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Host test of src/audio/Resampler with every bank of src/audio/resampler_banks.cpp
+ * (48 kHz -> 16 kHz, 22.05 kHz -> 16 kHz, 16 kHz -> 8 kHz):
+ *  - SNR of passband sines against the best-fitting ideal sine at the output rate
+ *  - output sample count: max_output() per call, and ceil(inputs * up / down) over a stream fed
+ *    in irregular blocks of at most AUDIO_CAPTURE_FRAME_LEN samples
+ *
+ * build and run from the repository root:
+ *   g++ -O2 -std=c++17 -I. tools/resampler_test.cpp src/audio/Resampler.cpp src/audio/resampler_banks.cpp \
+ *       src/audio/accel.cpp -o resampler_test
+ *   ./resampler_test
+ */
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "src/audio/Resampler.h"
+
+#define MIN_SNR_DB 73.0
+#define INPUT_SECONDS 2
+
+static const size_t blockSizes[] = {AUDIO_CAPTURE_FRAME_LEN, 1, 300, AUDIO_CAPTURE_FRAME_LEN - 1, 64, 2, 441};
+
+// resamples a sine of freq Hz, returns false on a wrong sample count
+static bool run(const resampler_bank_t *bank, double freq, std::vector<int16_t> &out, size_t *inputs)
+{
+    Resampler resampler;
+    resampler.init(bank);
+
+    size_t total = bank->in_rate * INPUT_SECONDS + 7; // the last output falls between input samples
+    int16_t src[AUDIO_CAPTURE_FRAME_LEN];
+    out.clear();
+    size_t n = 0;
+    for (size_t b = 0; n < total; b++)
+    {
+        size_t count = blockSizes[b % (sizeof(blockSizes) / sizeof(blockSizes[0]))];
+        count = (count < total - n) ? count : total - n;
+        for (size_t i = 0; i < count; i++, n++)
+        {
+            src[i] = (int16_t)lround(16000 * sin(2 * M_PI * freq * n / bank->in_rate));
+        }
+        size_t limit = resampler.max_output(count);
+        out.resize(out.size() + limit);
+        size_t written = resampler.process(src, count, &out[out.size() - limit]);
+        if (written > limit)
+        {
+            printf("  %zu samples from a block of %zu, max_output() %zu\n", written, count, limit);
+            return false;
+        }
+        out.resize(out.size() - limit + written);
+    }
+    *inputs = n;
+    return out.size() == (n * bank->up + bank->down - 1) / bank->down;
+}
+
+// least-squares fit of a * sin + b * cos at freq past the filter warm-up, SNR of the fit against the residual
+static double snr_db(const std::vector<int16_t> &out, double freq, double rate, size_t skip)
+{
+    double ss = 0, sc = 0, cc = 0, ys = 0, yc = 0;
+    for (size_t i = skip; i < out.size(); i++)
+    {
+        double s = sin(2 * M_PI * freq * i / rate), c = cos(2 * M_PI * freq * i / rate);
+        ss += s * s;
+        sc += s * c;
+        cc += c * c;
+        ys += out[i] * s;
+        yc += out[i] * c;
+    }
+    double det = ss * cc - sc * sc;
+    double a = (ys * cc - yc * sc) / det, b = (yc * ss - ys * sc) / det;
+    double signal = 0, noise = 0;
+    for (size_t i = skip; i < out.size(); i++)
+    {
+        double fit = a * sin(2 * M_PI * freq * i / rate) + b * cos(2 * M_PI * freq * i / rate);
+        signal += fit * fit;
+        noise += (out[i] - fit) * (out[i] - fit);
+    }
+    return 10 * log10(signal / noise);
+}
+
+int main()
+{
+    int failures = 0;
+    std::vector<int16_t> out;
+
+    printf("bank                taps   tone(Hz)   inputs  outputs  SNR(dB)\n");
+    for (size_t k = 0; k < resampler_bank_count; k++)
+    {
+        const resampler_bank_t *bank = &resampler_banks[k];
+        const double tones[] = {440, 1000, 0.3 * bank->out_rate};
+        for (double freq : tones)
+        {
+            size_t inputs = 0;
+            bool counted = run(bank, freq, out, &inputs);
+            double snr = snr_db(out, freq, bank->out_rate, bank->taps);
+            printf("%5u -> %5u Hz  %4u  %9.0f  %7zu  %7zu  %7.2f%s\n", bank->in_rate, bank->out_rate, bank->taps,
+                   freq, inputs, out.size(), snr, counted ? "" : "  wrong sample count");
+            if (!counted || (snr < MIN_SNR_DB))
+            {
+                failures++;
+            }
+        }
+    }
+
+    printf("\n%s\n", failures ? "FAILED" : "passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,284 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Host test of the 256-point real FFT in src/ml/Rfft256:
+ *  1. bit-exact against a plain C reference of the same fixed-point algorithm (textbook loops,
+ *     explicit digit-reversal reorder, one bin at a time split)
+ *  2. accuracy against a double precision DFT scaled as arm_rfft_q15() (DFT / 256), for noise,
+ *     tones, full-scale worst cases and the frames of a recording
+ *
+ * build and run from the repository root:
+ *   g++ -O2 -std=c++17 -I. tools/rfft256_test.cpp src/ml/Rfft256.cpp -o rfft256_test
+ *   ./rfft256_test sound/alarm-sound.wav
+ */
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "src/ml/Rfft256.h"
+
+#define N RFFT256_LEN
+#define M (N / 2)
+
+struct cint
+{
+    int32_t re, im;
+};
+
+static int16_t q15(double x)
+{
+    long y = lround(x * 32768.0);
+    return (int16_t)((y > 32767) ? 32767 : y);
+}
+
+static cint twiddle(int k) // W256^k
+{
+    return {q15(cos(M_PI * k / M)), q15(-sin(M_PI * k / M))};
+}
+
+static cint rotate(cint y, cint w)
+{
+    return {(int16_t)((y.re * w.re - y.im * w.im) >> 15), (int16_t)((y.re * w.im + y.im * w.re) >> 15)};
+}
+
+// reference: same arithmetic, written for clarity
+static void reference_rfft(const int16_t *src, int16_t *dst)
+{
+    cint z[M];
+    for (int n = 0; n < M; n++)
+    {
+        z[n] = {src[2 * n], src[2 * n + 1]};
+    }
+
+    // radix-4 decimation in frequency, sizes 128, 32, 8
+    int shift = 3;
+    for (int size = M; size >= 8; size /= 4, shift = 2)
+    {
+        int span = size / 4;
+        for (int base = 0; base < M; base += size)
+        {
+            for (int n = 0; n < span; n++)
+            {
+                cint a = z[base + n], b = z[base + n + span], c = z[base + n + 2 * span], d = z[base + n + 3 * span];
+                cint t0 = {a.re + c.re, a.im + c.im}, t1 = {a.re - c.re, a.im - c.im};
+                cint t2 = {b.re + d.re, b.im + d.im}, t3 = {b.re - d.re, b.im - d.im};
+                cint y[4] = {
+                    {(t0.re + t2.re) >> shift, (t0.im + t2.im) >> shift},
+                    {(t1.re + t3.im) >> shift, (t1.im - t3.re) >> shift}, // t1 - j t3
+                    {(t0.re - t2.re) >> shift, (t0.im - t2.im) >> shift},
+                    {(t1.re - t3.im) >> shift, (t1.im + t3.re) >> shift}, // t1 + j t3
+                };
+                for (int q = 0; q < 4; q++)
+                {
+                    z[base + n + q * span] = (n == 0 || q == 0) ? cint{(int16_t)y[q].re, (int16_t)y[q].im}
+                                                                : rotate(y[q], twiddle((N / size) * q * n));
+                }
+            }
+        }
+    }
+    for (int base = 0; base < M; base += 2)
+    {
+        cint a = z[base], b = z[base + 1];
+        z[base] = {(int16_t)((a.re + b.re) >> 1), (int16_t)((a.im + b.im) >> 1)};
+        z[base + 1] = {(int16_t)((a.re - b.re) >> 1), (int16_t)((a.im - b.im) >> 1)};
+    }
+
+    // reorder: bin k is at the position given by its base (4, 4, 4, 2) digits reversed
+    cint Z[M];
+    for (int k = 0; k < M; k++)
+    {
+        int d0 = k % 4, d1 = (k / 4) % 4, d2 = (k / 16) % 4, d3 = k / 64;
+        Z[k] = z[((d0 * 4 + d1) * 4 + d2) * 2 + d3];
+    }
+
+    // real spectrum
+    for (int k = 0; k <= M; k++)
+    {
+        cint x;
+        if (k == 0 || k == M)
+        {
+            x = {(int16_t)(k ? Z[0].re - Z[0].im : Z[0].re + Z[0].im), 0};
+        }
+        else if (k == M / 2)
+        {
+            x = {Z[k].re, (int16_t)-Z[k].im};
+        }
+        else
+        {
+            int j = (k < M / 2) ? k : M - k; // bins above M / 2 are the conjugate half of pair (j, M - j)
+            cint zk = Z[j], zm = Z[M - j], w = twiddle(j);
+            int32_t sr = zk.re + zm.re, si = zk.im - zm.im;
+            int32_t dr = zk.re - zm.re, di = zk.im + zm.im;
+            int32_t hr = (w.re * di + w.im * dr) >> 15, hi = (w.im * di - w.re * dr) >> 15;
+            x = (j == k) ? cint{(int16_t)((sr + hr) >> 1), (int16_t)((si + hi) >> 1)}
+                         : cint{(int16_t)((sr - hr) >> 1), (int16_t)((hi - si) >> 1)};
+        }
+        dst[2 * k] = (int16_t)x.re;
+        dst[2 * k + 1] = (int16_t)x.im;
+    }
+}
+
+static void dft(const int16_t *src, std::complex<double> *dst)
+{
+    for (int k = 0; k <= M; k++)
+    {
+        std::complex<double> acc = 0;
+        for (int n = 0; n < N; n++)
+        {
+            acc += (double)src[n] * std::polar(1.0, -2 * M_PI * k * n / N);
+        }
+        dst[k] = acc / (double)N;
+    }
+}
+
+struct Stats
+{
+    const char *name;
+    size_t frames = 0, mismatches = 0;
+    double signal = 0, noise = 0, max_err = 0;
+
+    void add(const int16_t *x)
+    {
+        int16_t out[2 * RFFT256_BINS], ref[2 * RFFT256_BINS];
+        std::complex<double> exact[RFFT256_BINS];
+        rfft256::transform(x, out);
+        reference_rfft(x, ref);
+        dft(x, exact);
+        frames++;
+        mismatches += (memcmp(out, ref, sizeof(out)) != 0);
+        for (int k = 0; k < RFFT256_BINS; k++)
+        {
+            std::complex<double> e = std::complex<double>(out[2 * k], out[2 * k + 1]) - exact[k];
+            signal += std::norm(exact[k]);
+            noise += std::norm(e);
+            max_err = std::max(max_err, std::abs(e));
+        }
+    }
+
+    bool report(void) const
+    {
+        printf("%-24s %6zu  %9.1f  %12.2f  %s\n", name, frames, 10 * log10(signal / noise), max_err,
+               mismatches ? "NO" : "yes");
+        return mismatches == 0;
+    }
+};
+
+static void hann(int16_t *x)
+{
+    for (int n = 0; n < N; n++)
+    {
+        x[n] = (int16_t)((x[n] * (int32_t)q15(0.5 - 0.5 * cos(2 * M_PI * n / N))) >> 15);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const char *path = (argc > 1) ? argv[1] : "sound/alarm-sound.wav";
+    rfft256::begin();
+    bool ok = true;
+    std::mt19937 rng(1);
+    int16_t x[N];
+
+    printf("input                    frames  SNR (dB)  max err (LSB)  bit-exact\n");
+    for (double level : {1.0, 0.1, 0.01})
+    {
+        static char name[32];
+        Stats s;
+        snprintf(name, sizeof(name), "noise %+.0f dBFS", 20 * log10(level));
+        s.name = name;
+        std::uniform_int_distribution<int> u(-32768, 32767);
+        for (int f = 0; f < 100; f++)
+        {
+            for (int n = 0; n < N; n++)
+            {
+                x[n] = (int16_t)lround(u(rng) * level);
+            }
+            hann(x);
+            s.add(x);
+        }
+        ok &= s.report();
+    }
+    {
+        Stats s;
+        s.name = "tones -1 dBFS";
+        std::uniform_real_distribution<double> freq(0, M_PI), phase(0, 2 * M_PI);
+        for (int f = 0; f < 100; f++)
+        {
+            double w = freq(rng), p = phase(rng);
+            for (int n = 0; n < N; n++)
+            {
+                x[n] = (int16_t)lround(29204 * sin(w * n + p));
+            }
+            hann(x);
+            s.add(x);
+        }
+        ok &= s.report();
+    }
+    {
+        // full-scale worst cases, no window: DC, Nyquist, alternating pairs, random signs
+        Stats s;
+        s.name = "full scale, no window";
+        const int patterns[][4] = {{1, 1, 1, 1}, {-1, -1, -1, -1}, {1, -1, 1, -1}, {1, 1, -1, -1}, {1, -1, -1, 1}};
+        for (auto &p : patterns)
+        {
+            for (int n = 0; n < N; n++)
+            {
+                x[n] = (int16_t)(p[n % 4] * 32767);
+            }
+            s.add(x);
+        }
+        std::bernoulli_distribution sign;
+        for (int f = 0; f < 100; f++)
+        {
+            for (int n = 0; n < N; n++)
+            {
+                x[n] = sign(rng) ? 32767 : -32768;
+            }
+            s.add(x);
+        }
+        ok &= s.report();
+    }
+
+    FILE *f = fopen(path, "rb");
+    if (f)
+    {
+        // 16-bit mono PCM after a 44-byte header, hop AUDIO_FRAME_STEP (128)
+        Stats s;
+        s.name = "recording, Hann window";
+        std::vector<int16_t> pcm;
+        fseek(f, 44, SEEK_SET);
+        int16_t sample;
+        while (fread(&sample, sizeof(sample), 1, f) == 1)
+        {
+            pcm.push_back(sample);
+        }
+        fclose(f);
+        for (size_t start = 0; start + N <= pcm.size() && s.frames < 1000; start += 128)
+        {
+            memcpy(x, &pcm[start], sizeof(x));
+            hann(x);
+            s.add(x);
+        }
+        ok &= s.report();
+    }
+    else
+    {
+        fprintf(stderr, "cannot open %s, recording skipped\n", path);
+    }
+
+    const int repeat = 100000;
+    int16_t out[2 * RFFT256_BINS];
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeat; i++)
+    {
+        x[i & (N - 1)] ^= 1;
+        rfft256::transform(x, out);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    printf("\nhost: %.0f ns per transform\n%s\n",
+           std::chrono::duration<double, std::nano>(t1 - t0).count() / repeat, ok ? "passed" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,403 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Host test of the detection timestamps:
+ *  - SampleClock: DMA blocks with interrupt latency jitter, latency spikes, dropped blocks, the
+ *    time_us_32() wrap, and flash erases holding interrupts off for 45 to 50 ms (alone and 16 in a row),
+ *    which coalesce interrupts and lose blocks; the blocks numbered by the handler (missedBlocks()),
+ *    the sample time and the measured rate error against the true capture clock
+ *  - Sntp on the W5100S emulator (tools/host) against a stand-in server on loopback whose clock runs
+ *    300 ppm fast and crosses the NTP era boundary (2036): first sync, drift compensation, holdover while
+ *    the server is silent, a step of the server clock, kiss-o'-death, a reply with a negative round
+ *    trip followed by a slower route; every reply is preceded by a decoy with a wrong originate timestamp
+ *  - Sntp::format()
+ *
+ * build and run from the repository root:
+ *   g++ -O2 -std=c++17 -I. -Itools/host -DSNTP_POLL_MIN_S=1 -DSNTP_POLL_MAX_S=8 tools/timestamp_test.cpp \
+ *       src/audio/SampleClock.cpp src/util/Sntp.cpp tools/host/W5100sEmulator.cpp tools/host/EventEthernet.cpp \
+ *       src/peripheral/W5100sSpi.cpp src/util/BinLog.cpp -lpthread -o timestamp_test
+ *   ./timestamp_test
+ */
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <EventEthernet.h>
+#include "hardware/timer.h"
+#include "src/audio/SampleClock.h"
+#include "src/util/Sntp.h"
+
+#define CAPTURE_ERROR_PPM 40    // true capture rate against AUDIO_CAPTURE_RATE
+#define SERVER_SKEW_PPB 300000  // server clock against the local clock
+#define NTP_ERA1 2085978496ull  // Unix time of the NTP era boundary, 2036-02-07T06:28:16Z
+
+static int failures = 0;
+
+#define CHECK(cond, ...)                \
+    do                                  \
+    {                                   \
+        if (!(cond))                    \
+        {                               \
+            printf("FAIL %s: ", #cond); \
+            printf(__VA_ARGS__);        \
+            printf("\n");               \
+            failures++;                 \
+        }                               \
+    } while (0)
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// SampleClock
+////////////////////////////////////////////////////////////////////////////////////////////
+static void test_sample_clock(void)
+{
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> jitter(3, 40);          // interrupt latency, us
+    std::uniform_int_distribution<int> spike(2000, 15000);     // higher priority interrupt, us
+    std::uniform_int_distribution<int> erase(45000, 50000);    // flash sector erase with interrupts off, us
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    SampleClock clock;
+    const uint32_t blockUs = (uint32_t)(AUDIO_CAPTURE_FRAME_LEN * 1000000ull / AUDIO_CAPTURE_RATE); // as ThreadAudio
+    const double period = 1e6 / (AUDIO_CAPTURE_RATE * (1.0 + CAPTURE_ERROR_PPM * 1e-6)); // true, us
+    const uint64_t origin = 0xFFFFFFFFull - 5000000;                                       // wraps after 5 s
+    const uint32_t blocks = 8 * SAMPLE_CLOCK_WINDOW / AUDIO_CAPTURE_FRAME_LEN;
+    double worst = 0, worstFrame = 0;
+    int measured = 0, lost = 0, miscounted = 0;
+
+    // DMA interrupt served for the block completing at complete: interrupts held off until offUntil coalesce,
+    // the handler then serves the newest completed block (the DMA ring has overwritten the others)
+    double offUntil = 0;
+    uint64_t lastServed = origin;
+    uint32_t lastIndex = 1, sequence = 0;
+    for (uint32_t block = 0; block < blocks; block++)
+    {
+        double complete = origin + SampleClock::samples(block) * period;
+        double next = complete + AUDIO_CAPTURE_FRAME_LEN * period;
+        if ((offUntil <= complete) && (percent(rng) == 0))
+        {
+            offUntil = complete + percent(rng) * period * AUDIO_CAPTURE_FRAME_LEN / 100 + erase(rng);
+            if (block % 1000 == 500)
+            {
+                // a slot upload: 16 sector erases, 5 ms apart
+                offUntil += 15 * (50000 + 5000);
+            }
+        }
+        double served = complete + ((percent(rng) == 0) ? spike(rng) : jitter(rng));
+        if (offUntil > complete)
+        {
+            served = offUntil + jitter(rng);
+        }
+        if (served > next)
+        {
+            lost++; // overwritten before the handler ran
+            continue;
+        }
+
+        // handler: numbers the overwritten blocks, then takes this one
+        uint64_t now = (uint64_t)served;
+        uint32_t numbered = sequence + SampleClock::missedBlocks((uint32_t)(now - lastServed), blockUs, (block & 1) == lastIndex);
+        lastServed = now;
+        lastIndex = block & 1;
+        miscounted += (numbered != block);
+        sequence = numbered + 1;
+        if (percent(rng) < 3)
+        {
+            continue; // dropped by the DMA handler, the pool is full
+        }
+        measured += clock.update(numbered, (uint32_t)now);
+
+        // after the first measured window: block ends, and a frame ending 100 samples before the block
+        if (measured >= 1)
+        {
+            uint64_t count = SampleClock::samples(numbered);
+            worst = std::max(worst, std::fabs((double)clock.micros(count) - complete));
+            double frame = origin + (count - 100) * period;
+            worstFrame = std::max(worstFrame, std::fabs((double)clock.micros(count - 100) - frame));
+        }
+    }
+    printf("sample clock: %d rate measurements, error %d ppm (true %d), worst sample time error %.1f us\n",
+           measured, clock.errorPpm(), CAPTURE_ERROR_PPM, std::max(worst, worstFrame));
+    printf("  %d blocks lost to interrupts held off, %d miscounted by the handler\n", lost, miscounted);
+    CHECK(lost > 16, "%d blocks lost", lost);
+    CHECK(miscounted == 0, "%d blocks miscounted", miscounted);
+    CHECK(measured >= 4, "rate measured %d times", measured);
+    CHECK(std::abs(clock.errorPpm() - CAPTURE_ERROR_PPM) <= 1, "rate error %d ppm", clock.errorPpm());
+    CHECK(worst < 50, "block end within %.1f us", worst);
+    CHECK(worstFrame < 50, "frame end within %.1f us", worstFrame);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// stand-in SNTP server: time = base + local time * (1 + skew) + step; a decoy with a wrong originate
+// timestamp, then the reply with a processing delay between receive and transmit timestamps
+////////////////////////////////////////////////////////////////////////////////////////////
+class NtpServer
+{
+public:
+    std::atomic<bool> enabled{true};
+    std::atomic<bool> kissOfDeath{false};
+    std::atomic<int64_t> step{0};
+    std::atomic<int64_t> claimUs{0}; // processing time claimed beyond the real one: negative round trip
+    std::atomic<int64_t> routeUs{0}; // added to the return path
+    std::atomic<int> requests{0};
+
+    NtpServer(uint16_t port, uint64_t base) : _base(base), _stop(false)
+    {
+        _fd = socket(AF_INET, SOCK_DGRAM, 0);
+        sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = htons(port);
+        bind(_fd, (sockaddr *)&addr, sizeof(addr));
+        _thread = std::thread(&NtpServer::run, this);
+    }
+    ~NtpServer()
+    {
+        _stop = true;
+        _thread.join();
+        close(_fd);
+    }
+
+    // Unix time of the server in microseconds at the local time_us_64()
+    uint64_t utc(uint64_t localUs) const
+    {
+        return _base + localUs + (int64_t)localUs * SERVER_SKEW_PPB / 1000000000 + step;
+    }
+
+private:
+    int _fd;
+    uint64_t _base;
+    std::atomic<bool> _stop;
+    std::thread _thread;
+
+    static void put(uint8_t *p, uint64_t unixUs)
+    {
+        uint64_t seconds = unixUs / 1000000 + 2208988800ull; // era 1 wraps in the 32-bit field
+        uint32_t fraction = (uint32_t)(((unixUs % 1000000) << 32) / 1000000);
+        for (int i = 0; i < 4; i++)
+        {
+            p[i] = (uint8_t)(seconds >> (24 - 8 * i));
+            p[4 + i] = (uint8_t)(fraction >> (24 - 8 * i));
+        }
+    }
+
+    void run(void)
+    {
+        while (!_stop)
+        {
+            pollfd pfd = {_fd, POLLIN, 0};
+            if (poll(&pfd, 1, 10) <= 0)
+            {
+                continue;
+            }
+            uint8_t msg[48];
+            sockaddr_in from;
+            socklen_t fromLen = sizeof(from);
+            ssize_t len = recvfrom(_fd, msg, sizeof(msg), 0, (sockaddr *)&from, &fromLen);
+            uint64_t received = utc(time_us_64());
+            if ((len < 48) || !enabled)
+            {
+                continue;
+            }
+            requests++;
+
+            uint8_t reply[48] = {0};
+            reply[0] = (0 << 6) | (4 << 3) | 4; // no leap, version 4, server
+            reply[1] = kissOfDeath ? 0 : 2;
+            memcpy(&reply[24], &msg[40], 8);    // originate = client transmit
+            put(&reply[32], received);
+
+            uint8_t decoy[48];
+            memcpy(decoy, reply, sizeof(decoy));
+            decoy[31] ^= 0x55;
+            put(&decoy[40], received);
+            sendto(_fd, decoy, sizeof(decoy), 0, (sockaddr *)&from, fromLen);
+
+            std::this_thread::sleep_for(std::chrono::microseconds(2000)); // processing time
+            put(&reply[40], utc(time_us_64()) + claimUs);
+            std::this_thread::sleep_for(std::chrono::microseconds(routeUs.load()));
+            sendto(_fd, reply, sizeof(reply), 0, (sockaddr *)&from, fromLen);
+        }
+    }
+};
+
+static uint16_t free_udp_port(void)
+{
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t len = sizeof(addr);
+    bind(fd, (sockaddr *)&addr, len);
+    getsockname(fd, (sockaddr *)&addr, &len);
+    close(fd);
+    return ntohs(addr.sin_port);
+}
+
+// ThreadNet: update() every second, and every few tens of microseconds while a reply is awaited so the
+// receive time does not limit the test (ThreadNet uses SNTP_WAIT_MS)
+static bool run(uint32_t timeout, std::function<bool(void)> done)
+{
+    auto sntp = Sntp::getInstance();
+    uint32_t start = millis();
+    uint32_t nextPoll = start;
+    while ((int32_t)(millis() - start) < (int32_t)timeout)
+    {
+        if (done())
+        {
+            return true;
+        }
+        if (sntp->waiting() || ((int32_t)(millis() - nextPoll) >= 0))
+        {
+            nextPoll = millis() + 1000;
+            sntp->update();
+        }
+        // short sleeps while waiting: the server thread runs at once, even on a single core
+        std::this_thread::sleep_for(std::chrono::microseconds(sntp->waiting() ? 20 : 1000));
+    }
+    return done();
+}
+
+static int64_t clock_error(const NtpServer &server)
+{
+    uint64_t now = time_us_64();
+    return (int64_t)(Sntp::getInstance()->utc(now) - server.utc(now));
+}
+
+static void test_sntp(void)
+{
+    W5100sEmulator *emu = W5100sEmulator::getInstance();
+    auto sntp = Sntp::getInstance();
+    uint16_t serverPort = free_udp_port();
+    emu->mapPort(SNTP_PORT, serverPort);
+    emu->mapPort(SNTP_LOCAL_PORT, free_udp_port());
+    emu->mapHost(SNTP_SERVER, htonl(0x7F000001));
+
+    // the server crosses the NTP era boundary 4 s into the test
+    NtpServer server(serverPort, (NTP_ERA1 - 4) * 1000000 - time_us_64());
+
+    uint8_t mac[] = {0x00, 0xAA, 0xBB, 0xCC, 0xDE, 0x02};
+    Ethernet.init(17, 21);
+    CHECK(Ethernet.begin(mac, 0, 0, 0, nullptr), "begin()");
+
+    // first sync
+    CHECK(run(2000, [&]()
+              { return sntp->synced(); }),
+          "synced");
+    // a single sample is off by at most half its round trip (all of the delay on one path)
+    const Sntp::Stats &stats = sntp->stats();
+    printf("first sync: error %lld us, delay %u us\n", (long long)clock_error(server), stats.delayUs);
+    CHECK(std::llabs(clock_error(server)) <= stats.delayUs / 2 + 100, "first sync error %lld us, delay %u us",
+          (long long)clock_error(server), stats.delayUs);
+
+    // polls after 1, 2, 4, 8 s: the drift estimate converges on the server skew
+    run(20000, [&]()
+        { return stats.syncs >= 5; });
+    printf("after %u samples: error %lld us, drift %d ppb (true %d), last correction %d us, delay %u us\n",
+           stats.syncs, (long long)clock_error(server), stats.driftPpb, SERVER_SKEW_PPB, stats.errorUs, stats.delayUs);
+    CHECK(stats.syncs >= 5, "samples %u", stats.syncs);
+    CHECK(std::abs(stats.driftPpb - SERVER_SKEW_PPB) < 20000, "drift %d ppb", stats.driftPpb);
+    CHECK(std::llabs(clock_error(server)) < 200, "error %lld us", (long long)clock_error(server));
+    CHECK(stats.failures == 0, "no failure, %u", stats.failures);
+    CHECK(stats.steps == 0, "no step, %u", stats.steps);
+
+    // holdover: 10 s without answer, 3 ms of skew without drift compensation
+    server.enabled = false;
+    run(10000, []()
+        { return false; });
+    printf("holdover 10 s: error %lld us, %u failed polls\n", (long long)clock_error(server), stats.failures);
+    CHECK(stats.failures >= 1, "failures %u", stats.failures);
+    CHECK(std::llabs(clock_error(server)) < 400, "holdover error %lld us", (long long)clock_error(server));
+
+    // the server clock steps by 2 s
+    server.step = 2000000;
+    server.enabled = true;
+    uint32_t syncs = stats.syncs;
+    CHECK(run(SNTP_POLL_MIN_S * 1000 + 2000, [&]()
+              { return stats.syncs > syncs; }),
+          "sync after the step");
+    CHECK(stats.steps == 1, "steps %u", stats.steps);
+    CHECK(std::llabs(clock_error(server)) <= stats.delayUs / 2 + 100, "error after the step %lld us, delay %u us",
+          (long long)clock_error(server), stats.delayUs);
+
+    // kiss-o'-death: a failure, no sample
+    server.kissOfDeath = true;
+    syncs = stats.syncs;
+    uint32_t failed = stats.failures;
+    sntp->abort(); // poll now
+    run(2000, [&]()
+        { return stats.failures > failed; });
+    CHECK((stats.failures == failed + 1) && (stats.syncs == syncs), "kiss-o'-death: failures %u, syncs %u",
+          stats.failures - failed, stats.syncs - syncs);
+
+    // a reply claiming 5 ms more processing than it took: negative round trip, taken as 0
+    server.kissOfDeath = false;
+    server.claimUs = 5000;
+    syncs = stats.syncs;
+    sntp->abort();
+    run(2000, [&]()
+        { return stats.syncs > syncs; });
+    CHECK((stats.syncs == syncs + 1) && (stats.delayUs == 0), "negative round trip: syncs %u, delay %u us",
+          stats.syncs - syncs, stats.delayUs);
+
+    // then 3 ms more on the return path: skipped as a spike at first, accepted after the best doubled
+    server.claimUs = 0;
+    server.routeUs = 3000;
+    syncs = stats.syncs;
+    failed = stats.failures;
+    sntp->abort();
+    CHECK(run(SNTP_POLL_MIN_S * 3000 + 2000, [&]()
+              { return stats.syncs > syncs; }),
+          "sync on the slower route, %u failed polls", stats.failures - failed);
+    printf("slower route: delay %u us after %u skipped replies, error %lld us\n", stats.delayUs,
+           stats.failures - failed, (long long)clock_error(server));
+    CHECK(std::llabs(clock_error(server)) <= stats.delayUs / 2 + 100, "error on the slower route %lld us, delay %u us",
+          (long long)clock_error(server), stats.delayUs);
+
+    char text[32];
+    Sntp::format(text, sizeof(text), sntp->utc(time_us_64()));
+    printf("%u requests, now %s\n", server.requests.load(), text);
+}
+
+static void test_format(void)
+{
+    static const struct
+    {
+        uint64_t us;
+        const char *text;
+    } cases[] = {
+        {0, "1970-01-01T00:00:00.000Z"},
+        {951782400123456ull, "2000-02-29T00:00:00.123Z"},
+        {1792413296789000ull, "2026-10-19T12:34:56.789Z"},
+        {NTP_ERA1 * 1000000, "2036-02-07T06:28:16.000Z"},
+        {4107542399999999ull, "2100-02-28T23:59:59.999Z"},
+    };
+    for (auto c : cases)
+    {
+        char text[32];
+        size_t len = Sntp::format(text, sizeof(text), c.us);
+        CHECK(!strcmp(text, c.text) && (len == strlen(c.text)), "format %s, expected %s", text, c.text);
+    }
+    char small[8];
+    CHECK(Sntp::format(small, sizeof(small), 0) == sizeof(small) - 1, "truncated");
+}
+
+int main(void)
+{
+    test_sample_clock();
+    test_format();
+    test_sntp();
+
+    printf(failures ? "FAILED\n" : "passed\n");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,515 @@
+/* Copyright 2026 teamprof.net@gmail.com
+ *
+ * Host test of the networking code on the W5100S emulator (tools/host):
+ *  - register model: VERR, PHYSR link, buffer sizes, IMR / IR2 / SLIR masking and the INTn service
+ *    routine delivering CONFLICT, WOL and PING to the Ethernet.begin() callback as ThreadNet gets them
+ *  - the 4 socket limit: a fifth connection fails
+ *  - Callmebot end to end against a loopback HTTP server (port 80 mapped), including the socket events
+ *    it logs through BinLog, and the connect failure path
+ *  - TCP throughput to a sink, request / response latency against an echo server, UDP round trip,
+ *    each with the SPI traffic it costs: frames and bus bytes per payload byte and the bus time at
+ *    the 14 MHz SPI clock of the Ethernet library; TCP once through the library and once through the
+ *    W5100sSpi burst transport (gather sends across the TX ring wrap, checked byte by byte)
+ *
+ * build and run from the repository root:
+ *   g++ -O2 -std=c++17 -I. -Itools/host tools/w5100s_emu_test.cpp tools/host/W5100sEmulator.cpp \
+ *       tools/host/EventEthernet.cpp src/peripheral/W5100sSpi.cpp src/util/Callmebot.cpp src/util/BinLog.cpp \
+ *       -lpthread -o w5100s_emu_test
+ *   ./w5100s_emu_test [--json net.json]
+ */
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <EventEthernet.h>
+#include "src/util/BinLog.h"
+#include "src/peripheral/W5100sSpi.h"
+#include "src/util/Callmebot.h"
+
+#define SPI_CLOCK_HZ 14000000.0 // SPI clock of the Ethernet library for the W5100S
+#define SINK_BYTES (1024 * 1024)
+#define ECHO_ROUNDS 1000
+#define ECHO_SIZE 64
+
+static int failures = 0;
+
+#define CHECK(cond, ...)                \
+    do                                  \
+    {                                   \
+        if (!(cond))                    \
+        {                               \
+            printf("FAIL %s: ", #cond); \
+            printf(__VA_ARGS__);        \
+            printf("\n");               \
+            failures++;                 \
+        }                               \
+    } while (0)
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// loopback peers
+////////////////////////////////////////////////////////////////////////////////////////////
+static int host_listen(int type, uint16_t *port)
+{
+    int fd = socket(AF_INET, type, 0);
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t len = sizeof(addr);
+    bind(fd, (sockaddr *)&addr, len);
+    if (type == SOCK_STREAM)
+    {
+        listen(fd, 8);
+    }
+    getsockname(fd, (sockaddr *)&addr, &len);
+    *port = ntohs(addr.sin_port);
+    return fd;
+}
+
+// one HTTP exchange: keeps the request, answers with status, closes
+static void http_server(int fd, int status, std::string *request)
+{
+    int c = accept(fd, nullptr, nullptr);
+    char buf[1024];
+    while (request->find("\r\n\r\n") == std::string::npos)
+    {
+        ssize_t n = recv(c, buf, sizeof(buf), 0);
+        if (n <= 0)
+        {
+            break;
+        }
+        request->append(buf, n);
+    }
+    char response[128];
+    int len = snprintf(response, sizeof(response), "HTTP/1.1 %d OK\r\nContent-Length: 2\r\nConnection: close\r\n\r\nOK", status);
+    send(c, response, len, MSG_NOSIGNAL);
+    close(c);
+}
+
+static uint8_t pattern(size_t i)
+{
+    return (uint8_t)(i * 31 + (i >> 11)); // no period of a TX buffer size
+}
+
+// counts the bytes, and the first one out of pattern()
+static void sink_server(int fd, size_t *received, size_t *mismatch)
+{
+    int c = accept(fd, nullptr, nullptr);
+    uint8_t buf[8192];
+    ssize_t n;
+    *mismatch = SIZE_MAX;
+    while ((n = recv(c, buf, sizeof(buf), 0)) > 0)
+    {
+        for (ssize_t k = 0; k < n; k++)
+        {
+            if ((buf[k] != pattern(*received + k)) && (*mismatch == SIZE_MAX))
+            {
+                *mismatch = *received + k;
+            }
+        }
+        *received += n;
+    }
+    close(c);
+}
+
+static void echo_server(int fd)
+{
+    int c = accept(fd, nullptr, nullptr);
+    char buf[2048];
+    ssize_t n;
+    while ((n = recv(c, buf, sizeof(buf), 0)) > 0)
+    {
+        send(c, buf, n, MSG_NOSIGNAL);
+    }
+    close(c);
+}
+
+static void udp_echo(int fd, int count)
+{
+    char buf[2048];
+    for (int i = 0; i < count; i++)
+    {
+        sockaddr_in peer;
+        socklen_t len = sizeof(peer);
+        ssize_t n = recvfrom(fd, buf, sizeof(buf), 0, (sockaddr *)&peer, &len);
+        if (n >= 0)
+        {
+            sendto(fd, buf, n, 0, (sockaddr *)&peer, len);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+// ThreadNet's INTn handler, delivered by Ethernet.poll()
+static struct
+{
+    int count;
+    uint8_t ir, ir2, slir;
+} ethEvents;
+
+static void onEthernetEvent(uint8_t ir, uint8_t ir2, uint8_t slir)
+{
+    ethEvents.count++;
+    ethEvents.ir |= ir;
+    ethEvents.ir2 |= ir2;
+    ethEvents.slir |= slir;
+}
+
+static Callmebot::MessageState botState = Callmebot::Unknown;
+static void onBotState(Callmebot::MessageState state)
+{
+    botState = state;
+}
+
+// runs Callmebot as ThreadNet does: INTn serviced on demand, update() on its timer
+static void run_bot(Callmebot &bot)
+{
+    for (int i = 0; (i < 200) && (botState == Callmebot::Sending); i++)
+    {
+        Ethernet.poll();
+        bot.update();
+        delay(2);
+    }
+    Ethernet.poll();
+}
+
+static std::vector<uint32_t> binlog_sn_ir(void)
+{
+    std::vector<uint32_t> events;
+    BinLog::Record record;
+    while (BinLog::getInstance()->read(&record))
+    {
+        if (record.id == BL_TCP_IR)
+        {
+            events.push_back(record.args[0]);
+        }
+    }
+    return events;
+}
+
+typedef struct
+{
+    const char *name;
+    double payload; // bytes moved
+    double seconds;
+    W5100sEmulator::SpiStats spi;
+} Result;
+
+// SINK_BYTES to a sink: library writes of one TX buffer, or W5100sSpi gather sends of odd sized pieces
+static Result run_sink(const char *name, bool burst)
+{
+    W5100sEmulator *emu = W5100sEmulator::getInstance();
+    uint16_t port;
+    int fd = host_listen(SOCK_STREAM, &port);
+    size_t received = 0, mismatch = SIZE_MAX;
+    std::thread server(sink_server, fd, &received, &mismatch);
+    EthernetClient client;
+    CHECK(client.connect(IPAddress(127, 0, 0, 1), port), "%s connect", name);
+    std::vector<uint8_t> data(SINK_BYTES);
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = pattern(i);
+    }
+
+    emu->clearStats();
+    uint32_t start = micros();
+    size_t sent = 0;
+    while (sent < SINK_BYTES)
+    {
+        size_t n;
+        if (burst)
+        {
+            const uint8_t *ptr[3] = {&data[sent], &data[sent + 1], &data[sent + 4]};
+            uint32_t len[3] = {1, 3, (uint32_t)std::min<size_t>(3000, SINK_BYTES - sent - 4)};
+            n = W5100sSpi::getInstance()->send(client.getSocketNumber(), ptr, len, 3);
+        }
+        else
+        {
+            n = client.write(&data[sent], std::min<size_t>(2048, SINK_BYTES - sent));
+        }
+        if (!n)
+        {
+            break;
+        }
+        sent += n;
+    }
+    client.stop();
+    server.join();
+    close(fd);
+    CHECK(received == SINK_BYTES, "%s: sink received %zu bytes", name, received);
+    CHECK(mismatch == SIZE_MAX, "%s: byte %zu differs", name, mismatch);
+    return {name, (double)sent, (micros() - start) * 1e-6, emu->spiStats()};
+}
+
+// request / response rounds: library write() and read(), or W5100sSpi send() and library read()
+static Result run_echo(const char *name, bool burst)
+{
+    W5100sEmulator *emu = W5100sEmulator::getInstance();
+    W5100sSpi *spi = W5100sSpi::getInstance();
+    uint16_t port;
+    int fd = host_listen(SOCK_STREAM, &port);
+    std::thread server(echo_server, fd);
+    EthernetClient client;
+    CHECK(client.connect(IPAddress(127, 0, 0, 1), port), "%s connect", name);
+    uint8_t sn = client.getSocketNumber();
+    uint8_t out[ECHO_SIZE], in[ECHO_SIZE];
+    std::vector<uint32_t> rtt;
+
+    emu->clearStats();
+    uint32_t start = micros();
+    for (int i = 0; i < ECHO_ROUNDS; i++)
+    {
+        memset(out, i, sizeof(out));
+        uint32_t t0 = micros();
+        if (burst)
+        {
+            spi->send(sn, out, sizeof(out));
+        }
+        else
+        {
+            client.write(out, sizeof(out));
+        }
+        int got = 0;
+        while (got < ECHO_SIZE)
+        {
+            int n = client.read(in + got, ECHO_SIZE - got);
+            if (n > 0)
+            {
+                got += n;
+            }
+        }
+        rtt.push_back(micros() - t0);
+        if (memcmp(in, out, sizeof(in)))
+        {
+            CHECK(false, "%s round %d", name, i);
+            break;
+        }
+    }
+    Result result = {name, 2.0 * ECHO_ROUNDS * ECHO_SIZE, (micros() - start) * 1e-6, emu->spiStats()};
+    client.stop();
+    server.join();
+    close(fd);
+    std::sort(rtt.begin(), rtt.end());
+    printf("%s %d B: median %u us, p99 %u us, %.0f SPI frames per round trip\n", name, ECHO_SIZE, rtt[rtt.size() / 2],
+           rtt[rtt.size() * 99 / 100], (double)result.spi.frames / ECHO_ROUNDS);
+    return result;
+}
+
+static void print_result(const Result &r)
+{
+    double busSeconds = r.spi.bytes * 8 / SPI_CLOCK_HZ;
+    printf("%-14s %9.0f B %8.1f ms %9llu frames %6.2f frames/B %6.2f bus B/B  SPI %7.1f ms  SPI bound %6.1f KB/s\n",
+           r.name, r.payload, r.seconds * 1e3, (unsigned long long)r.spi.frames, r.spi.frames / r.payload,
+           r.spi.bytes / r.payload, busSeconds * 1e3, r.payload / busSeconds / 1024);
+}
+
+int main(int argc, char **argv)
+{
+    const char *json = nullptr;
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--json") && (i + 1 < argc))
+        {
+            json = argv[++i];
+        }
+    }
+
+    W5100sEmulator *emu = W5100sEmulator::getInstance();
+    uint8_t mac[] = {0xDE, 0xAD, 0xBE, 0xEF, 0xFE, 0xED};
+
+    // link down: begin() fails like a DHCP timeout
+    emu->setLink(false);
+    CHECK(!Ethernet.begin(mac, 0, 0, 0, onEthernetEvent), "begin() with link down");
+    emu->setLink(true);
+
+    // register model
+    uint8_t ir = IR::CONFLICT | IR::UNREACH;
+    CHECK(Ethernet.begin(mac, ir, IR2::WOL, SLIR::PING | SLIR::TIMEOUT, onEthernetEvent), "begin()");
+    CHECK(W5100sSpi::getInstance()->begin(), "W5100sSpi::begin()");
+    CHECK(Ethernet.hardwareStatus() == EthernetW5100S, "hardwareStatus");
+    CHECK(Ethernet.linkStatus() == LinkON, "linkStatus");
+    CHECK(Ethernet.localIP() == IPAddress(127, 0, 0, 1), "localIP");
+    uint8_t shar[6];
+    W5100.read(W5100S_SHAR, shar, 6);
+    CHECK(!memcmp(shar, mac, 6), "SHAR");
+    int txTotal = 0, rxTotal = 0;
+    for (int sn = 0; sn < MAX_SOCK_NUM; sn++)
+    {
+        txTotal += W5100.readSn8(sn, W5100S_SN_TXBUF_SIZE);
+        rxTotal += W5100.readSn8(sn, W5100S_SN_RXBUF_SIZE);
+        CHECK(W5100.readSnSR(sn) == SnSR::CLOSED, "socket %d closed after reset", sn);
+        CHECK(W5100.readSn16(sn, W5100S_SN_TX_FSR) == 2048, "socket %d TX_FSR", sn);
+    }
+    CHECK((txTotal == 8) && (rxTotal == 8), "8 KB TX and RX memory, got %d / %d", txTotal, rxTotal);
+
+    // common interrupts: enabled ones reach the callback once, masked ones keep INTn high
+    emu->raise(IR::CONFLICT | IR::PPPTERM, IR2::WOL, SLIR::PING | SLIR::ARP);
+    CHECK(Ethernet.poll(), "INTn asserted");
+    CHECK((ethEvents.count == 1) && (ethEvents.ir == IR::CONFLICT) && (ethEvents.ir2 == IR2::WOL) &&
+              (ethEvents.slir == SLIR::PING),
+          "callback count=%d ir=0x%x ir2=0x%x slir=0x%x", ethEvents.count, ethEvents.ir, ethEvents.ir2, ethEvents.slir);
+    CHECK(!Ethernet.poll(), "INTn released after the interrupts are cleared");
+    CHECK(W5100.read8(W5100S_IR) & IR::PPPTERM, "masked IR bit stays pending");
+    W5100.write8(W5100S_IR, IR::PPPTERM);
+    W5100.write8(W5100S_SLIR, SLIR::ARP);
+
+    // 4 sockets: a fifth connection fails
+    {
+        uint16_t port;
+        int fd = host_listen(SOCK_STREAM, &port);
+        EthernetClient clients[MAX_SOCK_NUM + 1];
+        int connected = 0;
+        for (auto &client : clients)
+        {
+            connected += client.connect(IPAddress(127, 0, 0, 1), port);
+        }
+        CHECK(connected == MAX_SOCK_NUM, "%d connections", connected);
+        CHECK(!clients[MAX_SOCK_NUM], "fifth client has no socket");
+        close(fd); // resets the connections nobody accepted
+        for (auto &client : clients)
+        {
+            client.stop();
+        }
+        for (int sn = 0; sn < MAX_SOCK_NUM; sn++)
+        {
+            CHECK(W5100.readSnSR(sn) == SnSR::CLOSED, "socket %d closed", sn);
+        }
+    }
+    binlog_sn_ir(); // drop older records
+
+    // Callmebot: success
+    {
+        uint16_t port;
+        int fd = host_listen(SOCK_STREAM, &port);
+        emu->mapPort(CALLMEBOT_PORT, port);
+        std::string request;
+        std::thread server(http_server, fd, 200, &request);
+
+        Callmebot bot(onBotState);
+        botState = Callmebot::Unknown;
+        bot.send("alarm detected");
+        CHECK(botState == Callmebot::Sending, "Callmebot sending");
+        run_bot(bot);
+        server.join();
+        close(fd);
+        CHECK(botState == Callmebot::SentSuccess, "Callmebot state %d", botState);
+
+        std::string expected = std::string("GET " CALLMEBOT_PATH "alarm%20detected HTTP/1.1\r\nHost: " CALLMEBOT_HOST "\r\n") +
+                               "Connection: close\r\n\r\n";
+        CHECK(request == expected, "request:\n%s", request.c_str());
+
+        uint32_t events = 0;
+        for (uint32_t sn_ir : binlog_sn_ir())
+        {
+            events |= sn_ir;
+        }
+        // SEND_OK is consumed by socketSend() waiting for it, as on the board
+        uint32_t expectedEvents = SnIR::CON | SnIR::RECV | SnIR::DISCON;
+        CHECK((events & expectedEvents) == expectedEvents, "socket events 0x%x", events);
+    }
+
+    // Callmebot: nothing listens on the mapped port, the connection times out
+    {
+        uint16_t port;
+        int fd = host_listen(SOCK_STREAM, &port);
+        close(fd);
+        emu->mapPort(CALLMEBOT_PORT, port);
+        Callmebot bot(onBotState);
+        botState = Callmebot::Unknown;
+        bot.send("alarm detected");
+        run_bot(bot);
+        CHECK(botState == Callmebot::SentFail, "Callmebot state %d", botState);
+        uint32_t events = 0;
+        for (uint32_t sn_ir : binlog_sn_ir())
+        {
+            events |= sn_ir;
+        }
+        CHECK(events & SnIR::TIMEOUT, "socket events 0x%x", events);
+    }
+
+    std::vector<Result> results;
+
+    // throughput: 1 MB through the library, then through W5100sSpi
+    results.push_back(run_sink("tcp_tx", false));
+    results.push_back(run_sink("tcp_tx_burst", true));
+
+    // latency: request / response against an echo server
+    results.push_back(run_echo("tcp_echo", false));
+    results.push_back(run_echo("tcp_echo_burst", true));
+
+    // UDP: datagrams keep their boundaries and peer address
+    {
+        uint16_t port;
+        int fd = host_listen(SOCK_DGRAM, &port);
+        std::thread server(udp_echo, fd, ECHO_ROUNDS);
+        emu->mapPort(8888, 0); // any free host port
+        EthernetUDP udp;
+        CHECK(udp.begin(8888), "udp begin");
+        uint8_t out[ECHO_SIZE], in[ECHO_SIZE];
+
+        emu->clearStats();
+        uint32_t start = micros();
+        int good = 0;
+        for (int i = 0; i < ECHO_ROUNDS; i++)
+        {
+            memset(out, i, sizeof(out));
+            udp.beginPacket(IPAddress(127, 0, 0, 1), port);
+            udp.write(out, sizeof(out));
+            udp.endPacket();
+            int size;
+            while (!(size = udp.parsePacket()))
+            {
+            }
+            if ((size == ECHO_SIZE) && (udp.read(in, sizeof(in)) == ECHO_SIZE) && !memcmp(in, out, sizeof(in)) &&
+                (udp.remotePort() == port) && (udp.remoteIP() == IPAddress(127, 0, 0, 1)))
+            {
+                good++;
+            }
+        }
+        results.push_back({"udp_echo", 2.0 * ECHO_ROUNDS * ECHO_SIZE, (micros() - start) * 1e-6, emu->spiStats()});
+        udp.stop();
+        server.join();
+        close(fd);
+        CHECK(good == ECHO_ROUNDS, "%d of %d datagrams", good, ECHO_ROUNDS);
+    }
+
+    printf("\n");
+    for (auto &r : results)
+    {
+        print_result(r);
+    }
+
+    if (json)
+    {
+        FILE *f = fopen(json, "w");
+        if (!f)
+        {
+            fprintf(stderr, "cannot write %s\n", json);
+            return 1;
+        }
+        fprintf(f, "{\n  \"spi_clock_hz\": %.0f,\n  \"results\": [\n", SPI_CLOCK_HZ);
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            const Result &r = results[i];
+            fprintf(f, "    {\"name\": \"%s\", \"payload_bytes\": %.0f, \"seconds\": %.6f, \"spi_frames\": %llu, "
+                       "\"spi_bytes\": %llu, \"spi_seconds\": %.6f}%s\n",
+                    r.name, r.payload, r.seconds, (unsigned long long)r.spi.frames, (unsigned long long)r.spi.bytes,
+                    r.spi.bytes * 8 / SPI_CLOCK_HZ, (i + 1 < results.size()) ? "," : "");
+        }
+        fprintf(f, "  ]\n}\n");
+        fclose(f);
+        printf("\nwritten %s\n", json);
+    }
+
+    printf("%s\n", failures ? "FAILED" : "passed");
+    return failures ? 1 : 0;
+}